@@ -4,6 +4,8 @@
 // =============================================================================
 // This shader runs ONCE FOR EACH PIXEL that the triangle covers.
 // Its job: Determine the final color of each pixel.
+//
+// SHADOWS and FOG are optional features (see basic.vert).
 // =============================================================================
 
 // Input from Vertex Shader (interpolated values)
@@ -20,6 +22,31 @@ uniform vec3 uLightColor;     // Light color (usually white)
 uniform vec3 uAmbientColor;   // Ambient light (fills in shadows)
 uniform vec3 uCameraPos;      // Camera position (for specular)
 
+#ifdef SHADOWS
+in vec4 vLightSpacePosition;
+uniform sampler2DShadow uShadowMap;  // Depth compare done by the sampler
+
+// Fraction of light reaching this pixel, averaged over 2x2 texels (PCF)
+float shadowFactor() {
+    vec3 coords = vLightSpacePosition.xyz / vLightSpacePosition.w * 0.5 + 0.5;
+    if (coords.z > 1.0) {
+        return 1.0;  // Beyond the light's far plane
+    }
+    coords.z -= 0.002;  // Bias against shadow acne
+    float lit = 0.0;
+    lit += textureOffset(uShadowMap, coords, ivec2(0, 0));
+    lit += textureOffset(uShadowMap, coords, ivec2(1, 0));
+    lit += textureOffset(uShadowMap, coords, ivec2(0, 1));
+    lit += textureOffset(uShadowMap, coords, ivec2(1, 1));
+    return lit * 0.25;
+}
+#endif
+
+#ifdef FOG
+uniform vec3 uFogColor;      // What distant geometry fades into
+uniform float uFogDensity;   // Per meter
+#endif
+
 void main() {
     // Normalize the normal (interpolation can de-normalize it)
     vec3 normal = normalize(vNormal);
@@ -37,8 +64,22 @@ void main() {
     float spec = pow(max(dot(normal, halfDir), 0.0), 32.0);
     vec3 specular = spec * uLightColor * 0.3;
 
+#ifdef SHADOWS
+    // Shadows only block the direct light
+    float shadow = shadowFactor();
+    diffuse *= shadow;
+    specular *= shadow;
+#endif
+
     // Combine all lighting
     vec3 result = ambient + diffuse + specular;
 
+#ifdef FOG
+    // Exponential-squared: clear up close, thickening quickly with distance
+    float fogDistance = length(uCameraPos - vPosition) * uFogDensity;
+    float visibility = exp(-fogDistance * fogDistance);
+    result = mix(uFogColor, result, visibility);
+#endif
+
     FragColor = vec4(result, 1.0);
 }
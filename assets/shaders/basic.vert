@@ -6,6 +6,9 @@
 // Its job: Transform vertex positions from model space to screen space.
 //
 // GLSL (OpenGL Shading Language) looks like C but runs on the GPU.
+//
+// This is an uber-shader: ShaderPermutations compiles it once per combination of
+// INSTANCING, SKINNING, SHADOWS and FOG by #defining them after the #version line.
 // =============================================================================
 
 // Input Attributes - These match glVertexAttribPointer indices in Mesh.cpp
@@ -13,24 +16,63 @@ layout(location = 0) in vec3 aPosition;  // Vertex position
 layout(location = 1) in vec3 aNormal;    // Vertex normal
 layout(location = 2) in vec3 aColor;     // Vertex color
 
+#ifdef INSTANCING
+layout(location = 3) in mat4 aInstanceModel;  // Per-instance model matrix (locations 3-6)
+#endif
+
+#ifdef SKINNING
+#define MAX_BONES 64
+layout(location = 7) in uvec4 aBoneIndices;   // Up to four bones per vertex
+layout(location = 8) in vec4 aBoneWeights;    // Weights sum to 1
+uniform mat4 uBones[MAX_BONES];               // Bone pose * inverse bind pose
+#endif
+
 // Output to Fragment Shader - interpolated across the triangle
 out vec3 vPosition;  // World position (for lighting)
 out vec3 vNormal;    // Normal vector (for lighting)
 out vec3 vColor;     // Color
 
+#ifdef SHADOWS
+out vec4 vLightSpacePosition;  // Position as the shadow-casting light sees it
+uniform mat4 uLightViewProjection;
+#endif
+
 // Uniforms - values set from C++ that stay constant per draw call
 uniform mat4 uModel;       // Model matrix: object -> world space
 uniform mat4 uView;        // View matrix: world -> camera space
 uniform mat4 uProjection;  // Projection matrix: camera -> screen space
 
 void main() {
+#ifdef INSTANCING
+    mat4 model = aInstanceModel;
+#else
+    mat4 model = uModel;
+#endif
+
+    vec4 localPosition = vec4(aPosition, 1.0);
+    vec3 localNormal = aNormal;
+
+#ifdef SKINNING
+    // Blend the bone transforms, then move the vertex as if it were rigid
+    mat4 skin = aBoneWeights.x * uBones[aBoneIndices.x]
+              + aBoneWeights.y * uBones[aBoneIndices.y]
+              + aBoneWeights.z * uBones[aBoneIndices.z]
+              + aBoneWeights.w * uBones[aBoneIndices.w];
+    localPosition = skin * localPosition;
+    localNormal = mat3(skin) * localNormal;
+#endif
+
     // Transform position to world space
-    vec4 worldPosition = uModel * vec4(aPosition, 1.0);
+    vec4 worldPosition = model * localPosition;
     vPosition = worldPosition.xyz;
 
     // Transform normal to world space
     // transpose(inverse()) handles non-uniform scaling correctly
-    vNormal = mat3(transpose(inverse(uModel))) * aNormal;
+    vNormal = mat3(transpose(inverse(model))) * localNormal;
+
+#ifdef SHADOWS
+    vLightSpacePosition = uLightViewProjection * worldPosition;
+#endif
 
     // Pass color through unchanged
     vColor = aColor;
@@ -0,0 +1,20 @@
+#version 450 core
+// =============================================================================
+// bloom_downsample.frag - Bloom Downsample
+// =============================================================================
+// Halves resolution with four bilinear taps (a 4x4 box over the source).
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uSource;
+uniform vec2 uTexelSize;   // Of the source
+
+void main() {
+    vec3 color = texture(uSource, vUV + uTexelSize * vec2(-1.0, -1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(1.0, -1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(-1.0, 1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(1.0, 1.0)).rgb;
+    FragColor = vec4(color * 0.25, 1.0);
+}
@@ -0,0 +1,31 @@
+#version 450 core
+// =============================================================================
+// bloom_prefilter.frag - Bloom Bright Pass
+// =============================================================================
+// Downsamples the HDR scene to half resolution and keeps only what is brighter
+// than the threshold, with a soft knee so bloom fades in instead of popping.
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uSource;
+uniform vec2 uTexelSize;   // Of the source
+uniform float uThreshold;
+uniform float uKnee;
+
+void main() {
+    // Four bilinear taps average a 4x4 texel footprint
+    vec3 color = texture(uSource, vUV + uTexelSize * vec2(-1.0, -1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(1.0, -1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(-1.0, 1.0)).rgb;
+    color += texture(uSource, vUV + uTexelSize * vec2(1.0, 1.0)).rgb;
+    color = min(color * 0.25, vec3(64.0));  // Clamp single-pixel fireflies
+
+    float brightness = max(color.r, max(color.g, color.b));
+    float soft = clamp(brightness - uThreshold + uKnee, 0.0, 2.0 * uKnee);
+    soft = soft * soft / (4.0 * uKnee + 1e-4);
+    float contribution = max(soft, brightness - uThreshold) / max(brightness, 1e-4);
+
+    FragColor = vec4(color * contribution, 1.0);
+}
@@ -0,0 +1,23 @@
+#version 450 core
+// =============================================================================
+// bloom_upsample.frag - Bloom Upsample
+// =============================================================================
+// 3x3 tent filter over the smaller level; additively blended into the next
+// larger one, so each level ends up holding the sum of everything below it.
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uSource;
+uniform vec2 uTexelSize;   // Of the source
+
+void main() {
+    vec2 d = uTexelSize;
+    vec3 color = texture(uSource, vUV).rgb * 4.0;
+    color += (texture(uSource, vUV + vec2(-d.x, 0.0)).rgb + texture(uSource, vUV + vec2(d.x, 0.0)).rgb
+            + texture(uSource, vUV + vec2(0.0, -d.y)).rgb + texture(uSource, vUV + vec2(0.0, d.y)).rgb) * 2.0;
+    color += texture(uSource, vUV + vec2(-d.x, -d.y)).rgb + texture(uSource, vUV + vec2(d.x, -d.y)).rgb
+           + texture(uSource, vUV + vec2(-d.x, d.y)).rgb + texture(uSource, vUV + vec2(d.x, d.y)).rgb;
+    FragColor = vec4(color / 16.0, 1.0);
+}
@@ -0,0 +1,29 @@
+#version 450 core
+// =============================================================================
+// color_grade.frag - Colour Grading
+// =============================================================================
+// Lift/gamma/gain per channel, then saturation and contrast, in display range.
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uSource;
+uniform vec3 uLift;
+uniform vec3 uGamma;
+uniform vec3 uGain;
+uniform float uSaturation;
+uniform float uContrast;
+
+void main() {
+    vec3 color = texture(uSource, vUV).rgb;
+
+    color = uGain * (color + uLift * (1.0 - color));
+    color = pow(max(color, vec3(0.0)), 1.0 / uGamma);
+
+    float luma = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    color = mix(vec3(luma), color, uSaturation);
+    color = (color - 0.5) * uContrast + 0.5;
+
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450 core
+// =============================================================================
+// debug_draw.frag - Debug Lines
+// =============================================================================
+// Flat vertex colour. Depth-tested and overlay lines share this program; the
+// render pass decides whether the depth test applies.
+// =============================================================================
+
+in vec4 vColor;
+out vec4 FragColor;
+
+void main() {
+    FragColor = vColor;
+}
@@ -0,0 +1,19 @@
+#version 450 core
+// =============================================================================
+// debug_draw.vert - Debug Lines
+// =============================================================================
+// World-space line vertices from DebugDraw; the colour arrives as normalized
+// RGBA8 straight from the vertex buffer.
+// =============================================================================
+
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec4 aColor;
+
+out vec4 vColor;
+
+uniform mat4 uViewProjection;
+
+void main() {
+    vColor = aColor;
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
+}
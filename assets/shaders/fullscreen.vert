@@ -0,0 +1,15 @@
+#version 450 core
+// =============================================================================
+// fullscreen.vert - Fullscreen Triangle
+// =============================================================================
+// No vertex buffer: three vertices from gl_VertexID make one triangle that
+// covers the screen, with UVs running 0..1 over the visible part.
+// =============================================================================
+
+out vec2 vUV;
+
+void main() {
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);  // (0,0) (2,0) (0,2)
+    vUV = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
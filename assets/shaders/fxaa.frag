@@ -0,0 +1,52 @@
+#version 450 core
+// =============================================================================
+// fxaa.frag - Fast Approximate Anti-Aliasing
+// =============================================================================
+// Lottes' FXAA (reduced quality preset): estimates the edge direction from
+// luma at the four diagonal neighbours and blurs along it, falling back to the
+// narrower blur when the wide one picks up colour from across the edge.
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uSource;
+uniform vec2 uTexelSize;
+
+const float SPAN_MAX = 8.0;
+const float REDUCE_MUL = 1.0 / 8.0;
+const float REDUCE_MIN = 1.0 / 128.0;
+const vec3 LUMA = vec3(0.299, 0.587, 0.114);
+
+void main() {
+    vec3 rgbNW = texture(uSource, vUV + vec2(-1.0, -1.0) * uTexelSize).rgb;
+    vec3 rgbNE = texture(uSource, vUV + vec2(1.0, -1.0) * uTexelSize).rgb;
+    vec3 rgbSW = texture(uSource, vUV + vec2(-1.0, 1.0) * uTexelSize).rgb;
+    vec3 rgbSE = texture(uSource, vUV + vec2(1.0, 1.0) * uTexelSize).rgb;
+    vec3 rgbM = texture(uSource, vUV).rgb;
+
+    float lumaNW = dot(rgbNW, LUMA);
+    float lumaNE = dot(rgbNE, LUMA);
+    float lumaSW = dot(rgbSW, LUMA);
+    float lumaSE = dot(rgbSE, LUMA);
+    float lumaM = dot(rgbM, LUMA);
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+    // Perpendicular to the luma gradient
+    vec2 dir;
+    dir.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+    dir.y = ((lumaNW + lumaSW) - (lumaNE + lumaSE));
+
+    float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25 * REDUCE_MUL), REDUCE_MIN);
+    float rcpDirMin = 1.0 / (min(abs(dir.x), abs(dir.y)) + dirReduce);
+    dir = clamp(dir * rcpDirMin, vec2(-SPAN_MAX), vec2(SPAN_MAX)) * uTexelSize;
+
+    vec3 rgbA = 0.5 * (texture(uSource, vUV + dir * (1.0 / 3.0 - 0.5)).rgb
+                     + texture(uSource, vUV + dir * (2.0 / 3.0 - 0.5)).rgb);
+    vec3 rgbB = rgbA * 0.5 + 0.25 * (texture(uSource, vUV - dir * 0.5).rgb
+                                   + texture(uSource, vUV + dir * 0.5).rgb);
+
+    float lumaB = dot(rgbB, LUMA);
+    FragColor = vec4((lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, 1.0);
+}
@@ -0,0 +1,32 @@
+#version 450 core
+// =============================================================================
+// tonemap.frag - HDR Resolve
+// =============================================================================
+// Adds bloom, applies exposure, and maps scene-referred colour into [0, 1]
+// with a filmic ACES curve (or a plain clamp when tonemapping is off).
+// =============================================================================
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D uScene;
+uniform sampler2D uBloom;
+uniform float uBloomIntensity;   // 0 when bloom is off
+uniform float uExposure;
+uniform int uTonemap;
+
+// Narkowicz's fit of the ACES reference rendering transform
+vec3 aces(vec3 x) {
+    return clamp((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14), 0.0, 1.0);
+}
+
+void main() {
+    vec3 hdr = texture(uScene, vUV).rgb;
+    if (uBloomIntensity > 0.0) {
+        hdr += texture(uBloom, vUV).rgb * uBloomIntensity;
+    }
+    hdr *= uExposure;
+
+    vec3 ldr = (uTonemap != 0) ? aces(hdr) : clamp(hdr, 0.0, 1.0);
+    FragColor = vec4(ldr, 1.0);
+}
@@ -0,0 +1,98 @@
+// AllocationCounter.cpp
+// Global operator new/delete replacements that feed AllocationStats (SPORTS_COUNT_ALLOCATIONS).
+#include "Metrics.hpp"
+
+#ifdef SPORTS_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+void* countedAlloc(std::size_t size) {
+    // Relaxed adds: contended only when many threads allocate at once, which the hot paths avoid
+    Sports::AllocationStats::count.fetch_add(1, std::memory_order_relaxed);
+    Sports::AllocationStats::bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+// Over-aligned types (alignas > __STDCPP_DEFAULT_NEW_ALIGNMENT__) land here; they must be
+// counted too and freed with the matching call
+void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    Sports::AllocationStats::count.fetch_add(1, std::memory_order_relaxed);
+    Sports::AllocationStats::bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    std::size_t rounded = ((size ? size : 1) + align - 1) & ~(align - 1);
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void alignedFree(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+
+#endif
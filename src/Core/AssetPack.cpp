@@ -0,0 +1,172 @@
+// AssetPack.cpp
+// Pack validation, index lookup, and pack writing.
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Sports {
+
+namespace {
+
+u64 alignUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+u64 AssetPack::hashPath(std::string_view path) {
+    // FNV-1a, 64-bit
+    u64 hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash ^= static_cast<u8>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+AssetType AssetPack::typeFromExtension(std::string_view path) {
+    auto endsWith = [&](std::string_view ext) {
+        return path.size() >= ext.size() && path.substr(path.size() - ext.size()) == ext;
+    };
+    if (endsWith(".vert") || endsWith(".frag") || endsWith(".comp") || endsWith(".glsl")) return AssetType::Shader;
+    if (endsWith(".mesh")) return AssetType::Mesh;
+    if (endsWith(".lut")) return AssetType::Table;
+    if (endsWith(".formation")) return AssetType::Formation;
+    return AssetType::Raw;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!m_mapping.open(path)) {
+        return false;
+    }
+    m_base = m_mapping.data();
+    m_size = m_mapping.size();
+
+    // Validate everything the lookups will dereference
+    PackHeader header;
+    bool valid = m_size >= sizeof(PackHeader);
+    if (valid) {
+        std::memcpy(&header, m_base, sizeof(header));
+        u64 indexBytes = static_cast<u64>(header.entryCount) * sizeof(PackEntry);
+        valid = std::memcmp(header.magic, "SPAK", 4) == 0 && header.version == 1 &&
+                header.indexOffset % alignof(PackEntry) == 0 &&
+                header.indexOffset + indexBytes <= m_size && header.namesOffset <= m_size;
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const PackEntry*>(m_base + header.indexOffset);
+    m_entryCount = header.entryCount;
+    m_names = reinterpret_cast<const char*>(m_base + header.namesOffset);
+
+    for (u32 i = 0; i < m_entryCount; i++) {
+        const PackEntry& e = m_entries[i];
+        if (e.offset + e.size > m_size || header.namesOffset + e.nameOffset + e.nameLength > m_size) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    m_mapping.close();
+    m_base = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_names = nullptr;
+}
+
+std::string_view AssetPack::getName(const PackEntry& entry) const {
+    return std::string_view(m_names + entry.nameOffset, entry.nameLength);
+}
+
+const PackEntry* AssetPack::findEntry(std::string_view path) const {
+    if (!m_entries) return nullptr;
+
+    u64 hash = hashPath(path);
+    const PackEntry* end = m_entries + m_entryCount;
+    const PackEntry* it = std::lower_bound(m_entries, end, hash,
+        [](const PackEntry& e, u64 h) { return e.hash < h; });
+
+    for (; it != end && it->hash == hash; ++it) {
+        if (getName(*it) == path) return it;
+    }
+    return nullptr;
+}
+
+std::span<const u8> AssetPack::find(std::string_view path) const {
+    const PackEntry* entry = findEntry(path);
+    if (!entry) return {};
+    return {m_base + entry->offset, static_cast<size_t>(entry->size)};
+}
+
+void AssetPackWriter::add(std::string path, std::vector<u8> data) {
+    std::replace(path.begin(), path.end(), '\\', '/');
+    m_assets.push_back({std::move(path), std::move(data)});
+}
+
+bool AssetPackWriter::write(const std::string& outputPath) const {
+    PackHeader header;
+    header.entryCount = static_cast<u32>(m_assets.size());
+
+    // Blobs first, each on its own aligned offset
+    std::vector<PackEntry> entries;
+    std::string names;
+    u64 offset = alignUp(sizeof(PackHeader), AssetPack::BLOB_ALIGNMENT);
+    for (const auto& asset : m_assets) {
+        PackEntry entry;
+        entry.hash = AssetPack::hashPath(asset.path);
+        entry.offset = offset;
+        entry.size = asset.data.size();
+        entry.nameOffset = static_cast<u32>(names.size());
+        entry.nameLength = static_cast<u16>(asset.path.size());
+        entry.type = static_cast<u16>(AssetPack::typeFromExtension(asset.path));
+        entries.push_back(entry);
+        names += asset.path;
+        offset = alignUp(offset + asset.data.size(), AssetPack::BLOB_ALIGNMENT);
+    }
+
+    std::vector<u32> order(entries.size());
+    for (u32 i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](u32 a, u32 b) { return entries[a].hash < entries[b].hash; });
+
+    std::vector<PackEntry> sorted;
+    for (u32 i : order) sorted.push_back(entries[i]);
+
+    header.indexOffset = offset;
+    header.namesOffset = offset + sorted.size() * sizeof(PackEntry);
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    auto pad = [&](u64 target) {
+        static const char zeros[AssetPack::BLOB_ALIGNMENT] = {};
+        u64 at = static_cast<u64>(out.tellp());
+        if (target > at) out.write(zeros, static_cast<std::streamsize>(target - at));
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t i = 0; i < m_assets.size(); i++) {
+        pad(entries[i].offset);
+        out.write(reinterpret_cast<const char*>(m_assets[i].data.data()),
+                  static_cast<std::streamsize>(m_assets[i].data.size()));
+    }
+    pad(header.indexOffset);
+    out.write(reinterpret_cast<const char*>(sorted.data()),
+              static_cast<std::streamsize>(sorted.size() * sizeof(PackEntry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    return static_cast<bool>(out);
+}
+
+}
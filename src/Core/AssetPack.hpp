@@ -0,0 +1,88 @@
+// AssetPack.hpp
+// Single-file asset archive: sorted hash index over aligned blobs, opened with one memory mapping.
+#pragma once
+
+#include "MappedFile.hpp"
+#include "Types.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Sports {
+
+enum class AssetType : u32 { Raw, Shader, Mesh, Table, Formation };
+
+// On-disk layout: header, blobs (each BLOB_ALIGNMENT-aligned), entry index, name table
+struct PackHeader {
+    char magic[4] = {'S', 'P', 'A', 'K'};
+    u32 version = 1;
+    u32 entryCount = 0;
+    u32 reserved = 0;
+    u64 indexOffset = 0;  // PackEntry[entryCount], sorted by hash
+    u64 namesOffset = 0;  // Concatenated paths, for listing and collision checks
+};
+static_assert(sizeof(PackHeader) == 32, "PackHeader layout is part of the file format");
+
+struct PackEntry {
+    u64 hash = 0;         // fnv1a of the normalized path
+    u64 offset = 0;       // From the start of the file
+    u64 size = 0;
+    u32 nameOffset = 0;   // Into the name table
+    u16 nameLength = 0;
+    u16 type = 0;         // AssetType
+};
+static_assert(sizeof(PackEntry) == 32, "PackEntry layout is part of the file format");
+
+// Read-only view of a mapped pack; lookups return spans straight into the mapping
+class AssetPack {
+public:
+    static constexpr u64 BLOB_ALIGNMENT = 64;  // Cache line; safe for SIMD loads of tables
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    // Empty span if the path is not in the pack
+    std::span<const u8> find(std::string_view path) const;
+    const PackEntry* findEntry(std::string_view path) const;
+
+    u32 getEntryCount() const { return m_entryCount; }
+    std::string_view getName(const PackEntry& entry) const;
+    size_t getMappedSize() const { return m_size; }
+
+    static u64 hashPath(std::string_view path);
+    static AssetType typeFromExtension(std::string_view path);
+
+private:
+    MappedFile m_mapping;
+    const u8* m_base = nullptr;
+    size_t m_size = 0;
+    const PackEntry* m_entries = nullptr;
+    u32 m_entryCount = 0;
+    const char* m_names = nullptr;
+};
+
+// Builds a pack in memory and writes it out (used by the packer tool)
+class AssetPackWriter {
+public:
+    void add(std::string path, std::vector<u8> data);
+    bool write(const std::string& outputPath) const;
+
+    size_t getCount() const { return m_assets.size(); }
+
+private:
+    struct Pending {
+        std::string path;
+        std::vector<u8> data;
+    };
+    std::vector<Pending> m_assets;
+};
+
+}
@@ -0,0 +1,255 @@
+// CpuTopology.cpp
+// Sysfs parsing, placement planning, and platform affinity/priority calls.
+#include "CpuTopology.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Sports {
+
+namespace {
+
+constexpr u32 MAX_CACHE_INDEX = 8;
+
+bool readLine(const std::string& path, std::string& out) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, out));
+}
+
+bool readNumber(const std::string& path, u32& out) {
+    std::string line;
+    if (!readLine(path, line) || line.empty()) return false;
+    out = static_cast<u32>(std::strtoul(line.c_str(), nullptr, 10));
+    return true;
+}
+
+#ifdef __linux__
+bool toCpuSet(const std::vector<u32>& cpus, cpu_set_t& set) {
+    CPU_ZERO(&set);
+    for (u32 cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return !cpus.empty();
+}
+#elif defined(_WIN32)
+DWORD_PTR toMask(const std::vector<u32>& cpus) {
+    DWORD_PTR mask = 0;
+    for (u32 cpu : cpus) {
+        if (cpu < sizeof(DWORD_PTR) * 8) mask |= DWORD_PTR(1) << cpu;  // First processor group only
+    }
+    return mask;
+}
+#endif
+
+}
+
+std::vector<u32> CpuTopology::parseCpuList(const std::string& list) {
+    std::vector<u32> cpus;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        std::string range = list.substr(pos, end - pos);
+        pos = end + 1;
+        if (range.empty()) continue;
+
+        size_t dash = range.find('-');
+        unsigned long first = std::strtoul(range.c_str(), nullptr, 10);
+        unsigned long last = dash == std::string::npos ? first : std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+        if (last >= MAX_CPUS) {
+            return {};  // Checked before the loop, which would never end at UINT_MAX
+        }
+        for (u32 cpu = static_cast<u32>(first); cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+CpuTopology CpuTopology::detect(const std::string& sysRoot) {
+    CpuTopology topology;
+
+    std::string online;
+    std::vector<u32> ids;
+    if (readLine(sysRoot + "/online", online)) {
+        ids = parseCpuList(online);
+    }
+
+    // Dense indices keyed by (package, core_id) and by the lowest cpu sharing an L3
+    std::map<std::pair<u32, u32>, u32> cores;
+    std::map<u32, u32> domains;
+
+    for (u32 id : ids) {
+        std::string cpuDir = sysRoot + "/cpu" + std::to_string(id);
+        u32 package = 0;
+        u32 coreId = id;
+        if (!readNumber(cpuDir + "/topology/core_id", coreId)) {
+            ids.clear();  // Incomplete sysfs: trust none of it
+            break;
+        }
+        readNumber(cpuDir + "/topology/physical_package_id", package);
+
+        u32 domainKey = ~0u;
+        for (u32 index = 0; index < MAX_CACHE_INDEX; index++) {
+            std::string cacheDir = cpuDir + "/cache/index" + std::to_string(index);
+            u32 level = 0;
+            std::string shared;
+            if (!readNumber(cacheDir + "/level", level)) break;
+            if (level == 3 && readLine(cacheDir + "/shared_cpu_list", shared)) {
+                std::vector<u32> sharing = parseCpuList(shared);
+                if (!sharing.empty()) domainKey = *std::min_element(sharing.begin(), sharing.end());
+                break;
+            }
+        }
+        if (domainKey == ~0u) {
+            domainKey = 0x80000000u | package;  // No L3 reported: one domain per package
+        }
+
+        auto core = cores.try_emplace({package, coreId}, static_cast<u32>(cores.size())).first->second;
+        auto domain = domains.try_emplace(domainKey, static_cast<u32>(domains.size())).first->second;
+        topology.m_cpus.push_back({id, core, domain});
+    }
+
+    if (!ids.empty()) {
+        topology.m_coreCount = static_cast<u32>(cores.size());
+        topology.m_domainCount = static_cast<u32>(domains.size());
+        topology.m_detected = true;
+        return topology;
+    }
+
+    // No usable /sys: every hardware thread is its own core in one domain
+    topology.m_cpus.clear();
+    u32 hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (u32 i = 0; i < hardware; i++) {
+        topology.m_cpus.push_back({i, i, 0});
+    }
+    topology.m_coreCount = hardware;
+    topology.m_domainCount = 1;
+    return topology;
+}
+
+std::vector<u32> CpuTopology::cpusOfCore(u32 core) const {
+    std::vector<u32> cpus;
+    for (const LogicalCpu& cpu : m_cpus) {
+        if (cpu.core == core) cpus.push_back(cpu.id);
+    }
+    return cpus;
+}
+
+std::vector<u32> CpuTopology::cpusOfDomain(u32 domain) const {
+    std::vector<u32> cpus;
+    for (const LogicalCpu& cpu : m_cpus) {
+        if (cpu.domain == domain) cpus.push_back(cpu.id);
+    }
+    return cpus;
+}
+
+ThreadPlacementConfig ThreadPlacementConfig::fromEnvironment() {
+    ThreadPlacementConfig config;
+    if (const char* pin = std::getenv("SPORTS_PIN_THREADS")) {
+        config.pinThreads = std::string(pin) != "0";
+    }
+    if (const char* fifo = std::getenv("SPORTS_FRAME_FIFO")) {
+        config.framePriority = std::clamp(std::atoi(fifo), 0, 99);
+    }
+    return config;
+}
+
+ThreadPlacement ThreadPlacement::plan(const CpuTopology& topology, u32 workerCount) {
+    ThreadPlacement placement;
+    // Guessed layouts and tiny machines: pinning would only take options away from the scheduler
+    if (!topology.isDetected() || topology.getCoreCount() < 2) {
+        return placement;
+    }
+
+    // Frame core: first core in domain 0 that is not cpu 0's (interrupts and housekeeping land there)
+    const std::vector<LogicalCpu>& cpus = topology.getCpus();
+    u32 frameCore = cpus.front().core;
+    for (const LogicalCpu& cpu : cpus) {
+        if (cpu.domain == cpus.front().domain && cpu.core != cpus.front().core) {
+            frameCore = cpu.core;
+            break;
+        }
+    }
+    placement.frameCpus = {topology.cpusOfCore(frameCore).front()};
+
+    // Workers keep off the whole frame core so SMT siblings don't steal its execution units
+    std::vector<std::vector<u32>> domainCpus;
+    for (u32 d = 0; d < topology.getDomainCount(); d++) {
+        std::vector<u32> available;
+        for (const LogicalCpu& cpu : cpus) {
+            if (cpu.domain == d && cpu.core != frameCore) available.push_back(cpu.id);
+        }
+        if (!available.empty()) domainCpus.push_back(std::move(available));
+    }
+    if (domainCpus.empty()) {
+        return placement;
+    }
+
+    // Deal workers over domains in proportion to their free cpus, so batch worlds spread over every L3
+    std::vector<u32> assigned(domainCpus.size(), 0);
+    for (u32 w = 0; w < workerCount; w++) {
+        size_t best = 0;
+        for (size_t d = 1; d < domainCpus.size(); d++) {
+            // Lowest load first: assigned/size compared without division
+            if (assigned[d] * domainCpus[best].size() < assigned[best] * domainCpus[d].size()) best = d;
+        }
+        assigned[best]++;
+        placement.workerCpus.push_back(domainCpus[best]);
+    }
+    return placement;
+}
+
+bool ThreadAffinity::pinCurrentThread(const std::vector<u32>& cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    return toCpuSet(cpus, set) && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    DWORD_PTR mask = toMask(cpus);
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool ThreadAffinity::pinThread(std::thread& thread, const std::vector<u32>& cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    return toCpuSet(cpus, set) && pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    DWORD_PTR mask = toMask(cpus);
+    return mask != 0 && SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), mask) != 0;
+#else
+    (void)thread;
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool ThreadAffinity::setRealtimePriority(i32 priority) {
+#ifdef __linux__
+    sched_param param{};
+    param.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#elif defined(_WIN32)
+    (void)priority;
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,69 @@
+// CpuTopology.hpp
+// Machine topology from /sys (cores, SMT siblings, L3 domains) and thread placement/pinning.
+#pragma once
+
+#include "Types.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Sports {
+
+struct LogicalCpu {
+    u32 id = 0;       // OS cpu number
+    u32 core = 0;     // Dense physical core index (SMT siblings share it)
+    u32 domain = 0;   // Dense L3 domain index (package when no L3 is reported)
+};
+
+class CpuTopology {
+public:
+    static constexpr u32 MAX_CPUS = 4096;  // Kernel NR_CPUS ceiling; higher ids mean a corrupt list
+
+    // Reads <sysRoot>/cpuN/topology and cache; falls back to a flat layout without /sys
+    static CpuTopology detect(const std::string& sysRoot = "/sys/devices/system/cpu");
+
+    bool isDetected() const { return m_detected; }
+    const std::vector<LogicalCpu>& getCpus() const { return m_cpus; }
+    u32 getLogicalCount() const { return static_cast<u32>(m_cpus.size()); }
+    u32 getCoreCount() const { return m_coreCount; }
+    u32 getDomainCount() const { return m_domainCount; }
+
+    std::vector<u32> cpusOfCore(u32 core) const;
+    std::vector<u32> cpusOfDomain(u32 domain) const;
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}; empty if any id reaches MAX_CPUS
+    static std::vector<u32> parseCpuList(const std::string& list);
+
+private:
+    std::vector<LogicalCpu> m_cpus;  // Sorted by id
+    u32 m_coreCount = 0;
+    u32 m_domainCount = 0;
+    bool m_detected = false;
+};
+
+struct ThreadPlacementConfig {
+    bool pinThreads = true;       // SPORTS_PIN_THREADS=0 disables
+    i32 framePriority = 0;        // SPORTS_FRAME_FIFO=<1..99> runs the frame thread SCHED_FIFO
+
+    static ThreadPlacementConfig fromEnvironment();
+};
+
+// Frame (sim + render) thread gets a core of its own, its SMT siblings stay idle,
+// and workers are dealt round-robin over L3 domains, each pinned to its whole domain.
+struct ThreadPlacement {
+    std::vector<u32> frameCpus;                 // Empty = leave unpinned
+    std::vector<std::vector<u32>> workerCpus;   // One set per worker
+
+    static ThreadPlacement plan(const CpuTopology& topology, u32 workerCount);
+};
+
+class ThreadAffinity {
+public:
+    static bool pinCurrentThread(const std::vector<u32>& cpus);
+    static bool pinThread(std::thread& thread, const std::vector<u32>& cpus);
+
+    // SCHED_FIFO on Linux (needs CAP_SYS_NICE or an rtprio limit); time-critical priority on Windows
+    static bool setRealtimePriority(i32 priority);
+};
+
+}
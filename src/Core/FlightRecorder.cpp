@@ -0,0 +1,231 @@
+// FlightRecorder.cpp
+// Keyframe publishing, signal-safe dump writer, and dump loading.
+#include "FlightRecorder.hpp"
+
+#include <csignal>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Sports {
+
+namespace {
+
+// On-disk header, followed by `count` FrameSummaries (oldest first) and the keyframe bytes
+struct FlightFileHeader {
+    char magic[4];
+    u16 version;
+    u16 frameSize;
+    i32 reason;
+    u32 count;
+    u64 totalFrames;
+    u64 keyframeFrame;
+    u64 keyframeSize;
+};
+
+constexpr int CRASH_SIGNALS[] = {
+    SIGSEGV, SIGFPE, SIGILL, SIGABRT,
+#ifndef _WIN32
+    SIGBUS,
+#endif
+};
+
+#ifdef _WIN32
+int openForDump(const char* path) {
+    return _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        int written = _write(fd, bytes, static_cast<unsigned>(size));
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void closeDump(int fd) {
+    _close(fd);
+}
+#else
+int openForDump(const char* path) {
+    return ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void closeDump(int fd) {
+    ::close(fd);
+}
+#endif
+
+}
+
+FlightRecorder::FlightRecorder()
+    : m_frames(CAPACITY) {
+    // Allocated up front: nothing on the record or crash path allocates
+    m_keyframes[0].resize(MAX_KEYFRAME_BYTES);
+    m_keyframes[1].resize(MAX_KEYFRAME_BYTES);
+}
+
+FlightRecorder::~FlightRecorder() {
+    uninstallCrashHandler();
+}
+
+bool FlightRecorder::setKeyframe(u64 frame, std::span<const u8> data) {
+    if (data.size() > MAX_KEYFRAME_BYTES) {
+        return false;
+    }
+
+    i32 slot = m_publishedKeyframe.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+    std::memcpy(m_keyframes[slot].data(), data.data(), data.size());
+    m_keyframeSize[slot] = data.size();
+    m_keyframeFrame[slot] = frame;
+    m_publishedKeyframe.store(slot, std::memory_order_release);
+    return true;
+}
+
+bool FlightRecorder::installCrashHandler(const std::string& path) {
+    if (path.size() >= sizeof(m_crashPath)) {
+        return false;
+    }
+    std::memcpy(m_crashPath, path.c_str(), path.size() + 1);
+
+    FlightRecorder* expected = nullptr;
+    if (!s_active.compare_exchange_strong(expected, this) && expected != this) {
+        return false;
+    }
+
+#ifndef _WIN32
+    // A stack overflow leaves the handler no stack of its own to run on
+    m_signalStack.resize(SIGNAL_STACK_BYTES);
+    stack_t altStack {};
+    altStack.ss_sp = m_signalStack.data();
+    altStack.ss_size = m_signalStack.size();
+    sigaltstack(&altStack, nullptr);
+#endif
+
+    for (int sig : CRASH_SIGNALS) {
+#ifdef _WIN32
+        std::signal(sig, &FlightRecorder::onSignal);
+#else
+        struct sigaction action {};
+        action.sa_handler = &FlightRecorder::onSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESETHAND | SA_ONSTACK;  // Default action (core dump) on re-raise
+        sigaction(sig, &action, nullptr);
+#endif
+    }
+    return true;
+}
+
+void FlightRecorder::uninstallCrashHandler() {
+    FlightRecorder* expected = this;
+    if (!s_active.compare_exchange_strong(expected, nullptr)) {
+        return;
+    }
+    for (int sig : CRASH_SIGNALS) {
+        std::signal(sig, SIG_DFL);
+    }
+
+#ifndef _WIN32
+    // The stack is freed with the recorder; the kernel must stop using it first
+    stack_t disabled {};
+    disabled.ss_flags = SS_DISABLE;
+    sigaltstack(&disabled, nullptr);
+#endif
+}
+
+void FlightRecorder::onSignal(int signal) {
+    FlightRecorder* recorder = s_active.exchange(nullptr);
+    if (recorder) {
+        recorder->dump(recorder->m_crashPath, signal);
+    }
+
+    // Let the process die the way it would have
+#ifdef _WIN32
+    std::signal(signal, SIG_DFL);
+#endif
+    std::raise(signal);
+}
+
+bool FlightRecorder::dump(const char* path, i32 reason) const {
+    // Async-signal-safe: no allocation, no stdio, no locks
+    u64 head = m_head.load(std::memory_order_acquire);
+    u32 count = head < CAPACITY ? static_cast<u32>(head) : CAPACITY;
+    i32 keyframe = m_publishedKeyframe.load(std::memory_order_acquire);
+
+    FlightFileHeader header;
+    std::memcpy(header.magic, "FLTR", 4);
+    header.version = 1;
+    header.frameSize = sizeof(FrameSummary);
+    header.reason = reason;
+    header.count = count;
+    header.totalFrames = head;
+    header.keyframeFrame = keyframe >= 0 ? m_keyframeFrame[keyframe] : 0;
+    header.keyframeSize = keyframe >= 0 ? m_keyframeSize[keyframe] : 0;
+
+    int fd = openForDump(path);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Ring in chronological order: [first, end) then [0, head)
+    u32 first = static_cast<u32>((head - count) & (CAPACITY - 1));
+    u32 tail = count - (CAPACITY - first < count ? CAPACITY - first : count);
+    bool ok = writeAll(fd, &header, sizeof(header)) &&
+              writeAll(fd, m_frames.data() + first, (count - tail) * sizeof(FrameSummary)) &&
+              writeAll(fd, m_frames.data(), tail * sizeof(FrameSummary));
+    if (ok && header.keyframeSize > 0) {
+        ok = writeAll(fd, m_keyframes[keyframe].data(), header.keyframeSize);
+    }
+    closeDump(fd);
+    return ok;
+}
+
+bool FlightRecorder::load(const std::string& path, FlightDump& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    FlightFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, "FLTR", 4) != 0 || header.version != 1 ||
+        header.frameSize != sizeof(FrameSummary) || header.count > CAPACITY ||
+        header.keyframeSize > MAX_KEYFRAME_BYTES) {
+        return false;
+    }
+
+    out.reason = header.reason;
+    out.totalFrames = header.totalFrames;
+    out.keyframeFrame = header.keyframeFrame;
+    out.frames.resize(header.count);
+    out.keyframe.resize(header.keyframeSize);
+    file.read(reinterpret_cast<char*>(out.frames.data()), header.count * sizeof(FrameSummary));
+    file.read(reinterpret_cast<char*>(out.keyframe.data()), static_cast<std::streamsize>(header.keyframeSize));
+    return static_cast<bool>(file);
+}
+
+}
@@ -0,0 +1,97 @@
+// FlightRecorder.hpp
+// Always-on ring of recent frame summaries plus the last keyframe, flushed to disk on a crash.
+#pragma once
+
+#include "Types.hpp"
+#include <atomic>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+// One frame of the game loop (48 bytes)
+struct FrameSummary {
+    enum Flags : u32 {
+        Goal      = 1 << 0,
+        Restart   = 1 << 1,
+        NonFinite = 1 << 2,  // NaN/Inf reached the world state
+        Keyframe  = 1 << 3,  // A keyframe was taken this frame
+    };
+
+    u64 frame = 0;
+    u64 checksum = 0;      // World state hash, to find the first divergent frame on replay
+    f32 deltaTime = 0.0f;
+    f32 updateMs = 0.0f;
+    f32 renderMs = 0.0f;
+    u32 flags = 0;
+    u16 contacts = 0;
+    u16 reserved = 0;
+    f32 ballX = 0.0f;
+    f32 ballY = 0.0f;
+    f32 ballZ = 0.0f;
+};
+static_assert(sizeof(FrameSummary) == 48, "FrameSummary is written to disk as-is");
+
+// Contents of a dump file, for tooling (not used on the crash path)
+struct FlightDump {
+    i32 reason = 0;                   // Signal number, 0 for a manual dump
+    u64 totalFrames = 0;
+    u64 keyframeFrame = 0;
+    std::vector<FrameSummary> frames; // Oldest first
+    std::vector<u8> keyframe;         // Serialized world snapshot
+};
+
+class FlightRecorder {
+public:
+    static constexpr u32 CAPACITY = 1024;                // Frames kept (power of two)
+    static constexpr size_t MAX_KEYFRAME_BYTES = 256 * 1024;
+    static constexpr size_t SIGNAL_STACK_BYTES = 64 * 1024;
+
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Hot path: one 48-byte store, no locks or allocation
+    void record(const FrameSummary& summary) {
+        u64 head = m_head.load(std::memory_order_relaxed);
+        m_frames[head & (CAPACITY - 1)] = summary;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // Copies into the inactive buffer then publishes it, so a crash mid-copy still dumps the previous one
+    bool setKeyframe(u64 frame, std::span<const u8> data);
+
+    // Dumps to `path` on SIGSEGV/SIGBUS/SIGFPE/SIGILL/SIGABRT, then lets the signal proceed.
+    // One recorder can own the handler at a time. On POSIX the calling thread also gets an
+    // alternate signal stack, so a stack overflow there still writes its dump.
+    bool installCrashHandler(const std::string& path);
+    void uninstallCrashHandler();
+
+    // Same writer the signal handler uses (only async-signal-safe calls)
+    bool dump(const char* path, i32 reason) const;
+
+    static bool load(const std::string& path, FlightDump& out);
+
+    u64 getFrameCount() const { return m_head.load(std::memory_order_acquire); }
+
+private:
+    static void onSignal(int signal);
+
+    std::vector<FrameSummary> m_frames;
+    std::atomic<u64> m_head{0};
+
+    std::vector<u8> m_keyframes[2];
+    size_t m_keyframeSize[2] = {0, 0};
+    u64 m_keyframeFrame[2] = {0, 0};
+    std::atomic<i32> m_publishedKeyframe{-1};
+
+    char m_crashPath[256] = {};
+    std::vector<u8> m_signalStack;  // Alternate stack for the handler (POSIX)
+
+    static inline std::atomic<FlightRecorder*> s_active{nullptr};
+};
+
+}
@@ -0,0 +1,284 @@
+// FrameEncoder.cpp
+// Frame buffer pool, encoder thread, and RGBA to I420 conversion.
+#include "FrameEncoder.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+namespace Sports {
+
+namespace {
+
+// BT.601 limited range, 8-bit fixed point
+u8 lumaOf(i32 r, i32 g, i32 b) {
+    return static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+u8 blueDifferenceOf(i32 r, i32 g, i32 b) {
+    return static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+u8 redDifferenceOf(i32 r, i32 g, i32 b) {
+    return static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+}
+
+FrameEncoder::~FrameEncoder() {
+    close();
+    if (m_worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_wake.notify_all();
+        m_worker.join();
+    }
+}
+
+void FrameEncoder::startWorker() {
+    if (!m_worker.joinable()) {
+        m_worker = std::thread(&FrameEncoder::workerLoop, this);
+    }
+}
+
+VideoFormat FrameEncoder::formatForPath(const std::string& path) {
+    std::string extension = path.size() >= 4 ? path.substr(path.size() - 4) : "";
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".y4m" ? VideoFormat::Y4M : VideoFormat::Raw;
+}
+
+std::string FrameEncoder::partPath(const std::string& outputPath, size_t index) {
+    char number[16];
+    std::snprintf(number, sizeof(number), ".part%03zu", index);
+    size_t slash = outputPath.find_last_of("/\\");
+    size_t dot = outputPath.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = outputPath.size();
+    }
+    return outputPath.substr(0, dot) + number + outputPath.substr(dot);
+}
+
+bool FrameEncoder::concatenate(std::span<const std::string> parts, const std::string& outputPath) {
+    std::FILE* out = std::fopen(outputPath.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+
+    bool y4m = formatForPath(outputPath) == VideoFormat::Y4M;
+    std::string firstHeader;
+    std::vector<char> chunk(1 << 20);
+    bool ok = true;
+    for (size_t i = 0; ok && i < parts.size(); i++) {
+        std::FILE* in = std::fopen(parts[i].c_str(), "rb");
+        if (!in) {
+            ok = false;
+            break;
+        }
+        if (y4m) {
+            // The stream header is one line; later parts drop theirs
+            std::string header;
+            for (int c = std::fgetc(in); c != EOF; c = std::fgetc(in)) {
+                header.push_back(static_cast<char>(c));
+                if (c == '\n') break;
+            }
+            if (i == 0) {
+                firstHeader = header;
+                ok = std::fwrite(header.data(), 1, header.size(), out) == header.size();
+            } else {
+                ok = header == firstHeader;
+            }
+        }
+        for (size_t read; ok && (read = std::fread(chunk.data(), 1, chunk.size(), in)) > 0;) {
+            ok = std::fwrite(chunk.data(), 1, read, out) == read;
+        }
+        std::fclose(in);
+    }
+    ok = std::fclose(out) == 0 && ok;
+    return ok;
+}
+
+bool FrameEncoder::open(const std::string& path, u32 width, u32 height, u32 fps, VideoFormat format) {
+    close();
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        return false;
+    }
+    m_format = format;
+    m_width = width;
+    m_height = height;
+
+    if (format == VideoFormat::Y4M) {
+        std::string header = y4mHeader(width, height, fps);
+        std::fwrite(header.data(), 1, header.size(), m_file);
+        m_converted.resize(i420Size(width, height));
+    }
+
+    // Everything the render thread will touch is allocated up front
+    m_buffers.assign(QUEUE_DEPTH, std::vector<u8>(static_cast<size_t>(width) * height * 4));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.clear();
+        for (auto& buffer : m_buffers) {
+            m_free.push_back(&buffer);
+        }
+        m_ready.clear();
+    }
+    m_written.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+
+    startWorker();
+    return true;
+}
+
+void FrameEncoder::close() {
+    if (!m_file) {
+        return;
+    }
+    {
+        // The worker finishes the queue; it never touches the file while idle
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_returned.wait(lock, [this] { return m_ready.empty() && !m_busy; });
+        m_free.clear();
+    }
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_buffers.clear();
+    m_buffers.shrink_to_fit();
+}
+
+std::vector<u8>* FrameEncoder::acquireFrame(bool wait) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (wait) {
+        m_returned.wait(lock, [this] { return !m_free.empty(); });
+    }
+    if (m_free.empty()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    std::vector<u8>* frame = m_free.back();
+    m_free.pop_back();
+    return frame;
+}
+
+void FrameEncoder::submitFrame(std::vector<u8>* frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.push_back(frame);
+    }
+    m_wake.notify_one();
+}
+
+void FrameEncoder::cancelFrame(std::vector<u8>* frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(frame);
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    m_returned.notify_one();
+}
+
+void FrameEncoder::workerLoop() {
+    for (;;) {
+        std::vector<u8>* frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_shutdown || !m_ready.empty(); });
+            if (m_ready.empty()) break;  // Shutting down, and everything submitted is written
+            frame = m_ready.front();
+            m_ready.pop_front();
+            m_busy = true;
+        }
+
+        if (writeFrame(*frame)) {
+            m_written.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(frame);
+            m_busy = false;
+        }
+        m_returned.notify_all();  // The render thread and close() both wait on it
+    }
+}
+
+bool FrameEncoder::writeFrame(const std::vector<u8>& frame) {
+    if (m_format == VideoFormat::Y4M) {
+        rgbaToI420(frame.data(), m_width, m_height, m_converted.data());
+        static const char FRAME_TAG[] = "FRAME\n";
+        return std::fwrite(FRAME_TAG, 1, sizeof(FRAME_TAG) - 1, m_file) == sizeof(FRAME_TAG) - 1
+            && std::fwrite(m_converted.data(), 1, m_converted.size(), m_file) == m_converted.size();
+    }
+
+    // Raw: rows reversed on the way out
+    size_t rowBytes = static_cast<size_t>(m_width) * 4;
+    for (u32 y = m_height; y-- > 0;) {
+        if (std::fwrite(frame.data() + y * rowBytes, 1, rowBytes, m_file) != rowBytes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string FrameEncoder::y4mHeader(u32 width, u32 height, u32 fps) {
+    return "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) + " F" + std::to_string(fps) +
+           ":1 Ip A1:1 C420jpeg\n";
+}
+
+size_t FrameEncoder::i420Size(u32 width, u32 height) {
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    return static_cast<size_t>(width) * height + 2 * chroma;
+}
+
+void FrameEncoder::rgbaToI420(const u8* rgba, u32 width, u32 height, u8* out) {
+    u32 chromaWidth = (width + 1) / 2;
+    u32 chromaHeight = (height + 1) / 2;
+    u8* lumaPlane = out;
+    u8* bluePlane = out + static_cast<size_t>(width) * height;
+    u8* redPlane = bluePlane + static_cast<size_t>(chromaWidth) * chromaHeight;
+
+    auto pixel = [&](u32 x, u32 y) {
+        return rgba + (static_cast<size_t>(height - 1 - y) * width + x) * 4;  // y counts from the top
+    };
+
+    for (u32 y = 0; y < height; y++) {
+        u8* row = lumaPlane + static_cast<size_t>(y) * width;
+        for (u32 x = 0; x < width; x++) {
+            const u8* p = pixel(x, y);
+            row[x] = lumaOf(p[0], p[1], p[2]);
+        }
+    }
+
+    // Odd edges reuse the last column/row
+    for (u32 cy = 0; cy < chromaHeight; cy++) {
+        u32 y0 = 2 * cy;
+        u32 y1 = std::min(y0 + 1, height - 1);
+        for (u32 cx = 0; cx < chromaWidth; cx++) {
+            u32 x0 = 2 * cx;
+            u32 x1 = std::min(x0 + 1, width - 1);
+            i32 r = 0, g = 0, b = 0;
+            for (const u8* p : {pixel(x0, y0), pixel(x1, y0), pixel(x0, y1), pixel(x1, y1)}) {
+                r += p[0];
+                g += p[1];
+                b += p[2];
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            size_t index = static_cast<size_t>(cy) * chromaWidth + cx;
+            bluePlane[index] = blueDifferenceOf(r, g, b);
+            redPlane[index] = redDifferenceOf(r, g, b);
+        }
+    }
+}
+
+}
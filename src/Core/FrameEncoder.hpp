@@ -0,0 +1,96 @@
+// FrameEncoder.hpp
+// Background thread writing captured frames to disk as raw RGBA or Y4M video.
+#pragma once
+
+#include "Types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Sports {
+
+enum class VideoFormat : u8 {
+    Raw,   // RGBA8, top row first, no header (ffmpeg -f rawvideo -pix_fmt rgba)
+    Y4M,   // YUV4MPEG2, 4:2:0, BT.601 limited range
+};
+
+// The render thread borrows one of QUEUE_DEPTH preallocated frame buffers, fills
+// it, and submits it; the encoder thread converts and writes it, then returns it.
+// When every buffer is still queued the frame is dropped rather than waited for,
+// so a slow disk costs frames in the video, never frames on screen.
+//
+// Frames arrive bottom-up, as glReadPixels returns them; the flip happens here.
+//
+// The encoder thread lives from the first startWorker() or open() until destruction
+// and idles between recordings, so it keeps the affinity and priority of the thread
+// that started it rather than whatever that thread is given later.
+class FrameEncoder {
+public:
+    static constexpr u32 QUEUE_DEPTH = 8;
+
+    FrameEncoder() = default;
+    ~FrameEncoder();
+
+    FrameEncoder(const FrameEncoder&) = delete;
+    FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+    static VideoFormat formatForPath(const std::string& path);  // ".y4m" is Y4M, anything else raw
+
+    // Joins recordings of one size and format end to end; Y4M parts must share a header
+    static bool concatenate(std::span<const std::string> parts, const std::string& outputPath);
+    // out.y4m -> out.part007.y4m, so a part keeps the format the extension picks
+    static std::string partPath(const std::string& outputPath, size_t index);
+
+    void startWorker();  // Optional: open() starts the thread if it isn't running
+    bool open(const std::string& path, u32 width, u32 height, u32 fps, VideoFormat format);
+    void close();  // Writes everything already submitted; the thread stays for the next recording
+    bool isOpen() const { return m_file != nullptr; }
+
+    // Render thread: null when no buffer is free (the frame counts as dropped),
+    // unless wait is set, for offscreen runs that have no frame rate to protect
+    std::vector<u8>* acquireFrame(bool wait = false);
+    void submitFrame(std::vector<u8>* frame);
+    void cancelFrame(std::vector<u8>* frame);  // Returns an acquired buffer unwritten; counts as dropped
+    void dropFrame() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    u32 getWidth() const { return m_width; }
+    u32 getHeight() const { return m_height; }
+    const std::atomic<u64>* getWrittenCounter() const { return &m_written; }
+    const std::atomic<u64>* getDroppedCounter() const { return &m_dropped; }
+
+    static std::string y4mHeader(u32 width, u32 height, u32 fps);
+    static size_t i420Size(u32 width, u32 height);
+    // Bottom-up RGBA to top-down planar Y, U, V; chroma is each 2x2 block's average
+    static void rgbaToI420(const u8* rgba, u32 width, u32 height, u8* out);
+
+private:
+    void workerLoop();
+    bool writeFrame(const std::vector<u8>& frame);
+
+    std::FILE* m_file = nullptr;
+    VideoFormat m_format = VideoFormat::Raw;
+    u32 m_width = 0;
+    u32 m_height = 0;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;       // Encoder thread: frames are ready
+    std::condition_variable m_returned;   // Render thread: a buffer is free
+    std::vector<std::vector<u8>> m_buffers;  // QUEUE_DEPTH frames, allocated by open()
+    std::vector<std::vector<u8>*> m_free;    // Guarded by m_mutex
+    std::deque<std::vector<u8>*> m_ready;    // Guarded by m_mutex, oldest first
+    std::vector<u8> m_converted;             // Encoder thread only
+    bool m_busy = false;                     // Guarded by m_mutex: a frame is being written
+    bool m_shutdown = false;
+
+    std::atomic<u64> m_written{0};
+    std::atomic<u64> m_dropped{0};
+};
+
+}
@@ -0,0 +1,118 @@
+// JobSystem.cpp
+// Worker threads, job queue, and parallel-for with caller participation.
+#include "JobSystem.hpp"
+#include "CpuTopology.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace Sports {
+
+namespace {
+thread_local u32 t_workerIndex = JobSystem::NOT_A_WORKER;
+}
+
+JobSystem::JobSystem(u32 workerCount) {
+    if (workerCount == 0) {
+        u32 hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    m_workers.reserve(workerCount);
+    for (u32 i = 0; i < workerCount; i++) {
+        m_workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+}
+
+void JobSystem::parallelFor(u32 count, const std::function<void(u32)>& body) {
+    if (count == 0) return;
+
+    // Shared so late-starting helpers never touch a dead stack frame
+    struct Batch {
+        std::atomic<u32> next{0};
+        std::atomic<u32> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto batch = std::make_shared<Batch>();
+    const auto* fn = &body;
+
+    auto drain = [batch, fn, count] {
+        u32 index;
+        while ((index = batch->next.fetch_add(1)) < count) {
+            (*fn)(index);
+            if (batch->done.fetch_add(1) + 1 == count) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    u32 helpers = std::min(count - 1, getWorkerCount());
+    for (u32 i = 0; i < helpers; i++) {
+        submit(drain);
+    }
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&] { return batch->done.load() == count; });
+}
+
+u32 JobSystem::getQueueDepth() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<u32>(m_queue.size());
+}
+
+u32 JobSystem::pinWorkers(const std::vector<std::vector<u32>>& cpuSets) {
+    if (cpuSets.empty()) return 0;
+    u32 pinned = 0;
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        if (ThreadAffinity::pinThread(m_workers[i], cpuSets[i % cpuSets.size()])) pinned++;
+    }
+    return pinned;
+}
+
+u32 JobSystem::currentWorkerIndex() {
+    return t_workerIndex;
+}
+
+void JobSystem::workerLoop(u32 index) {
+    t_workerIndex = index;
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping && m_queue.empty()) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        job();
+    }
+}
+
+}
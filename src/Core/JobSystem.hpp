@@ -0,0 +1,48 @@
+// JobSystem.hpp
+// Fixed pool of worker threads with a shared queue and a blocking parallel-for.
+#pragma once
+
+#include "Types.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sports {
+
+class JobSystem {
+public:
+    explicit JobSystem(u32 workerCount = 0);  // 0 = one per hardware thread, minus the caller
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(std::function<void()> job);
+
+    // Runs body(0..count-1) across workers; the calling thread helps and returns when all are done
+    void parallelFor(u32 count, const std::function<void(u32)>& body);
+
+    u32 getWorkerCount() const { return static_cast<u32>(m_workers.size()); }
+    u32 getQueueDepth();
+
+    // Worker i runs on cpuSets[i % size]; returns how many workers were pinned
+    u32 pinWorkers(const std::vector<std::vector<u32>>& cpuSets);
+
+    // Index of the calling worker thread, or NOT_A_WORKER on any other thread
+    static constexpr u32 NOT_A_WORKER = ~0u;
+    static u32 currentWorkerIndex();
+
+private:
+    void workerLoop(u32 index);
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+};
+
+}
@@ -0,0 +1,39 @@
+// MappedFile.hpp
+// Read-only memory mapping of a whole file (mmap / file mapping).
+#pragma once
+
+#include "Types.hpp"
+#include <span>
+#include <string>
+
+namespace Sports {
+
+// Pages are read in on first touch, so opening a large file and reading its
+// header and tail costs a few page faults, not the file size
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);  // False for missing or empty files
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    const u8* data() const { return m_base; }
+    size_t size() const { return m_size; }
+    std::span<const u8> bytes() const { return {m_base, m_size}; }
+
+private:
+    const u8* m_base = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+}
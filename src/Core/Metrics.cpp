@@ -0,0 +1,279 @@
+// Metrics.cpp
+// Registry storage, per-thread slabs, and exposition formats.
+#include "Metrics.hpp"
+
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace Sports {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;  // Registration and slab creation only
+    u32 nextSlot = 0;
+    std::vector<std::unique_ptr<std::atomic<u64>[]>> slabs;  // One per thread that ever recorded
+    std::array<std::atomic<u64>, Metrics::MAX_SLOTS> gauges{};  // f64 bits
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local std::atomic<u64>* t_slab = nullptr;
+
+// Only the owning thread writes a slab slot, so load + store is enough (no RMW)
+void bump(std::atomic<u64>& slot, u64 amount) {
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+std::string formatLabels(const MetricLabels& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) return "";
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); i++) {
+        if (i > 0) out += ",";
+        out += labels[i].first + "=\"" + labels[i].second + "\"";
+    }
+    if (!extra.empty()) {
+        if (!labels.empty()) out += ",";
+        out += extra;
+    }
+    return out + "}";
+}
+
+template <typename Definition, typename Kind>
+Definition describe(const std::string& name, const std::string& help, MetricLabels labels, Kind kind) {
+    Definition definition;
+    definition.name = name;
+    definition.help = help;
+    definition.labels = std::move(labels);
+    definition.kind = kind;
+    return definition;
+}
+
+std::string formatNumber(f64 value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    return buffer;
+}
+
+}
+
+std::array<Metrics::Definition, Metrics::MAX_METRICS> Metrics::s_definitions;
+std::atomic<u32> Metrics::s_definitionCount{0};
+
+MetricId Metrics::define(Definition definition, u32 slotCount) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    u32 index = s_definitionCount.load(std::memory_order_relaxed);
+    if (index >= MAX_METRICS || reg.nextSlot + slotCount > MAX_SLOTS) {
+        return MAX_METRICS;  // Out of space: recording to this id is a no-op
+    }
+
+    definition.slot = reg.nextSlot;
+    reg.nextSlot += slotCount;
+    s_definitions[index] = std::move(definition);
+    s_definitionCount.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+MetricId Metrics::counter(const std::string& name, const std::string& help, MetricLabels labels) {
+    return define(describe<Definition>(name, help, std::move(labels), Kind::Counter), 1);
+}
+
+MetricId Metrics::gauge(const std::string& name, const std::string& help, MetricLabels labels) {
+    return define(describe<Definition>(name, help, std::move(labels), Kind::Gauge), 1);
+}
+
+MetricId Metrics::histogram(const std::string& name, const std::string& help,
+                            std::initializer_list<f64> bucketBounds, MetricLabels labels) {
+    Definition definition = describe<Definition>(name, help, std::move(labels), Kind::Histogram);
+    definition.bounds.assign(bucketBounds);
+    u32 slots = static_cast<u32>(definition.bounds.size()) + 2;  // Buckets, +Inf, sum
+    return define(std::move(definition), slots);
+}
+
+void Metrics::counterFrom(const std::string& name, const std::string& help,
+                          const std::atomic<u64>* source, MetricLabels labels) {
+    Definition definition = describe<Definition>(name, help, std::move(labels), Kind::External);
+    definition.external = source;
+    define(std::move(definition), 0);
+}
+
+std::atomic<u64>* Metrics::threadSlab() {
+    if (!t_slab) {
+        auto slab = std::make_unique<std::atomic<u64>[]>(MAX_SLOTS);
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        t_slab = slab.get();
+        reg.slabs.push_back(std::move(slab));
+    }
+    return t_slab;
+}
+
+void Metrics::add(MetricId id, u64 amount) {
+    if (id >= s_definitionCount.load(std::memory_order_acquire)) return;
+    bump(threadSlab()[s_definitions[id].slot], amount);
+}
+
+void Metrics::set(MetricId id, f64 value) {
+    if (id >= s_definitionCount.load(std::memory_order_acquire)) return;
+    registry().gauges[s_definitions[id].slot].store(std::bit_cast<u64>(value), std::memory_order_relaxed);
+}
+
+void Metrics::observe(MetricId id, f64 value) {
+    if (id >= s_definitionCount.load(std::memory_order_acquire)) return;
+    const Definition& definition = s_definitions[id];
+    std::atomic<u64>* slab = threadSlab() + definition.slot;
+
+    // Bounds are short (under ~16); a linear scan beats a binary search here
+    size_t bucket = 0;
+    while (bucket < definition.bounds.size() && value > definition.bounds[bucket]) {
+        bucket++;
+    }
+    bump(slab[bucket], 1);
+
+    std::atomic<u64>& sum = slab[definition.bounds.size() + 1];
+    f64 total = std::bit_cast<f64>(sum.load(std::memory_order_relaxed)) + value;
+    sum.store(std::bit_cast<u64>(total), std::memory_order_relaxed);
+}
+
+Metrics::Snapshot Metrics::collect() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    Snapshot snapshot;
+    snapshot.slots.assign(reg.nextSlot, 0);
+    u32 count = s_definitionCount.load(std::memory_order_acquire);
+
+    for (u32 i = 0; i < count; i++) {
+        const Definition& definition = s_definitions[i];
+        if (definition.kind == Kind::Gauge || definition.kind == Kind::External) continue;
+
+        u32 slots = definition.kind == Kind::Histogram ? static_cast<u32>(definition.bounds.size()) + 2 : 1;
+        bool isSum = false;
+        for (u32 s = 0; s < slots; s++) {
+            isSum = definition.kind == Kind::Histogram && s == slots - 1;
+            f64 sum = 0.0;
+            u64 total = 0;
+            for (const auto& slab : reg.slabs) {
+                u64 raw = slab[definition.slot + s].load(std::memory_order_relaxed);
+                if (isSum) sum += std::bit_cast<f64>(raw);
+                else total += raw;
+            }
+            snapshot.slots[definition.slot + s] = isSum ? std::bit_cast<u64>(sum) : total;
+        }
+    }
+    return snapshot;
+}
+
+f64 Metrics::gaugeValue(const Definition& definition) {
+    return std::bit_cast<f64>(registry().gauges[definition.slot].load(std::memory_order_relaxed));
+}
+
+std::string Metrics::renderPrometheus() {
+    Snapshot snapshot = collect();
+    u32 count = s_definitionCount.load(std::memory_order_acquire);
+
+    std::string out;
+    std::vector<bool> written(count, false);
+    for (u32 i = 0; i < count; i++) {
+        if (written[i]) continue;
+        const Definition& first = s_definitions[i];
+
+        const char* type = first.kind == Kind::Gauge ? "gauge" :
+                           first.kind == Kind::Histogram ? "histogram" : "counter";
+        out += "# HELP " + first.name + " " + first.help + "\n";
+        out += "# TYPE " + first.name + " " + type + "\n";
+
+        // Every label set of this name goes under one header
+        for (u32 j = i; j < count; j++) {
+            const Definition& d = s_definitions[j];
+            if (written[j] || d.name != first.name) continue;
+            written[j] = true;
+
+            switch (d.kind) {
+                case Kind::Counter:
+                    out += d.name + formatLabels(d.labels) + " " + std::to_string(snapshot.slots[d.slot]) + "\n";
+                    break;
+                case Kind::External:
+                    out += d.name + formatLabels(d.labels) + " " +
+                           std::to_string(d.external->load(std::memory_order_relaxed)) + "\n";
+                    break;
+                case Kind::Gauge:
+                    out += d.name + formatLabels(d.labels) + " " + formatNumber(gaugeValue(d)) + "\n";
+                    break;
+                case Kind::Histogram: {
+                    u64 cumulative = 0;
+                    for (size_t b = 0; b <= d.bounds.size(); b++) {
+                        cumulative += snapshot.slots[d.slot + b];
+                        std::string le = b < d.bounds.size() ? formatNumber(d.bounds[b]) : "+Inf";
+                        out += d.name + "_bucket" + formatLabels(d.labels, "le=\"" + le + "\"") + " " +
+                               std::to_string(cumulative) + "\n";
+                    }
+                    f64 sum = std::bit_cast<f64>(snapshot.slots[d.slot + d.bounds.size() + 1]);
+                    out += d.name + "_sum" + formatLabels(d.labels) + " " + formatNumber(sum) + "\n";
+                    out += d.name + "_count" + formatLabels(d.labels) + " " + std::to_string(cumulative) + "\n";
+                    break;
+                }
+            }
+        }
+    }
+    return out;
+}
+
+std::string Metrics::renderJson() {
+    Snapshot snapshot = collect();
+    u32 count = s_definitionCount.load(std::memory_order_acquire);
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::string out = "{\"ts\":" + std::to_string(ms) + ",\"metrics\":[";
+    for (u32 i = 0; i < count; i++) {
+        const Definition& d = s_definitions[i];
+        if (i > 0) out += ",";
+        out += "{\"name\":\"" + d.name + "\"";
+        if (!d.labels.empty()) {
+            out += ",\"labels\":{";
+            for (size_t l = 0; l < d.labels.size(); l++) {
+                if (l > 0) out += ",";
+                out += "\"" + d.labels[l].first + "\":\"" + d.labels[l].second + "\"";
+            }
+            out += "}";
+        }
+
+        switch (d.kind) {
+            case Kind::Counter:
+                out += ",\"value\":" + std::to_string(snapshot.slots[d.slot]);
+                break;
+            case Kind::External:
+                out += ",\"value\":" + std::to_string(d.external->load(std::memory_order_relaxed));
+                break;
+            case Kind::Gauge:
+                out += ",\"value\":" + formatNumber(gaugeValue(d));
+                break;
+            case Kind::Histogram: {
+                u64 total = 0;
+                out += ",\"buckets\":[";
+                for (size_t b = 0; b <= d.bounds.size(); b++) {
+                    if (b > 0) out += ",";
+                    out += std::to_string(snapshot.slots[d.slot + b]);
+                    total += snapshot.slots[d.slot + b];
+                }
+                f64 sum = std::bit_cast<f64>(snapshot.slots[d.slot + d.bounds.size() + 1]);
+                out += "],\"count\":" + std::to_string(total) + ",\"sum\":" + formatNumber(sum);
+                break;
+            }
+        }
+        out += "}";
+    }
+    return out + "]}";
+}
+
+}
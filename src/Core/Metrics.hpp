@@ -0,0 +1,74 @@
+// Metrics.hpp
+// Lock-free per-thread counters, gauges, and histograms with Prometheus and JSON rendering.
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <atomic>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Sports {
+
+using MetricId = u32;
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Process-wide registry. Register at startup, then record from any thread:
+// each thread writes only its own slab, so recording is a plain relaxed store.
+class Metrics {
+public:
+    static constexpr u32 MAX_SLOTS = 1024;  // Per-thread slab size (a histogram takes buckets + 2)
+    static constexpr u32 MAX_METRICS = 256;
+
+    static MetricId counter(const std::string& name, const std::string& help, MetricLabels labels = {});
+    static MetricId gauge(const std::string& name, const std::string& help, MetricLabels labels = {});
+    static MetricId histogram(const std::string& name, const std::string& help,
+                              std::initializer_list<f64> bucketBounds, MetricLabels labels = {});
+
+    // Counter whose value lives elsewhere (read on scrape)
+    static void counterFrom(const std::string& name, const std::string& help,
+                            const std::atomic<u64>* source, MetricLabels labels = {});
+
+    static void add(MetricId id, u64 amount = 1);
+    static void set(MetricId id, f64 value);      // Gauges are global: last write wins
+    static void observe(MetricId id, f64 value);
+
+    static std::string renderPrometheus();
+    static std::string renderJson();  // One line, for periodic log output
+
+private:
+    enum class Kind : u8 { Counter, Gauge, Histogram, External };
+
+    struct Definition {
+        std::string name;
+        std::string help;
+        MetricLabels labels;
+        Kind kind = Kind::Counter;
+        u32 slot = 0;                // First slot in every thread slab
+        std::vector<f64> bounds;     // Histogram upper bounds (+Inf implied)
+        const std::atomic<u64>* external = nullptr;
+    };
+
+    struct Snapshot {
+        std::vector<u64> slots;      // Summed over threads
+    };
+
+    static MetricId define(Definition definition, u32 slotCount);
+    static std::atomic<u64>* threadSlab();
+    static Snapshot collect();
+    static f64 gaugeValue(const Definition& definition);
+
+    // Fixed storage so recording threads never race with a growing container
+    static std::array<Definition, MAX_METRICS> s_definitions;
+    static std::atomic<u32> s_definitionCount;
+};
+
+// Allocations made through global operator new (counted by AllocationCounter.cpp)
+struct AllocationStats {
+    static inline std::atomic<u64> count{0};
+    static inline std::atomic<u64> bytes{0};
+};
+
+}
@@ -0,0 +1,201 @@
+// MetricsServer.cpp
+// Blocking accept loop on a background thread; one short request per connection.
+#include "MetricsServer.hpp"
+#include "Metrics.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using SocketLength = int;
+#define pollSockets WSAPoll
+#define closeSocket closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketLength = socklen_t;
+#define pollSockets poll
+#define closeSocket close
+#endif
+
+namespace Sports {
+
+namespace {
+
+constexpr int POLL_INTERVAL_MS = 200;  // How quickly stop() is noticed
+constexpr int CLIENT_TIMEOUT_MS = 2000;  // A client that sends or reads nothing for this long is dropped
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Socket>
+bool isInvalid(Socket socket) {
+#ifdef _WIN32
+    return socket == INVALID_SOCKET;
+#else
+    return socket < 0;
+#endif
+}
+
+// Polls in short slices so neither a silent client nor stop() can hold the serve thread
+bool waitReady(std::intptr_t socket, short events, Clock::time_point deadline, const std::atomic<bool>& stopping) {
+    while (!stopping) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        if (remaining <= 0) {
+            return false;
+        }
+        pollfd entry{};
+        entry.fd = static_cast<decltype(entry.fd)>(socket);
+        entry.events = events;
+        int ready = pollSockets(&entry, 1, static_cast<int>(std::min<long long>(remaining, POLL_INTERVAL_MS)));
+        if (ready < 0) {
+            return false;
+        }
+        if (ready > 0) {
+            return true;  // Readable, writable, or closed: the next call reports which
+        }
+    }
+    return false;
+}
+
+void sendAll(std::intptr_t socket, const std::string& data, Clock::time_point deadline,
+             const std::atomic<bool>& stopping) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        if (!waitReady(socket, POLLOUT, deadline, stopping)) return;
+        auto n = ::send(static_cast<int>(socket), data.data() + sent, static_cast<int>(data.size() - sent), 0);
+        if (n <= 0) return;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+u16 MetricsServer::configuredPort() {
+    const char* value = std::getenv("SPORTS_METRICS_PORT");
+    if (!value || *value == '\0') {
+        return DEFAULT_PORT;
+    }
+    unsigned long port = std::strtoul(value, nullptr, 10);
+    return port <= 65535 ? static_cast<u16>(port) : 0;
+}
+
+bool MetricsServer::start(u16 port) {
+    if (isRunning()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        return false;
+    }
+#endif
+
+    auto listenSocket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (isInvalid(listenSocket)) {
+        LOG_ERROR("Metrics endpoint: socket() failed");
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Never exposed beyond this machine
+    address.sin_port = htons(port);
+
+    if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket, 8) != 0) {
+        LOG_ERROR("Metrics endpoint: cannot listen on 127.0.0.1:{}", port);
+        closeSocket(listenSocket);
+        return false;
+    }
+
+    // Port 0 picks a free one; report what we got
+    SocketLength length = sizeof(address);
+    getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length);
+    m_port = ntohs(address.sin_port);
+
+    m_listenSocket = static_cast<std::intptr_t>(listenSocket);
+    m_stopping = false;
+    m_thread = std::thread([this] { serveLoop(); });
+
+    LOG_INFO("Metrics endpoint at http://127.0.0.1:{}/metrics", m_port);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    m_stopping = true;
+    m_thread.join();
+    closeSocket(static_cast<int>(m_listenSocket));
+    m_listenSocket = -1;
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void MetricsServer::serveLoop() {
+    while (!m_stopping) {
+        pollfd entry{};
+        entry.fd = static_cast<decltype(entry.fd)>(m_listenSocket);
+        entry.events = POLLIN;
+        if (pollSockets(&entry, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+
+        auto client = ::accept(static_cast<int>(m_listenSocket), nullptr, nullptr);
+        if (isInvalid(client)) {
+            continue;
+        }
+        handleClient(static_cast<std::intptr_t>(client));
+        closeSocket(client);
+    }
+}
+
+void MetricsServer::handleClient(std::intptr_t client) {
+    // Scrapers send one small GET; the request line is all we look at
+    auto deadline = Clock::now() + std::chrono::milliseconds(CLIENT_TIMEOUT_MS);
+    if (!waitReady(client, POLLIN, deadline, m_stopping)) {
+        return;
+    }
+    char request[1024];
+    auto received = ::recv(static_cast<int>(client), request, sizeof(request) - 1, 0);
+    if (received <= 0) {
+        return;
+    }
+    request[received] = '\0';
+
+    std::string response;
+    if (std::strncmp(request, "GET /metrics", 12) == 0) {
+        std::string body = Metrics::renderPrometheus();
+        response = "HTTP/1.1 200 OK\r\n"
+                   "Content-Type: text/plain; version=0.0.4\r\n"
+                   "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                   "Connection: close\r\n\r\n" + body;
+    } else {
+        response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+    sendAll(client, response, deadline, m_stopping);
+}
+
+}
@@ -0,0 +1,40 @@
+// MetricsServer.hpp
+// Minimal localhost HTTP endpoint serving Metrics in Prometheus text format at /metrics.
+#pragma once
+
+#include "Types.hpp"
+#include <atomic>
+#include <thread>
+
+namespace Sports {
+
+class MetricsServer {
+public:
+    static constexpr u16 DEFAULT_PORT = 9108;
+
+    MetricsServer() = default;
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // SPORTS_METRICS_PORT=<n> if set, else DEFAULT_PORT; 0 means the endpoint stays off
+    static u16 configuredPort();
+
+    bool start(u16 port = DEFAULT_PORT);  // Binds 127.0.0.1 only
+    void stop();
+
+    bool isRunning() const { return m_thread.joinable(); }
+    u16 getPort() const { return m_port; }
+
+private:
+    void serveLoop();
+    void handleClient(std::intptr_t client);
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    std::intptr_t m_listenSocket = -1;
+    u16 m_port = 0;
+};
+
+}
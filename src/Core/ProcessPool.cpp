@@ -0,0 +1,116 @@
+// ProcessPool.cpp
+// posix_spawn / CreateProcess with a wait for whichever child exits first.
+#include "ProcessPool.hpp"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace Sports {
+
+namespace {
+
+#ifdef _WIN32
+using Process = HANDLE;
+
+bool spawn(const std::vector<std::string>& args, Process& process) {
+    std::string commandLine;
+    for (const std::string& arg : args) {
+        commandLine += (commandLine.empty() ? "\"" : " \"") + arg + "\"";
+    }
+    STARTUPINFOA startup{};
+    startup.cb = sizeof(startup);
+    PROCESS_INFORMATION info{};
+    if (!CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &info)) {
+        return false;
+    }
+    CloseHandle(info.hThread);
+    process = info.hProcess;
+    return true;
+}
+
+// Blocks until one of `running` exits; returns its position
+size_t waitAny(const std::vector<Process>& running, bool& succeeded) {
+    DWORD result = WaitForMultipleObjects(static_cast<DWORD>(running.size()), running.data(), FALSE, INFINITE);
+    size_t index = result - WAIT_OBJECT_0;
+    DWORD exitCode = 1;
+    GetExitCodeProcess(running[index], &exitCode);
+    CloseHandle(running[index]);
+    succeeded = exitCode == 0;
+    return index;
+}
+#else
+using Process = pid_t;
+
+bool spawn(const std::vector<std::string>& args, Process& process) {
+    std::vector<char*> argv;
+    for (const std::string& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    return posix_spawn(&process, argv[0], nullptr, nullptr, argv.data(), environ) == 0;
+}
+
+size_t waitAny(const std::vector<Process>& running, bool& succeeded) {
+    for (;;) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        auto it = std::find(running.begin(), running.end(), pid);
+        if (it != running.end()) {
+            succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            return static_cast<size_t>(it - running.begin());
+        }
+    }
+}
+#endif
+
+}
+
+bool ProcessPool::runAll(std::span<const std::vector<std::string>> commands, u32 maxRunning, size_t* failed) {
+    size_t limit = std::clamp<u32>(maxRunning, 1, MAX_RUNNING);
+    std::vector<Process> running;
+    std::vector<size_t> runningCommand;
+    size_t next = 0;
+    bool ok = true;
+    auto fail = [&](size_t command) {
+        if (ok && failed) {
+            *failed = command;
+        }
+        ok = false;
+    };
+
+    // Commands start in order and may finish in any order
+    while (!running.empty() || (ok && next < commands.size())) {
+        while (ok && running.size() < limit && next < commands.size()) {
+            Process process;
+            if (commands[next].empty() || !spawn(commands[next], process)) {
+                fail(next);
+                break;
+            }
+            running.push_back(process);
+            runningCommand.push_back(next++);
+        }
+        if (running.empty()) {
+            break;
+        }
+
+        bool succeeded = false;
+        size_t done = waitAny(running, succeeded);
+        size_t command = runningCommand[done];
+        running.erase(running.begin() + static_cast<std::ptrdiff_t>(done));
+        runningCommand.erase(runningCommand.begin() + static_cast<std::ptrdiff_t>(done));
+        if (!succeeded) {
+            fail(command);
+        }
+    }
+    return ok;
+}
+
+}
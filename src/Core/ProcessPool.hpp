@@ -0,0 +1,24 @@
+// ProcessPool.hpp
+// Runs a batch of command lines as child processes, a bounded number at a time.
+#pragma once
+
+#include "Types.hpp"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+// Static utility class for the offline tools that fan work out to engine processes
+class ProcessPool {
+public:
+    static constexpr u32 MAX_RUNNING = 64;  // WaitForMultipleObjects limit
+
+    // Starts the commands in order (argv[0] is the executable path) and waits for all of
+    // them. After the first failure nothing new starts. True if every one exited with 0;
+    // otherwise `failed` gets the index of the first command that didn't start or exit cleanly.
+    static bool runAll(std::span<const std::vector<std::string>> commands, u32 maxRunning,
+                       size_t* failed = nullptr);
+};
+
+}
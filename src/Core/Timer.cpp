@@ -1,63 +1,136 @@
 // Timer.cpp
-// Chrono-based timing implementation.
+// Cycle-clock calibration and timer implementation.
 #include "Timer.hpp"
 
+#if defined(SPORTS_HAS_TSC) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
 namespace Sports {
 
+namespace {
+
+constexpr f64 CALIBRATION_SECONDS = 0.01;
+
+#ifdef SPORTS_HAS_TSC
+// Registers of an extended CPUID leaf, zeroed when the leaf is not supported
+void cpuid(u32 leaf, u32 regs[4]) {
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, static_cast<int>(leaf & 0x80000000u));
+    if (static_cast<u32>(info[0]) < leaf) return;
+    __cpuid(info, static_cast<int>(leaf));
+    for (int i = 0; i < 4; i++) regs[i] = static_cast<u32>(info[i]);
+#else
+    unsigned int a, b, c, d;
+    if (__get_cpuid(leaf, &a, &b, &c, &d)) {
+        regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+    }
+#endif
+}
+#endif
+
+}
+
+CycleClock::Calibration CycleClock::calibrate() {
+    Calibration result;
+#ifdef SPORTS_HAS_TSC
+    u32 regs[4];
+    cpuid(0x80000007u, regs);
+    bool invariant = (regs[3] & (1u << 8)) != 0;   // Constant rate across P-states, ticks in C-states
+    cpuid(0x80000001u, regs);
+    bool rdtscp = (regs[3] & (1u << 27)) != 0;
+    if (!invariant) {
+        return result;
+    }
+
+    // Spin rather than sleep: a descheduled thread makes no difference, an early wakeup would
+    u64 steadyStart = steadyTicks();
+    u64 tscStart = __rdtsc();
+    u64 steadyEnd = steadyStart;
+    while (steadyEnd - steadyStart < static_cast<u64>(CALIBRATION_SECONDS * 1e9)) {
+        steadyEnd = steadyTicks();
+    }
+    u64 tscEnd = __rdtsc();
+
+    f64 ticksPerSecond = static_cast<f64>(tscEnd - tscStart) * 1e9 / static_cast<f64>(steadyEnd - steadyStart);
+    if (ticksPerSecond < 1e8) {
+        return result;  // Implausible (virtualized or trapped TSC): keep steady_clock
+    }
+    result.useTsc = true;
+    result.hasRdtscp = rdtscp;
+    result.ticksPerSecond = ticksPerSecond;
+    result.nanosPerTick = 1e9 / ticksPerSecond;
+#endif
+    return result;
+}
+
 Timer::Timer() {
     reset();
 }
 
 void Timer::reset() {
-    m_startTime = Clock::now();
+    m_startTicks = CycleClock::now();
 }
 
 f64 Timer::elapsed() const {
-    Duration elapsed = Clock::now() - m_startTime;
-    return elapsed.count();
+    return CycleClock::toSeconds(elapsedTicks());
 }
 
 f64 Timer::elapsedMillis() const {
     return elapsed() * 1000.0;
 }
 
+u64 Timer::elapsedTicks() const {
+    return CycleClock::now() - m_startTicks;
+}
+
 f64 Timer::lap() {
-    f64 time = elapsed();
-    reset();
+    u64 now = CycleClock::now();
+    f64 time = CycleClock::toSeconds(now - m_startTicks);
+    m_startTicks = now;
     return time;
 }
 
 Stopwatch::Stopwatch()
-    : m_accumulated(0.0)
+    : m_startTicks(0)
+    , m_accumulatedTicks(0)
     , m_running(false) {
 }
 
 void Stopwatch::start() {
     if (!m_running) {
-        m_startTime = Timer::Clock::now();
+        m_startTicks = CycleClock::now();
         m_running = true;
     }
 }
 
 void Stopwatch::stop() {
     if (m_running) {
-        Timer::Duration elapsed = Timer::Clock::now() - m_startTime;
-        m_accumulated += elapsed.count();
+        m_accumulatedTicks += CycleClock::nowSerialized() - m_startTicks;
         m_running = false;
     }
 }
 
 void Stopwatch::reset() {
-    m_accumulated = 0.0;
+    m_accumulatedTicks = 0;
     m_running = false;
 }
 
 f64 Stopwatch::elapsed() const {
+    return CycleClock::toSeconds(elapsedTicks());
+}
+
+f64 Stopwatch::elapsedNanos() const {
+    return CycleClock::toNanos(elapsedTicks());
+}
+
+u64 Stopwatch::elapsedTicks() const {
     if (m_running) {
-        Timer::Duration currentSegment = Timer::Clock::now() - m_startTime;
-        return m_accumulated + currentSegment.count();
+        return m_accumulatedTicks + (CycleClock::now() - m_startTicks);
     }
-    return m_accumulated;
+    return m_accumulatedTicks;
 }
 
 }
@@ -5,24 +5,80 @@
 #include "Types.hpp"
 #include <chrono>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SPORTS_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SPORTS_HAS_TSC 1
+#endif
+
 namespace Sports {
 
+// Tick source for every timer: the invariant TSC when the CPU has one (a few ns per read),
+// steady_clock otherwise. Ticks are only meaningful as differences within one process.
+class CycleClock {
+public:
+    struct Calibration {
+        bool useTsc = false;
+        bool hasRdtscp = false;
+        f64 ticksPerSecond = 1e9;
+        f64 nanosPerTick = 1.0;
+    };
+
+    // Measured once, on first use (~10 ms spin against steady_clock)
+    static const Calibration& calibration() {
+        static const Calibration instance = calibrate();
+        return instance;
+    }
+
+    static u64 now() {
+#ifdef SPORTS_HAS_TSC
+        if (calibration().useTsc) {
+            return __rdtsc();
+        }
+#endif
+        return steadyTicks();
+    }
+
+    // Waits for earlier instructions to retire first; for the end of a measured region
+    static u64 nowSerialized() {
+#ifdef SPORTS_HAS_TSC
+        if (calibration().hasRdtscp) {
+            unsigned int aux;
+            return __rdtscp(&aux);
+        }
+#endif
+        return now();
+    }
+
+    static f64 toNanos(u64 ticks) { return static_cast<f64>(ticks) * calibration().nanosPerTick; }
+    static f64 toSeconds(u64 ticks) { return toNanos(ticks) * 1e-9; }
+    static u64 fromSeconds(f64 seconds) { return static_cast<u64>(seconds * calibration().ticksPerSecond); }
+    static bool isTsc() { return calibration().useTsc; }
+
+private:
+    static Calibration calibrate();
+
+    static u64 steadyTicks() {
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
 // Simple timer that measures elapsed time since construction or reset
 class Timer {
 public:
-    using Clock = std::chrono::steady_clock;
-    using TimePoint = Clock::time_point;
-    using Duration = std::chrono::duration<f64>;
-
     Timer();
 
     void reset();
     f64 elapsed() const;       // Seconds since reset
     f64 elapsedMillis() const; // Milliseconds since reset
+    u64 elapsedTicks() const;  // Raw CycleClock ticks since reset
     f64 lap();                 // Returns elapsed and resets (for frame timing)
 
 private:
-    TimePoint m_startTime;
+    u64 m_startTicks;
 };
 
 // Pausable timer for accumulating time across multiple intervals
@@ -35,11 +91,13 @@ public:
     void reset();
 
     f64 elapsed() const;
+    f64 elapsedNanos() const;
+    u64 elapsedTicks() const;
     bool isRunning() const { return m_running; }
 
 private:
-    Timer::TimePoint m_startTime;
-    f64 m_accumulated;
+    u64 m_startTicks;
+    u64 m_accumulatedTicks;
     bool m_running;
 };
 
@@ -0,0 +1,82 @@
+// VirtualFileSystem.cpp
+// Pack mounting and pack/loose asset resolution.
+#include "VirtualFileSystem.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace Sports {
+
+bool VirtualFileSystem::mount(const std::string& packPath, const std::string& looseRoot) {
+    s_looseRoot = looseRoot;
+
+    if (s_pack.open(packPath)) {
+        LOG_INFO("Mounted asset pack {} ({} assets, {} KB)", packPath,
+                 s_pack.getEntryCount(), s_pack.getMappedSize() / 1024);
+        return true;
+    }
+
+    LOG_WARN("No asset pack at {}, using loose files under {}/", packPath, looseRoot);
+    return false;
+}
+
+void VirtualFileSystem::unmount() {
+    s_pack.close();
+}
+
+std::string VirtualFileSystem::normalize(std::string_view path) {
+    std::string result(path);
+    std::replace(result.begin(), result.end(), '\\', '/');
+    if (result.rfind("./", 0) == 0) {
+        result.erase(0, 2);
+    }
+
+    // Callers may still spell out the loose root ("assets/shaders/basic.vert")
+    std::string rootPrefix = s_looseRoot + "/";
+    if (result.rfind(rootPrefix, 0) == 0) {
+        result.erase(0, rootPrefix.size());
+    }
+    return result;
+}
+
+AssetData VirtualFileSystem::read(std::string_view path) {
+    std::string key = normalize(path);
+
+    // Development builds: an edited loose file wins over the stale packed copy
+    if (s_looseFirst) {
+        AssetData loose = readLoose(key);
+        if (loose.isValid()) {
+            return loose;
+        }
+    }
+
+    std::span<const u8> packed = s_pack.find(key);
+    if (packed.data() != nullptr) {
+        return AssetData(packed);
+    }
+
+    // Release fallback: anything the pack lacks
+    return s_looseFirst ? AssetData() : readLoose(key);
+}
+
+AssetData VirtualFileSystem::readLoose(const std::string& key) {
+    std::ifstream file(std::filesystem::path(s_looseRoot) / key, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    std::vector<u8> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return AssetData(std::move(bytes));
+}
+
+bool VirtualFileSystem::exists(std::string_view path) {
+    std::string key = normalize(path);
+    return s_pack.findEntry(key) != nullptr ||
+           std::filesystem::exists(std::filesystem::path(s_looseRoot) / key);
+}
+
+}
@@ -0,0 +1,72 @@
+// VirtualFileSystem.hpp
+// Asset lookup: mounted pack (zero-copy) and loose files under a root directory. Release builds
+// prefer the pack; loose-asset builds prefer the loose files so edits show up without repacking.
+#pragma once
+
+#include "AssetPack.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Sports {
+
+// Bytes of one asset. Pack assets point into the mapping; loose files own a buffer.
+class AssetData {
+public:
+    AssetData() = default;
+    AssetData(std::span<const u8> view) : m_view(view), m_valid(true), m_mapped(true) {}
+    AssetData(std::vector<u8> owned) : m_owned(std::move(owned)), m_view(m_owned), m_valid(true) {}
+
+    AssetData(AssetData&& other) noexcept = default;  // vector move keeps its buffer
+    AssetData& operator=(AssetData&& other) noexcept = default;
+    AssetData(const AssetData&) = delete;
+    AssetData& operator=(const AssetData&) = delete;
+
+    // An empty file is still a file: validity doesn't depend on the size
+    bool isValid() const { return m_valid; }
+    bool isMapped() const { return m_mapped; }
+    std::span<const u8> bytes() const { return m_view; }
+    std::string_view text() const {
+        return {reinterpret_cast<const char*>(m_view.data()), m_view.size()};
+    }
+
+private:
+    std::vector<u8> m_owned;
+    std::span<const u8> m_view;
+    bool m_valid = false;
+    bool m_mapped = false;
+};
+
+// Process-wide asset source, mounted once at startup
+class VirtualFileSystem {
+public:
+    // Maps the pack if it exists; loose files under looseRoot serve anything it lacks
+    static bool mount(const std::string& packPath, const std::string& looseRoot);
+    static void unmount();
+
+    // Paths are relative to the asset root with forward slashes ("shaders/basic.vert")
+    static AssetData read(std::string_view path);
+    static bool exists(std::string_view path);
+
+    static bool hasPack() { return s_pack.isOpen(); }
+    static const AssetPack& getPack() { return s_pack; }
+
+    // Loose files shadow packed ones (on in SPORTS_ENGINE_LOOSE_ASSETS builds)
+    static void setLooseFirst(bool looseFirst) { s_looseFirst = looseFirst; }
+    static bool isLooseFirst() { return s_looseFirst; }
+
+private:
+    static std::string normalize(std::string_view path);
+    static AssetData readLoose(const std::string& key);
+
+    static inline AssetPack s_pack;
+    static inline std::string s_looseRoot = "assets";
+#ifdef SPORTS_LOOSE_ASSETS
+    static inline bool s_looseFirst = true;
+#else
+    static inline bool s_looseFirst = false;
+#endif
+};
+
+}
@@ -1,12 +1,22 @@
 // AIPlayer.cpp
 // AI player decision-making, movement, and team management.
 #include "AIPlayer.hpp"
+#include "Math/FastMath.hpp"
 #include <cmath>
 #include <algorithm>
-#include <cstdlib>
 
 namespace Sports {
 
+namespace {
+
+// LCG step mapped to [-0.5, 0.5); plenty for shot scatter and cheap to carry per world
+f32 nextNoise(u32& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<f32>(state >> 8) / 16777216.0f - 0.5f;
+}
+
+}
+
 AIPlayer::AIPlayer() = default;
 
 void AIPlayer::setHomePosition(const Vec3& pos) {
@@ -18,18 +28,33 @@ void AIPlayer::setHomePosition(const Vec3& pos) {
 }
 
 void AIPlayer::update(f32 deltaTime, Ball& ball, const Vec3& playerPos,
-                      f32 fieldLength, f32 fieldWidth, f32 goalWidth) {
+                      f32 fieldLength, f32 fieldWidth, f32 goalWidth, u32& rngState) {
+    m_kickedThisTick = false;
     if (m_kickCooldown > 0) {
         m_kickCooldown -= deltaTime;
     }
+    if (m_runTimer > 0) {
+        m_runTimer -= deltaTime;
+    }
+    if (m_plannedKickTimer > 0) {
+        m_plannedKickTimer -= deltaTime;
+    }
 
-    decideAction(ball.getPosition(), ball.getVelocity(), fieldLength);
+    decideAction(m_knownBallPos, m_knownBallVel, fieldLength);
     moveToward(m_targetPos, m_currentTargetSpeed, deltaTime);
 
+    // Lost sight of the ball: turn to where it should be
+    if (!m_ballVisible && m_timeSinceBallSeen > SCAN_DELAY) {
+        Vec3 toBall = m_knownBallPos - m_position;
+        if (glm::length(Vec3(toBall.x, 0.0f, toBall.z)) > 0.1f) {
+            m_targetRotation = FastMath::atan2(-toBall.x, -toBall.z);
+        }
+    }
+
     // Only attempt kick when ball is grounded (isLow prevents mid-air kicks)
     f32 dist = distanceToBall(ball.getPosition());
     if (dist < KICK_RANGE && m_kickCooldown <= 0 && ball.isLow()) {
-        tryKick(ball, fieldLength);
+        tryKick(ball, fieldLength, rngState);
     }
 
     // Animate legs based on movement speed
@@ -46,10 +71,24 @@ void AIPlayer::update(f32 deltaTime, Ball& ball, const Vec3& playerPos,
     f32 rotDiff = m_targetRotation - m_rotation;
     while (rotDiff > 3.14159f) rotDiff -= 6.28318f;
     while (rotDiff < -3.14159f) rotDiff += 6.28318f;
-    f32 rotT = 1.0f - std::exp(-ROTATION_SPEED * deltaTime);
+    f32 rotT = 1.0f - FastMath::exp(-ROTATION_SPEED * deltaTime);
     m_rotation += rotDiff * rotT;
 }
 
+void AIPlayer::observeBall(const Vec3& ballPos, const Vec3& ballVel, bool visible, f32 deltaTime) {
+    m_ballVisible = visible;
+    if (visible) {
+        m_knownBallPos = ballPos;
+        m_knownBallVel = ballVel;
+        m_timeSinceBallSeen = 0.0f;
+    } else {
+        // Dead reckoning with a rough rolling slowdown
+        m_knownBallPos += m_knownBallVel * deltaTime;
+        m_knownBallVel *= std::max(0.0f, 1.0f - deltaTime);
+        m_timeSinceBallSeen += deltaTime;
+    }
+}
+
 f32 AIPlayer::distanceToBall(const Vec3& ballPos) const {
     Vec3 toBall = ballPos - m_position;
     toBall.y = 0;  // Ignore vertical distance for ground-based checks
@@ -61,10 +100,10 @@ void AIPlayer::decideAction(const Vec3& ballPos, const Vec3& ballVel, f32 fieldL
     f32 ballX = ballPos.x;
 
     bool shouldChase = false;
+    f32 goalX = (m_team == 0) ? -fieldLength / 2.0f : fieldLength / 2.0f;
 
     if (m_isGoalkeeper) {
         // Goalkeeper only engages when ball is near their goal
-        f32 goalX = (m_team == 0) ? -fieldLength / 2.0f : fieldLength / 2.0f;
         if (std::abs(ballX - goalX) < 20.0f && dist < 15.0f) {
             shouldChase = true;
         }
@@ -78,13 +117,41 @@ void AIPlayer::decideAction(const Vec3& ballPos, const Vec3& ballVel, f32 fieldL
         }
     }
 
-    if (shouldChase && dist < 35.0f) {
+    if (m_runTimer > 0.0f) {
+        // Set-piece run takes priority over normal positioning
+        m_state = State::MakeRun;
+        m_targetPos = m_runTarget;
+        m_currentTargetSpeed = MAX_SPEED;
+    } else if (shouldChase && dist < 35.0f) {
         m_state = State::ChaseBall;
         chaseBall(ballPos, ballVel);
     } else {
         m_state = State::ReturnToPosition;
         returnToPosition(ballPos, fieldLength, 7.32f);
     }
+
+    // Pack inputs and outcome for the decision trace
+    DecisionRecord& rec = m_lastDecision;
+    rec.team = static_cast<u8>(m_team);
+    rec.state = static_cast<u8>(m_state);
+    rec.flags = (m_isGoalkeeper ? DecisionRecord::Goalkeeper : 0) |
+                (m_isDefender ? DecisionRecord::Defender : 0) |
+                (m_isClosestChaser ? DecisionRecord::ClosestChaser : 0) |
+                (shouldChase ? DecisionRecord::WantsChase : 0) |
+                (dist < 35.0f ? DecisionRecord::InChaseRange : 0) |
+                (m_ballVisible ? DecisionRecord::BallVisible : 0);
+    rec.positionX = DecisionRecord::quantize(m_position.x);
+    rec.positionZ = DecisionRecord::quantize(m_position.z);
+    rec.ballX = DecisionRecord::quantize(ballPos.x);
+    rec.ballZ = DecisionRecord::quantize(ballPos.z);
+    rec.ballY = DecisionRecord::quantize(ballPos.y);
+    rec.kickCooldownMs = static_cast<u16>(std::clamp(m_kickCooldown * 1000.0f, 0.0f, 65535.0f));
+    rec.ballVelX = DecisionRecord::quantize(ballVel.x);
+    rec.ballVelZ = DecisionRecord::quantize(ballVel.z);
+    rec.targetX = DecisionRecord::quantize(m_targetPos.x);
+    rec.targetZ = DecisionRecord::quantize(m_targetPos.z);
+    rec.ballDistance = DecisionRecord::quantizeDistance(dist);
+    rec.goalDistance = DecisionRecord::quantizeDistance(std::abs(ballX - goalX));
 }
 
 void AIPlayer::chaseBall(const Vec3& ballPos, const Vec3& ballVel) {
@@ -136,7 +203,7 @@ void AIPlayer::moveToward(const Vec3& target, f32 targetSpeed, f32 deltaTime) {
         }
 
         // Face movement direction
-        m_targetRotation = std::atan2(-moveDir.x, -moveDir.z);
+        m_targetRotation = FastMath::atan2(-moveDir.x, -moveDir.z);
     } else {
         // Arrived at target, decelerate
         f32 speed = glm::length(m_velocity);
@@ -150,7 +217,29 @@ void AIPlayer::moveToward(const Vec3& target, f32 targetSpeed, f32 deltaTime) {
     m_position += m_velocity * deltaTime;
 }
 
-void AIPlayer::tryKick(Ball& ball, f32 fieldLength) {
+void AIPlayer::commandRun(const Vec3& target, f32 duration) {
+    m_runTarget = target;
+    m_runTimer = duration;
+}
+
+void AIPlayer::setPlannedKick(const Vec3& direction, f32 power, f32 spinY) {
+    m_plannedKickDir = direction;
+    m_plannedKickPower = power;
+    m_plannedKickSpin = spinY;
+    m_plannedKickTimer = PLANNED_KICK_TIMEOUT;
+}
+
+void AIPlayer::tryKick(Ball& ball, f32 fieldLength, u32& rngState) {
+    m_kickedThisTick = true;
+
+    // A pending set-piece plan replaces the default shot at goal
+    if (m_plannedKickTimer > 0.0f) {
+        ball.kick(m_plannedKickDir, m_plannedKickPower, m_plannedKickSpin);
+        m_plannedKickTimer = 0.0f;
+        m_kickCooldown = KICK_COOLDOWN;
+        return;
+    }
+
     // Calculate direction toward opponent's goal
     Vec3 goalDir;
     if (m_team == 0) {
@@ -162,7 +251,7 @@ void AIPlayer::tryKick(Ball& ball, f32 fieldLength) {
     goalDir = glm::normalize(goalDir);
 
     // Add slight randomness to prevent predictable shots
-    goalDir.z += ((std::rand() % 100) - 50) / 100.0f * 0.3f;
+    goalDir.z += nextNoise(rngState) * 0.3f;
     goalDir = glm::normalize(goalDir);
 
     ball.state().velocity = goalDir * KICK_POWER;
@@ -170,16 +259,18 @@ void AIPlayer::tryKick(Ball& ball, f32 fieldLength) {
     m_kickCooldown = KICK_COOLDOWN;
 }
 
-void AIPlayer::handleBallCollision(Ball& ball) {
-    // Push ball away when overlapping (prevents walking through ball)
-    f32 dist = distanceToBall(ball.getPosition());
-    if (dist < 0.5f && dist > 0.01f) {
-        Vec3 toBall = ball.getPosition() - m_position;
-        toBall.y = 0;
-        Vec3 pushDir = glm::normalize(toBall);
-        ball.state().position.x = m_position.x + pushDir.x * 0.5f;
-        ball.state().position.z = m_position.z + pushDir.z * 0.5f;
+bool AIPlayer::handleBallCollision(Ball& ball, ContactEvent& event) {
+    // Full-body capsule so lofted balls can be headed, chested, or blocked
+    BallContact contact;
+    if (!BodyCollision::sphereVsCapsule(ball.getPosition(), Ball::RADIUS, getCapsule(), contact)) {
+        return false;
     }
+
+    event.team = m_team;
+    event.point = contact.point;
+    event.normal = contact.normal;
+    event.impactSpeed = BodyCollision::resolveBallContact(ball.state(), contact, m_velocity);
+    return true;
 }
 
 void AIPlayer::handlePlayerCollision(const Vec3& playerPos) {
@@ -264,11 +355,49 @@ void AIManager::update(f32 deltaTime, Ball& ball, const Vec3& playerPos,
     // Determine which player on each team should chase
     findClosestChasers(ball.getPosition());
 
-    for (auto& ai : m_players) {
-        ai.update(deltaTime, ball, playerPos, fieldLength, fieldWidth, goalWidth);
+    // One batched visibility pass per tick, shared by every player
+    m_perception.update(m_tick, m_players, playerPos, ball.getPosition());
+    for (size_t i = 0; i < m_players.size(); i++) {
+        bool visible = !m_perceptionEnabled || i >= PerceptionSystem::MAX_ENTITIES - 2 ||
+                       m_perception.canSeeBall(static_cast<u32>(i));
+        m_players[i].observeBall(ball.getPosition(), ball.getVelocity(), visible, deltaTime);
     }
 
-    handleCollisions(ball, playerPos);
+    for (size_t i = 0; i < m_players.size(); i++) {
+        m_players[i].update(deltaTime, ball, playerPos, fieldLength, fieldWidth, goalWidth, m_rngState);
+        if (m_players[i].hasKickedThisTick()) {
+            // Kicks are touches too (the rules judge offside from them)
+            ContactEvent event;
+            event.team = m_players[i].getTeam();
+            event.playerIndex = static_cast<i32>(i);
+            event.point = ball.getPosition();
+            event.impactSpeed = glm::length(ball.getVelocity());
+            ball.recordContact(event);
+        }
+        if (m_tracing) {
+            m_trace.record(m_tick, static_cast<u8>(i), m_players[i].getLastDecision());
+        }
+    }
+    m_tick++;
+
+    handleCollisions(ball, playerPos, fieldLength, fieldWidth);
+}
+
+i32 AIManager::findClosestOutfielder(i32 team, const Vec3& pos) const {
+    i32 closestIdx = -1;
+    f32 closestDist = 999.0f;
+
+    for (size_t i = 0; i < m_players.size(); i++) {
+        const AIPlayer& ai = m_players[i];
+        if (ai.getTeam() != team || ai.isGoalkeeper()) continue;
+
+        f32 dist = ai.distanceToBall(pos);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closestIdx = static_cast<i32>(i);
+        }
+    }
+    return closestIdx;
 }
 
 void AIManager::findClosestChasers(const Vec3& ballPos) {
@@ -303,17 +432,35 @@ void AIManager::findClosestChasers(const Vec3& ballPos) {
     }
 }
 
-void AIManager::handleCollisions(Ball& ball, const Vec3& playerPos) {
-    // AI-ball and AI-human collisions
+void AIManager::handleCollisions(Ball& ball, const Vec3& playerPos, f32 fieldLength, f32 fieldWidth) {
+    m_bodies.clear();
+    for (const auto& ai : m_players) {
+        m_bodies.push_back(ai.getCapsule());
+    }
+    m_broadphase.build(m_bodies, fieldLength, fieldWidth);
+
+    // AI-ball: narrowphase only for bodies in the cells around the ball
+    m_broadphase.query(ball.getPosition(), Ball::RADIUS, m_candidates);
+    for (u32 idx : m_candidates) {
+        ContactEvent event;
+        if (m_players[idx].handleBallCollision(ball, event)) {
+            event.playerIndex = static_cast<i32>(idx);
+            ball.recordContact(event);
+        }
+    }
+
+    // AI-human collisions
     for (auto& ai : m_players) {
-        ai.handleBallCollision(ball);
         ai.handlePlayerCollision(playerPos);
     }
 
-    // AI-AI collisions (O(n^2) but n is small)
+    // AI-AI collisions: neighbours from the grid (positions from this tick's build)
     for (size_t i = 0; i < m_players.size(); i++) {
-        for (size_t j = i + 1; j < m_players.size(); j++) {
-            m_players[i].handleAICollision(m_players[j]);
+        m_broadphase.query(m_bodies[i].base, 0.7f, m_candidates);  // Separation distance
+        for (u32 j : m_candidates) {
+            if (j > i) {
+                m_players[i].handleAICollision(m_players[j]);
+            }
         }
     }
 }
@@ -4,6 +4,8 @@
 
 #include "Core/Types.hpp"
 #include "Ball.hpp"
+#include "DecisionTrace.hpp"
+#include "Perception.hpp"
 #include <vector>
 
 namespace Sports {
@@ -11,7 +13,7 @@ namespace Sports {
 class AIPlayer {
 public:
     // Behavioral states for AI decision-making
-    enum class State { Idle, ChaseBall, ReturnToPosition, Defend };
+    enum class State { Idle, ChaseBall, ReturnToPosition, Defend, MakeRun };
 
     // Movement tuning (slightly slower than human player for balance)
     static constexpr f32 MAX_SPEED = 7.0f;
@@ -21,6 +23,8 @@ public:
     static constexpr f32 ROTATION_SPEED = 8.0f;
     static constexpr f32 KICK_COOLDOWN = 1.5f;   // Prevents rapid-fire kicks
     static constexpr f32 RADIUS = 0.3f;
+    static constexpr f32 PLANNED_KICK_TIMEOUT = 5.0f;  // Stale set-piece plans are dropped
+    static constexpr f32 SCAN_DELAY = 0.5f;            // Look for the ball after losing it this long
 
     AIPlayer();
 
@@ -28,10 +32,19 @@ public:
     void setTeam(i32 team) { m_team = team; }
     void setIsClosestChaser(bool isClosest) { m_isClosestChaser = isClosest; }
 
-    void update(f32 deltaTime, Ball& ball, const Vec3& playerPos, f32 fieldLength, f32 fieldWidth, f32 goalWidth);
+    // Set-piece instructions (override normal decisions until done or expired)
+    void commandRun(const Vec3& target, f32 duration);
+    void setPlannedKick(const Vec3& direction, f32 power, f32 spinY);
+
+    // Ball knowledge for this tick; decisions use what was last seen, not ground truth
+    void observeBall(const Vec3& ballPos, const Vec3& ballVel, bool visible, f32 deltaTime);
+
+    // rngState: the owning manager's generator (shot scatter), so forked worlds never share one
+    void update(f32 deltaTime, Ball& ball, const Vec3& playerPos, f32 fieldLength, f32 fieldWidth, f32 goalWidth,
+                u32& rngState);
 
     // Collision handlers for ball and other entities
-    void handleBallCollision(Ball& ball);
+    bool handleBallCollision(Ball& ball, ContactEvent& event);  // Fills event on contact
     void handlePlayerCollision(const Vec3& playerPos);
     void handleAICollision(AIPlayer& other);
 
@@ -39,10 +52,16 @@ public:
     const Vec3& getPosition() const { return m_position; }
     const Vec3& getVelocity() const { return m_velocity; }
     const Vec3& getHomePosition() const { return m_homePosition; }
+    const Vec3& getTargetPosition() const { return m_targetPos; }
     f32 getRotation() const { return m_rotation; }
     f32 getAnimTime() const { return m_animTime; }
     i32 getTeam() const { return m_team; }
     State getState() const { return m_state; }
+    bool isGoalkeeper() const { return m_isGoalkeeper; }
+    bool canSeeBall() const { return m_ballVisible; }
+    bool hasKickedThisTick() const { return m_kickedThisTick; }
+    const DecisionRecord& getLastDecision() const { return m_lastDecision; }
+    Capsule getCapsule() const { return {m_position, RADIUS, BodyCollision::BODY_HEIGHT}; }
 
     f32 distanceToBall(const Vec3& ballPos) const;
 
@@ -51,7 +70,7 @@ private:
     void chaseBall(const Vec3& ballPos, const Vec3& ballVel);
     void returnToPosition(const Vec3& ballPos, f32 fieldLength, f32 goalWidth);
     void moveToward(const Vec3& target, f32 targetSpeed, f32 deltaTime);
-    void tryKick(Ball& ball, f32 fieldLength);
+    void tryKick(Ball& ball, f32 fieldLength, u32& rngState);
 
     Vec3 m_position{0.0f};
     Vec3 m_velocity{0.0f};
@@ -62,6 +81,7 @@ private:
     State m_state = State::Idle;
     i32 m_team = 0;                  // 0 = red, 1 = blue
     f32 m_kickCooldown = 0.0f;
+    bool m_kickedThisTick = false;
     f32 m_animTime = 0.0f;
 
     bool m_isClosestChaser = false;  // Only closest player per team chases
@@ -70,6 +90,21 @@ private:
 
     Vec3 m_targetPos{0.0f};
     f32 m_currentTargetSpeed = MAX_SPEED;
+
+    Vec3 m_runTarget{0.0f};
+    f32 m_runTimer = 0.0f;
+    Vec3 m_plannedKickDir{0.0f};
+    f32 m_plannedKickPower = 0.0f;
+    f32 m_plannedKickSpin = 0.0f;
+    f32 m_plannedKickTimer = 0.0f;
+
+    // Perceived ball (dead-reckoned while out of sight)
+    Vec3 m_knownBallPos{0.0f};
+    Vec3 m_knownBallVel{0.0f};
+    f32 m_timeSinceBallSeen = 0.0f;
+    bool m_ballVisible = true;
+
+    DecisionRecord m_lastDecision;   // Inputs and outcome of the latest decideAction()
 };
 
 // Manages all AI players and coordinates team behavior
@@ -80,12 +115,41 @@ public:
 
     std::vector<AIPlayer>& getPlayers() { return m_players; }
     const std::vector<AIPlayer>& getPlayers() const { return m_players; }
+    void setPlayers(const std::vector<AIPlayer>& players) { m_players = players; }
+
+    // Index of the outfield player on a team nearest to a point (-1 if none)
+    i32 findClosestOutfielder(i32 team, const Vec3& pos) const;
+
+    // Every decision of every player lands here; dump on demand or after a goal
+    DecisionTrace& getTrace() { return m_trace; }
+    const DecisionTrace& getTrace() const { return m_trace; }
+    u32 getTick() const { return m_tick; }
+    void setTracing(bool enabled) { m_tracing = enabled; }  // Off for throwaway rollout worlds
+
+    // Shot scatter comes from here; same seed and state, same match
+    void seedRandom(u32 seed) { m_rngState = seed; }
+
+    // Vision-limited ball knowledge; off = every AI always knows where the ball is
+    void setPerceptionEnabled(bool enabled) { m_perceptionEnabled = enabled; }
+    const PerceptionSystem& getPerception() const { return m_perception; }
 
 private:
     void findClosestChasers(const Vec3& ballPos);
-    void handleCollisions(Ball& ball, const Vec3& playerPos);
+    void handleCollisions(Ball& ball, const Vec3& playerPos, f32 fieldLength, f32 fieldWidth);
 
     std::vector<AIPlayer> m_players;
+    DecisionTrace m_trace;
+    u32 m_tick = 0;
+    bool m_tracing = true;
+    u32 m_rngState = 0x2545F491u;
+
+    PerceptionSystem m_perception;
+    bool m_perceptionEnabled = true;
+
+    // Collision scratch, reused every tick
+    BodyBroadphase m_broadphase;
+    std::vector<Capsule> m_bodies;
+    std::vector<u32> m_candidates;
 };
 
 }
@@ -9,7 +9,11 @@ Ball::Ball() {
 }
 
 void Ball::update(f32 deltaTime, const FieldBounds& bounds) {
-    BallPhysics::update(m_state, deltaTime, bounds);
+    if (m_eventDriven) {
+        BallPhysics::updateEventDriven(m_state, m_roll, deltaTime, bounds);
+    } else {
+        BallPhysics::update(m_state, deltaTime, bounds);
+    }
 }
 
 void Ball::reset() {
@@ -17,6 +21,7 @@ void Ball::reset() {
     m_state.velocity = Vec3(0.0f);
     m_state.angularVelocity = Vec3(0.0f);
     m_state.rotationAngle = 0.0f;
+    m_roll.active = false;
 }
 
 void Ball::kick(const Vec3& direction, f32 power, f32 spinY, f32 spinX) {
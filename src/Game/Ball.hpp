@@ -4,6 +4,8 @@
 
 #include "Core/Types.hpp"
 #include "Physics/BallPhysics.hpp"
+#include "Physics/BodyCollision.hpp"
+#include <vector>
 
 namespace Sports {
 
@@ -14,6 +16,10 @@ public:
     void update(f32 deltaTime, const FieldBounds& bounds);
     void reset();  // Return to center field
 
+    // Closed-form rolling between events (on by default)
+    void setEventDriven(bool enabled) { m_eventDriven = enabled; m_roll.active = false; }
+    bool isEventDriven() const { return m_eventDriven; }
+
     // Actions
     void kick(const Vec3& direction, f32 power, f32 spinY = 0.0f, f32 spinX = 0.0f);
     void push(const Vec3& direction, f32 force);
@@ -29,6 +35,11 @@ public:
     void setPosition(const Vec3& pos) { m_state.position = pos; }
     void setVelocity(const Vec3& vel) { m_state.velocity = vel; }
 
+    // Player touches since the last clearContacts() (cleared once per tick)
+    void recordContact(const ContactEvent& contact) { m_contacts.push_back(contact); }
+    const std::vector<ContactEvent>& getContacts() const { return m_contacts; }
+    void clearContacts() { m_contacts.clear(); }
+
     // Direct state access for collision handling
     BallState& state() { return m_state; }
     const BallState& state() const { return m_state; }
@@ -37,6 +48,9 @@ public:
 
 private:
     BallState m_state;
+    RollSegment m_roll;
+    bool m_eventDriven = true;
+    std::vector<ContactEvent> m_contacts;
 };
 
 }
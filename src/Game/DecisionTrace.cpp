@@ -0,0 +1,169 @@
+// DecisionTrace.cpp
+// Decision quantization and trace dumping, inline or on a writer thread.
+#include "DecisionTrace.hpp"
+#include "Core/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace Sports {
+
+namespace {
+
+// On-disk header, followed by `count` DecisionRecords
+struct TraceFileHeader {
+    u32 magic;
+    u16 version;
+    u16 recordSize;
+    u32 count;
+    u32 reserved;
+    u64 totalRecorded;
+};
+
+}
+
+i16 DecisionRecord::quantize(f32 meters) {
+    f32 cm = std::round(meters * 100.0f);
+    return static_cast<i16>(std::clamp(cm, -32767.0f, 32767.0f));
+}
+
+u16 DecisionRecord::quantizeDistance(f32 meters) {
+    f32 cm = std::round(meters * 100.0f);
+    return static_cast<u16>(std::clamp(cm, 0.0f, 65535.0f));
+}
+
+DecisionTrace::DecisionTrace()
+    : m_records(CAPACITY) {
+}
+
+std::vector<DecisionRecord> DecisionTrace::snapshot() const {
+    std::vector<DecisionRecord> out;
+    copyTo(out);
+    return out;
+}
+
+void DecisionTrace::copyTo(std::vector<DecisionRecord>& out) const {
+    u32 count = size();
+    out.resize(count);
+
+    // At most two runs: the ring's tail, then its head
+    u32 first = static_cast<u32>((m_head - count) & (CAPACITY - 1));
+    u32 tail = std::min(count, CAPACITY - first);
+    std::copy_n(m_records.begin() + first, tail, out.begin());
+    std::copy_n(m_records.begin(), count - tail, out.begin() + tail);
+}
+
+bool DecisionTrace::dump(const std::string& path) const {
+    return writeFile(path, snapshot(), m_head);
+}
+
+bool DecisionTrace::writeFile(const std::string& path, std::span<const DecisionRecord> records, u64 totalRecorded) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open AI trace file: {}", path);
+        return false;
+    }
+
+    TraceFileHeader header{};
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.recordSize = sizeof(DecisionRecord);
+    header.count = static_cast<u32>(records.size());
+    header.totalRecorded = totalRecorded;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(DecisionRecord)));
+
+    file.close();
+    if (!file.good()) {
+        LOG_ERROR("Failed to write AI trace file: {}", path);
+        return false;
+    }
+    LOG_INFO("AI trace dumped: {} decisions to {}", records.size(), path);
+    return true;
+}
+
+DecisionTraceWriter::DecisionTraceWriter()
+    : m_dumps(QUEUE_DEPTH) {
+    for (Dump& dump : m_dumps) {
+        dump.records.reserve(DecisionTrace::CAPACITY);
+        m_free.push_back(&dump);
+    }
+}
+
+DecisionTraceWriter::~DecisionTraceWriter() {
+    if (m_worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_wake.notify_all();
+        m_worker.join();
+    }
+}
+
+void DecisionTraceWriter::startWorker() {
+    if (!m_worker.joinable()) {
+        m_worker = std::thread(&DecisionTraceWriter::workerLoop, this);
+    }
+}
+
+bool DecisionTraceWriter::submit(const DecisionTrace& trace, std::string path) {
+    startWorker();
+
+    Dump* dump;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free.empty()) {
+            LOG_WARN("AI trace writer busy, dropped {}", path);
+            return false;
+        }
+        dump = m_free.back();
+        m_free.pop_back();
+    }
+
+    trace.copyTo(dump->records);  // Within the reserved capacity: no allocation
+    dump->path = std::move(path);
+    dump->totalRecorded = trace.getTotalRecorded();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.push_back(dump);
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+void DecisionTraceWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_returned.wait(lock, [this] { return m_ready.empty() && !m_busy; });
+}
+
+void DecisionTraceWriter::workerLoop() {
+    for (;;) {
+        Dump* dump;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_shutdown || !m_ready.empty(); });
+            if (m_ready.empty()) break;  // Shutting down, and everything submitted is written
+            dump = m_ready.front();
+            m_ready.pop_front();
+            m_busy = true;
+        }
+
+        if (!DecisionTrace::writeFile(dump->path, dump->records, dump->totalRecorded)) {
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(dump);
+            m_busy = false;
+        }
+        m_returned.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,126 @@
+// DecisionTrace.hpp
+// Always-on ring buffer of packed AI decisions for post-hoc debugging.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Sports {
+
+// One AI decision, quantized to centimeters (32 bytes)
+struct DecisionRecord {
+    enum Flags : u8 {
+        Goalkeeper    = 1 << 0,
+        Defender      = 1 << 1,
+        ClosestChaser = 1 << 2,
+        WantsChase    = 1 << 3,  // Role rules allowed chasing this tick
+        InChaseRange  = 1 << 4,  // Ball close enough to commit
+        BallVisible   = 1 << 5,  // Ball fields are seen, not dead-reckoned
+    };
+
+    u32 tick = 0;
+    u8 playerIndex = 0;
+    u8 team = 0;
+    u8 state = 0;          // AIPlayer::State
+    u8 flags = 0;
+    i16 positionX = 0, positionZ = 0;
+    i16 ballX = 0, ballZ = 0;
+    i16 ballY = 0;         // Height, so aerial balls are visible in the trace
+    u16 kickCooldownMs = 0;
+    i16 ballVelX = 0, ballVelZ = 0;  // cm/s
+    i16 targetX = 0, targetZ = 0;
+    u16 ballDistance = 0;  // Score inputs: distance to ball
+    u16 goalDistance = 0;  // and ball distance from own goal line
+
+    static i16 quantize(f32 meters);
+    static u16 quantizeDistance(f32 meters);
+    static f32 toMeters(i32 centimeters) { return centimeters * 0.01f; }
+};
+
+static_assert(sizeof(DecisionRecord) == 32, "DecisionRecord must stay compact");
+
+// Fixed-size per-world ring; recording is a single struct store with no allocation
+class DecisionTrace {
+public:
+    static constexpr u32 CAPACITY = 16384;  // Power of two, ~20s of 12 players at 60 Hz (512 KB)
+
+    DecisionTrace();
+
+    void record(u32 tick, u8 playerIndex, const DecisionRecord& decision) {
+        DecisionRecord& slot = m_records[m_head & (CAPACITY - 1)];
+        slot = decision;
+        slot.tick = tick;
+        slot.playerIndex = playerIndex;
+        m_head++;
+    }
+
+    void clear() { m_head = 0; }
+    u64 getTotalRecorded() const { return m_head; }
+    u32 size() const { return m_head < CAPACITY ? static_cast<u32>(m_head) : CAPACITY; }
+
+    // Records in chronological order (oldest first)
+    std::vector<DecisionRecord> snapshot() const;
+    void copyTo(std::vector<DecisionRecord>& out) const;  // Same, into a reused buffer
+
+    // Binary dump: header followed by records oldest-first. Blocks on the disk;
+    // the frame thread hands dumps to a DecisionTraceWriter instead.
+    bool dump(const std::string& path) const;
+    static bool writeFile(const std::string& path, std::span<const DecisionRecord> records, u64 totalRecorded);
+
+    static constexpr u32 FILE_MAGIC = 0x52544941;  // "AITR"
+    static constexpr u16 FILE_VERSION = 1;
+
+private:
+    std::vector<DecisionRecord> m_records;
+    u64 m_head = 0;
+};
+
+// Background thread writing trace dumps. The frame thread copies the ring into one of
+// QUEUE_DEPTH preallocated buffers (a memcpy, no allocation) and returns; the file is
+// written off the frame. Like FrameEncoder, start it before the frame thread is pinned.
+class DecisionTraceWriter {
+public:
+    static constexpr u32 QUEUE_DEPTH = 2;
+
+    DecisionTraceWriter();
+    ~DecisionTraceWriter();  // Writes everything submitted, then joins
+
+    DecisionTraceWriter(const DecisionTraceWriter&) = delete;
+    DecisionTraceWriter& operator=(const DecisionTraceWriter&) = delete;
+
+    void startWorker();  // Optional: submit() starts the thread if it isn't running
+
+    // False (and nothing written) when every buffer is still queued
+    bool submit(const DecisionTrace& trace, std::string path);
+    void flush();  // Waits until everything submitted is written or has failed
+    u32 getFailedCount() const { return m_failed.load(std::memory_order_relaxed); }
+
+private:
+    struct Dump {
+        std::vector<DecisionRecord> records;
+        std::string path;
+        u64 totalRecorded = 0;
+    };
+
+    void workerLoop();
+
+    std::vector<Dump> m_dumps;
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;      // Writer thread: a dump is ready
+    std::condition_variable m_returned;  // flush(): a dump was written
+    std::vector<Dump*> m_free;           // Guarded by m_mutex
+    std::deque<Dump*> m_ready;           // Guarded by m_mutex, oldest first
+    bool m_busy = false;                 // Guarded by m_mutex: a dump is being written
+    bool m_shutdown = false;
+    std::atomic<u32> m_failed{0};        // Dumps that couldn't be written (already logged)
+};
+
+}
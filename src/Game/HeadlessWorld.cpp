@@ -0,0 +1,249 @@
+// HeadlessWorld.cpp
+// Snapshot capture/restore, render-free stepping, and batch recording.
+#include "HeadlessWorld.hpp"
+#include "MatchEvents.hpp"
+#include "Player.hpp"
+#include "ReplayCapture.hpp"
+#include "Core/Metrics.hpp"
+#include <cstring>
+#include <type_traits>
+
+namespace Sports {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<AIPlayer>, "AI players are serialized as raw bytes");
+
+struct SnapshotHeader {
+    char magic[4];
+    u32 aiCount;
+    u32 aiSize;     // sizeof(AIPlayer) when written; rejects dumps from other builds
+    u32 reserved;
+    BallState ball;
+    Vec3 humanPosition;
+    FieldBounds bounds;
+};
+
+template <typename T>
+void hashBytes(u64& hash, const T& value) {
+    const u8* bytes = reinterpret_cast<const u8*>(&value);
+    for (size_t i = 0; i < sizeof(T); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+}
+
+WorldSnapshot WorldSnapshot::capture(const Ball& ball, const AIManager& ai,
+                                     const Vec3& humanPosition, const FieldBounds& bounds) {
+    WorldSnapshot snapshot;
+    snapshot.ball = ball.state();
+    snapshot.aiPlayers = ai.getPlayers();
+    snapshot.humanPosition = humanPosition;
+    snapshot.bounds = bounds;
+    return snapshot;
+}
+
+void WorldSnapshot::serialize(std::vector<u8>& out) const {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, "WSNP", 4);
+    header.aiCount = static_cast<u32>(aiPlayers.size());
+    header.aiSize = sizeof(AIPlayer);
+    header.ball = ball;
+    header.humanPosition = humanPosition;
+    header.bounds = bounds;
+
+    out.resize(sizeof(header) + aiPlayers.size() * sizeof(AIPlayer));
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!aiPlayers.empty()) {
+        std::memcpy(out.data() + sizeof(header), aiPlayers.data(), aiPlayers.size() * sizeof(AIPlayer));
+    }
+}
+
+bool WorldSnapshot::deserialize(std::span<const u8> data, WorldSnapshot& out) {
+    SnapshotHeader header;
+    if (data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, "WSNP", 4) != 0 || header.aiSize != sizeof(AIPlayer) ||
+        data.size() != sizeof(header) + static_cast<size_t>(header.aiCount) * sizeof(AIPlayer)) {
+        return false;
+    }
+
+    out.ball = header.ball;
+    out.humanPosition = header.humanPosition;
+    out.bounds = header.bounds;
+    out.aiPlayers.resize(header.aiCount);
+    if (header.aiCount > 0) {
+        std::memcpy(out.aiPlayers.data(), data.data() + sizeof(header), header.aiCount * sizeof(AIPlayer));
+    }
+    return true;
+}
+
+u64 WorldSnapshot::checksum(const BallState& ball, const std::vector<AIPlayer>& aiPlayers,
+                            const Vec3& humanPosition) {
+    // FNV-1a over positions and velocities (the state that diverges first)
+    u64 hash = 14695981039346656037ull;
+    hashBytes(hash, ball.position);
+    hashBytes(hash, ball.velocity);
+    hashBytes(hash, ball.angularVelocity);
+    hashBytes(hash, humanPosition);
+    for (const auto& ai : aiPlayers) {
+        hashBytes(hash, ai.getPosition());
+        hashBytes(hash, ai.getVelocity());
+    }
+    return hash;
+}
+
+struct HeadlessWorld::Recording {
+    ReplayWriter writer;
+    MatchEventDetector detector;
+    ReplayFrame frame;
+    std::vector<ReplayRole> roles;
+    std::vector<MatchEvent> events;  // This step's
+    bool failed = false;
+};
+
+HeadlessWorld::HeadlessWorld() {
+    // Forked worlds are throwaway: no trace records, no goal announcements
+    m_ai.setTracing(false);
+    m_match.setAnnounceGoals(false);
+}
+
+HeadlessWorld::~HeadlessWorld() {
+    stopRecording();
+}
+
+void HeadlessWorld::restore(const WorldSnapshot& snapshot, u32 seed) {
+    m_ball.reset();
+    m_ball.clearContacts();
+    m_ball.state() = snapshot.ball;
+    m_ai.setPlayers(snapshot.aiPlayers);
+    m_ai.seedRandom(seed);
+    m_humanPosition = snapshot.humanPosition;
+    m_bounds = snapshot.bounds;
+
+    m_match.reset();
+    m_match.setFieldDimensions(m_bounds.length, m_bounds.width, m_bounds.goalWidth, m_bounds.goalHeight);
+}
+
+WorldSnapshot HeadlessWorld::capture() const {
+    return WorldSnapshot::capture(m_ball, m_ai, m_humanPosition, m_bounds);
+}
+
+void HeadlessWorld::step(f32 deltaTime) {
+    // Rollout worlds step on job workers; each thread counts into its own slab
+    static const MetricId ticksMetric = Metrics::counter("sports_ticks_total", "Simulation ticks",
+                                                         {{"world", "rollout"}});
+    Metrics::add(ticksMetric);
+
+    m_ball.update(deltaTime, m_bounds);
+    m_match.handleBoundaryCollision(m_ball);
+    m_match.update(deltaTime, m_ball);
+    m_ai.update(deltaTime, m_ball, m_humanPosition, m_bounds.length, m_bounds.width, m_bounds.goalWidth);
+    m_match.processTouches(m_ball, m_ai.getPlayers(), m_humanPosition);
+
+    if (m_lagCompensator) {
+        m_bodyPositions.clear();
+        for (const auto& ai : m_ai.getPlayers()) {
+            m_bodyPositions.push_back(ai.getPosition());
+        }
+        m_bodyPositions.push_back(m_humanPosition);
+        m_lagCompensator->record(m_tick, m_ball, m_bodyPositions);
+    }
+    if (m_recording) {
+        recordStep(deltaTime);
+    }
+    m_tick++;
+
+    // Cleared after the tick rather than before, so challenges applied between
+    // ticks reach the referee as the next tick's first contacts
+    m_ball.clearContacts();
+}
+
+bool HeadlessWorld::startRecording(const std::string& path, u32 tickRate) {
+    stopRecording();
+    auto recording = std::make_unique<Recording>();
+    ReplayCapture::roles(m_ai.getPlayers(), recording->roles);
+    if (!recording->writer.open(path, recording->roles, tickRate)) {
+        return false;
+    }
+    recording->detector.setField(m_bounds);
+    m_recording = std::move(recording);
+    return true;
+}
+
+bool HeadlessWorld::stopRecording() {
+    if (!m_recording) {
+        return false;
+    }
+    m_recording->events.clear();
+    m_recording->detector.flush(m_recording->events);
+    for (const MatchEvent& event : m_recording->events) {
+        m_recording->writer.addEvent(event);
+    }
+    bool written = m_recording->writer.close() && !m_recording->failed;
+    m_recording.reset();
+    return written;
+}
+
+void HeadlessWorld::recordStep(f32 deltaTime) {
+    Recording& recording = *m_recording;
+    if (recording.failed) {
+        return;
+    }
+
+    ReplayFrame& frame = recording.frame;
+    frame.tick = m_tick;
+    frame.ball = ReplayCapture::ball(m_ball);
+    frame.players.clear();
+    for (const AIPlayer& ai : m_ai.getPlayers()) {
+        frame.players.push_back(ReplayCapture::aiPlayer(ai));
+    }
+    frame.players.push_back(ReplayCapture::standing(m_humanPosition));
+    ReplayCapture::match(m_match, frame);
+    // A restore() with a different squad can't continue the same replay
+    recording.failed = !recording.writer.write(frame);
+
+    recording.events.clear();
+    recording.detector.observe(m_tick, deltaTime, m_ball.state(), m_ball.getContacts(), m_match.isGoalScored(),
+                               m_match.getLastScoringTeam(), recording.events);
+    for (const MatchEvent& event : recording.events) {
+        recording.writer.addEvent(event);
+    }
+}
+
+void HeadlessWorld::enableLagCompensation() {
+    if (!m_lagCompensator) {
+        m_lagCompensator = std::make_unique<LagCompensator>();
+    }
+}
+
+ChallengeResult HeadlessWorld::applyChallenge(const ChallengeCommand& command) {
+    static const MetricId acceptedMetric = Metrics::counter("sports_lagcomp_challenges_total",
+                                                            "Client kicks and tackles judged by rewinding",
+                                                            {{"result", "accepted"}});
+    static const MetricId rejectedMetric = Metrics::counter("sports_lagcomp_challenges_total",
+                                                            "Client kicks and tackles judged by rewinding",
+                                                            {{"result", "rejected"}});
+    if (!m_lagCompensator) {
+        return ChallengeResult::InFuture;  // No history to judge against
+    }
+
+    // The team comes from the server's roster, never the client: the referee keys
+    // restarts and offside on it
+    const std::vector<AIPlayer>& players = m_ai.getPlayers();
+    if (command.slot > players.size()) {
+        Metrics::add(rejectedMetric);
+        return ChallengeResult::UnknownSlot;
+    }
+    ChallengeCommand judged = command;
+    judged.team = command.slot < players.size() ? players[command.slot].getTeam() : Player::TEAM;
+
+    ChallengeResult result = m_lagCompensator->apply(judged, m_ball);
+    Metrics::add(result == ChallengeResult::Accepted ? acceptedMetric : rejectedMetric);
+    return result;
+}
+
+}
@@ -0,0 +1,81 @@
+// HeadlessWorld.hpp
+// World snapshots and a render-free simulation that can be forked from them.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Ball.hpp"
+#include "AIPlayer.hpp"
+#include "Match.hpp"
+#include "LagCompensation.hpp"
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+// Everything needed to resume simulation from a moment in a match
+struct WorldSnapshot {
+    BallState ball;
+    std::vector<AIPlayer> aiPlayers;
+    Vec3 humanPosition{0.0f};  // Human player acts as a static obstacle
+    FieldBounds bounds;
+
+    static WorldSnapshot capture(const Ball& ball, const AIManager& ai,
+                                 const Vec3& humanPosition, const FieldBounds& bounds);
+
+    // Flat binary form for the flight recorder (same build only: AI players are stored raw)
+    void serialize(std::vector<u8>& out) const;
+    static bool deserialize(std::span<const u8> data, WorldSnapshot& out);
+
+    // Order-sensitive hash of the simulated state, cheap enough for every frame
+    static u64 checksum(const BallState& ball, const std::vector<AIPlayer>& aiPlayers, const Vec3& humanPosition);
+};
+
+// Ball, AI teams and goal detection stepped without window, input, or rendering
+class HeadlessWorld {
+public:
+    HeadlessWorld();
+    ~HeadlessWorld();
+
+    // The seed drives shot scatter; forks of one snapshot pass different seeds to differ
+    void restore(const WorldSnapshot& snapshot, u32 seed = 0);
+    WorldSnapshot capture() const;
+
+    // Same order as the game loop: ball, boundaries, goals, AI
+    void step(f32 deltaTime);
+
+    // Hosted matches: keep a rewind history of every tick and judge client
+    // challenges against it. Off by default (rollouts don't need it). An accepted
+    // challenge changes the ball at once and counts as a contact of the next step.
+    void enableLagCompensation();
+    ChallengeResult applyChallenge(const ChallengeCommand& command);
+    u64 getTick() const { return m_tick; }  // Ticks stepped since construction
+
+    // Batch matches: every step from here on is written as a replay, with the
+    // match events indexed for highlights. Roles come from the current players.
+    bool startRecording(const std::string& path, u32 tickRate);
+    bool stopRecording();  // Writes the index; false if any part of the replay failed
+    bool isRecording() const { return m_recording != nullptr; }
+
+    Ball& getBall() { return m_ball; }
+    AIManager& getAI() { return m_ai; }
+    const Match& getMatch() const { return m_match; }
+
+private:
+    struct Recording;
+    void recordStep(f32 deltaTime);
+
+    Ball m_ball;
+    AIManager m_ai;
+    Match m_match;
+    FieldBounds m_bounds;
+    Vec3 m_humanPosition{0.0f};
+
+    u64 m_tick = 0;
+    std::unique_ptr<LagCompensator> m_lagCompensator;
+    std::vector<Vec3> m_bodyPositions;  // Scratch: AI players, then the human
+    std::unique_ptr<Recording> m_recording;
+};
+
+}
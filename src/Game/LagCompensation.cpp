@@ -0,0 +1,122 @@
+// LagCompensation.cpp
+// History ring recording, rewinding to a client's view, and applying accepted challenges now.
+#include "LagCompensation.hpp"
+#include "Player.hpp"
+#include <algorithm>
+
+namespace Sports {
+
+static_assert((LagCompensator::HISTORY_TICKS & (LagCompensator::HISTORY_TICKS - 1)) == 0,
+              "History is indexed by tick & (HISTORY_TICKS - 1)");
+static_assert(LagCompensator::MAX_REWIND_TICKS < LagCompensator::HISTORY_TICKS,
+              "A rewind reads its tick and the one after it");
+
+LagCompensator::LagCompensator() = default;
+
+void LagCompensator::record(u64 tick, const Ball& ball, std::span<const Vec3> bodies) {
+    // The human is always the last slot, whatever the AI count
+    u32 bodyCount = static_cast<u32>(std::min<size_t>(bodies.size(), MAX_BODIES));
+    for (const ContactEvent& contact : ball.getContacts()) {
+        m_touches++;
+        m_lastToucher = contact.playerIndex >= 0 ? contact.playerIndex : static_cast<i32>(bodyCount) - 1;
+    }
+    m_pendingTouches = 0;  // apply()'s contacts were on the ball, so they are counted above
+
+    Frame& frame = m_frames[tick & (HISTORY_TICKS - 1)];
+    frame.tick = tick;
+    frame.ball = ball.getPosition();
+    frame.touches = m_touches;
+    frame.lastToucher = m_lastToucher;
+    frame.bodyCount = bodyCount;
+    std::copy_n(bodies.begin(), bodyCount, frame.bodies.begin());
+    m_latest = tick;
+}
+
+const LagCompensator::Frame* LagCompensator::find(u64 tick) const {
+    const Frame& frame = m_frames[tick & (HISTORY_TICKS - 1)];
+    return frame.tick == tick ? &frame : nullptr;  // Overwritten by a later tick, or never recorded
+}
+
+bool LagCompensator::rewind(u64 viewTick, f32 viewAlpha, u32 slot, RewoundState& out) const {
+    const Frame* from = find(viewTick);
+    if (!from || slot >= from->bodyCount) {
+        return false;
+    }
+
+    // Clients render between ticks; the newest tick has nothing after it to blend toward
+    const Frame* to = viewTick < m_latest ? find(viewTick + 1) : nullptr;
+    if (!to || slot >= to->bodyCount) {
+        out.ball = from->ball;
+        out.body = from->bodies[slot];
+        return true;
+    }
+    f32 t = std::clamp(viewAlpha, 0.0f, 1.0f);
+    out.ball = glm::mix(from->ball, to->ball, t);
+    out.body = glm::mix(from->bodies[slot], to->bodies[slot], t);
+    return true;
+}
+
+bool LagCompensator::inReach(ChallengeType type, const RewoundState& state) {
+    if (type == ChallengeType::Tackle) {
+        // Ground challenge for the ball at the feet (not in the air by BallPhysics::isInAir's height)
+        Vec3 toBall = state.ball - state.body;
+        toBall.y = 0.0f;
+        return state.ball.y <= Ball::RADIUS + 0.3f && glm::length(toBall) < TACKLE_RANGE + REACH_TOLERANCE;
+    }
+
+    // Same reach as Player::tryKick, plus anything the body itself touches (headers, chest)
+    if (glm::length(state.ball - state.body) < Player::KICK_RANGE + REACH_TOLERANCE) {
+        return true;
+    }
+    BallContact contact;
+    Capsule body{state.body, Player::RADIUS, BodyCollision::BODY_HEIGHT};
+    return BodyCollision::sphereVsCapsule(state.ball, Ball::RADIUS + REACH_TOLERANCE, body, contact);
+}
+
+ChallengeResult LagCompensator::apply(const ChallengeCommand& command, Ball& ball) {
+    if (isEmpty() || command.viewTick > m_latest) {
+        return ChallengeResult::InFuture;
+    }
+    if (m_latest - command.viewTick > MAX_REWIND_TICKS) {
+        return ChallengeResult::TooOld;
+    }
+    const Frame* view = find(command.viewTick);
+    if (!view) {
+        return ChallengeResult::TooOld;
+    }
+
+    RewoundState state;
+    if (!rewind(command.viewTick, command.viewAlpha, command.slot, state)) {
+        return ChallengeResult::UnknownSlot;
+    }
+
+    // First touch wins: a client can't play a ball someone else has played since it looked
+    if (m_touches + m_pendingTouches != view->touches && m_lastToucher != static_cast<i32>(command.slot)) {
+        return ChallengeResult::Superseded;
+    }
+    if (!inReach(command.type, state)) {
+        return ChallengeResult::OutOfRange;
+    }
+
+    // Valid in the past, so it happens to the ball as it is now
+    if (command.type == ChallengeType::Tackle) {
+        ball.push(command.direction, command.power);
+    } else {
+        ball.kick(command.direction, command.power, command.spinY, command.spinX);
+    }
+
+    const Frame& latest = m_frames[m_latest & (HISTORY_TICKS - 1)];
+    ContactEvent event;
+    event.team = command.team;
+    event.playerIndex = command.slot + 1 == latest.bodyCount ? -1 : static_cast<i32>(command.slot);
+    event.point = ball.getPosition();
+    event.impactSpeed = command.power;
+    ball.recordContact(event);
+
+    // Counted now so a second challenge arriving before the next tick sees this one
+    m_pendingTouches++;
+    m_lastToucher = static_cast<i32>(command.slot);
+    return ChallengeResult::Accepted;
+}
+
+}
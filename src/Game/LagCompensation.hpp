@@ -0,0 +1,92 @@
+// LagCompensation.hpp
+// Server-side history of ball and body positions for judging client kicks and tackles at the moment the client saw.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Ball.hpp"
+#include <array>
+#include <span>
+
+namespace Sports {
+
+enum class ChallengeType : u8 { Kick, Tackle };
+
+// What a client asks for. The view is the interpolated state it was rendering:
+// viewAlpha of the way from viewTick to viewTick + 1.
+struct ChallengeCommand {
+    ChallengeType type = ChallengeType::Kick;
+    u32 slot = 0;          // Body slot: AI players first, then the human
+    i32 team = 0;          // Server's record of the slot; HeadlessWorld overwrites what a client sends
+    u64 viewTick = 0;
+    f32 viewAlpha = 0.0f;
+    Vec3 direction{0.0f, 0.0f, -1.0f};
+    f32 power = 0.0f;
+    f32 spinY = 0.0f;
+    f32 spinX = 0.0f;
+};
+
+enum class ChallengeResult : u8 {
+    Accepted,
+    OutOfRange,   // Not in reach of the ball even as the client saw it
+    TooOld,       // View older than MAX_REWIND_TICKS, or no longer in the history
+    InFuture,     // View newer than the last recorded tick
+    Superseded,   // Someone else has played the ball since the view
+    UnknownSlot,
+};
+
+// Ball and body positions at one instant, as the client saw them
+struct RewoundState {
+    Vec3 ball{0.0f};
+    Vec3 body{0.0f};
+};
+
+// Fixed ring of the last HISTORY_TICKS ticks, indexed by tick number, so a
+// rewind is one slot lookup and a match's history never grows or allocates.
+class LagCompensator {
+public:
+    static constexpr u32 HISTORY_TICKS = 32;     // Power of two; ~0.5 s at 60 Hz
+    static constexpr u32 MAX_BODIES = 32;
+    static constexpr u32 MAX_REWIND_TICKS = 20;  // ~333 ms: further back is refused, not clamped
+    static constexpr f32 TACKLE_RANGE = 1.2f;    // Reach from the body centre to the ball (horizontal)
+    static constexpr f32 REACH_TOLERANCE = 0.15f; // Slack for interpolation and quantized positions
+
+    LagCompensator();
+
+    // Once per server tick, after it is simulated and before the ball's contacts
+    // are cleared. Bodies use the slot layout of ChallengeCommand; the human's
+    // contacts (playerIndex -1) are the last slot.
+    void record(u64 tick, const Ball& ball, std::span<const Vec3> bodies);
+
+    // Rewinds to the command's view and, if the contact holds there, applies it to the present ball
+    ChallengeResult apply(const ChallengeCommand& command, Ball& ball);
+
+    // Positions as of the view; false (out untouched) when the view is not in the history
+    bool rewind(u64 viewTick, f32 viewAlpha, u32 slot, RewoundState& out) const;
+
+    static bool inReach(ChallengeType type, const RewoundState& state);
+
+    u64 getLatestTick() const { return m_latest; }
+    bool isEmpty() const { return m_latest == NO_TICK; }
+
+private:
+    static constexpr u64 NO_TICK = ~0ull;
+
+    struct Frame {
+        u64 tick = NO_TICK;
+        Vec3 ball{0.0f};
+        u32 touches = 0;        // Ball contacts recorded up to and including this tick
+        i32 lastToucher = -1;   // Slot of the latest of them
+        u32 bodyCount = 0;
+        std::array<Vec3, MAX_BODIES> bodies;
+    };
+
+    const Frame* find(u64 tick) const;
+
+    std::array<Frame, HISTORY_TICKS> m_frames;
+    u64 m_latest = NO_TICK;
+    u32 m_touches = 0;
+    u32 m_pendingTouches = 0;  // Accepted since the last record()
+    i32 m_lastToucher = -1;
+};
+
+}
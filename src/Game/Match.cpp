@@ -1,6 +1,8 @@
 // Match.cpp
-// Goal detection, score tracking, and ball boundary handling.
+// Goal detection, score tracking, ball boundary handling, and referee events.
 #include "Match.hpp"
+#include "AIPlayer.hpp"
+#include "Player.hpp"
 #include "Core/Logger.hpp"
 #include <cmath>
 
@@ -11,6 +13,7 @@ void Match::setFieldDimensions(f32 fieldLength, f32 fieldWidth, f32 goalWidth, f
     m_fieldWidth = fieldWidth;
     m_goalWidth = goalWidth;
     m_goalHeight = goalHeight;
+    m_rules.setFieldDimensions(fieldLength, fieldWidth, goalWidth, goalHeight);
 }
 
 void Match::update(f32 deltaTime, Ball& ball) {
@@ -30,6 +33,8 @@ void Match::reset() {
     m_goalScored = false;
     m_celebrationTimer = 0.0f;
     m_lastScoringTeam = -1;
+    m_rules.reset();
+    m_restartAwarded = false;
 }
 
 bool Match::checkGoal(const Vec3& ballPos) {
@@ -50,7 +55,9 @@ bool Match::checkGoal(const Vec3& ballPos) {
         m_goalScored = true;
         m_celebrationTimer = GOAL_CELEBRATION_DURATION;
         m_lastScoringTeam = 0;
-        LOG_INFO("GOAL! Red Team scores! Score: {} - {}", m_scoreLeft, m_scoreRight);
+        if (m_announceGoals) {
+            LOG_INFO("GOAL! Red Team scores! Score: {} - {}", m_scoreLeft, m_scoreRight);
+        }
         return true;
     }
     // Blue team scores (ball in negative X goal)
@@ -59,7 +66,9 @@ bool Match::checkGoal(const Vec3& ballPos) {
         m_goalScored = true;
         m_celebrationTimer = GOAL_CELEBRATION_DURATION;
         m_lastScoringTeam = 1;
-        LOG_INFO("GOAL! Blue Team scores! Score: {} - {}", m_scoreLeft, m_scoreRight);
+        if (m_announceGoals) {
+            LOG_INFO("GOAL! Blue Team scores! Score: {} - {}", m_scoreLeft, m_scoreRight);
+        }
         return true;
     }
 
@@ -70,6 +79,39 @@ void Match::resetAfterGoal(Ball& ball) {
     ball.reset();
     m_goalScored = false;
     m_celebrationTimer = 0.0f;
+    m_rules.reset();  // Kickoff
+}
+
+void Match::processTouches(Ball& ball, const std::vector<AIPlayer>& aiPlayers, const Vec3& humanPos) {
+    if (!m_rulesEnabled || m_goalScored || ball.getContacts().empty()) {
+        return;
+    }
+
+    // Slot layout matches ContactEvent::playerIndex: AI players, then the human
+    m_slotPositions.clear();
+    m_slotTeams.clear();
+    for (const auto& ai : aiPlayers) {
+        m_slotPositions.push_back(ai.getPosition());
+        m_slotTeams.push_back(ai.getTeam());
+    }
+    m_slotPositions.push_back(humanPos);
+    m_slotTeams.push_back(Player::TEAM);
+
+    if (m_rules.onTouches(ball.getContacts(), m_slotPositions, m_slotTeams, ball.state())) {
+        m_restartAwarded = true;
+        if (m_announceGoals) {
+            LOG_INFO("Offside! Free kick to {} team", m_rules.getLastRestart().team == 0 ? "Red" : "Blue");
+        }
+    }
+}
+
+bool Match::consumeRestart(Restart& out) {
+    if (!m_restartAwarded) {
+        return false;
+    }
+    m_restartAwarded = false;
+    out = m_rules.getLastRestart();
+    return true;
 }
 
 f32 Match::getCelebrationAlpha() const {
@@ -110,7 +152,7 @@ bool Match::isBallOutOfBounds(const Vec3& ballPos) const {
     return false;
 }
 
-void Match::handleBoundaryCollision(Ball& ball) {
+bool Match::handleBoundaryCollision(Ball& ball) {
     Vec3 pos = ball.getPosition();
     Vec3 vel = ball.getVelocity();
     f32 halfLength = m_fieldLength / 2.0f;
@@ -118,6 +160,17 @@ void Match::handleBoundaryCollision(Ball& ball) {
     f32 goalHalfWidth = m_goalWidth / 2.0f;
     f32 radius = Ball::RADIUS;
 
+    // With rules on, reaching a line is an out-of-play event rather than a bounce
+    if (m_rulesEnabled && !m_goalScored && m_rules.onBoundary(ball.state())) {
+        m_restartAwarded = true;
+        if (m_announceGoals) {
+            const Restart& restart = m_rules.getLastRestart();
+            const char* names[] = {"", "Throw-in", "Corner", "Goal kick", "Free kick"};
+            LOG_INFO("{} to {} team", names[static_cast<i32>(restart.type)], restart.team == 0 ? "Red" : "Blue");
+        }
+        return true;
+    }
+
     // Side boundaries (Z axis)
     if (pos.z < -halfWidth + radius) {
         ball.state().position.z = -halfWidth + radius;
@@ -139,6 +192,7 @@ void Match::handleBoundaryCollision(Ball& ball) {
             ball.state().velocity.x = -std::abs(vel.x) * 0.6f;
         }
     }
+    return false;
 }
 
 }
@@ -1,12 +1,16 @@
 // Match.hpp
-// Game state management: scoring, goal detection, and field boundaries.
+// Game state management: scoring, goal detection, field boundaries, and rules.
 #pragma once
 
 #include "Core/Types.hpp"
 #include "Ball.hpp"
+#include "Rules.hpp"
+#include <vector>
 
 namespace Sports {
 
+class AIPlayer;
+
 class Match {
 public:
     static constexpr f32 GOAL_CELEBRATION_DURATION = 3.0f;  // Pause after goal
@@ -16,6 +20,18 @@ public:
     void setFieldDimensions(f32 fieldLength, f32 fieldWidth, f32 goalWidth, f32 goalHeight);
     void update(f32 deltaTime, Ball& ball);
     void reset();
+    void setAnnounceGoals(bool announce) { m_announceGoals = announce; }  // Off for headless rollouts
+
+    // Out-of-play restarts and offside; off = the ball bounces off the boundary walls
+    void setRulesEnabled(bool enabled) { m_rulesEnabled = enabled; }
+    bool areRulesEnabled() const { return m_rulesEnabled; }
+    const RulesEngine& getRules() const { return m_rules; }
+
+    // Referee input for this tick's ball contacts; does nothing when nobody touched the ball
+    void processTouches(Ball& ball, const std::vector<AIPlayer>& aiPlayers, const Vec3& humanPos);
+
+    // True once per restart awarded (by the boundary or an offside), for set-piece planning
+    bool consumeRestart(Restart& out);
 
     // Goal detection
     bool checkGoal(const Vec3& ballPos);
@@ -31,7 +47,7 @@ public:
 
     // Ball out of bounds check
     bool isBallOutOfBounds(const Vec3& ballPos) const;
-    void handleBoundaryCollision(Ball& ball);
+    bool handleBoundaryCollision(Ball& ball);  // True if the ball went out of play
 
 private:
     f32 m_fieldLength = 105.0f;
@@ -45,6 +61,15 @@ private:
     bool m_goalScored = false;
     f32 m_celebrationTimer = 0.0f;
     i32 m_lastScoringTeam = -1;  // 0 = red scored, 1 = blue scored
+    bool m_announceGoals = true;
+
+    RulesEngine m_rules;
+    bool m_rulesEnabled = true;
+    bool m_restartAwarded = false;
+
+    // Touch scratch: AI slots first, then the human
+    std::vector<Vec3> m_slotPositions;
+    std::vector<i32> m_slotTeams;
 };
 
 }
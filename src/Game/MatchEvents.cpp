@@ -0,0 +1,155 @@
+// MatchEvents.cpp
+// Goal, shot, near-miss, long-pass, and fast-ball detection.
+#include "MatchEvents.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sports {
+
+namespace {
+
+// Further than this from where the last tick's velocity would put it, the ball was placed
+// (a restart or the kickoff after a goal) rather than played
+constexpr f32 RESTART_JUMP = 1.0f;
+
+// Team 0 attacks the +X goal
+f32 attackedGoalX(i32 team, f32 halfLength) {
+    return team == 0 ? halfLength : -halfLength;
+}
+
+// Height at time t on a drag-free arc; a ball that has already come down counts as on the ground
+f32 heightAfter(const BallState& ball, f32 t) {
+    return std::max(ball.position.y + ball.velocity.y * t - 0.5f * BallPhysics::GRAVITY * t * t, 0.0f);
+}
+
+}
+
+void MatchEventDetector::reset() {
+    m_hasPrevious = false;
+    m_goalScored = false;
+    m_touchTeam = -1;
+    m_touchPlayer = -1;
+    m_fast = false;
+}
+
+void MatchEventDetector::observe(u64 tick, f32 deltaTime, const BallState& ball, std::span<const ContactEvent> contacts,
+                                 bool goalScored, i32 scoringTeam, std::vector<MatchEvent>& out) {
+    if (m_hasPrevious && !m_goalScored) {
+        checkNearMiss(tick, deltaTime, out);
+    }
+
+    if (goalScored && !m_goalScored) {
+        const Vec3& velocity = m_hasPrevious ? m_previous.velocity : ball.velocity;
+        out.push_back({tick, glm::length(velocity), MatchEventType::Goal, static_cast<u8>(scoringTeam)});
+    }
+
+    bool placed = m_hasPrevious &&
+                  glm::length(ball.position - (m_previous.position + m_previous.velocity * deltaTime)) > RESTART_JUMP;
+    if (placed) {
+        // Touches before a restart don't chain into passes after it
+        m_touchTeam = -1;
+        m_touchPlayer = -1;
+    }
+
+    for (const ContactEvent& touch : contacts) {
+        if (!goalScored) {
+            checkShot(tick, ball, touch, out);
+        }
+        Vec2 from(m_touchPoint.x, m_touchPoint.z);
+        f32 distance = glm::length(Vec2(touch.point.x, touch.point.z) - from);
+        if (touch.team == m_touchTeam && touch.playerIndex != m_touchPlayer && distance >= m_config.longPassDistance) {
+            out.push_back({m_touchTick, distance, MatchEventType::LongPass, static_cast<u8>(touch.team)});
+        }
+        m_touchTick = tick;
+        m_touchPoint = touch.point;
+        m_touchTeam = touch.team;
+        m_touchPlayer = touch.playerIndex;
+    }
+
+    f32 speed = glm::length(ball.velocity);
+    if (speed >= m_config.fastBallSpeed && !placed) {
+        if (!m_fast || speed > m_peakSpeed) {
+            m_peakTick = tick;
+            m_peakSpeed = speed;
+        }
+        m_fast = true;
+    } else {
+        flush(out);
+    }
+
+    m_previous = ball;
+    m_hasPrevious = true;
+    m_goalScored = goalScored;
+}
+
+void MatchEventDetector::flush(std::vector<MatchEvent>& out) {
+    if (m_fast) {
+        out.push_back({m_peakTick, m_peakSpeed, MatchEventType::FastBall, MatchEvent::NO_TEAM});
+        m_fast = false;
+    }
+}
+
+void MatchEventDetector::checkShot(u64 tick, const BallState& ball, const ContactEvent& touch,
+                                   std::vector<MatchEvent>& out) const {
+    f32 goalX = attackedGoalX(touch.team, m_bounds.length / 2.0f);
+    f32 speed = glm::length(ball.velocity);
+    bool towardGoal = goalX > 0.0f ? ball.velocity.x > 0.0f : ball.velocity.x < 0.0f;
+    if (speed < m_config.shotSpeed || !towardGoal || std::abs(goalX - ball.position.x) > m_config.shotRange) {
+        return;
+    }
+
+    // Where it would cross the goal line, ignoring drag and bounces
+    f32 t = (goalX - ball.position.x) / ball.velocity.x;
+    f32 z = ball.position.z + ball.velocity.z * t;
+    if (std::abs(z) <= m_bounds.goalWidth / 2.0f + m_config.shotMargin &&
+        heightAfter(ball, t) <= m_bounds.goalHeight + m_config.shotMargin) {
+        out.push_back({tick, speed, MatchEventType::Shot, static_cast<u8>(touch.team)});
+    }
+}
+
+void MatchEventDetector::checkNearMiss(u64 tick, f32 deltaTime, std::vector<MatchEvent>& out) const {
+    // The referee has already moved a ball that went out to its restart spot, so the
+    // crossing is found from where last tick's ball was heading. The ball never gets
+    // past the inner wall one radius short of the line (physics stops it there and the
+    // referee rules it out there), so reaching that wall is what counts as going out.
+    const BallState& from = m_previous;
+    f32 halfLength = m_bounds.length / 2.0f;
+    f32 outX = halfLength - BallPhysics::BALL_RADIUS;
+    f32 endX = from.position.x + from.velocity.x * deltaTime;
+    f32 lineX = 0.0f;
+    if (from.position.x < outX && endX >= outX) {
+        lineX = halfLength;
+    } else if (from.position.x > -outX && endX <= -outX) {
+        lineX = -halfLength;
+    } else {
+        return;
+    }
+
+    // Off the frame measured where the flight would cross the goal line itself
+
+    f32 t = (lineX - from.position.x) / from.velocity.x;
+    f32 wide = std::abs(from.position.z + from.velocity.z * t) - m_bounds.goalWidth / 2.0f;
+    f32 over = heightAfter(from, t) - m_bounds.goalHeight;
+    if (wide < 0.0f && over < 0.0f) {
+        return;  // Inside the frame: a goal, not a miss
+    }
+    f32 offFrame = wide > 0.0f && over > 0.0f ? std::sqrt(wide * wide + over * over) : std::max(wide, over);
+    if (offFrame <= m_config.nearMissMargin) {
+        u8 attackers = lineX > 0.0f ? 0 : 1;
+        out.push_back({tick, offFrame, MatchEventType::NearMiss, attackers});
+    }
+}
+
+const char* MatchEventDetector::getName(MatchEventType type) {
+    switch (type) {
+        case MatchEventType::Goal: return "goal";
+        case MatchEventType::Shot: return "shot";
+        case MatchEventType::NearMiss: return "nearmiss";
+        case MatchEventType::LongPass: return "longpass";
+        case MatchEventType::FastBall: return "fast";
+    }
+    return "unknown";
+}
+
+}
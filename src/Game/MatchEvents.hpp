@@ -0,0 +1,68 @@
+// MatchEvents.hpp
+// Highlight-worthy moments found from the ball and its touches while a match is recorded.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Physics/BallPhysics.hpp"
+#include "Physics/BodyCollision.hpp"
+#include "Replay.hpp"
+#include <span>
+#include <vector>
+
+namespace Sports {
+
+// Thresholds for what counts as an event
+struct MatchEventConfig {
+    f32 shotSpeed = 14.0f;         // m/s off a touch, toward the goal being attacked
+    f32 shotRange = 35.0f;         // Furthest from the goal line a touch still counts as a shot
+    f32 shotMargin = 1.5f;         // Projected crossing may miss the frame by this much
+    f32 nearMissMargin = 2.0f;     // Ball crossed the goal line at most this far off the frame
+    f32 longPassDistance = 30.0f;  // Between two touches by different players of one team
+    f32 fastBallSpeed = 28.0f;
+};
+
+// Fed once per tick with the ball after the tick's physics and touches. Goals
+// come from the match; everything else is worked out from the ball alone, so
+// the detector runs the same in the game loop and in headless worlds.
+class MatchEventDetector {
+public:
+    MatchEventDetector() = default;
+    explicit MatchEventDetector(const MatchEventConfig& config) : m_config(config) {}
+
+    void setField(const FieldBounds& bounds) { m_bounds = bounds; }
+    void reset();  // Kickoff: no previous tick, touch, or fast ball in progress
+
+    // Appends this tick's events to `out`. Events may be dated earlier than
+    // `tick` (a long pass is dated at the pass, a fast ball at its peak).
+    void observe(u64 tick, f32 deltaTime, const BallState& ball, std::span<const ContactEvent> contacts,
+                 bool goalScored, i32 scoringTeam, std::vector<MatchEvent>& out);
+
+    // Closes a fast ball still in progress at the end of a recording
+    void flush(std::vector<MatchEvent>& out);
+
+    static const char* getName(MatchEventType type);
+
+private:
+    void checkShot(u64 tick, const BallState& ball, const ContactEvent& touch, std::vector<MatchEvent>& out) const;
+    void checkNearMiss(u64 tick, f32 deltaTime, std::vector<MatchEvent>& out) const;
+
+    MatchEventConfig m_config;
+    FieldBounds m_bounds;
+
+    BallState m_previous;
+    bool m_hasPrevious = false;
+    bool m_goalScored = false;
+
+    // Last touch, for long passes
+    u64 m_touchTick = 0;
+    Vec3 m_touchPoint{0.0f};
+    i32 m_touchTeam = -1;
+    i32 m_touchPlayer = -1;
+
+    // Fastest tick of the current spell above fastBallSpeed
+    u64 m_peakTick = 0;
+    f32 m_peakSpeed = 0.0f;
+    bool m_fast = false;
+};
+
+}
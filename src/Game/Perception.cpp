@@ -0,0 +1,236 @@
+// Perception.cpp
+// Vision cone and occlusion tests, four targets per SSE lane group with a scalar fallback.
+#include "Perception.hpp"
+#include "AIPlayer.hpp"
+#include "Physics/BodyCollision.hpp"
+#include "Math/FastMath.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define SPORTS_PERCEPTION_SSE 1
+#endif
+
+namespace Sports {
+
+void PerceptionSystem::update(u32 tick, const std::vector<AIPlayer>& players, const Vec3& humanPos,
+                              const Vec3& ballPos) {
+    if (tick == m_tick) {
+        return;
+    }
+    m_tick = tick;
+
+    m_observers = static_cast<u32>(std::min<size_t>(players.size(), MAX_ENTITIES - 2));
+    m_humanSlot = m_observers;
+    m_ballSlot = m_observers + 1;
+    m_count = m_observers + 2;
+
+    // Padding lanes sit far away with no radius so they never see or block anything
+    u32 padded = (m_count + 3) & ~3u;
+    m_x.assign(padded, 1e6f);
+    m_z.assign(padded, 1e6f);
+    m_height.assign(padded, 0.0f);
+    m_radius.assign(padded, 0.0f);
+    m_forwardX.resize(m_observers);
+    m_forwardZ.resize(m_observers);
+    m_visible.assign(m_observers, 0);
+
+    for (u32 i = 0; i < m_observers; i++) {
+        const AIPlayer& ai = players[i];
+        m_x[i] = ai.getPosition().x;
+        m_z[i] = ai.getPosition().z;
+        m_height[i] = BODY_TARGET_HEIGHT;
+        m_radius[i] = AIPlayer::RADIUS;
+        m_forwardX[i] = ai.getRotation();  // Angle for now; turned into the facing vector below
+    }
+
+    // Facing is (-sin, -cos) of the rotation, four observers per step
+    FastMath::sinCos(m_forwardX.data(), m_observers, m_forwardX.data(), m_forwardZ.data());
+    for (u32 i = 0; i < m_observers; i++) {
+        m_forwardX[i] = -m_forwardX[i];
+        m_forwardZ[i] = -m_forwardZ[i];
+    }
+
+    m_x[m_humanSlot] = humanPos.x;
+    m_z[m_humanSlot] = humanPos.z;
+    m_height[m_humanSlot] = BODY_TARGET_HEIGHT;
+    m_radius[m_humanSlot] = AIPlayer::RADIUS;
+
+    m_x[m_ballSlot] = ballPos.x;
+    m_z[m_ballSlot] = ballPos.z;
+    m_height[m_ballSlot] = ballPos.y;
+
+    for (u32 i = 0; i < m_observers; i++) {
+        computeObserver(i);
+    }
+}
+
+namespace {
+
+// A body can only block a ray it starts less than the ray's length from; the slack keeps
+// rounding from ever pruning a body the exact test would count
+constexpr f32 PRUNE_SLACK = 0.01f;
+
+}
+
+void PerceptionSystem::gatherOccluders(u32 observer) {
+    // Everything visible lies within VIEW_RANGE, so nothing starting beyond it can block
+    m_occluders.clear();
+    for (u32 k = 0; k < m_count; k++) {
+        if (m_radius[k] <= 0.0f || k == observer) continue;
+        f32 kx = m_x[k] - m_x[observer];
+        f32 kz = m_z[k] - m_z[observer];
+        f32 nearEdge = std::sqrt(kx * kx + kz * kz) - m_radius[k];
+        if (nearEdge < VIEW_RANGE + PRUNE_SLACK) {
+            m_occluders.push_back({nearEdge, k});
+        }
+    }
+    std::sort(m_occluders.begin(), m_occluders.end(),
+              [](const Occluder& a, const Occluder& b) { return a.nearEdge < b.nearEdge; });
+}
+
+void PerceptionSystem::computeObserver(u32 observer) {
+    gatherOccluders(observer);
+#ifdef SPORTS_PERCEPTION_SSE
+    if (m_simdEnabled) {
+        computeObserverSse(observer);
+        return;
+    }
+#endif
+    computeObserverScalar(observer);
+}
+
+// Both paths use the same arithmetic in the same order, and a body never occludes its own
+// slot (by index, not position: two bodies can stand on one spot), so they agree bit for bit
+
+#ifdef SPORTS_PERCEPTION_SSE
+
+void PerceptionSystem::computeObserverSse(u32 observer) {
+    const f32 ox = m_x[observer];
+    const f32 oz = m_z[observer];
+    const __m128 obsX = _mm_set1_ps(ox);
+    const __m128 obsZ = _mm_set1_ps(oz);
+    const __m128 fwdX = _mm_set1_ps(m_forwardX[observer]);
+    const __m128 fwdZ = _mm_set1_ps(m_forwardZ[observer]);
+    const __m128 cosFov = _mm_set1_ps(std::cos(HALF_FOV));
+    const __m128 rangeSq = _mm_set1_ps(VIEW_RANGE * VIEW_RANGE);
+    const __m128 awareSq = _mm_set1_ps(AWARENESS_RADIUS * AWARENESS_RADIUS);
+    const __m128 eye = _mm_set1_ps(EYE_HEIGHT);
+    const __m128 bodyTop = _mm_set1_ps(BodyCollision::BODY_HEIGHT);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(1e-6f);
+
+    u64 visible = 0;
+    u32 padded = static_cast<u32>(m_x.size());
+
+    for (u32 j = 0; j < padded; j += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_x[j]), obsX);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(&m_z[j]), obsZ);
+        __m128 targetHeight = _mm_loadu_ps(&m_height[j]);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+        __m128 dist = _mm_sqrt_ps(distSq);
+
+        // In the cone and in range, or close enough to sense without looking
+        __m128 facing = _mm_add_ps(_mm_mul_ps(dx, fwdX), _mm_mul_ps(dz, fwdZ));
+        __m128 inCone = _mm_cmpge_ps(facing, _mm_mul_ps(cosFov, dist));
+        __m128 inRange = _mm_cmple_ps(distSq, rangeSq);
+        __m128 aware = _mm_cmple_ps(distSq, awareSq);
+        __m128 candidate = _mm_or_ps(_mm_and_ps(inCone, inRange), aware);
+
+        u32 candidates = static_cast<u32>(_mm_movemask_ps(candidate));
+        if (candidates == 0) continue;
+
+        // Occluders are nearest first: stop at the first that starts beyond every candidate
+        alignas(16) f32 lanes[4];
+        _mm_store_ps(lanes, _mm_and_ps(dist, candidate));
+        f32 farthest = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3])) + PRUNE_SLACK;
+
+        // Any other body between observer and target blocks the ray below head height
+        u32 blocked = 0;
+        __m128 invDistSq = _mm_div_ps(one, _mm_max_ps(distSq, epsilon));
+        for (const Occluder& occluder : m_occluders) {
+            if (occluder.nearEdge >= farthest || (candidates & ~blocked) == 0) break;
+            u32 k = occluder.slot;
+            f32 radius = m_radius[k];
+
+            __m128 kx = _mm_set1_ps(m_x[k] - ox);
+            __m128 kz = _mm_set1_ps(m_z[k] - oz);
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(kx, dx), _mm_mul_ps(kz, dz)), invDistSq);
+            __m128 cx = _mm_sub_ps(kx, _mm_mul_ps(dx, t));
+            __m128 cz = _mm_sub_ps(kz, _mm_mul_ps(dz, t));
+            __m128 missSq = _mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cz, cz));
+
+            __m128 between = _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, one));
+            __m128 close = _mm_cmplt_ps(missSq, _mm_set1_ps(radius * radius));
+            __m128 rayHeight = _mm_add_ps(eye, _mm_mul_ps(_mm_sub_ps(targetHeight, eye), t));
+            __m128 low = _mm_cmplt_ps(rayHeight, bodyTop);
+
+            u32 hits = static_cast<u32>(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(between, close), low)));
+            if (k - j < 4) {
+                hits &= ~(1u << (k - j));  // A body never occludes itself
+            }
+            blocked |= hits;
+        }
+
+        visible |= static_cast<u64>(candidates & ~blocked) << j;
+    }
+
+    visible &= ~(1ull << observer);
+    if (m_count < 64) {
+        visible &= (1ull << m_count) - 1;
+    }
+    m_visible[observer] = visible;
+}
+
+#endif
+
+void PerceptionSystem::computeObserverScalar(u32 observer) {
+    const f32 ox = m_x[observer];
+    const f32 oz = m_z[observer];
+    const f32 cosFov = std::cos(HALF_FOV);
+
+    u64 visible = 0;
+    for (u32 j = 0; j < m_count; j++) {
+        if (j == observer) continue;
+
+        f32 dx = m_x[j] - ox;
+        f32 dz = m_z[j] - oz;
+        f32 distSq = dx * dx + dz * dz;
+        f32 dist = std::sqrt(distSq);
+        f32 facing = dx * m_forwardX[observer] + dz * m_forwardZ[observer];
+
+        bool aware = distSq <= AWARENESS_RADIUS * AWARENESS_RADIUS;
+        bool inView = facing >= cosFov * dist && distSq <= VIEW_RANGE * VIEW_RANGE;
+        if (!aware && !inView) continue;
+
+        bool blocked = false;
+        f32 invDistSq = 1.0f / std::max(distSq, 1e-6f);
+        for (const Occluder& occluder : m_occluders) {
+            if (occluder.nearEdge >= dist + PRUNE_SLACK) break;
+            u32 k = occluder.slot;
+            if (k == j) continue;  // A body never occludes itself
+
+            f32 kx = m_x[k] - ox;
+            f32 kz = m_z[k] - oz;
+            f32 t = (kx * dx + kz * dz) * invDistSq;
+            f32 cx = kx - dx * t;
+            f32 cz = kz - dz * t;
+            f32 rayHeight = EYE_HEIGHT + (m_height[j] - EYE_HEIGHT) * t;
+            if (t > 0.0f && t < 1.0f && cx * cx + cz * cz < m_radius[k] * m_radius[k] &&
+                rayHeight < BodyCollision::BODY_HEIGHT) {
+                blocked = true;
+                break;
+            }
+        }
+
+        if (!blocked) {
+            visible |= 1ull << j;
+        }
+    }
+    m_visible[observer] = visible;
+}
+
+}
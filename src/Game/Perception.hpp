@@ -0,0 +1,66 @@
+// Perception.hpp
+// Batched per-tick visibility: vision cones plus line-of-sight occlusion by player bodies.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <vector>
+
+namespace Sports {
+
+class AIPlayer;
+
+// Entity slots: AI players [0, n), human player n, ball n + 1
+class PerceptionSystem {
+public:
+    static constexpr u32 MAX_ENTITIES = 64;       // Visibility is a 64-bit mask per observer
+    static constexpr f32 HALF_FOV = 1.4f;         // ~160 degree vision cone
+    static constexpr f32 VIEW_RANGE = 70.0f;      // meters
+    static constexpr f32 AWARENESS_RADIUS = 3.0f; // Always sensed, regardless of facing
+    static constexpr f32 EYE_HEIGHT = 1.7f;
+    static constexpr f32 BODY_TARGET_HEIGHT = 1.2f;  // Aim point when looking at another player
+
+    // Recomputes only when the tick changes; later calls in the same tick reuse the cache
+    void update(u32 tick, const std::vector<AIPlayer>& players, const Vec3& humanPos, const Vec3& ballPos);
+
+    bool canSee(u32 observer, u32 entity) const { return (m_visible[observer] >> entity) & 1ull; }
+    bool canSeeBall(u32 observer) const { return canSee(observer, m_ballSlot); }
+    u64 getVisibleMask(u32 observer) const { return m_visible[observer]; }
+
+    // Off runs the portable path even where SSE is available (validation and parity tests)
+    void setSimdEnabled(bool enabled) { m_simdEnabled = enabled; }
+
+    u32 getHumanSlot() const { return m_humanSlot; }
+    u32 getBallSlot() const { return m_ballSlot; }
+    u32 getTick() const { return m_tick; }
+
+private:
+    // A body that can block this observer's view; nearEdge is its distance minus radius
+    struct Occluder {
+        f32 nearEdge;
+        u32 slot;
+    };
+
+    void gatherOccluders(u32 observer);
+    void computeObserver(u32 observer);
+    void computeObserverScalar(u32 observer);
+    void computeObserverSse(u32 observer);  // SSE builds only
+
+    // Structure of arrays, padded to a multiple of 4 for SIMD
+    std::vector<f32> m_x;
+    std::vector<f32> m_z;
+    std::vector<f32> m_height;    // Aim height of each entity
+    std::vector<f32> m_radius;    // Occluding radius (0 = does not block)
+    std::vector<f32> m_forwardX;  // Observer facing (AI only)
+    std::vector<f32> m_forwardZ;
+    std::vector<u64> m_visible;
+    std::vector<Occluder> m_occluders;  // Scratch for the observer being computed, nearest first
+
+    u32 m_count = 0;
+    u32 m_observers = 0;
+    u32 m_humanSlot = 0;
+    u32 m_ballSlot = 0;
+    u32 m_tick = ~0u;
+    bool m_simdEnabled = true;
+};
+
+}
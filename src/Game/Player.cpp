@@ -1,6 +1,7 @@
 // Player.cpp
 // Human player movement, dribbling, and kick mechanics.
 #include "Player.hpp"
+#include "Math/FastMath.hpp"
 #include <cmath>
 #include <algorithm>
 #include <cstdlib>
@@ -32,7 +33,9 @@ bool Player::tryKick(Ball& ball, bool sprinting, f32 spinY) {
     }
 
     // Kick in facing direction with slight upward angle
-    Vec3 kickDir(-std::sin(m_rotation), 0.3f, -std::cos(m_rotation));
+    f32 facingSin, facingCos;
+    FastMath::sinCos(m_rotation, facingSin, facingCos);
+    Vec3 kickDir(-facingSin, 0.3f, -facingCos);
     kickDir = glm::normalize(kickDir);
 
     f32 kickPower = sprinting ? 22.0f : 15.0f;
@@ -40,18 +43,24 @@ bool Player::tryKick(Ball& ball, bool sprinting, f32 spinY) {
 
     ball.kick(kickDir, kickPower, spinY, spinX);
 
+    ContactEvent event;
+    event.team = TEAM;
+    event.playerIndex = -1;
+    event.point = ball.getPosition();
+    event.impactSpeed = kickPower;
+    ball.recordContact(event);
+
     m_isKicking = true;
     m_kickAnimationTimer = 0.3f;
 
     return true;
 }
 
-void Player::handleBallCollision(Ball& ball, f32 deltaTime) {
+bool Player::handleBallCollision(Ball& ball, f32 deltaTime) {
     Vec3 toBall = ball.getPosition() - m_position;
     toBall.y = 0;
     f32 distToBall = glm::length(toBall);
 
-    f32 minDist = RADIUS + Ball::RADIUS;
     bool ballOnGround = ball.getPosition().y <= Ball::RADIUS + 0.1f;
 
     // Dribbling: guide ball while moving
@@ -59,18 +68,20 @@ void Player::handleBallCollision(Ball& ball, f32 deltaTime) {
         dribble(ball, deltaTime);
     }
 
-    // Hard collision: prevent walking through ball
-    if (distToBall < minDist && distToBall > 0.01f) {
-        Vec3 pushDir = glm::normalize(toBall);
-        ball.state().position.x = m_position.x + pushDir.x * minDist;
-        ball.state().position.z = m_position.z + pushDir.z * minDist;
-
-        // Transfer some momentum
-        if (getSpeed() > 0.5f) {
-            ball.state().velocity.x += pushDir.x * getSpeed() * 0.3f;
-            ball.state().velocity.z += pushDir.z * getSpeed() * 0.3f;
-        }
+    // Hard collision against the full body (feet, chest, head)
+    BallContact contact;
+    if (!BodyCollision::sphereVsCapsule(ball.getPosition(), Ball::RADIUS, getCapsule(), contact)) {
+        return false;
     }
+
+    ContactEvent event;
+    event.team = TEAM;
+    event.playerIndex = -1;
+    event.point = contact.point;
+    event.normal = contact.normal;
+    event.impactSpeed = BodyCollision::resolveBallContact(ball.state(), contact, m_velocity);
+    ball.recordContact(event);
+    return true;
 }
 
 void Player::updateMovement(f32 deltaTime) {
@@ -113,7 +124,7 @@ void Player::updateRotation(f32 deltaTime) {
     while (rotationDiff < -3.14159f) rotationDiff += 6.28318f;
 
     // Smooth rotation using exponential decay (frame-rate independent)
-    f32 t = 1.0f - std::exp(-ROTATION_SPEED * deltaTime);
+    f32 t = 1.0f - FastMath::exp(-ROTATION_SPEED * deltaTime);
     m_rotation += rotationDiff * t;
 
     // Keep rotation in valid range
@@ -145,7 +156,9 @@ void Player::dribble(Ball& ball, f32 deltaTime) {
     toBall.y = 0;
 
     // Calculate ideal ball position: slightly in front of player
-    Vec3 playerForward(-std::sin(m_rotation), 0.0f, -std::cos(m_rotation));
+    f32 facingSin, facingCos;
+    FastMath::sinCos(m_rotation, facingSin, facingCos);
+    Vec3 playerForward(-facingSin, 0.0f, -facingCos);
     Vec3 idealBallPos = m_position + playerForward * 0.8f;
     idealBallPos.y = Ball::RADIUS;
 
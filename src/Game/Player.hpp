@@ -18,6 +18,7 @@ public:
     static constexpr f32 RADIUS = 0.3f;          // Collision radius
     static constexpr f32 KICK_RANGE = 1.5f;
     static constexpr f32 DRIBBLE_RANGE = 1.2f;
+    static constexpr i32 TEAM = 1;               // Human plays for blue
 
     Player();
 
@@ -29,7 +30,7 @@ public:
 
     // Ball interaction
     bool tryKick(Ball& ball, bool sprinting, f32 spinY);
-    void handleBallCollision(Ball& ball, f32 deltaTime);
+    bool handleBallCollision(Ball& ball, f32 deltaTime);  // True if the body touched the ball
 
     // Getters
     const Vec3& getPosition() const { return m_position; }
@@ -38,6 +39,7 @@ public:
     f32 getSpeed() const { return glm::length(m_velocity); }
     f32 getAnimationTime() const { return m_animationTime; }
     bool isKicking() const { return m_isKicking; }
+    Capsule getCapsule() const { return {m_position, RADIUS, BodyCollision::BODY_HEIGHT}; }
     f32 getKickTimer() const { return m_kickAnimationTimer; }
 
     void setPosition(const Vec3& pos) { m_position = pos; }
@@ -0,0 +1,425 @@
+// Replay.cpp
+// Quantized record encoding, keyframe and event index, and seeking.
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Sports {
+
+namespace {
+
+enum RecordTag : u8 { KEYFRAME_RECORD = 1, DELTA_RECORD = 2 };
+
+// Per body: x, y, z, yaw, pitch, bob. Lengths in millimetres; angles in
+// 1e-4 rad, wrapped so a delta never spans more than half a turn.
+constexpr u32 CHANNELS_PER_BODY = 6;
+constexpr f64 LENGTH_SCALE = 1000.0;
+constexpr f64 ANGLE_SCALE = 10000.0;
+constexpr i64 ANGLE_PERIOD = 62832;  // 2 pi in angle units, rounded
+constexpr size_t MATCH_BYTES = 4;    // Celebration alpha, scoring team, both scores
+
+bool isAngle(u32 channel) {
+    u32 slot = channel % CHANNELS_PER_BODY;
+    return slot == 3 || slot == 4;
+}
+
+i64 wrapAngle(i64 value) {
+    value %= ANGLE_PERIOD;
+    if (value >= ANGLE_PERIOD / 2) value -= ANGLE_PERIOD;
+    if (value < -ANGLE_PERIOD / 2) value += ANGLE_PERIOD;
+    return value;
+}
+
+i32 quantize(f32 value, bool angle) {
+    if (!std::isfinite(value)) {
+        return 0;  // The flight recorder reports these; a replay just shows the origin
+    }
+    if (angle) {
+        return static_cast<i32>(wrapAngle(std::llround(std::fmod(static_cast<f64>(value), 2.0 * 3.14159265358979) * ANGLE_SCALE)));
+    }
+    f64 scaled = std::round(static_cast<f64>(value) * LENGTH_SCALE);
+    scaled = std::clamp(scaled, static_cast<f64>(std::numeric_limits<i32>::min()),
+                        static_cast<f64>(std::numeric_limits<i32>::max()));
+    return static_cast<i32>(scaled);
+}
+
+f32 dequantize(i32 value, bool angle) {
+    return static_cast<f32>(value / (angle ? ANGLE_SCALE : LENGTH_SCALE));
+}
+
+size_t channelCount(u32 playerCount) {
+    return (static_cast<size_t>(playerCount) + 1) * CHANNELS_PER_BODY;
+}
+
+size_t recordSize(u8 tag, size_t channels) {
+    return 1 + MATCH_BYTES + channels * (tag == KEYFRAME_RECORD ? sizeof(i32) : sizeof(i16));
+}
+
+void poseToValues(const BodyPose& pose, i32* out) {
+    const f32 source[CHANNELS_PER_BODY] = {pose.position.x, pose.position.y, pose.position.z,
+                                           pose.yaw, pose.pitch, pose.bob};
+    for (u32 i = 0; i < CHANNELS_PER_BODY; i++) {
+        out[i] = quantize(source[i], isAngle(i));
+    }
+}
+
+BodyPose valuesToPose(const i32* values) {
+    BodyPose pose;
+    pose.position = Vec3(dequantize(values[0], false), dequantize(values[1], false), dequantize(values[2], false));
+    pose.yaw = dequantize(values[3], true);
+    pose.pitch = dequantize(values[4], true);
+    pose.bob = dequantize(values[5], false);
+    return pose;
+}
+
+u64 fileSize(std::FILE* file) {
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    return size < 0 ? 0 : static_cast<u64>(size);
+}
+
+}
+
+std::vector<TickRange> splitAtKeyframes(std::span<const ReplayKeyframe> keyframes, u64 endTick, u32 count) {
+    std::vector<TickRange> ranges;
+    if (keyframes.empty() || count == 0 || keyframes.front().tick >= endTick) {
+        return ranges;
+    }
+
+    u64 begin = keyframes.front().tick;
+    u64 total = endTick - begin;
+    u64 start = begin;
+    auto byTick = [](const ReplayKeyframe& keyframe, u64 tick) { return keyframe.tick < tick; };
+    for (u32 i = 1; i < count; i++) {
+        u64 ideal = begin + total * i / count;
+        // The keyframe nearest the ideal cut (the earlier on a tie), strictly inside what is left
+        auto after = std::lower_bound(keyframes.begin(), keyframes.end(), ideal, byTick);
+        u64 best = 0;
+        for (auto it : {after == keyframes.begin() ? keyframes.end() : after - 1, after}) {
+            if (it == keyframes.end() || it->tick <= start || it->tick >= endTick) continue;
+            u64 distance = it->tick > ideal ? it->tick - ideal : ideal - it->tick;
+            u64 bestDistance = best > ideal ? best - ideal : ideal - best;
+            if (best == 0 || distance < bestDistance) best = it->tick;
+        }
+        if (best == 0) continue;
+        ranges.push_back({start, best});
+        start = best;
+    }
+    ranges.push_back({start, endTick});
+    return ranges;
+}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+bool ReplayWriter::open(const std::string& path, std::span<const ReplayRole> roles, u32 tickRate) {
+    close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        return false;
+    }
+
+    m_header = ReplayHeader{};
+    m_header.tickRate = tickRate;
+    m_header.playerCount = static_cast<u32>(roles.size());
+    m_keyframes.clear();
+    m_events.clear();
+    m_values.assign(channelCount(m_header.playerCount), 0);
+    m_current.assign(m_values.size(), 0);
+    m_sinceKeyframe = 0;
+
+    bool written = std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1 &&
+                   (roles.empty() || std::fwrite(roles.data(), 1, roles.size(), m_file) == roles.size());
+    if (!written) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_offset = sizeof(m_header) + roles.size();
+    return true;
+}
+
+bool ReplayWriter::write(const ReplayFrame& frame) {
+    if (!m_file || frame.players.size() != m_header.playerCount) {
+        return false;
+    }
+
+    poseToValues(frame.ball, m_current.data());
+    for (size_t i = 0; i < frame.players.size(); i++) {
+        poseToValues(frame.players[i], &m_current[(i + 1) * CHANNELS_PER_BODY]);
+    }
+
+    // A delta that doesn't fit 16 bits (a reset ball, a teleported player) starts a keyframe early
+    bool keyframe = m_header.tickCount == 0 || m_sinceKeyframe >= KEYFRAME_INTERVAL;
+    size_t channels = m_current.size();
+    m_record.resize(recordSize(keyframe ? KEYFRAME_RECORD : DELTA_RECORD, channels));
+    if (!keyframe) {
+        u8* out = m_record.data() + 1 + MATCH_BYTES;
+        for (size_t i = 0; i < channels && !keyframe; i++) {
+            i64 delta = static_cast<i64>(m_current[i]) - m_values[i];
+            if (isAngle(static_cast<u32>(i))) {
+                delta = wrapAngle(delta);
+            }
+            if (delta < std::numeric_limits<i16>::min() || delta > std::numeric_limits<i16>::max()) {
+                keyframe = true;
+                break;
+            }
+            i16 packed = static_cast<i16>(delta);
+            std::memcpy(out + i * sizeof(i16), &packed, sizeof(i16));
+        }
+        if (keyframe) {
+            m_record.resize(recordSize(KEYFRAME_RECORD, channels));
+        }
+    }
+    if (keyframe) {
+        std::memcpy(m_record.data() + 1 + MATCH_BYTES, m_current.data(), channels * sizeof(i32));
+    }
+
+    m_record[0] = keyframe ? KEYFRAME_RECORD : DELTA_RECORD;
+    m_record[1] = static_cast<u8>(std::clamp(frame.celebration, 0.0f, 1.0f) * 255.0f + 0.5f);
+    m_record[2] = frame.scoringTeam;
+    m_record[3] = frame.scoreLeft;
+    m_record[4] = frame.scoreRight;
+
+    if (m_header.tickCount == 0) {
+        // The header goes out again now that the first tick is known
+        m_header.firstTick = frame.tick;
+        if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(&m_header, sizeof(m_header), 1, m_file) != 1 ||
+            std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET) != 0) {
+            return false;
+        }
+    }
+    if (std::fwrite(m_record.data(), 1, m_record.size(), m_file) != m_record.size()) {
+        return false;
+    }
+
+    if (keyframe) {
+        m_keyframes.push_back({m_header.firstTick + m_header.tickCount, m_offset});
+        m_sinceKeyframe = 0;
+    }
+    m_offset += m_record.size();
+    m_values.swap(m_current);
+    m_sinceKeyframe++;
+    m_header.tickCount++;
+    return true;
+}
+
+bool ReplayWriter::close() {
+    if (!m_file) {
+        return false;
+    }
+
+    // Aligned so ReplayIndex can use both tables straight from a mapping
+    const u8 padding[8] = {};
+    size_t paddingBytes = static_cast<size_t>((8 - m_offset % 8) % 8);
+    std::stable_sort(m_events.begin(), m_events.end(),
+                     [](const MatchEvent& a, const MatchEvent& b) { return a.tick < b.tick; });
+    m_header.indexOffset = m_offset + paddingBytes;
+    m_header.keyframeCount = static_cast<u32>(m_keyframes.size());
+    m_header.eventOffset = m_header.indexOffset + m_keyframes.size() * sizeof(ReplayKeyframe);
+    m_header.eventCount = static_cast<u32>(m_events.size());
+    bool written = std::fwrite(padding, 1, paddingBytes, m_file) == paddingBytes &&
+                   (m_keyframes.empty() ||
+                    std::fwrite(m_keyframes.data(), sizeof(ReplayKeyframe), m_keyframes.size(), m_file) ==
+                        m_keyframes.size()) &&
+                   (m_events.empty() ||
+                    std::fwrite(m_events.data(), sizeof(MatchEvent), m_events.size(), m_file) == m_events.size()) &&
+                   std::fseek(m_file, 0, SEEK_SET) == 0 &&
+                   std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1;
+    written = std::fclose(m_file) == 0 && written;
+    m_file = nullptr;
+    return written;
+}
+
+bool ReplayIndex::open(const std::string& path) {
+    close();
+    if (!m_file.open(path) || m_file.size() < sizeof(ReplayHeader)) {
+        close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+    u64 size = m_file.size();
+    u64 keyframeBytes = static_cast<u64>(m_header.keyframeCount) * sizeof(ReplayKeyframe);
+    u64 eventBytes = static_cast<u64>(m_header.eventCount) * sizeof(MatchEvent);
+    // Only closed replays have tables; an unclosed one is playable but not searchable
+    bool valid = std::memcmp(m_header.magic, "SRPL", 4) == 0 && m_header.version == ReplayHeader::VERSION &&
+                 m_header.indexOffset != 0 && m_header.indexOffset % 8 == 0 && m_header.eventOffset % 8 == 0 &&
+                 m_header.indexOffset >= sizeof(m_header) + m_header.playerCount &&
+                 m_header.indexOffset + keyframeBytes <= size && m_header.eventOffset + eventBytes <= size;
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    // The mapping is page aligned and both offsets are multiples of 8
+    m_keyframes = {reinterpret_cast<const ReplayKeyframe*>(m_file.data() + m_header.indexOffset),
+                   m_header.keyframeCount};
+    m_events = {reinterpret_cast<const MatchEvent*>(m_file.data() + m_header.eventOffset), m_header.eventCount};
+    return true;
+}
+
+void ReplayIndex::close() {
+    m_file.close();
+    m_header = ReplayHeader{};
+    m_keyframes = {};
+    m_events = {};
+}
+
+ReplayReader::~ReplayReader() {
+    close();
+}
+
+bool ReplayReader::open(const std::string& path) {
+    close();
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) {
+        return false;
+    }
+
+    u64 size = fileSize(m_file);
+    std::fseek(m_file, 0, SEEK_SET);
+    bool valid = std::fread(&m_header, sizeof(m_header), 1, m_file) == 1 &&
+                 std::memcmp(m_header.magic, "SRPL", 4) == 0 && m_header.version == ReplayHeader::VERSION &&
+                 sizeof(m_header) + static_cast<u64>(m_header.playerCount) <= size;
+    if (valid) {
+        m_roles.resize(m_header.playerCount);
+        valid = m_roles.empty() || std::fread(m_roles.data(), 1, m_roles.size(), m_file) == m_roles.size();
+        for (ReplayRole role : m_roles) {
+            valid = valid && role <= ReplayRole::Human;
+        }
+    }
+
+    u64 recordsStart = sizeof(m_header) + m_header.playerCount;
+    if (valid && m_header.indexOffset != 0) {
+        u64 indexBytes = static_cast<u64>(m_header.keyframeCount) * sizeof(ReplayKeyframe);
+        valid = m_header.indexOffset >= recordsStart && m_header.indexOffset + indexBytes <= size;
+        if (valid) {
+            m_keyframes.resize(m_header.keyframeCount);
+            std::fseek(m_file, static_cast<long>(m_header.indexOffset), SEEK_SET);
+            valid = m_keyframes.empty() ||
+                    std::fread(m_keyframes.data(), sizeof(ReplayKeyframe), m_keyframes.size(), m_file) ==
+                        m_keyframes.size();
+        }
+    } else if (valid) {
+        valid = scanKeyframes(recordsStart);  // Recording was cut off before close()
+    }
+    if (!valid || m_keyframes.empty() || m_keyframes.front().tick != m_header.firstTick) {
+        close();
+        return false;
+    }
+
+    m_values.assign(channelCount(m_header.playerCount), 0);
+    m_nextTick = m_header.firstTick;
+    m_positioned = false;
+    return true;
+}
+
+bool ReplayReader::scanKeyframes(u64 recordsStart) {
+    size_t channels = channelCount(m_header.playerCount);
+    u64 offset = recordsStart;
+    u64 tick = m_header.firstTick;
+    m_keyframes.clear();
+    std::fseek(m_file, static_cast<long>(offset), SEEK_SET);
+    for (int tag = std::fgetc(m_file); tag == KEYFRAME_RECORD || tag == DELTA_RECORD; tag = std::fgetc(m_file)) {
+        size_t rest = recordSize(static_cast<u8>(tag), channels) - 1;
+        m_record.resize(rest);
+        if (std::fread(m_record.data(), 1, rest, m_file) != rest) {
+            break;  // Torn last record
+        }
+        if (tag == KEYFRAME_RECORD) {
+            m_keyframes.push_back({tick, offset});
+        }
+        offset += rest + 1;
+        tick++;
+    }
+    m_header.tickCount = tick - m_header.firstTick;
+    m_header.keyframeCount = static_cast<u32>(m_keyframes.size());
+    return true;
+}
+
+void ReplayReader::close() {
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_header = ReplayHeader{};
+    m_roles.clear();
+    m_keyframes.clear();
+}
+
+bool ReplayReader::seek(u64 tick) {
+    if (!m_file || tick < getFirstTick() || tick >= getEndTick()) {
+        return false;
+    }
+
+    auto after = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), tick,
+                                  [](u64 value, const ReplayKeyframe& keyframe) { return value < keyframe.tick; });
+    const ReplayKeyframe& keyframe = *(after - 1);  // The first keyframe is the first tick
+    if (std::fseek(m_file, static_cast<long>(keyframe.offset), SEEK_SET) != 0) {
+        return false;
+    }
+    m_nextTick = keyframe.tick;
+    m_positioned = true;
+    while (m_nextTick < tick) {
+        if (!decodeNext()) {
+            m_positioned = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReplayReader::read(ReplayFrame& frame) {
+    if (!m_positioned && !seek(m_nextTick)) {
+        return false;
+    }
+    if (m_nextTick >= getEndTick() || !decodeNext()) {
+        return false;
+    }
+
+    frame.tick = m_nextTick - 1;
+    frame.ball = valuesToPose(m_values.data());
+    frame.players.resize(m_header.playerCount);
+    for (u32 i = 0; i < m_header.playerCount; i++) {
+        frame.players[i] = valuesToPose(&m_values[(static_cast<size_t>(i) + 1) * CHANNELS_PER_BODY]);
+    }
+    frame.celebration = m_record[1] / 255.0f;
+    frame.scoringTeam = m_record[2];
+    frame.scoreLeft = m_record[3];
+    frame.scoreRight = m_record[4];
+    return true;
+}
+
+bool ReplayReader::decodeNext() {
+    int tag = std::fgetc(m_file);
+    if (tag != KEYFRAME_RECORD && tag != DELTA_RECORD) {
+        return false;
+    }
+    size_t channels = m_values.size();
+    m_record.resize(recordSize(static_cast<u8>(tag), channels));
+    m_record[0] = static_cast<u8>(tag);
+    if (std::fread(m_record.data() + 1, 1, m_record.size() - 1, m_file) != m_record.size() - 1) {
+        return false;
+    }
+
+    const u8* payload = m_record.data() + 1 + MATCH_BYTES;
+    if (tag == KEYFRAME_RECORD) {
+        std::memcpy(m_values.data(), payload, channels * sizeof(i32));
+    } else {
+        for (size_t i = 0; i < channels; i++) {
+            i16 delta;
+            std::memcpy(&delta, payload + i * sizeof(i16), sizeof(i16));
+            i64 value = static_cast<i64>(m_values[i]) + delta;
+            m_values[i] = static_cast<i32>(isAngle(static_cast<u32>(i)) ? wrapAngle(value) : value);
+        }
+    }
+    m_nextTick++;
+    return true;
+}
+
+}
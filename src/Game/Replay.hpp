@@ -0,0 +1,179 @@
+// Replay.hpp
+// Recorded matches as drawn: every body's pose each tick, delta-coded between keyframes.
+#pragma once
+
+#include "Core/MappedFile.hpp"
+#include "Core/Types.hpp"
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+// One body where the renderer puts it
+struct BodyPose {
+    Vec3 position{0.0f};
+    f32 yaw = 0.0f;
+    f32 pitch = 0.0f;  // Players: running and kick lean; ball: roll angle
+    f32 bob = 0.0f;    // Players: running bounce above standing height
+};
+
+// How each recorded player is drawn
+enum class ReplayRole : u8 { TeamRed, TeamBlue, Human };
+
+// One tick of a replay
+struct ReplayFrame {
+    u64 tick = 0;
+    BodyPose ball;
+    std::vector<BodyPose> players;  // One per role, in header order
+    f32 celebration = 0.0f;         // Goal overlay alpha, 0 outside a celebration
+    u8 scoringTeam = 0;
+    u8 scoreLeft = 0;
+    u8 scoreRight = 0;
+};
+
+enum class MatchEventType : u8 { Goal, Shot, NearMiss, LongPass, FastBall };
+
+// A moment worth a highlight, found while the match was recorded
+struct MatchEvent {
+    u64 tick = 0;
+    f32 value = 0.0f;  // Ball speed in m/s (goal, shot, fast ball), metres off the frame (near miss), pass length
+    MatchEventType type = MatchEventType::Goal;
+    u8 team = NO_TEAM;  // Scorer's, shooter's or passer's team
+    u16 reserved = 0;
+
+    static constexpr u8 NO_TEAM = 0xFF;
+};
+static_assert(sizeof(MatchEvent) == 16, "MatchEvent layout is part of the file format");
+
+// On-disk layout: header, one ReplayRole byte per player, one record per tick,
+// then (8-byte aligned) the keyframe index and the event table sorted by tick.
+// A keyframe record holds every value; a delta record holds the change since
+// the tick before, so decoding any tick starts at a keyframe.
+struct ReplayHeader {
+    // 2 added the event table and grew the header to 64 bytes; version 1 files are refused
+    static constexpr u32 VERSION = 2;
+
+    char magic[4] = {'S', 'R', 'P', 'L'};
+    u32 version = VERSION;
+    u32 tickRate = 60;
+    u32 playerCount = 0;
+    u64 firstTick = 0;
+    u64 tickCount = 0;
+    u64 indexOffset = 0;   // ReplayKeyframe[keyframeCount]; 0 until the writer closes
+    u32 keyframeCount = 0;
+    u32 eventCount = 0;
+    u64 eventOffset = 0;   // MatchEvent[eventCount]
+    u64 reserved = 0;
+};
+static_assert(sizeof(ReplayHeader) == 64, "ReplayHeader layout is part of the file format");
+
+struct ReplayKeyframe {
+    u64 tick = 0;
+    u64 offset = 0;  // Of its record, from the start of the file
+};
+static_assert(sizeof(ReplayKeyframe) == 16, "ReplayKeyframe layout is part of the file format");
+
+// Ticks [begin, end)
+struct TickRange {
+    u64 begin = 0;
+    u64 end = 0;
+};
+
+// Up to `count` contiguous ranges covering [first keyframe, endTick), each starting
+// on a keyframe and as close to equal length as the keyframes allow
+std::vector<TickRange> splitAtKeyframes(std::span<const ReplayKeyframe> keyframes, u64 endTick, u32 count);
+
+class ReplayWriter {
+public:
+    static constexpr u32 KEYFRAME_INTERVAL = 300;  // Ticks (5 s at 60 Hz); also the finest split
+
+    ReplayWriter() = default;
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    bool open(const std::string& path, std::span<const ReplayRole> roles, u32 tickRate);
+    // Frames are stored as consecutive ticks from the first one's; the player count must match
+    bool write(const ReplayFrame& frame);
+    void addEvent(const MatchEvent& event) { m_events.push_back(event); }  // Any order
+    // Appends the keyframe index and events. A replay that was never closed still
+    // plays, by scanning, but has no events.
+    bool close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    u64 getTickCount() const { return m_header.tickCount; }
+    size_t getEventCount() const { return m_events.size(); }
+
+private:
+    std::FILE* m_file = nullptr;
+    ReplayHeader m_header;
+    u64 m_offset = 0;
+    u32 m_sinceKeyframe = 0;
+    std::vector<i32> m_values;    // Last tick as quantized, which the decoder will also hold
+    std::vector<i32> m_current;
+    std::vector<u8> m_record;
+    std::vector<ReplayKeyframe> m_keyframes;
+    std::vector<MatchEvent> m_events;
+};
+
+// Header, keyframes and events of a closed replay read in place from a memory
+// mapping. No tick is decoded, so querying thousands of replays touches only the
+// first page and the tail of each.
+class ReplayIndex {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    const ReplayHeader& getHeader() const { return m_header; }
+    std::span<const ReplayKeyframe> getKeyframes() const { return m_keyframes; }
+    std::span<const MatchEvent> getEvents() const { return m_events; }
+
+private:
+    MappedFile m_file;
+    ReplayHeader m_header;
+    std::span<const ReplayKeyframe> m_keyframes;
+    std::span<const MatchEvent> m_events;
+};
+
+class ReplayReader {
+public:
+    ReplayReader() = default;
+    ~ReplayReader();
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    const ReplayHeader& getHeader() const { return m_header; }
+    std::span<const ReplayRole> getRoles() const { return m_roles; }
+    std::span<const ReplayKeyframe> getKeyframes() const { return m_keyframes; }
+    u64 getFirstTick() const { return m_header.firstTick; }
+    u64 getEndTick() const { return m_header.firstTick + m_header.tickCount; }
+
+    // Decodes forward from the keyframe at or before `tick`; read() then returns `tick`
+    bool seek(u64 tick);
+    // The next tick; false at the end or on a damaged record
+    bool read(ReplayFrame& frame);
+
+private:
+    bool decodeNext();
+    bool scanKeyframes(u64 recordsStart);
+
+    std::FILE* m_file = nullptr;
+    ReplayHeader m_header;
+    std::vector<ReplayRole> m_roles;
+    std::vector<ReplayKeyframe> m_keyframes;
+    std::vector<i32> m_values;
+    std::vector<u8> m_record;
+    u64 m_nextTick = 0;
+    bool m_positioned = false;  // m_values holds the tick before m_nextTick
+};
+
+}
@@ -0,0 +1,61 @@
+// ReplayCapture.cpp
+// Running bob and lean as the player animations show them.
+#include "ReplayCapture.hpp"
+#include "AIPlayer.hpp"
+#include "Ball.hpp"
+#include "Match.hpp"
+#include "Player.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sports {
+
+BodyPose ReplayCapture::ball(const Ball& ball) {
+    return {ball.getPosition(), 0.0f, ball.getRotationAngle(), 0.0f};
+}
+
+BodyPose ReplayCapture::aiPlayer(const AIPlayer& ai) {
+    BodyPose pose{ai.getPosition(), ai.getRotation(), 0.0f, 0.0f};
+    f32 speed = glm::length(ai.getVelocity());
+    if (speed > 0.5f) {
+        pose.bob = std::sin(ai.getAnimTime() * 2.0f) * 0.05f * std::min(speed / 7.0f, 1.0f);
+        pose.pitch = std::min(speed / 12.0f, 0.15f);
+    }
+    return pose;
+}
+
+BodyPose ReplayCapture::human(const Player& player) {
+    BodyPose pose{player.getPosition(), player.getRotation(), 0.0f, 0.0f};
+    f32 speed = player.getSpeed();
+    if (speed > 0.5f) {
+        pose.bob = std::sin(player.getAnimationTime() * 2.0f) * 0.05f * std::min(speed / 8.0f, 1.0f);
+        pose.pitch = std::min(speed / 15.0f, 0.15f);
+    }
+    if (player.isKicking()) {
+        f32 kickProgress = player.getKickTimer() / 0.3f;
+        pose.pitch += std::sin(kickProgress * 3.14159f) * 0.3f;
+    }
+    return pose;
+}
+
+BodyPose ReplayCapture::standing(const Vec3& position) {
+    return {position, 0.0f, 0.0f, 0.0f};
+}
+
+void ReplayCapture::roles(const std::vector<AIPlayer>& aiPlayers, std::vector<ReplayRole>& out) {
+    out.clear();
+    for (const AIPlayer& ai : aiPlayers) {
+        out.push_back(ai.getTeam() == 0 ? ReplayRole::TeamRed : ReplayRole::TeamBlue);
+    }
+    out.push_back(ReplayRole::Human);
+}
+
+void ReplayCapture::match(const Match& match, ReplayFrame& frame) {
+    frame.celebration = match.isGoalScored() ? match.getCelebrationAlpha() : 0.0f;
+    frame.scoringTeam = static_cast<u8>(match.getLastScoringTeam());
+    frame.scoreLeft = static_cast<u8>(match.getScoreLeft());
+    frame.scoreRight = static_cast<u8>(match.getScoreRight());
+}
+
+}
@@ -0,0 +1,29 @@
+// ReplayCapture.hpp
+// Live game objects to replay frames, posed the way the renderer animates them.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Replay.hpp"
+#include <vector>
+
+namespace Sports {
+
+class AIPlayer;
+class Ball;
+class Match;
+class Player;
+
+// Static utility class shared by the game loop and headless recording
+class ReplayCapture {
+public:
+    static BodyPose ball(const Ball& ball);
+    static BodyPose aiPlayer(const AIPlayer& ai);
+    static BodyPose human(const Player& player);
+    static BodyPose standing(const Vec3& position);  // A body that never moves (the headless human)
+
+    // AI players in team order, then the human
+    static void roles(const std::vector<AIPlayer>& aiPlayers, std::vector<ReplayRole>& out);
+    static void match(const Match& match, ReplayFrame& frame);  // Scores and celebration
+};
+
+}
@@ -0,0 +1,167 @@
+// Rules.cpp
+// Restart awards, restart spots, and offside judged at the moment of each pass.
+#include "Rules.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Sports {
+
+void OffsideLines::rebuild(const std::vector<i32>& teams) {
+    m_order[0].clear();
+    m_order[1].clear();
+    for (size_t i = 0; i < teams.size(); i++) {
+        m_order[teams[i] & 1].push_back(static_cast<u32>(i));
+    }
+}
+
+void OffsideLines::refresh(const std::vector<Vec3>& positions, const std::vector<i32>& teams) {
+    // Roster changes (setup, snapshot restore) rebuild the order; otherwise it is reused
+    if (m_order[0].size() + m_order[1].size() != teams.size()) {
+        rebuild(teams);
+    }
+
+    m_x.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        m_x[i] = positions[i].x;
+    }
+
+    m_lastShifts = 0;
+    for (auto& order : m_order) {
+        // Insertion sort: linear when the previous order still (nearly) holds
+        for (size_t i = 1; i < order.size(); i++) {
+            u32 slot = order[i];
+            f32 x = m_x[slot];
+            size_t j = i;
+            while (j > 0 && m_x[order[j - 1]] > x) {
+                order[j] = order[j - 1];
+                j--;
+                m_lastShifts++;
+            }
+            order[j] = slot;
+        }
+    }
+
+    // Team 0 defends -X (second-smallest x), team 1 defends +X (second-largest x)
+    const auto& red = m_order[0];
+    const auto& blue = m_order[1];
+    m_lineX[0] = red.size() >= 2 ? m_x[red[1]] : -m_halfLength;
+    m_lineX[1] = blue.size() >= 2 ? m_x[blue[blue.size() - 2]] : m_halfLength;
+}
+
+void RulesEngine::setFieldDimensions(f32 fieldLength, f32 fieldWidth, f32 goalWidth, f32 goalHeight) {
+    m_halfLength = fieldLength / 2.0f;
+    m_halfWidth = fieldWidth / 2.0f;
+    m_goalHalfWidth = goalWidth / 2.0f;
+    m_goalHeight = goalHeight;
+    m_lines.setFieldLength(fieldLength);
+}
+
+void RulesEngine::reset() {
+    m_restart = Restart{};
+    m_lastTouchTeam = -1;
+    m_lastTouchSlot = -1;
+    m_offsideMask = 0;
+    m_restartTaken = true;
+}
+
+bool RulesEngine::onBoundary(BallState& ball) {
+    // The pitch walls stop the ball one radius inside the lines, so reaching them is out of play
+    f32 radius = BallPhysics::BALL_RADIUS;
+    const Vec3& pos = ball.position;
+
+    bool inGoalMouth = std::abs(pos.z) < m_goalHalfWidth && pos.y < m_goalHeight;
+    bool overGoalLine = std::abs(pos.x) > m_halfLength - radius && !inGoalMouth;
+    bool overTouchline = std::abs(pos.z) > m_halfWidth - radius;
+
+    if (!overGoalLine && !overTouchline) {
+        return false;
+    }
+
+    f32 sideX = std::copysign(1.0f, pos.x);
+    f32 sideZ = std::copysign(1.0f, pos.z);
+    f32 edge = 2.0f * radius;  // Spots sit just inside the walls so a nudge doesn't re-trigger
+
+    if (overGoalLine) {
+        // Team 1 defends +X, team 0 defends -X
+        i32 defending = sideX > 0.0f ? 1 : 0;
+        if (m_lastTouchTeam == defending) {
+            Vec3 corner(sideX * (m_halfLength - edge), radius, sideZ * (m_halfWidth - edge));
+            award(RestartType::CornerKick, 1 - defending, corner, ball);
+        } else {
+            Vec3 goalKick(sideX * (m_halfLength - GOAL_AREA_LENGTH), radius, 0.0f);
+            award(RestartType::GoalKick, defending, goalKick, ball);
+        }
+    } else {
+        // No touch since kickoff: the team defending that half throws
+        i32 team = m_lastTouchTeam >= 0 ? 1 - m_lastTouchTeam : (sideX > 0.0f ? 1 : 0);
+        f32 x = std::clamp(pos.x, -m_halfLength + edge, m_halfLength - edge);
+        award(RestartType::ThrowIn, team, Vec3(x, radius, sideZ * (m_halfWidth - edge)), ball);
+    }
+    return true;
+}
+
+bool RulesEngine::onTouches(const std::vector<ContactEvent>& contacts, const std::vector<Vec3>& positions,
+                            const std::vector<i32>& teams, BallState& ball) {
+    size_t aiCount = positions.empty() ? 0 : positions.size() - 1;
+
+    for (const ContactEvent& contact : contacts) {
+        i32 slot = slotOf(contact, aiCount);
+        if (slot < 0 || slot >= static_cast<i32>(positions.size())) continue;
+
+        // Receiving a teammate's pass from an offside position
+        bool fromTeammate = m_lastTouchTeam == contact.team && m_lastTouchSlot != slot;
+        bool flagged = slot < 64 && (m_offsideMask >> slot) & 1ull;
+        if (fromTeammate && flagged) {
+            award(RestartType::IndirectFreeKick, 1 - contact.team,
+                  Vec3(positions[slot].x, BallPhysics::BALL_RADIUS, positions[slot].z), ball);
+            return true;
+        }
+
+        m_lastTouchTeam = contact.team;
+        m_lastTouchSlot = slot;
+
+        // No offside straight from a throw-in, corner, or goal kick
+        if (!m_restartTaken) {
+            m_restartTaken = true;
+            m_offsideMask = 0;
+            continue;
+        }
+
+        m_lines.refresh(positions, teams);
+        markOffsidePositions(contact.team, slot, ball.position.x, positions, teams);
+    }
+    return false;
+}
+
+void RulesEngine::markOffsidePositions(i32 attackingTeam, i32 passerSlot, f32 ballX,
+                                       const std::vector<Vec3>& positions, const std::vector<i32>& teams) {
+    // Attackers ahead of both the ball and the second-last defender, in the opponents' half
+    f32 dir = attackingTeam == 0 ? 1.0f : -1.0f;
+    f32 line = dir * m_lines.getLineX(1 - attackingTeam);
+    f32 ball = dir * ballX;
+
+    m_offsideMask = 0;
+    size_t count = std::min<size_t>(positions.size(), 64);
+    for (size_t i = 0; i < count; i++) {
+        if (teams[i] != attackingTeam || static_cast<i32>(i) == passerSlot) continue;
+
+        f32 x = dir * positions[i].x;
+        if (x > 0.0f && x > ball && x > line) {
+            m_offsideMask |= 1ull << i;
+        }
+    }
+}
+
+void RulesEngine::award(RestartType type, i32 team, const Vec3& spot, BallState& ball) {
+    m_restart = {type, team, spot};
+    m_offsideMask = 0;
+    m_lastTouchSlot = -1;
+    m_restartTaken = type == RestartType::IndirectFreeKick;
+
+    // Dead ball on its spot
+    ball.position = spot;
+    ball.velocity = Vec3(0.0f);
+    ball.angularVelocity = Vec3(0.0f);
+}
+
+}
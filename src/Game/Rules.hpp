@@ -0,0 +1,92 @@
+// Rules.hpp
+// Out-of-play restarts and offside, driven by boundary and touch events.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Physics/BallPhysics.hpp"
+#include "Physics/BodyCollision.hpp"
+#include <vector>
+
+namespace Sports {
+
+enum class RestartType : u8 { None, ThrowIn, CornerKick, GoalKick, IndirectFreeKick };
+
+// A dead ball awarded to a team, with the spot it is taken from
+struct Restart {
+    RestartType type = RestartType::None;
+    i32 team = -1;        // Team taking the restart
+    Vec3 spot{0.0f};
+};
+
+// Second-last defender per team, kept in per-team x order between touches.
+// Players move little between touches, so an insertion sort over the previous
+// order is close to O(n) instead of a full sort every time.
+class OffsideLines {
+public:
+    // Slot i has position positions[i] and team teams[i] (0 or 1)
+    void refresh(const std::vector<Vec3>& positions, const std::vector<i32>& teams);
+
+    void setFieldLength(f32 fieldLength) { m_halfLength = fieldLength / 2.0f; }
+
+    // X of the defending team's second-last player (their goal line if they have fewer than two)
+    f32 getLineX(i32 defendingTeam) const { return m_lineX[defendingTeam]; }
+
+    u32 getLastSortShifts() const { return m_lastShifts; }  // Work done by the last refresh
+
+private:
+    void rebuild(const std::vector<i32>& teams);
+
+    std::vector<u32> m_order[2];  // Slots ascending by x
+    std::vector<f32> m_x;
+    f32 m_lineX[2] = {0.0f, 0.0f};
+    f32 m_halfLength = 52.5f;
+    u32 m_lastShifts = 0;
+};
+
+// Referee state machine. Nothing here runs per frame: Match forwards boundary
+// crossings and the ball's contact events, and only those advance the rules.
+class RulesEngine {
+public:
+    static constexpr f32 GOAL_AREA_LENGTH = 5.5f;  // Goal kicks are taken from its edge
+
+    void setFieldDimensions(f32 fieldLength, f32 fieldWidth, f32 goalWidth, f32 goalHeight);
+    void reset();  // Kickoff: no last touch, no offside candidates
+
+    // Ball reached a touchline or goal line outside the goal mouth: awards the restart,
+    // places the ball on its spot and returns true. False if the ball is still in play.
+    bool onBoundary(BallState& ball);
+
+    // Touches in order for this tick. Slots index positions/teams (AI players, then the human).
+    // Returns true if a touch was offside; the free kick is placed like any other restart.
+    bool onTouches(const std::vector<ContactEvent>& contacts, const std::vector<Vec3>& positions,
+                   const std::vector<i32>& teams, BallState& ball);
+
+    const Restart& getLastRestart() const { return m_restart; }
+    i32 getLastTouchTeam() const { return m_lastTouchTeam; }
+    u64 getOffsideCandidates() const { return m_offsideMask; }
+    const OffsideLines& getOffsideLines() const { return m_lines; }
+
+    // Slot of a touch in positions/teams (the human comes after the AI players)
+    static i32 slotOf(const ContactEvent& contact, size_t aiCount) {
+        return contact.playerIndex >= 0 ? contact.playerIndex : static_cast<i32>(aiCount);
+    }
+
+private:
+    void award(RestartType type, i32 team, const Vec3& spot, BallState& ball);
+    void markOffsidePositions(i32 attackingTeam, i32 passerSlot, f32 ballX,
+                              const std::vector<Vec3>& positions, const std::vector<i32>& teams);
+
+    f32 m_halfLength = 52.5f;
+    f32 m_halfWidth = 34.0f;
+    f32 m_goalHalfWidth = 3.66f;
+    f32 m_goalHeight = 2.44f;
+
+    OffsideLines m_lines;
+    Restart m_restart;
+    i32 m_lastTouchTeam = -1;
+    i32 m_lastTouchSlot = -1;
+    u64 m_offsideMask = 0;       // Attackers in an offside position when the ball was last played
+    bool m_restartTaken = true;  // False until the first touch after a restart (no offside from those)
+};
+
+}
@@ -0,0 +1,287 @@
+// SetPiecePlanner.cpp
+// UCT search with virtual loss; rollout batches run in parallel on the job system.
+#include "SetPiecePlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Sports {
+
+SetPiecePlanner::SetPiecePlanner(JobSystem& jobs)
+    : m_jobs(jobs) {
+}
+
+SetPiecePlan SetPiecePlanner::plan(const WorldSnapshot& snapshot, i32 team, i32 takerIndex,
+                                   const PlannerConfig& config) {
+    Timer clock;
+    m_config = config;
+
+    SetPiecePlan result;
+    result.takerIndex = takerIndex;
+    if (takerIndex < 0 || takerIndex >= static_cast<i32>(snapshot.aiPlayers.size())) {
+        return result;
+    }
+
+    f32 attackSign = (team == 0) ? 1.0f : -1.0f;  // Red attacks +X, blue attacks -X
+
+    m_nodes.clear();
+    m_nodes.emplace_back();  // Root
+    buildRunOptions(snapshot, team, takerIndex, attackSign);
+
+    // One rollout per thread per batch; worlds are kept across calls
+    u32 batchSize = m_jobs.getWorkerCount() + 1;
+    if (m_worlds.size() < batchSize) {
+        m_worlds.resize(batchSize);
+    }
+
+    std::vector<u32> leaves(batchSize);
+    std::vector<f32> rewards(batchSize);
+    std::vector<u8> completed(batchSize);
+    f64 batchEstimateMs = 0.0;
+    u32 launched = 0;
+
+    while (result.rollouts < config.maxRollouts) {
+        // Anytime: stop launching work that would not finish inside the budget
+        if (clock.elapsedMillis() + batchEstimateMs >= config.budgetMs) {
+            break;
+        }
+
+        // Select leaves; virtual loss (-1 per in-flight visit) spreads the batch over the tree
+        for (u32 b = 0; b < batchSize; b++) {
+            u32 run = selectChild(0, config.exploration);
+            if (m_nodes[run].childCount == 0) {
+                expandKicks(run, snapshot, team, takerIndex, attackSign);
+            }
+            u32 leaf = selectChild(run, config.exploration);
+            leaves[b] = leaf;
+
+            for (i32 n = static_cast<i32>(leaf); n >= 0; n = m_nodes[n].parent) {
+                m_nodes[n].visits++;
+                m_nodes[n].totalReward -= 1.0f;
+            }
+        }
+
+        f64 batchStart = clock.elapsedMillis();
+        m_jobs.parallelFor(batchSize, [&](u32 b) {
+            // Each thread owns one world, built on first use so its memory stays local to the
+            // worker's pinned L3 domain; the caller takes the slot after the workers
+            u32 worker = JobSystem::currentWorkerIndex();
+            auto& world = m_worlds[worker == JobSystem::NOT_A_WORKER ? batchSize - 1 : worker];
+            if (!world) {
+                world = std::make_unique<HeadlessWorld>();
+            }
+            // Seeded by launch order, not by thread: the same search replays the same rollouts
+            u32 seed = launched + b;
+            completed[b] = rollout(*world, snapshot, m_nodes[leaves[b]].action,
+                                   team, takerIndex, seed, clock, rewards[b]) ? 1 : 0;
+        });
+        f64 batchMs = clock.elapsedMillis() - batchStart;
+        batchEstimateMs = (batchEstimateMs == 0.0) ? batchMs : batchEstimateMs * 0.7 + batchMs * 0.3;
+
+        // Backpropagate; rollouts cut off by the deadline are withdrawn entirely
+        for (u32 b = 0; b < batchSize; b++) {
+            for (i32 n = static_cast<i32>(leaves[b]); n >= 0; n = m_nodes[n].parent) {
+                m_nodes[n].totalReward += 1.0f;
+                if (completed[b]) {
+                    m_nodes[n].totalReward += rewards[b];
+                } else {
+                    m_nodes[n].visits--;
+                }
+            }
+            result.rollouts += completed[b];
+        }
+        launched += batchSize;
+    }
+
+    // Most-visited path is the robust choice
+    auto mostVisited = [&](u32 node) {
+        const Node& parent = m_nodes[node];
+        u32 best = 0;
+        u32 bestVisits = 0;
+        for (u32 i = parent.firstChild; i < parent.firstChild + parent.childCount; i++) {
+            if (m_nodes[i].visits > bestVisits) {
+                bestVisits = m_nodes[i].visits;
+                best = i;
+            }
+        }
+        return best;
+    };
+
+    u32 run = mostVisited(0);
+    if (run == 0 || m_nodes[run].childCount == 0) {
+        return result;
+    }
+    u32 leaf = mostVisited(run);
+    if (leaf == 0) {
+        return result;
+    }
+
+    const Node& chosen = m_nodes[leaf];
+    result.runnerIndex = chosen.action.runner;
+    result.runTarget = chosen.action.runTarget;
+    result.kickDirection = chosen.action.kickDir;
+    result.kickPower = chosen.action.power;
+    result.kickSpin = chosen.action.spin;
+    result.expectedValue = chosen.totalReward / static_cast<f32>(chosen.visits);
+    result.valid = true;
+    return result;
+}
+
+void SetPiecePlanner::buildRunOptions(const WorldSnapshot& snapshot, i32 team, i32 takerIndex,
+                                      f32 attackSign) {
+    f32 maxX = snapshot.bounds.length / 2.0f - 2.0f;
+    f32 maxZ = snapshot.bounds.width / 2.0f - 2.0f;
+
+    m_nodes[0].firstChild = static_cast<u32>(m_nodes.size());
+
+    Node noRun;
+    noRun.parent = 0;
+    m_nodes.push_back(noRun);
+
+    // Forward runs that drift toward the middle
+    for (size_t i = 0; i < snapshot.aiPlayers.size(); i++) {
+        const AIPlayer& ai = snapshot.aiPlayers[i];
+        if (ai.getTeam() != team || ai.isGoalkeeper() || static_cast<i32>(i) == takerIndex) continue;
+
+        Vec3 pos = ai.getPosition();
+        Node run;
+        run.parent = 0;
+        run.action.runner = static_cast<i32>(i);
+        run.action.runTarget = Vec3(std::clamp(pos.x + attackSign * 12.0f, -maxX, maxX), 0.0f,
+                                    std::clamp(pos.z * 0.7f, -maxZ, maxZ));
+        m_nodes.push_back(run);
+    }
+
+    m_nodes[0].childCount = static_cast<u32>(m_nodes.size()) - m_nodes[0].firstChild;
+}
+
+void SetPiecePlanner::expandKicks(u32 runNode, const WorldSnapshot& snapshot, i32 team, i32 takerIndex,
+                                  f32 attackSign) {
+    Action base = m_nodes[runNode].action;
+    Vec3 ballPos = snapshot.ball.position;
+    u32 first = static_cast<u32>(m_nodes.size());
+
+    auto addKick = [&](const Vec3& dir, f32 power, f32 spin) {
+        Node node;
+        node.parent = static_cast<i32>(runNode);
+        node.action = base;
+        node.action.kickDir = dir;
+        node.action.power = power;
+        node.action.spin = spin;
+        m_nodes.push_back(node);
+    };
+
+    // Passes: ground pass to every teammate (the runner's run target, not their current spot),
+    // plus a lofted ball for longer ones
+    const f32 rollDecel = BallPhysics::ROLLING_FRICTION * BallPhysics::GRAVITY;
+    for (size_t i = 0; i < snapshot.aiPlayers.size(); i++) {
+        const AIPlayer& ai = snapshot.aiPlayers[i];
+        if (ai.getTeam() != team || ai.isGoalkeeper() || static_cast<i32>(i) == takerIndex) continue;
+
+        Vec3 target = (static_cast<i32>(i) == base.runner) ? base.runTarget : ai.getPosition();
+        Vec3 flat(target.x - ballPos.x, 0.0f, target.z - ballPos.z);
+        f32 dist = glm::length(flat);
+        if (dist < 1.0f) continue;
+        flat /= dist;
+
+        // Arrive with a little pace: v0 = sqrt(2 a d) plus a margin
+        f32 groundPower = std::clamp(std::sqrt(2.0f * rollDecel * dist) + 3.0f, 6.0f, 20.0f);
+        addKick(Vec3(flat.x, 0.05f, flat.z), groundPower, 0.0f);
+
+        if (dist > 15.0f) {
+            // 35 degree launch, range = v^2 sin(2a) / g, padded for drag
+            const f32 launch = glm::radians(35.0f);
+            f32 loftPower = std::sqrt(dist * BallPhysics::GRAVITY / std::sin(2.0f * launch)) * 1.1f;
+            addKick(Vec3(flat.x * std::cos(launch), std::sin(launch), flat.z * std::cos(launch)),
+                    std::clamp(loftPower, 8.0f, 26.0f), 0.0f);
+        }
+    }
+
+    // Shots: near post, centre, far post, each plain or curled either way
+    f32 goalX = attackSign * snapshot.bounds.length / 2.0f;
+    const f32 aims[3] = {-0.35f, 0.0f, 0.35f};
+    const f32 spins[3] = {0.0f, -8.0f, 8.0f};
+    for (f32 aim : aims) {
+        Vec3 toGoal(goalX - ballPos.x, 0.0f, aim * snapshot.bounds.goalWidth - ballPos.z);
+        f32 dist = glm::length(toGoal);
+        if (dist < 0.01f) continue;
+        toGoal /= dist;
+        for (f32 spin : spins) {
+            addKick(Vec3(toGoal.x, 0.12f, toGoal.z), 22.0f, spin);
+        }
+    }
+
+    m_nodes[runNode].firstChild = first;
+    m_nodes[runNode].childCount = static_cast<u32>(m_nodes.size()) - first;
+}
+
+u32 SetPiecePlanner::selectChild(u32 node, f32 exploration) const {
+    const Node& parent = m_nodes[node];
+    f32 logVisits = std::log(static_cast<f32>(std::max(parent.visits, 1u)));
+
+    u32 best = parent.firstChild;
+    f32 bestScore = -std::numeric_limits<f32>::infinity();
+    for (u32 i = parent.firstChild; i < parent.firstChild + parent.childCount; i++) {
+        const Node& child = m_nodes[i];
+        if (child.visits == 0) {
+            return i;  // Try everything once
+        }
+        f32 visits = static_cast<f32>(child.visits);
+        f32 score = child.totalReward / visits + exploration * std::sqrt(logVisits / visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+bool SetPiecePlanner::rollout(HeadlessWorld& world, const WorldSnapshot& snapshot, const Action& action,
+                              i32 team, i32 takerIndex, u32 seed, const Timer& clock, f32& reward) const {
+    world.restore(snapshot, seed);
+
+    std::vector<AIPlayer>& players = world.getAI().getPlayers();
+    if (action.runner >= 0) {
+        players[action.runner].commandRun(action.runTarget, m_config.runDuration);
+    }
+    players[takerIndex].setPlannedKick(action.kickDir, action.power, action.spin);
+
+    f32 attackSign = (team == 0) ? 1.0f : -1.0f;
+    f32 halfLength = snapshot.bounds.length / 2.0f;
+    u32 steps = static_cast<u32>(m_config.horizon / m_config.rolloutStep);
+
+    for (u32 s = 0; s < steps; s++) {
+        // Abandon rather than overrun the caller's budget
+        if ((s & 7) == 0 && clock.elapsedMillis() >= m_config.budgetMs) {
+            return false;
+        }
+
+        world.step(m_config.rolloutStep);
+
+        if (world.getMatch().isGoalScored()) {
+            reward = (world.getMatch().getLastScoringTeam() == team) ? 1.0f : -1.0f;
+            return true;
+        }
+    }
+
+    // No goal: territory gained plus who is closest to the ball at the end
+    Vec3 ballPos = world.getBall().getPosition();
+    f32 progress = std::clamp(attackSign * (ballPos.x - snapshot.ball.position.x) / halfLength, -1.0f, 1.0f);
+
+    f32 closestDist = std::numeric_limits<f32>::max();
+    i32 closestTeam = team;
+    for (const auto& ai : players) {
+        f32 dist = ai.distanceToBall(ballPos);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closestTeam = ai.getTeam();
+        }
+    }
+    f32 possession = (closestTeam == team) ? 0.2f : -0.2f;
+
+    reward = std::clamp(progress * 0.5f + possession, -1.0f, 1.0f);
+    return true;
+}
+
+}
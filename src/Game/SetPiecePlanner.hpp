@@ -0,0 +1,75 @@
+// SetPiecePlanner.hpp
+// Anytime Monte Carlo tree search over set-piece options using forked headless worlds.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Timer.hpp"
+#include "HeadlessWorld.hpp"
+#include <memory>
+#include <vector>
+
+namespace Sports {
+
+// Best sequence found: an optional teammate run followed by the taker's kick
+struct SetPiecePlan {
+    i32 takerIndex = -1;
+    i32 runnerIndex = -1;        // -1 = no run
+    Vec3 runTarget{0.0f};
+    Vec3 kickDirection{0.0f};
+    f32 kickPower = 0.0f;
+    f32 kickSpin = 0.0f;
+    f32 expectedValue = 0.0f;    // Mean rollout reward in [-1, 1]
+    u32 rollouts = 0;
+    bool valid = false;
+};
+
+struct PlannerConfig {
+    f32 budgetMs = 4.0f;             // Hard wall-clock limit for plan()
+    f32 horizon = 3.0f;              // Simulated seconds per rollout
+    f32 rolloutStep = 1.0f / 30.0f;  // Coarser than the game tick; plenty for scoring
+    f32 exploration = 1.4f;          // UCT exploration constant
+    f32 runDuration = 2.5f;
+    u32 maxRollouts = 100000;
+};
+
+class SetPiecePlanner {
+public:
+    explicit SetPiecePlanner(JobSystem& jobs);
+
+    // Searches until the budget runs out; never returns later than budgetMs
+    SetPiecePlan plan(const WorldSnapshot& snapshot, i32 team, i32 takerIndex,
+                      const PlannerConfig& config = {});
+
+private:
+    struct Action {
+        i32 runner = -1;
+        Vec3 runTarget{0.0f};
+        Vec3 kickDir{0.0f};
+        f32 power = 0.0f;
+        f32 spin = 0.0f;
+    };
+
+    // Depth 1 = run choice, depth 2 = kick choice (leaf)
+    struct Node {
+        i32 parent = -1;
+        u32 firstChild = 0;
+        u32 childCount = 0;
+        u32 visits = 0;
+        f32 totalReward = 0.0f;
+        Action action;
+    };
+
+    void buildRunOptions(const WorldSnapshot& snapshot, i32 team, i32 takerIndex, f32 attackSign);
+    void expandKicks(u32 runNode, const WorldSnapshot& snapshot, i32 team, i32 takerIndex, f32 attackSign);
+    u32 selectChild(u32 node, f32 exploration) const;
+    bool rollout(HeadlessWorld& world, const WorldSnapshot& snapshot, const Action& action,
+                 i32 team, i32 takerIndex, u32 seed, const Timer& clock, f32& reward) const;
+
+    JobSystem& m_jobs;
+    std::vector<Node> m_nodes;
+    std::vector<std::unique_ptr<HeadlessWorld>> m_worlds;  // One per thread (workers, then caller), reused
+    PlannerConfig m_config;
+};
+
+}
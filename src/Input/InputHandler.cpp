@@ -13,6 +13,13 @@ void InputHandler::processEvents(Window& window, Camera& camera) {
     // Reset one-shot flags each frame
     m_resetBallRequested = false;
     m_toggleAIRequested = false;
+    m_dumpTraceRequested = false;
+    m_toggleOcclusionRequested = false;
+    m_toggleFogRequested = false;
+    m_toggleGpuCullingRequested = false;
+    m_toggleDebugViewRequested = false;
+    m_toggleRecordingRequested = false;
+    m_postPassToggle = -1;
 
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
@@ -104,6 +111,37 @@ void InputHandler::handleKeyDown(SDL_Keycode key, Window& window) {
         case SDLK_0:
             m_toggleAIRequested = true;
             break;
+
+        case SDLK_t:
+            m_dumpTraceRequested = true;
+            break;
+
+        case SDLK_o:
+            m_toggleOcclusionRequested = true;
+            break;
+
+        case SDLK_f:
+            m_toggleFogRequested = true;
+            break;
+
+        case SDLK_g:
+            m_toggleGpuCullingRequested = true;
+            break;
+
+        case SDLK_v:
+            m_toggleDebugViewRequested = true;
+            break;
+
+        case SDLK_F1:
+        case SDLK_F2:
+        case SDLK_F3:
+        case SDLK_F4:
+            m_postPassToggle = static_cast<i32>(key - SDLK_F1);
+            break;
+
+        case SDLK_F9:
+            m_toggleRecordingRequested = true;
+            break;
     }
 }
 
@@ -37,6 +37,29 @@ public:
     bool shouldToggleAI() const { return m_toggleAIRequested; }
     void clearToggleAI() { m_toggleAIRequested = false; }
 
+    bool shouldDumpAITrace() const { return m_dumpTraceRequested; }
+    void clearDumpAITrace() { m_dumpTraceRequested = false; }
+
+    bool shouldToggleOcclusion() const { return m_toggleOcclusionRequested; }
+    void clearToggleOcclusion() { m_toggleOcclusionRequested = false; }
+
+    bool shouldToggleFog() const { return m_toggleFogRequested; }
+    void clearToggleFog() { m_toggleFogRequested = false; }
+
+    bool shouldToggleGpuCulling() const { return m_toggleGpuCullingRequested; }
+    void clearToggleGpuCulling() { m_toggleGpuCullingRequested = false; }
+
+    bool shouldToggleDebugView() const { return m_toggleDebugViewRequested; }
+    void clearToggleDebugView() { m_toggleDebugViewRequested = false; }
+
+    bool shouldToggleRecording() const { return m_toggleRecordingRequested; }
+    void clearToggleRecording() { m_toggleRecordingRequested = false; }
+
+    // F1-F4 toggle post passes; index into PostPass
+    bool shouldTogglePostPass() const { return m_postPassToggle >= 0; }
+    u32 getPostPassToggle() const { return static_cast<u32>(m_postPassToggle); }
+    void clearTogglePostPass() { m_postPassToggle = -1; }
+
 private:
     void handleKeyDown(SDL_Keycode key, Window& window);
     void handleMouseMotion(i32 xrel, i32 yrel, Camera& camera);
@@ -47,6 +70,13 @@ private:
     bool m_prevKickPressed = false;
     bool m_resetBallRequested = false;
     bool m_toggleAIRequested = false;
+    bool m_dumpTraceRequested = false;
+    bool m_toggleOcclusionRequested = false;
+    bool m_toggleFogRequested = false;
+    bool m_toggleGpuCullingRequested = false;
+    bool m_toggleDebugViewRequested = false;
+    bool m_toggleRecordingRequested = false;
+    i32 m_postPassToggle = -1;
 };
 
 }
@@ -0,0 +1,201 @@
+// FastMath.hpp
+// Polynomial sin/cos, exp, and atan2, four lanes at a time, with documented error bounds.
+#pragma once
+
+#include "Simd.hpp"
+#include <cmath>
+
+namespace Sports {
+
+// Branch-free approximations for per-entity gameplay math. Build with SPORTS_EXACT_MATH to route
+// every call to libm instead (for validating that behaviour doesn't depend on the approximation).
+// Scalar calls run the same polynomial as lane 0, so batched and one-off results agree bit for bit.
+//
+// Maximum error over the stated range (held to these in FastMathTest):
+//   sinCos  |x| <= 8192     absolute 2.4e-7
+//   exp     [-87, 88]       relative 1.5e-7
+//   atan2   all finite      absolute 1.2e-5 rad
+class FastMath {
+public:
+    static constexpr f32 PI = 3.14159265358979f;
+
+    static void sinCos(Float4 x, Float4& outSin, Float4& outCos);
+    static Float4 exp(Float4 x);
+    static Float4 atan2(Float4 y, Float4 x);
+
+    static void sinCos(f32 x, f32& outSin, f32& outCos);
+    static f32 sin(f32 x);
+    static f32 cos(f32 x);
+    static f32 exp(f32 x);
+    static f32 atan2(f32 y, f32 x);
+
+    // Any count, no alignment needed; outputs may alias the input
+    static void sinCos(const f32* angles, u32 count, f32* outSin, f32* outCos);
+};
+
+#if defined(SPORTS_MATH_SSE) && !defined(SPORTS_EXACT_MATH)
+
+// Cephes sinf/cosf: octant reduction with pi/4 split in three, then degree 7/8 polynomials
+inline void FastMath::sinCos(Float4 x, Float4& outSin, Float4& outCos) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 sinSign = _mm_and_ps(x.v, signMask);
+    __m128 ax = _mm_andnot_ps(signMask, x.v);
+
+    // Octant j (rounded up to even) and its remainder in [-pi/4, pi/4]
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(ax, _mm_set1_ps(1.27323954473516f)));  // 4/pi
+    j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(j);
+
+    __m128 sinFlip = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(
+        _mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 useSinPoly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    sinSign = _mm_xor_ps(sinSign, sinFlip);
+
+    ax = _mm_sub_ps(ax, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+    ax = _mm_sub_ps(ax, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+    ax = _mm_sub_ps(ax, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+    __m128 z = _mm_mul_ps(ax, ax);
+
+    __m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765e-3f));
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827e-2f));
+    cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+    cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+    __m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736e-3f));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611e-1f));
+    sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), ax), ax);
+
+    __m128 s = _mm_or_ps(_mm_and_ps(useSinPoly, sinPoly), _mm_andnot_ps(useSinPoly, cosPoly));
+    __m128 c = _mm_or_ps(_mm_and_ps(useSinPoly, cosPoly), _mm_andnot_ps(useSinPoly, sinPoly));
+    outSin.v = _mm_xor_ps(s, sinSign);
+    outCos.v = _mm_xor_ps(c, cosSign);
+}
+
+// Cephes expf: x = n*ln2 + r, degree 5 polynomial for e^r, 2^n built in the exponent bits
+inline Float4 FastMath::exp(Float4 x) {
+    __m128 v = _mm_min_ps(_mm_max_ps(x.v, _mm_set1_ps(-87.0f)), _mm_set1_ps(88.0f));
+
+    __m128 fx = _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+    __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, fx), _mm_set1_ps(1.0f)));  // Truncation -> floor
+
+    v = _mm_sub_ps(v, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+    v = _mm_add_ps(v, _mm_mul_ps(n, _mm_set1_ps(2.12194440e-4f)));
+    __m128 z = _mm_mul_ps(v, v);
+
+    __m128 p = _mm_set1_ps(1.9875691500e-4f);
+    p = _mm_add_ps(_mm_mul_ps(p, v), _mm_set1_ps(1.3981999507e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, v), _mm_set1_ps(8.3334519073e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, v), _mm_set1_ps(4.1665795894e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, v), _mm_set1_ps(1.6666665459e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, v), _mm_set1_ps(5.0000001201e-1f));
+    p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, z), v), _mm_set1_ps(1.0f));
+
+    __m128i exponent = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+    return {_mm_mul_ps(p, _mm_castsi128_ps(exponent))};
+}
+
+// Octant folding onto [0, 1] and an odd degree 9 polynomial for atan (Abramowitz & Stegun 4.4.49)
+inline Float4 FastMath::atan2(Float4 y, Float4 x) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(signMask, x.v);
+    __m128 ay = _mm_andnot_ps(signMask, y.v);
+
+    __m128 big = _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(1e-30f));  // atan2(0, 0) = 0
+    __m128 a = _mm_div_ps(_mm_min_ps(ax, ay), big);
+    __m128 s = _mm_mul_ps(a, a);
+
+    __m128 r = _mm_set1_ps(0.0208351f);
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.0851330f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.1801410f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.3302995f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.9998660f));
+    r = _mm_mul_ps(r, a);
+
+    __m128 steep = _mm_cmpgt_ps(ay, ax);
+    r = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(PI * 0.5f), r)), _mm_andnot_ps(steep, r));
+    __m128 behind = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x.v), 31));  // Sign bit, so -0 counts
+    r = _mm_or_ps(_mm_and_ps(behind, _mm_sub_ps(_mm_set1_ps(PI), r)), _mm_andnot_ps(behind, r));
+    return {_mm_or_ps(r, _mm_and_ps(y.v, signMask))};
+}
+
+inline void FastMath::sinCos(f32 x, f32& outSin, f32& outCos) {
+    Float4 s, c;
+    sinCos(Float4::splat(x), s, c);
+    outSin = _mm_cvtss_f32(s.v);
+    outCos = _mm_cvtss_f32(c.v);
+}
+
+inline f32 FastMath::exp(f32 x) {
+    return _mm_cvtss_f32(exp(Float4::splat(x)).v);
+}
+
+inline f32 FastMath::atan2(f32 y, f32 x) {
+    return _mm_cvtss_f32(atan2(Float4::splat(y), Float4::splat(x)).v);
+}
+
+#else
+
+// libm per lane: SPORTS_EXACT_MATH builds, and targets without SSE2
+inline void FastMath::sinCos(f32 x, f32& outSin, f32& outCos) {
+    outSin = std::sin(x);
+    outCos = std::cos(x);
+}
+
+inline f32 FastMath::exp(f32 x) { return std::exp(x); }
+inline f32 FastMath::atan2(f32 y, f32 x) { return std::atan2(y, x); }
+
+inline void FastMath::sinCos(Float4 x, Float4& outSin, Float4& outCos) {
+    alignas(16) f32 in[4], s[4], c[4];
+    x.store(in);
+    for (int i = 0; i < 4; i++) sinCos(in[i], s[i], c[i]);
+    outSin = Float4::load(s);
+    outCos = Float4::load(c);
+}
+
+inline Float4 FastMath::exp(Float4 x) {
+    alignas(16) f32 v[4];
+    x.store(v);
+    for (int i = 0; i < 4; i++) v[i] = exp(v[i]);
+    return Float4::load(v);
+}
+
+inline Float4 FastMath::atan2(Float4 y, Float4 x) {
+    alignas(16) f32 vy[4], vx[4];
+    y.store(vy);
+    x.store(vx);
+    for (int i = 0; i < 4; i++) vy[i] = atan2(vy[i], vx[i]);
+    return Float4::load(vy);
+}
+
+#endif
+
+inline f32 FastMath::sin(f32 x) {
+    f32 s, c;
+    sinCos(x, s, c);
+    return s;
+}
+
+inline f32 FastMath::cos(f32 x) {
+    f32 s, c;
+    sinCos(x, s, c);
+    return c;
+}
+
+inline void FastMath::sinCos(const f32* angles, u32 count, f32* outSin, f32* outCos) {
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Float4 s, c;
+        sinCos(Float4::loadUnaligned(angles + i), s, c);
+        s.storeUnaligned(outSin + i);
+        c.storeUnaligned(outCos + i);
+    }
+    for (; i < count; i++) {
+        sinCos(angles[i], outSin[i], outCos[i]);
+    }
+}
+
+}
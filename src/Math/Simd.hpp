@@ -0,0 +1,111 @@
+// Simd.hpp
+// Four-wide float vectors (SSE2 with a scalar fallback) and cache-line aligned storage.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define SPORTS_MATH_SSE 1
+#endif
+
+namespace Sports {
+
+constexpr size_t SIMD_ALIGNMENT = 64;  // One cache line; covers any vector width we load
+
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(SIMD_ALIGNMENT)));
+    }
+    void deallocate(T* pointer, size_t) {
+        ::operator delete(pointer, std::align_val_t(SIMD_ALIGNMENT));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+};
+
+// Lanes of SoA arrays are loaded four at a time straight from these
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Four floats in one register. load/store expect 16-byte aligned addresses; the Unaligned forms don't.
+struct Float4 {
+#ifdef SPORTS_MATH_SSE
+    __m128 v;
+
+    static Float4 load(const f32* p) { return {_mm_load_ps(p)}; }
+    static Float4 loadUnaligned(const f32* p) { return {_mm_loadu_ps(p)}; }
+    static Float4 splat(f32 s) { return {_mm_set1_ps(s)}; }
+    static Float4 zero() { return {_mm_setzero_ps()}; }
+    void store(f32* p) const { _mm_store_ps(p, v); }
+    void storeUnaligned(f32* p) const { _mm_storeu_ps(p, v); }
+#else
+    alignas(16) f32 v[4];
+
+    static Float4 load(const f32* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    static Float4 loadUnaligned(const f32* p) { return load(p); }
+    static Float4 splat(f32 s) { return {{s, s, s, s}}; }
+    static Float4 zero() { return splat(0.0f); }
+    void store(f32* p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+    void storeUnaligned(f32* p) const { store(p); }
+#endif
+};
+
+#ifdef SPORTS_MATH_SSE
+inline Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a) { return {_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+inline Float4 min(Float4 a, Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 max(Float4 a, Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+
+inline f32 horizontalMax(Float4 a) {
+    __m128 m = _mm_max_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+}
+
+// Rows in, columns out: (a,b,c,d) lane i becomes register i
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+}
+#else
+inline Float4 operator+(Float4 a, Float4 b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+inline Float4 operator-(Float4 a) { return {{-a.v[0], -a.v[1], -a.v[2], -a.v[3]}}; }
+inline Float4 min(Float4 a, Float4 b) {
+    return {{std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3])}};
+}
+inline Float4 max(Float4 a, Float4 b) {
+    return {{std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3])}};
+}
+
+inline f32 horizontalMax(Float4 a) {
+    return std::max(std::max(a.v[0], a.v[1]), std::max(a.v[2], a.v[3]));
+}
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    Float4 rows[4] = {a, b, c, d};
+    for (int i = 0; i < 4; i++) {
+        a.v[i] = rows[i].v[0];
+        b.v[i] = rows[i].v[1];
+        c.v[i] = rows[i].v[2];
+        d.v[i] = rows[i].v[3];
+    }
+}
+#endif
+
+}
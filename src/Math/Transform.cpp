@@ -0,0 +1,87 @@
+// Transform.cpp
+// Closed-form translate/yaw/pitch composition, scalar and four-wide.
+#include "Transform.hpp"
+#include "FastMath.hpp"
+
+namespace Sports {
+
+namespace {
+
+// Columns of T * Ry * Rx:
+//   ( cy, 0, -sy)  (sy*sp, cp, cy*sp)  (sy*cp, -sp, cy*cp)  (x, y, z)
+void writeMatrix(f32* m, f32 x, f32 y, f32 z, f32 sy, f32 cy, f32 sp, f32 cp) {
+    m[0] = cy;       m[1] = 0.0f;  m[2] = -sy;      m[3] = 0.0f;
+    m[4] = sy * sp;  m[5] = cp;    m[6] = cy * sp;  m[7] = 0.0f;
+    m[8] = sy * cp;  m[9] = -sp;   m[10] = cy * cp; m[11] = 0.0f;
+    m[12] = x;       m[13] = y;    m[14] = z;       m[15] = 1.0f;
+}
+
+// Lane k of (a,b,c,d) is column `column` of entity k
+void storeColumn(Mat4* out, u32 column, Float4 a, Float4 b, Float4 c, Float4 d) {
+    transpose(a, b, c, d);
+    a.store(&out[0][column][0]);
+    b.store(&out[1][column][0]);
+    c.store(&out[2][column][0]);
+    d.store(&out[3][column][0]);
+}
+
+}
+
+Mat4 Transforms::translateYawPitch(const Vec3& position, f32 yaw, f32 pitch) {
+    f32 sy, cy, sp, cp;
+    FastMath::sinCos(yaw, sy, cy);
+    FastMath::sinCos(pitch, sp, cp);
+    Mat4 result;
+    writeMatrix(&result[0][0], position.x, position.y, position.z, sy, cy, sp, cp);
+    return result;
+}
+
+void Transforms::translateYawPitch(const f32* x, const f32* y, const f32* z,
+                                   const f32* yaw, const f32* pitch, u32 count, Mat4* out) {
+    const Float4 zero = Float4::zero();
+    const Float4 one = Float4::splat(1.0f);
+
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Float4 sy, cy, sp, cp;
+        FastMath::sinCos(Float4::load(yaw + i), sy, cy);
+        FastMath::sinCos(Float4::load(pitch + i), sp, cp);
+
+        storeColumn(out + i, 0, cy, zero, -sy, zero);
+        storeColumn(out + i, 1, sy * sp, cp, cy * sp, zero);
+        storeColumn(out + i, 2, sy * cp, -sp, cy * cp, zero);
+        storeColumn(out + i, 3, Float4::load(x + i), Float4::load(y + i), Float4::load(z + i), one);
+    }
+
+    for (; i < count; i++) {
+        f32 sy, cy, sp, cp;
+        FastMath::sinCos(yaw[i], sy, cy);
+        FastMath::sinCos(pitch[i], sp, cp);
+        writeMatrix(&out[i][0][0], x[i], y[i], z[i], sy, cy, sp, cp);
+    }
+}
+
+void TransformBatch::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_yaw.clear();
+    m_pitch.clear();
+}
+
+u32 TransformBatch::add(const Vec3& position, f32 yaw, f32 pitch) {
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_z.push_back(position.z);
+    m_yaw.push_back(yaw);
+    m_pitch.push_back(pitch);
+    return static_cast<u32>(m_x.size()) - 1;
+}
+
+void TransformBatch::compose() {
+    m_matrices.resize(m_x.size());
+    Transforms::translateYawPitch(m_x.data(), m_y.data(), m_z.data(), m_yaw.data(), m_pitch.data(),
+                                  size(), m_matrices.data());
+}
+
+}
@@ -0,0 +1,39 @@
+// Transform.hpp
+// Model matrices composed directly as translate * rotateY(yaw) * rotateX(pitch), singly or in batches.
+#pragma once
+
+#include "Simd.hpp"
+
+namespace Sports {
+
+class Transforms {
+public:
+    // Same result as glm::translate, then glm::rotate about +Y, then about +X
+    static Mat4 translateYawPitch(const Vec3& position, f32 yaw, f32 pitch);
+
+    // SoA inputs, four entities per step with vector sin/cos and no matrix multiplies.
+    // Inputs and out must come from 64-byte aligned storage; any count is accepted.
+    static void translateYawPitch(const f32* x, const f32* y, const f32* z,
+                                  const f32* yaw, const f32* pitch, u32 count, Mat4* out);
+};
+
+// Collects one frame's entity transforms, composes them together, then hands them out by index
+class TransformBatch {
+public:
+    void clear();
+    u32 add(const Vec3& position, f32 yaw = 0.0f, f32 pitch = 0.0f);
+    void compose();
+
+    const Mat4& getMatrix(u32 index) const { return m_matrices[index]; }
+    u32 size() const { return static_cast<u32>(m_x.size()); }
+
+private:
+    AlignedVector<f32> m_x;
+    AlignedVector<f32> m_y;
+    AlignedVector<f32> m_z;
+    AlignedVector<f32> m_yaw;
+    AlignedVector<f32> m_pitch;
+    AlignedVector<Mat4> m_matrices;
+};
+
+}
@@ -0,0 +1,202 @@
+// SharedMemoryTransport.cpp
+// Region layout and mapping (shm_open / named file mapping) for the two rings.
+#include "SharedMemoryTransport.hpp"
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Sports {
+
+namespace {
+
+// Region: header, ring 0 (creator to attacher), ring 1 (attacher to creator)
+struct alignas(64) RegionHeader {
+    char magic[4];
+    u32 slotCount;
+    u32 slotSize;
+    u32 ownerPid;            // Creator's process, to tell a live region from one left by a crash
+    std::atomic<u32> ready;  // Set last by the creator, once the rings are initialized
+};
+
+constexpr char REGION_MAGIC[4] = {'S', 'S', 'H', 'M'};
+
+size_t ringOffset(u32 ring) {
+    return sizeof(RegionHeader) + ring * SpscRing::bytesFor(SharedMemoryTransport::SLOT_COUNT);
+}
+
+std::string osName(const std::string& name) {
+#ifdef _WIN32
+    return "Local\\" + name;
+#else
+    return "/" + name;
+#endif
+}
+
+#ifndef _WIN32
+// POSIX names outlive their process: a creator that died without close() leaves a
+// finished region whose owner is gone. Windows drops the mapping with its last handle.
+bool isStaleRegion(const std::string& path) {
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat info;
+    void* view = fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(RegionHeader)
+                     ? mmap(nullptr, sizeof(RegionHeader), PROT_READ, MAP_SHARED, fd, 0)
+                     : MAP_FAILED;
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    const auto* header = static_cast<const RegionHeader*>(view);
+    bool stale = header->ready.load(std::memory_order_acquire) == 1 &&
+                 std::memcmp(header->magic, REGION_MAGIC, sizeof(REGION_MAGIC)) == 0 &&
+                 ::kill(static_cast<pid_t>(header->ownerPid), 0) != 0 && errno == ESRCH;
+    munmap(view, sizeof(RegionHeader));
+    return stale;
+}
+#endif
+
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+    close();
+}
+
+size_t SharedMemoryTransport::regionSize() {
+    return ringOffset(2);
+}
+
+bool SharedMemoryTransport::map(const std::string& name, bool create) {
+    size_t size = regionSize();
+#ifdef _WIN32
+    HANDLE mapping;
+    if (create) {
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                     static_cast<DWORD>(static_cast<u64>(size) >> 32),
+                                     static_cast<DWORD>(size), osName(name).c_str());
+        if (mapping && GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(mapping);
+            return false;
+        }
+    } else {
+        mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, osName(name).c_str());
+    }
+    if (!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+    m_base = view;
+#else
+    int fd = create ? shm_open(osName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)
+                    : shm_open(osName(name).c_str(), O_RDWR, 0);
+    if (fd < 0 && create && errno == EEXIST && isStaleRegion(osName(name))) {
+        // Unlinking only frees the name; anything still mapping the old region keeps it
+        shm_unlink(osName(name).c_str());
+        fd = shm_open(osName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (fd < 0) return false;
+
+    struct stat info;
+    bool sized = create ? ftruncate(fd, static_cast<off_t>(size)) == 0
+                        : fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= size;
+    void* view = sized ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);  // The mapping keeps the object alive
+    if (view == MAP_FAILED) {
+        if (create) shm_unlink(osName(name).c_str());
+        return false;
+    }
+    m_base = view;
+#endif
+    if (create) {
+        m_ownedName = name;
+    }
+    return true;
+}
+
+bool SharedMemoryTransport::create(const std::string& name) {
+    close();
+    if (!map(name, true)) {
+        return false;
+    }
+
+    u8* base = static_cast<u8*>(m_base);
+    m_outgoing.attach(base + ringOffset(0), SLOT_COUNT);
+    m_outgoing.initialize();
+    m_incoming.attach(base + ringOffset(1), SLOT_COUNT);
+    m_incoming.initialize();
+
+    auto* header = new (base) RegionHeader();
+    std::memcpy(header->magic, REGION_MAGIC, sizeof(REGION_MAGIC));
+    header->slotCount = SLOT_COUNT;
+    header->slotSize = static_cast<u32>(SpscRing::SLOT_SIZE);
+#ifdef _WIN32
+    header->ownerPid = static_cast<u32>(GetCurrentProcessId());
+#else
+    header->ownerPid = static_cast<u32>(getpid());
+#endif
+    header->ready.store(1, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryTransport::attach(const std::string& name) {
+    close();
+    if (!map(name, false)) {
+        return false;
+    }
+
+    // Refuse regions from another build or a creator that hasn't finished
+    u8* base = static_cast<u8*>(m_base);
+    auto* header = reinterpret_cast<RegionHeader*>(base);
+    if (header->ready.load(std::memory_order_acquire) != 1 ||
+        std::memcmp(header->magic, REGION_MAGIC, sizeof(REGION_MAGIC)) != 0 ||
+        header->slotCount != SLOT_COUNT || header->slotSize != SpscRing::SLOT_SIZE) {
+        close();
+        return false;
+    }
+
+    m_incoming.attach(base + ringOffset(0), SLOT_COUNT);
+    m_outgoing.attach(base + ringOffset(1), SLOT_COUNT);
+    return true;
+}
+
+bool SharedMemoryTransport::send(std::span<const u8> message) {
+    return m_base && message.size() <= MAX_MESSAGE && m_outgoing.push(message);
+}
+
+bool SharedMemoryTransport::receive(std::span<u8> buffer, size_t& size) {
+    return m_base && m_incoming.pop(buffer, size);
+}
+
+void SharedMemoryTransport::close() {
+    if (!m_base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#else
+    munmap(m_base, regionSize());
+    if (!m_ownedName.empty()) {
+        shm_unlink(osName(m_ownedName).c_str());  // The attacher keeps its mapping
+    }
+#endif
+    m_base = nullptr;
+    m_ownedName.clear();
+    m_outgoing = SpscRing();
+    m_incoming = SpscRing();
+}
+
+}
@@ -0,0 +1,52 @@
+// SharedMemoryTransport.hpp
+// Same-machine Transport over two SPSC rings in a named shared-memory region.
+#pragma once
+
+#include "Transport.hpp"
+#include "SpscRing.hpp"
+#include <string>
+
+namespace Sports {
+
+// The creator (usually the server) writes ring 0 and reads ring 1; the process
+// that attaches does the reverse. After setup, send and receive are a copy into
+// or out of the mapping: no syscalls and no kernel copies. Exactly one creator
+// and one attacher per region, each used from one thread.
+class SharedMemoryTransport final : public Transport {
+public:
+    static constexpr u32 SLOT_COUNT = 256;  // Per direction (~300 KB each)
+    static_assert(SpscRing::MAX_MESSAGE >= MAX_MESSAGE, "A ring slot must hold any datagram");
+
+    SharedMemoryTransport() = default;
+    ~SharedMemoryTransport() override;
+
+    SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+    SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+    // name is a bare identifier (e.g. "sports_match_1"); create() fails while another live
+    // creator holds it, and takes over a name left behind by one that crashed
+    bool create(const std::string& name);
+    bool attach(const std::string& name);
+
+    bool send(std::span<const u8> message) override;
+    bool receive(std::span<u8> buffer, size_t& size) override;
+
+    bool isOpen() const override { return m_base != nullptr; }
+    void close() override;
+
+    static size_t regionSize();
+
+private:
+    bool map(const std::string& name, bool create);
+
+    void* m_base = nullptr;
+    SpscRing m_outgoing;
+    SpscRing m_incoming;
+    std::string m_ownedName;  // Set on the creator, which removes the name on close
+
+#ifdef _WIN32
+    void* m_mapping = nullptr;
+#endif
+};
+
+}
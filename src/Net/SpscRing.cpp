@@ -0,0 +1,68 @@
+// SpscRing.cpp
+// Slot claim and publish with acquire/release counters; no locks, syscalls, or allocation.
+#include "SpscRing.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Sports {
+
+void SpscRing::attach(void* memory, u32 slotCount) {
+    m_header = static_cast<SpscRingHeader*>(memory);
+    m_slots = static_cast<u8*>(memory) + sizeof(SpscRingHeader);
+    m_mask = slotCount - 1;
+    m_cachedHead = m_header->head.load(std::memory_order_acquire);
+    m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+}
+
+void SpscRing::initialize() {
+    new (m_header) SpscRingHeader();
+    m_cachedHead = 0;
+    m_cachedTail = 0;
+}
+
+bool SpscRing::push(std::span<const u8> message) {
+    if (message.size() > MAX_MESSAGE) {
+        return false;
+    }
+
+    // Only re-read the consumer's counter when the ring looks full
+    u64 head = m_header->head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail > m_mask) {
+        m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+        if (head - m_cachedTail > m_mask) {
+            return false;
+        }
+    }
+
+    u8* out = slot(head);
+    u32 length = static_cast<u32>(message.size());
+    std::memcpy(out, &length, sizeof(length));
+    if (length > 0) {
+        std::memcpy(out + sizeof(length), message.data(), length);
+    }
+    m_header->head.store(head + 1, std::memory_order_release);  // Publishes the slot contents
+    return true;
+}
+
+bool SpscRing::pop(std::span<u8> buffer, size_t& size) {
+    u64 tail = m_header->tail.load(std::memory_order_relaxed);
+    if (tail == m_cachedHead) {
+        m_cachedHead = m_header->head.load(std::memory_order_acquire);
+        if (tail == m_cachedHead) {
+            return false;
+        }
+    }
+
+    const u8* in = slot(tail);
+    u32 length;
+    std::memcpy(&length, in, sizeof(length));
+    size = std::min<size_t>({length, buffer.size(), MAX_MESSAGE});  // Never trust the other process
+    if (size > 0) {
+        std::memcpy(buffer.data(), in + sizeof(length), size);
+    }
+    m_header->tail.store(tail + 1, std::memory_order_release);  // Slot may be reused from here
+    return true;
+}
+
+}
@@ -0,0 +1,51 @@
+// SpscRing.hpp
+// Lock-free single-producer single-consumer ring of fixed-size message slots over caller-provided memory.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <atomic>
+#include <span>
+
+namespace Sports {
+
+// Shared between the two ends; counters only ever grow, slot = counter % slotCount
+struct SpscRingHeader {
+    alignas(64) std::atomic<u64> head{0};  // Next slot to write (producer owns)
+    alignas(64) std::atomic<u64> tail{0};  // Next slot to read (consumer owns)
+};
+
+// One end of a ring. The memory may be mapped into another process, so the
+// ring is plain data at a fixed layout and each end keeps its own cursor copy
+// of the other's counter to touch the shared line only when it must.
+class SpscRing {
+public:
+    static constexpr size_t SLOT_SIZE = 1216;                   // 64-byte multiple
+    static constexpr size_t MAX_MESSAGE = SLOT_SIZE - sizeof(u32);
+
+    static_assert(std::atomic<u64>::is_always_lock_free, "Ring counters must be address-free across processes");
+
+    static size_t bytesFor(u32 slotCount) { return sizeof(SpscRingHeader) + SLOT_SIZE * slotCount; }
+
+    // slotCount must be a power of two. initialize() resets the counters (call once, before either end uses it)
+    void attach(void* memory, u32 slotCount);
+    void initialize();
+
+    // Producer end
+    bool push(std::span<const u8> message);  // False when full or too long
+
+    // Consumer end; truncates to buffer like recv()
+    bool pop(std::span<u8> buffer, size_t& size);
+
+    bool isAttached() const { return m_header != nullptr; }
+
+private:
+    u8* slot(u64 index) const { return m_slots + (index & m_mask) * SLOT_SIZE; }
+
+    SpscRingHeader* m_header = nullptr;
+    u8* m_slots = nullptr;
+    u64 m_mask = 0;
+    u64 m_cachedHead = 0;  // Consumer's last view of head
+    u64 m_cachedTail = 0;  // Producer's last view of tail
+};
+
+}
@@ -0,0 +1,25 @@
+// Transport.cpp
+// Batch fallbacks: one send()/receive() per message.
+#include "Transport.hpp"
+
+namespace Sports {
+
+u32 Transport::sendBatch(std::span<const std::span<const u8>> messages) {
+    u32 sent = 0;
+    for (std::span<const u8> message : messages) {
+        if (!send(message)) break;
+        sent++;
+    }
+    return sent;
+}
+
+u32 Transport::receiveBatch(MessageBatch& batch) {
+    batch.count = 0;
+    size_t size = 0;
+    while (batch.count < MessageBatch::CAPACITY && receive(batch.buffer(batch.count), size)) {
+        batch.sizes[batch.count++] = static_cast<u32>(size);
+    }
+    return batch.count;
+}
+
+}
@@ -0,0 +1,55 @@
+// Transport.hpp
+// Unreliable, message-preserving link to one peer: the interface UDP and shared memory both implement.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Sports {
+
+struct MessageBatch;
+
+// Datagram semantics: a send is delivered whole or not at all, in any order
+// for UDP and in order for shared memory. Neither call blocks.
+class Transport {
+public:
+    static constexpr size_t MAX_MESSAGE = 1200;  // Fits one Ethernet frame after IP/UDP headers
+
+    virtual ~Transport() = default;
+
+    // False when the message is too big or can't be queued right now (dropped, as UDP would)
+    virtual bool send(std::span<const u8> message) = 0;
+
+    // Copies the next message into buffer and sets size; false when nothing is waiting.
+    // A message longer than buffer is truncated to it, as recv() does.
+    virtual bool receive(std::span<u8> buffer, size_t& size) = 0;
+
+    // Many messages per call. Returns how many were sent (a prefix of messages) or
+    // received into the batch. The defaults loop over send() and receive(); backends
+    // that can cover a batch with one syscall override them.
+    virtual u32 sendBatch(std::span<const std::span<const u8>> messages);
+    virtual u32 receiveBatch(MessageBatch& batch);
+
+    virtual bool isOpen() const = 0;
+    virtual void close() = 0;
+};
+
+// Receive storage for up to CAPACITY messages, reused from call to call
+struct MessageBatch {
+    static constexpr u32 CAPACITY = 64;
+
+    std::vector<u8> storage = std::vector<u8>(CAPACITY * Transport::MAX_MESSAGE);
+    std::array<u32, CAPACITY> sizes{};
+    u32 count = 0;
+
+    std::span<u8> buffer(u32 index) {
+        return {storage.data() + index * Transport::MAX_MESSAGE, Transport::MAX_MESSAGE};
+    }
+    std::span<const u8> operator[](u32 index) const {
+        return {storage.data() + index * Transport::MAX_MESSAGE, sizes[index]};
+    }
+};
+
+}
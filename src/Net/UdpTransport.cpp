@@ -0,0 +1,215 @@
+// UdpTransport.cpp
+// Socket setup and one send()/recv() per message.
+#include "UdpTransport.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using SocketLength = int;
+#define closeSocket ::closesocket
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+using SocketLength = socklen_t;
+#define closeSocket ::close  // Qualified: Transport::close() would hide it
+#endif
+
+namespace Sports {
+
+namespace {
+
+template <typename Socket>
+bool isInvalid(Socket socket) {
+#ifdef _WIN32
+    return socket == INVALID_SOCKET;
+#else
+    return socket < 0;
+#endif
+}
+
+}
+
+#ifdef __linux__
+struct UdpTransport::BatchHeaders {
+    std::array<mmsghdr, MessageBatch::CAPACITY> messages{};
+    std::array<iovec, MessageBatch::CAPACITY> vectors{};
+};
+#else
+struct UdpTransport::BatchHeaders {};
+#endif
+
+UdpTransport::UdpTransport() : m_headers(std::make_unique<BatchHeaders>()) {}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open(u16 localPort, const std::string& peerAddress, u16 peerPort, UdpBackend backend) {
+    close();
+
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        return false;
+    }
+#endif
+
+    sockaddr_in peer{};
+    peer.sin_family = AF_INET;
+    peer.sin_port = htons(peerPort);
+    if (inet_pton(AF_INET, peerAddress.c_str(), &peer.sin_addr) != 1) {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    auto socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    bool ready = !isInvalid(socket);
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(localPort);
+
+    // connect() filters out datagrams from anyone but the peer and lets send() skip the address
+    ready = ready && ::bind(socket, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0 &&
+            ::connect(socket, reinterpret_cast<sockaddr*>(&peer), sizeof(peer)) == 0;
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ready = ready && ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+    ready = ready && fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!ready) {
+        if (!isInvalid(socket)) closeSocket(socket);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    SocketLength length = sizeof(local);
+    getsockname(socket, reinterpret_cast<sockaddr*>(&local), &length);
+    m_localPort = ntohs(local.sin_port);
+    m_socket = static_cast<std::intptr_t>(socket);
+
+    if (backend == UdpBackend::IoUring) {
+        m_uring.init(static_cast<int>(m_socket));  // Stays on Syscall if this fails
+    }
+    return true;
+}
+
+bool UdpTransport::send(std::span<const u8> message) {
+    if (!isOpen() || message.size() > MAX_MESSAGE) {
+        return false;
+    }
+    if (m_uring.isActive()) {
+        return m_uring.send(std::span<const std::span<const u8>>(&message, 1)) == 1;
+    }
+    auto sent = ::send(static_cast<int>(m_socket), reinterpret_cast<const char*>(message.data()),
+                       static_cast<int>(message.size()), 0);
+    return sent == static_cast<decltype(sent)>(message.size());  // Full socket buffer: dropped
+}
+
+bool UdpTransport::receive(std::span<u8> buffer, size_t& size) {
+    if (!isOpen()) {
+        return false;
+    }
+    if (m_uring.isActive()) {
+        return m_uring.receive(buffer, size);
+    }
+    // Errors from the peer's ICMP replies end up here too; they read as "nothing waiting"
+    auto received = ::recv(static_cast<int>(m_socket), reinterpret_cast<char*>(buffer.data()),
+                           static_cast<int>(buffer.size()), 0);
+    if (received < 0) {
+        return false;
+    }
+    size = static_cast<size_t>(received);
+    return true;
+}
+
+u32 UdpTransport::sendBatch(std::span<const std::span<const u8>> messages) {
+    if (!isOpen()) {
+        return 0;
+    }
+    if (m_uring.isActive()) {
+        return m_uring.send(messages);
+    }
+#ifdef __linux__
+    // One sendmmsg per CAPACITY messages; stops at the first the socket won't take
+    u32 sent = 0;
+    while (sent < messages.size()) {
+        u32 count = 0;
+        while (count < MessageBatch::CAPACITY && sent + count < messages.size() &&
+               messages[sent + count].size() <= MAX_MESSAGE) {
+            std::span<const u8> message = messages[sent + count];
+            m_headers->vectors[count] = {const_cast<u8*>(message.data()), message.size()};
+            m_headers->messages[count] = {};
+            m_headers->messages[count].msg_hdr.msg_iov = &m_headers->vectors[count];
+            m_headers->messages[count].msg_hdr.msg_iovlen = 1;
+            count++;
+        }
+        if (count == 0) break;  // Oversized message
+        int result = sendmmsg(static_cast<int>(m_socket), m_headers->messages.data(), count, 0);
+        if (result <= 0) break;
+        sent += static_cast<u32>(result);
+        if (static_cast<u32>(result) < count) break;
+    }
+    return sent;
+#else
+    return Transport::sendBatch(messages);
+#endif
+}
+
+u32 UdpTransport::receiveBatch(MessageBatch& batch) {
+    batch.count = 0;
+    if (!isOpen()) {
+        return 0;
+    }
+    if (m_uring.isActive()) {
+        return m_uring.receive(batch);
+    }
+#ifdef __linux__
+    for (u32 i = 0; i < MessageBatch::CAPACITY; i++) {
+        std::span<u8> buffer = batch.buffer(i);
+        m_headers->vectors[i] = {buffer.data(), buffer.size()};
+        m_headers->messages[i] = {};
+        m_headers->messages[i].msg_hdr.msg_iov = &m_headers->vectors[i];
+        m_headers->messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    int result = recvmmsg(static_cast<int>(m_socket), m_headers->messages.data(), MessageBatch::CAPACITY, 0,
+                          nullptr);
+    if (result <= 0) {
+        return 0;
+    }
+    batch.count = static_cast<u32>(result);
+    for (u32 i = 0; i < batch.count; i++) {
+        batch.sizes[i] = m_headers->messages[i].msg_len;
+    }
+    return batch.count;
+#else
+    return Transport::receiveBatch(batch);
+#endif
+}
+
+void UdpTransport::close() {
+    if (!isOpen()) {
+        return;
+    }
+    m_uring.shutdown();  // Before the socket: it waits for reads posted on it
+    closeSocket(static_cast<int>(m_socket));
+    m_socket = -1;
+    m_localPort = 0;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+}
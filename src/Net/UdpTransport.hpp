@@ -0,0 +1,51 @@
+// UdpTransport.hpp
+// Transport over a non-blocking UDP socket connected to one peer.
+#pragma once
+
+#include "Transport.hpp"
+#include "UringSocket.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Sports {
+
+enum class UdpBackend : u8 {
+    Syscall,  // send/recv per message; batches use sendmmsg/recvmmsg on Linux
+    IoUring,  // Linux io_uring with registered buffers; falls back to Syscall where unavailable
+};
+
+class UdpTransport final : public Transport {
+public:
+    UdpTransport();
+    ~UdpTransport() override;
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // Binds localPort (0 picks a free one) and only exchanges datagrams with the
+    // peer, an IPv4 address in dotted form
+    bool open(u16 localPort, const std::string& peerAddress, u16 peerPort,
+              UdpBackend backend = UdpBackend::Syscall);
+
+    bool send(std::span<const u8> message) override;
+    bool receive(std::span<u8> buffer, size_t& size) override;
+    u32 sendBatch(std::span<const std::span<const u8>> messages) override;
+    u32 receiveBatch(MessageBatch& batch) override;
+
+    bool isOpen() const override { return m_socket >= 0; }
+    void close() override;
+
+    u16 getLocalPort() const { return m_localPort; }
+    UdpBackend getBackend() const { return m_uring.isActive() ? UdpBackend::IoUring : UdpBackend::Syscall; }
+
+private:
+    struct BatchHeaders;  // mmsghdr/iovec arrays, sized once
+
+    std::intptr_t m_socket = -1;
+    u16 m_localPort = 0;
+    UringSocket m_uring;
+    std::unique_ptr<BatchHeaders> m_headers;
+};
+
+}
@@ -0,0 +1,324 @@
+// UringSocket.cpp
+// Raw io_uring setup (no liburing), fixed-buffer reads and writes, and completion reaping.
+#include "UringSocket.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SPORTS_HAS_IO_URING 1
+#include <atomic>
+#include <cerrno>
+#include <linux/fs.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Sports {
+
+#ifdef SPORTS_HAS_IO_URING
+
+namespace {
+
+constexpr u64 SEND_TAG = 1ull << 32;  // user_data: send slots are tagged, reads are the bare slot
+constexpr u16 RECV_BUFFER = 0;        // Registered buffer indices
+constexpr u16 SEND_BUFFER = 1;
+constexpr u32 MIN_READS = 4;         // Reads issued even when the last call found nothing
+
+int uringSetup(u32 entries, io_uring_params& params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int uringEnter(int ring, u32 submit, u32 minComplete, u32 flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring, submit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int ring, u32 opcode, const void* arg, u32 count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ring, opcode, arg, count));
+}
+
+// Ring indices shared with the kernel
+u32 loadAcquire(u32* value) { return std::atomic_ref<u32>(*value).load(std::memory_order_acquire); }
+void storeRelease(u32* value, u32 v) { std::atomic_ref<u32>(*value).store(v, std::memory_order_release); }
+
+template <typename T>
+T* field(void* base, u32 offset) {
+    return reinterpret_cast<T*>(static_cast<u8*>(base) + offset);
+}
+
+}
+
+struct UringSocket::State {
+    int ring = -1;
+    int socket = -1;
+
+    void* ringMap = MAP_FAILED;  // SQ and CQ rings share one mapping (IORING_FEAT_SINGLE_MMAP)
+    size_t ringMapSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    u32* sqHead = nullptr;
+    u32* sqTail = nullptr;
+    u32* sqArray = nullptr;
+    u32 sqMask = 0;
+    u32 sqEntries = 0;
+    u32* cqHead = nullptr;
+    u32* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    u32 cqMask = 0;
+
+    std::vector<u8> recvBuffers = std::vector<u8>(RECV_SLOTS * Transport::MAX_MESSAGE);
+    std::vector<u8> sendBuffers = std::vector<u8>(SEND_SLOTS * Transport::MAX_MESSAGE);
+
+    std::array<u32, RECV_SLOTS> readSize{};  // Per slot, from this call's completions
+    std::array<bool, RECV_SLOTS> readDone{};
+    u32 postedReads = 0;
+    u32 readAhead = MIN_READS;               // Reads issued per receive, adapted to traffic
+
+    std::array<u32, SEND_SLOTS> freeSend{};
+    u32 freeSendCount = 0;
+    u32 postedWrites = 0;
+
+    ~State() {
+        if (ring >= 0) {
+            drain();
+            ::close(ring);
+        }
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (ringMap != MAP_FAILED) munmap(ringMap, ringMapSize);
+    }
+
+    // The kernel may still be using a slot; wait for those before freeing them
+    void drain() {
+        for (int attempt = 0; attempt < 100 && postedWrites + postedReads > 0; attempt++) {
+            if (uringEnter(ring, pendingSubmissions(), postedWrites + postedReads, IORING_ENTER_GETEVENTS) < 0 &&
+                errno != EINTR) {
+                break;
+            }
+            reap();
+        }
+    }
+
+    u32 pendingSubmissions() const {
+        return *sqTail - loadAcquire(sqHead);
+    }
+
+    bool queue(u8 opcode, u8* address, u32 length, u16 bufferIndex, u64 userData, u32 rwFlags = 0) {
+        u32 tail = *sqTail;  // Only we advance the tail
+        if (tail - loadAcquire(sqHead) >= sqEntries) {
+            return false;
+        }
+        io_uring_sqe& sqe = sqes[tail & sqMask];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = socket;
+        sqe.addr = reinterpret_cast<u64>(address);
+        sqe.len = length;
+        sqe.rw_flags = static_cast<__kernel_rwf_t>(rwFlags);
+        sqe.buf_index = bufferIndex;
+        sqe.user_data = userData;
+        sqArray[tail & sqMask] = tail & sqMask;
+        storeRelease(sqTail, tail + 1);  // Publishes the entry
+        return true;
+    }
+
+    void reap() {
+        u32 head = *cqHead;
+        u32 tail = loadAcquire(cqTail);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            u32 slot = static_cast<u32>(cqe.user_data);
+            if (cqe.user_data & SEND_TAG) {
+                // Failed writes are dropped datagrams, same as a full socket buffer
+                freeSend[freeSendCount++] = slot;
+                postedWrites--;
+            } else {
+                postedReads--;
+                if (cqe.res >= 0) {
+                    readSize[slot] = static_cast<u32>(cqe.res);
+                    readDone[slot] = true;
+                }
+                // -EAGAIN: nothing left in the socket for this read
+            }
+        }
+        storeRelease(cqHead, head);
+    }
+
+    // Up to `count` reads in one enter. RWF_NOWAIT makes a read with no datagram
+    // waiting fail at once rather than park on the socket: parked reads would all
+    // be woken by every datagram that arrives.
+    u32 readInto(std::span<u8>* buffers, size_t* sizes, u32 count) {
+        count = std::min(count, readAhead);
+        for (u32 slot = 0; slot < count; slot++) {
+            readDone[slot] = false;
+            if (!queue(IORING_OP_READ_FIXED, recvBuffers.data() + slot * Transport::MAX_MESSAGE,
+                       Transport::MAX_MESSAGE, RECV_BUFFER, slot, RWF_NOWAIT)) {
+                count = slot;
+                break;
+            }
+            postedReads++;
+        }
+
+        // Every read has to finish before its slot is copied out or reissued; an
+        // interrupted enter just goes round again
+        for (int attempt = 0; attempt < 100 && postedReads > 0; attempt++) {
+            if (uringEnter(ring, pendingSubmissions(), postedReads, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                break;
+            }
+            reap();
+        }
+
+        // Completions can arrive in any order and an early read can miss while a later
+        // one lands, so every finished slot is taken, in submission order
+        u32 received = 0;
+        for (u32 slot = 0; slot < count; slot++) {
+            if (!readDone[slot]) continue;
+            sizes[received] = std::min<size_t>(readSize[slot], buffers[received].size());
+            std::memcpy(buffers[received].data(), recvBuffers.data() + slot * Transport::MAX_MESSAGE,
+                        sizes[received]);
+            readDone[slot] = false;
+            received++;
+        }
+        // A full run suggests more is queued; a short one, about that many next time
+        readAhead = std::clamp(received == count ? received * 2 : received + MIN_READS, MIN_READS, RECV_SLOTS);
+        return received;
+    }
+};
+
+UringSocket::UringSocket() = default;
+
+UringSocket::~UringSocket() {
+    shutdown();
+}
+
+bool UringSocket::init(int socket) {
+    shutdown();
+    auto state = std::make_unique<State>();
+    state->socket = socket;
+
+    // One thread drives the ring, so completion work can wait for our next enter
+    // instead of interrupting us (6.1+); older kernels reject the flags
+    io_uring_params params{};
+#if defined(IORING_SETUP_SINGLE_ISSUER) && defined(IORING_SETUP_DEFER_TASKRUN)
+    params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    state->ring = uringSetup(RECV_SLOTS + SEND_SLOTS, params);
+    if (state->ring < 0) {
+        params = {};
+        state->ring = uringSetup(RECV_SLOTS + SEND_SLOTS, params);
+    }
+#else
+    state->ring = uringSetup(RECV_SLOTS + SEND_SLOTS, params);
+#endif
+    if (state->ring < 0 || !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        return false;
+    }
+
+    size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+    size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    state->ringMapSize = std::max(sqSize, cqSize);
+    state->ringMap = mmap(nullptr, state->ringMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          state->ring, IORING_OFF_SQ_RING);
+    state->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    state->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, state->sqesSize, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_POPULATE, state->ring, IORING_OFF_SQES));
+    if (state->ringMap == MAP_FAILED || state->sqes == MAP_FAILED) {
+        return false;
+    }
+
+    void* map = state->ringMap;
+    state->sqHead = field<u32>(map, params.sq_off.head);
+    state->sqTail = field<u32>(map, params.sq_off.tail);
+    state->sqArray = field<u32>(map, params.sq_off.array);
+    state->sqMask = *field<u32>(map, params.sq_off.ring_mask);
+    state->sqEntries = params.sq_entries;
+    state->cqHead = field<u32>(map, params.cq_off.head);
+    state->cqTail = field<u32>(map, params.cq_off.tail);
+    state->cqes = field<io_uring_cqe>(map, params.cq_off.cqes);
+    state->cqMask = *field<u32>(map, params.cq_off.ring_mask);
+
+    // Pinned once here so the kernel doesn't map user pages on every operation
+    iovec buffers[2] = {{state->recvBuffers.data(), state->recvBuffers.size()},
+                        {state->sendBuffers.data(), state->sendBuffers.size()}};
+    if (uringRegister(state->ring, IORING_REGISTER_BUFFERS, buffers, 2) < 0) {
+        return false;  // Usually RLIMIT_MEMLOCK
+    }
+
+    for (u32 slot = 0; slot < SEND_SLOTS; slot++) {
+        state->freeSend[state->freeSendCount++] = slot;
+    }
+    m_state = std::move(state);
+    return true;
+}
+
+void UringSocket::shutdown() {
+    m_state.reset();
+}
+
+bool UringSocket::receive(std::span<u8> buffer, size_t& size) {
+    if (!m_state) return false;
+    u32 readAhead = m_state->readAhead;
+    m_state->readAhead = 1;  // Further datagrams would be read and lost
+    bool received = m_state->readInto(&buffer, &size, 1) == 1;
+    m_state->readAhead = readAhead;
+    return received;
+}
+
+u32 UringSocket::receive(MessageBatch& batch) {
+    batch.count = 0;
+    if (!m_state) return 0;
+    std::array<std::span<u8>, MessageBatch::CAPACITY> buffers;
+    std::array<size_t, MessageBatch::CAPACITY> sizes;
+    for (u32 i = 0; i < MessageBatch::CAPACITY; i++) {
+        buffers[i] = batch.buffer(i);
+    }
+    batch.count = m_state->readInto(buffers.data(), sizes.data(), MessageBatch::CAPACITY);
+    for (u32 i = 0; i < batch.count; i++) {
+        batch.sizes[i] = static_cast<u32>(sizes[i]);
+    }
+    return batch.count;
+}
+
+u32 UringSocket::send(std::span<const std::span<const u8>> messages) {
+    if (!m_state) return 0;
+    State& s = *m_state;
+    if (s.freeSendCount < messages.size()) {
+        s.reap();  // Earlier writes may have finished
+    }
+
+    u32 queued = 0;
+    for (std::span<const u8> message : messages) {
+        if (message.size() > Transport::MAX_MESSAGE || s.freeSendCount == 0) break;
+        u32 slot = s.freeSend[s.freeSendCount - 1];
+        u8* buffer = s.sendBuffers.data() + slot * Transport::MAX_MESSAGE;
+        std::memcpy(buffer, message.data(), message.size());
+        if (!s.queue(IORING_OP_WRITE_FIXED, buffer, static_cast<u32>(message.size()), SEND_BUFFER,
+                     SEND_TAG | slot)) {
+            break;
+        }
+        s.freeSendCount--;
+        s.postedWrites++;
+        queued++;
+    }
+    uringEnter(s.ring, s.pendingSubmissions(), 0, 0);  // One syscall for the whole batch
+    return queued;
+}
+
+#else
+
+// No io_uring on this platform: init() fails and the transport keeps using plain syscalls
+struct UringSocket::State {};
+
+UringSocket::UringSocket() = default;
+UringSocket::~UringSocket() = default;
+bool UringSocket::init(int) { return false; }
+void UringSocket::shutdown() {}
+bool UringSocket::receive(std::span<u8>, size_t&) { return false; }
+u32 UringSocket::receive(MessageBatch& batch) { batch.count = 0; return 0; }
+u32 UringSocket::send(std::span<const std::span<const u8>>) { return 0; }
+
+#endif
+
+}
@@ -0,0 +1,41 @@
+// UringSocket.hpp
+// io_uring I/O for one connected datagram socket, through buffers registered with the kernel once.
+#pragma once
+
+#include "Transport.hpp"
+#include <memory>
+
+namespace Sports {
+
+// Every call is one io_uring_enter: a receive issues a run of non-blocking
+// fixed-buffer reads and collects them, a send copies the batch into
+// registered slots and writes them all. Writes complete in the background and
+// their slots are reclaimed by later calls. Single-threaded, like the socket.
+class UringSocket {
+public:
+    static constexpr u32 RECV_SLOTS = MessageBatch::CAPACITY;  // Reads per call at most
+    static constexpr u32 SEND_SLOTS = MessageBatch::CAPACITY;
+
+    UringSocket();
+    ~UringSocket();
+
+    UringSocket(const UringSocket&) = delete;
+    UringSocket& operator=(const UringSocket&) = delete;
+
+    // False when io_uring is missing (not Linux, old kernel, or blocked by a sandbox)
+    bool init(int socket);
+    void shutdown();
+    bool isActive() const { return m_state != nullptr; }
+
+    // Same contracts as Transport::sendBatch and Transport::receive/receiveBatch
+    u32 send(std::span<const std::span<const u8>> messages);
+    bool receive(std::span<u8> buffer, size_t& size);
+    u32 receive(MessageBatch& batch);
+
+private:
+    struct State;
+
+    std::unique_ptr<State> m_state;
+};
+
+}
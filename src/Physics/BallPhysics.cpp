@@ -1,11 +1,19 @@
 // BallPhysics.cpp
 // Implementation of realistic soccer ball physics.
 #include "BallPhysics.hpp"
+#include "Math/FastMath.hpp"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 namespace Sports {
 
+namespace {
+// decay^t as e^(t ln decay): one exp per call instead of pow
+const f32 LOG_SPIN_DECAY = std::log(BallPhysics::SPIN_DECAY);
+const f32 LOG_GROUND_SPIN_DECAY = std::log(BallPhysics::GROUND_SPIN_DECAY);
+}
+
 void BallPhysics::update(BallState& ball, f32 deltaTime, const FieldBounds& bounds) {
     bool inAir = isInAir(ball);
     f32 ballSpeed = glm::length(ball.velocity);
@@ -38,6 +46,99 @@ void BallPhysics::update(BallState& ball, f32 deltaTime, const FieldBounds& boun
     handleFieldBoundaries(ball, bounds);
 }
 
+void BallPhysics::updateEventDriven(BallState& ball, RollSegment& segment, f32 deltaTime,
+                                    const FieldBounds& bounds) {
+    // Closed form holds until the next event; anything else touching the ball
+    // (kicks, dribbles, body contacts) shows up as a mismatch with what we last wrote
+    const BallState& last = segment.expected;
+    bool untouched = ball.position == last.position &&
+                     ball.velocity == last.velocity &&
+                     ball.angularVelocity == last.angularVelocity &&
+                     ball.rotationAngle == last.rotationAngle;
+
+    if (segment.active && untouched) {
+        f32 time = segment.elapsed + deltaTime;
+        if (time < segment.eventTime) {
+            segment.elapsed = time;
+            evaluateRoll(segment, time, ball);
+            segment.expected = ball;
+            return;
+        }
+    }
+
+    // Event reached or ball disturbed: integrate this tick, then re-plan if grounded
+    segment.active = false;
+    update(ball, deltaTime, bounds);
+
+    if (isRolling(ball)) {
+        segment = planRoll(ball, bounds);
+        segment.expected = ball;
+    }
+}
+
+bool BallPhysics::isRolling(const BallState& ball) {
+    return ball.position.y <= BALL_RADIUS && ball.velocity.y == 0.0f;
+}
+
+RollSegment BallPhysics::planRoll(const BallState& ball, const FieldBounds& bounds) {
+    RollSegment segment;
+    segment.origin = ball.position;
+    segment.spin = ball.angularVelocity;
+    segment.initialRotation = ball.rotationAngle;
+    segment.eventTime = std::numeric_limits<f32>::infinity();
+    segment.active = true;
+
+    f32 groundSpeed = glm::length(Vec3(ball.velocity.x, 0.0f, ball.velocity.z));
+    if (groundSpeed <= 0.01f) {
+        return segment;  // Resting: nothing happens until something touches the ball
+    }
+
+    // Constant deceleration a: s(t) = v0*t - a*t^2/2, stops at t = v0/a
+    f32 decel = ROLLING_FRICTION * GRAVITY;
+    segment.direction = Vec3(ball.velocity.x, 0.0f, ball.velocity.z) / groundSpeed;
+    segment.initialSpeed = groundSpeed;
+    segment.stopTime = groundSpeed / decel;
+    f32 maxTravel = groundSpeed * groundSpeed / (2.0f * decel);
+
+    // Earliest wall contact (inner walls used by Match, so both handlers agree)
+    f32 limits[2] = {
+        bounds.length / 2.0f - BALL_RADIUS,
+        bounds.width / 2.0f - BALL_RADIUS
+    };
+    f32 positions[2] = {ball.position.x, ball.position.z};
+    f32 directions[2] = {segment.direction.x, segment.direction.z};
+
+    for (int axis = 0; axis < 2; axis++) {
+        if (std::abs(directions[axis]) < 1e-6f) continue;
+
+        f32 wall = std::copysign(limits[axis], directions[axis]);
+        f32 travel = (wall - positions[axis]) / directions[axis];
+        if (travel <= 0.0f) {
+            segment.eventTime = 0.0f;  // Already at or past the wall, moving outward
+            break;
+        }
+        if (travel < maxTravel) {
+            f32 disc = groundSpeed * groundSpeed - 2.0f * decel * travel;
+            f32 hitTime = (groundSpeed - std::sqrt(std::max(disc, 0.0f))) / decel;
+            segment.eventTime = std::min(segment.eventTime, hitTime);
+        }
+    }
+
+    return segment;
+}
+
+void BallPhysics::evaluateRoll(const RollSegment& segment, f32 time, BallState& out) {
+    f32 decel = ROLLING_FRICTION * GRAVITY;
+    f32 rollTime = std::min(time, segment.stopTime);
+    f32 travel = segment.initialSpeed * rollTime - 0.5f * decel * rollTime * rollTime;
+    f32 speed = (time < segment.stopTime) ? segment.initialSpeed - decel * time : 0.0f;
+
+    out.position = segment.origin + segment.direction * travel;
+    out.velocity = segment.direction * speed;
+    out.angularVelocity = segment.spin * FastMath::exp(LOG_GROUND_SPIN_DECAY * time);
+    out.rotationAngle = segment.initialRotation + travel * 3.0f;  // Matches update()
+}
+
 bool BallPhysics::isInAir(const BallState& ball) {
     const f32 airThreshold = BALL_RADIUS + 0.3f;
     return ball.position.y > airThreshold;
@@ -82,9 +183,9 @@ void BallPhysics::applyMagnusEffect(BallState& ball, f32 deltaTime) {
 void BallPhysics::applySpinDecay(BallState& ball, f32 deltaTime) {
     // Spin decays faster on ground due to friction
     if (isInAir(ball)) {
-        ball.angularVelocity *= std::pow(SPIN_DECAY, deltaTime);
+        ball.angularVelocity *= FastMath::exp(LOG_SPIN_DECAY * deltaTime);
     } else {
-        ball.angularVelocity *= std::pow(0.9f, deltaTime);
+        ball.angularVelocity *= FastMath::exp(LOG_GROUND_SPIN_DECAY * deltaTime);
     }
 }
 
@@ -22,6 +22,21 @@ struct FieldBounds {
     f32 goalHeight = 2.44f;
 };
 
+// Closed-form ground roll: constant deceleration from the moment it was planned.
+// Valid until the next event (boundary contact or an external change to the ball).
+struct RollSegment {
+    Vec3 origin{0.0f};           // Position at segment start
+    Vec3 direction{0.0f};        // Unit horizontal travel direction
+    Vec3 spin{0.0f};             // Angular velocity at segment start
+    f32 initialSpeed = 0.0f;
+    f32 initialRotation = 0.0f;
+    f32 stopTime = 0.0f;         // Seconds until the ball comes to rest
+    f32 eventTime = 0.0f;        // Seconds until the next boundary contact (infinity if none)
+    f32 elapsed = 0.0f;          // Time evaluated so far
+    BallState expected;          // Last state written, to detect outside changes
+    bool active = false;
+};
+
 // Static utility class for ball physics calculations
 class BallPhysics {
 public:
@@ -35,10 +50,21 @@ public:
     static constexpr f32 BOUNCE_FACTOR = 0.7f;       // Energy retained on bounce
     static constexpr f32 ROLLING_FRICTION = 0.3f;    // Grass friction
     static constexpr f32 SPIN_DECAY = 0.98f;         // Spin reduction per second
+    static constexpr f32 GROUND_SPIN_DECAY = 0.9f;   // Spin reduction per second while rolling
 
     // Main update - applies all physics for one frame
     static void update(BallState& ball, f32 deltaTime, const FieldBounds& bounds);
 
+    // Event-driven update: evaluates rolling/resting motion in closed form and
+    // only falls back to per-tick integration around events (kicks, bounces, walls)
+    static void updateEventDriven(BallState& ball, RollSegment& segment, f32 deltaTime,
+                                  const FieldBounds& bounds);
+
+    // Analytic rolling motion
+    static bool isRolling(const BallState& ball);  // Grounded with no vertical velocity
+    static RollSegment planRoll(const BallState& ball, const FieldBounds& bounds);
+    static void evaluateRoll(const RollSegment& segment, f32 time, BallState& out);
+
     // State queries
     static bool isInAir(const BallState& ball);  // Clearly airborne
     static bool isLow(const BallState& ball);    // Safe to kick
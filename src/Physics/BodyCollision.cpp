@@ -0,0 +1,123 @@
+// BodyCollision.cpp
+// Sphere-capsule narrowphase, contact response, and grid broadphase.
+#include "BodyCollision.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Sports {
+
+bool BodyCollision::sphereVsCapsule(const Vec3& center, f32 radius, const Capsule& capsule,
+                                    BallContact& out) {
+    // Vertical segment: closest point only needs the clamped height
+    Vec3 start = capsule.segmentStart();
+    Vec3 end = capsule.segmentEnd();
+    Vec3 closest(start.x, std::clamp(center.y, start.y, end.y), start.z);
+
+    Vec3 delta = center - closest;
+    f32 distSq = glm::dot(delta, delta);
+    f32 minDist = radius + capsule.radius;
+    if (distSq >= minDist * minDist) {
+        return false;
+    }
+
+    f32 dist = std::sqrt(distSq);
+    out.normal = (dist > 0.0001f) ? delta / dist : Vec3(1.0f, 0.0f, 0.0f);
+    out.point = closest + out.normal * capsule.radius;
+    out.depth = minDist - dist;
+    out.heightRatio = std::clamp((center.y - capsule.base.y) / capsule.height, 0.0f, 1.0f);
+    return true;
+}
+
+f32 BodyCollision::resolveBallContact(BallState& ball, const BallContact& contact,
+                                      const Vec3& bodyVelocity) {
+    Vec3 normal = contact.normal;
+
+    // Rolling balls are pushed along the ground, not into it
+    if (ball.position.y <= BallPhysics::BALL_RADIUS + 0.05f) {
+        normal.y = 0.0f;
+        f32 len = glm::length(normal);
+        if (len < 0.0001f) return 0.0f;
+        normal /= len;
+    }
+
+    ball.position += normal * contact.depth;
+
+    // Bounce off the body with height-dependent restitution (head, chest, legs)
+    f32 incoming = glm::dot(ball.velocity, normal);
+    f32 impactSpeed = 0.0f;
+    if (incoming < 0.0f) {
+        impactSpeed = -incoming;
+        ball.velocity -= normal * incoming * (1.0f + restitutionAt(contact.heightRatio));
+    }
+
+    // Moving bodies carry the ball along
+    f32 bodyPush = glm::dot(bodyVelocity, normal);
+    if (bodyPush > 0.5f) {
+        ball.velocity += normal * bodyPush * MOMENTUM_TRANSFER;
+    }
+
+    return impactSpeed;
+}
+
+f32 BodyCollision::restitutionAt(f32 heightRatio) {
+    if (heightRatio > 0.85f) return HEAD_RESTITUTION;
+    if (heightRatio > 0.5f) return CHEST_RESTITUTION;
+    return LEG_RESTITUTION;
+}
+
+void BodyBroadphase::build(const std::vector<Capsule>& bodies, f32 fieldLength, f32 fieldWidth) {
+    // Small margin so bodies pushed slightly past the lines still land in edge cells
+    m_minX = -fieldLength / 2.0f - CELL_SIZE;
+    m_minZ = -fieldWidth / 2.0f - CELL_SIZE;
+    m_cols = static_cast<i32>(std::ceil((fieldLength + 2.0f * CELL_SIZE) / CELL_SIZE));
+    m_rows = static_cast<i32>(std::ceil((fieldWidth + 2.0f * CELL_SIZE) / CELL_SIZE));
+    m_maxRadius = 0.0f;
+
+    // Counting sort of bodies by cell
+    m_cellStart.assign(static_cast<size_t>(m_cols * m_rows) + 1, 0);
+    for (const auto& body : bodies) {
+        i32 cell = cellZ(body.base.z) * m_cols + cellX(body.base.x);
+        m_cellStart[cell + 1]++;
+        m_maxRadius = std::max(m_maxRadius, body.radius);
+    }
+    for (size_t i = 1; i < m_cellStart.size(); i++) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_bodies.resize(bodies.size());
+    std::vector<u32> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < bodies.size(); i++) {
+        i32 cell = cellZ(bodies[i].base.z) * m_cols + cellX(bodies[i].base.x);
+        m_bodies[fill[cell]++] = static_cast<u32>(i);
+    }
+}
+
+void BodyBroadphase::query(const Vec3& center, f32 radius, std::vector<u32>& out) const {
+    out.clear();
+    if (m_cols == 0) return;
+
+    f32 reach = radius + m_maxRadius;
+    i32 x0 = cellX(center.x - reach);
+    i32 x1 = cellX(center.x + reach);
+    i32 z0 = cellZ(center.z - reach);
+    i32 z1 = cellZ(center.z + reach);
+
+    for (i32 z = z0; z <= z1; z++) {
+        for (i32 x = x0; x <= x1; x++) {
+            i32 cell = z * m_cols + x;
+            for (u32 i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++) {
+                out.push_back(m_bodies[i]);
+            }
+        }
+    }
+}
+
+i32 BodyBroadphase::cellX(f32 x) const {
+    return std::clamp(static_cast<i32>((x - m_minX) / CELL_SIZE), 0, m_cols - 1);
+}
+
+i32 BodyBroadphase::cellZ(f32 z) const {
+    return std::clamp(static_cast<i32>((z - m_minZ) / CELL_SIZE), 0, m_rows - 1);
+}
+
+}
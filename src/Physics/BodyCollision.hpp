@@ -0,0 +1,81 @@
+// BodyCollision.hpp
+// Player bodies as vertical capsules: ball narrowphase, grid broadphase, and contact events.
+#pragma once
+
+#include "Core/Types.hpp"
+#include "BallPhysics.hpp"
+#include <vector>
+
+namespace Sports {
+
+// Vertical capsule standing on the ground (same shape as Primitives::createCapsule)
+struct Capsule {
+    Vec3 base{0.0f};   // Ground point under the body
+    f32 radius = 0.3f;
+    f32 height = 1.8f; // Total height including caps
+
+    Vec3 segmentStart() const { return base + Vec3(0.0f, radius, 0.0f); }
+    Vec3 segmentEnd() const { return base + Vec3(0.0f, height - radius, 0.0f); }
+};
+
+// Result of a sphere-capsule overlap test
+struct BallContact {
+    Vec3 point{0.0f};   // Closest point on the capsule surface
+    Vec3 normal{0.0f};  // Points from body toward ball
+    f32 depth = 0.0f;   // Penetration distance
+    f32 heightRatio = 0.0f;  // Contact height along the body (0 = feet, 1 = top of head)
+};
+
+// A player touching the ball, recorded for game rules and analytics
+struct ContactEvent {
+    i32 team = 0;
+    i32 playerIndex = -1;  // AI index, -1 for the human player
+    Vec3 point{0.0f};
+    Vec3 normal{0.0f};
+    f32 impactSpeed = 0.0f;
+};
+
+// Static utility class for ball-vs-body collision
+class BodyCollision {
+public:
+    static constexpr f32 BODY_HEIGHT = 1.8f;          // meters
+    static constexpr f32 HEAD_RESTITUTION = 0.6f;     // Headers rebound firmly
+    static constexpr f32 CHEST_RESTITUTION = 0.15f;   // Chest absorbs (traps)
+    static constexpr f32 LEG_RESTITUTION = 0.35f;     // Blocks with legs
+    static constexpr f32 MOMENTUM_TRANSFER = 0.3f;    // Share of body speed given to ball
+
+    static bool sphereVsCapsule(const Vec3& center, f32 radius, const Capsule& capsule,
+                                BallContact& out);
+
+    // Separates the ball and reflects its velocity; returns impact speed along the normal
+    static f32 resolveBallContact(BallState& ball, const BallContact& contact,
+                                  const Vec3& bodyVelocity);
+
+private:
+    static f32 restitutionAt(f32 heightRatio);
+};
+
+// Uniform grid over the pitch, rebuilt every tick in O(n).
+// Queries only visit the cells around the probe, so cost stays flat as bodies are added.
+class BodyBroadphase {
+public:
+    static constexpr f32 CELL_SIZE = 4.0f;  // meters
+
+    void build(const std::vector<Capsule>& bodies, f32 fieldLength, f32 fieldWidth);
+    void query(const Vec3& center, f32 radius, std::vector<u32>& out) const;
+
+private:
+    i32 cellX(f32 x) const;
+    i32 cellZ(f32 z) const;
+
+    f32 m_minX = 0.0f;
+    f32 m_minZ = 0.0f;
+    i32 m_cols = 0;
+    i32 m_rows = 0;
+    f32 m_maxRadius = 0.0f;
+
+    std::vector<u32> m_cellStart;  // Prefix offsets into m_bodies (cells + 1)
+    std::vector<u32> m_bodies;     // Body indices grouped by cell
+};
+
+}
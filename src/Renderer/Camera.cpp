@@ -1,6 +1,7 @@
 // Camera.cpp
 // Third-person camera with exponential smoothing for lag effect.
 #include "Camera.hpp"
+#include "Math/FastMath.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -21,7 +22,7 @@ void Camera::setFollowTarget(const Vec3& targetPosition) {
 void Camera::update(f32 deltaTime) {
     // Exponential interpolation: frame-rate independent smoothing
     // t = 1 - e^(-speed * dt) gives consistent smoothing at any framerate
-    f32 t = 1.0f - std::exp(-m_lagSpeed * deltaTime);
+    f32 t = 1.0f - FastMath::exp(-m_lagSpeed * deltaTime);
 
     // Smoothly track the player position
     m_smoothedTargetPos.x += (m_targetPosition.x - m_smoothedTargetPos.x) * t;
@@ -81,6 +82,11 @@ Vec3 Camera::getRightXZ() const {
     ));
 }
 
+void Camera::lookAt(const Vec3& position, const Vec3& target) {
+    m_position = position;
+    m_viewMatrix = glm::lookAt(position, target, Vec3(0.0f, 1.0f, 0.0f));
+}
+
 void Camera::setPerspective(f32 fovDegrees, f32 aspectRatio, f32 nearPlane, f32 farPlane) {
     m_fov = fovDegrees;
     m_aspectRatio = aspectRatio;
@@ -16,6 +16,9 @@ public:
     void rotate(f32 deltaX, f32 deltaY);               // Mouse look
     void zoom(f32 delta);                               // Scroll wheel
 
+    // Fixed shot, no follow or smoothing (replays); the next update() takes over again
+    void lookAt(const Vec3& position, const Vec3& target);
+
     // Convert camera orientation to movement vectors (Y=0 for ground movement)
     Vec3 getForwardXZ() const;
     Vec3 getRightXZ() const;
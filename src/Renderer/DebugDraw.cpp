@@ -0,0 +1,185 @@
+// DebugDraw.cpp
+// Frame-thread primitive lists, the shared dynamic vertex buffer, and the two layer draws.
+#include "DebugDraw.hpp"
+
+#ifdef SPORTS_DEBUG_DRAW
+
+#include "Shader.hpp"
+#include "Core/Logger.hpp"
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <memory>
+
+namespace Sports {
+
+namespace {
+
+struct DebugDrawState {
+    DebugDrawBuffer buffer;
+    Shader shader;
+    u32 vao = 0;
+    u32 vbo = 0;
+    size_t capacity = 0;  // Vertices the buffer's current storage holds
+    u32 first[DebugDrawBuffer::LAYER_COUNT] = {};
+    u32 count[DebugDrawBuffer::LAYER_COUNT] = {};
+    bool enabled = true;
+};
+
+std::unique_ptr<DebugDrawState> s_state;  // Null before init() and after shutdown()
+
+DebugDrawBuffer* recording() {
+    return s_state && s_state->enabled ? &s_state->buffer : nullptr;
+}
+
+}
+
+bool DebugDraw::init() {
+    auto state = std::make_unique<DebugDrawState>();
+    if (!state->shader.loadFromFiles("shaders/debug_draw.vert", "shaders/debug_draw.frag")) {
+        LOG_WARN("Debug draw unavailable: shader failed to build");
+        return false;
+    }
+
+    glCreateBuffers(1, &state->vbo);
+    glCreateVertexArrays(1, &state->vao);
+    glVertexArrayVertexBuffer(state->vao, 0, state->vbo, 0, sizeof(DebugVertex));
+    glEnableVertexArrayAttrib(state->vao, 0);
+    glVertexArrayAttribFormat(state->vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(DebugVertex, position));
+    glVertexArrayAttribBinding(state->vao, 0, 0);
+    glEnableVertexArrayAttrib(state->vao, 1);
+    glVertexArrayAttribFormat(state->vao, 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(DebugVertex, color));
+    glVertexArrayAttribBinding(state->vao, 1, 0);
+
+    s_state = std::move(state);
+    return true;
+}
+
+void DebugDraw::shutdown() {
+    if (!s_state) {
+        return;
+    }
+    glDeleteVertexArrays(1, &s_state->vao);
+    glDeleteBuffers(1, &s_state->vbo);
+    s_state.reset();
+}
+
+void DebugDraw::setEnabled(bool enabled) {
+    if (s_state) {
+        s_state->enabled = enabled;
+        s_state->buffer.clear();
+    }
+}
+
+bool DebugDraw::isEnabled() {
+    return s_state && s_state->enabled;
+}
+
+void DebugDraw::line(const Vec3& from, const Vec3& to, const Vec3& color, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->line(layer, from, to, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::polyline(const Vec3* points, u32 count, const Vec3& color, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->polyline(layer, points, count, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::arrow(const Vec3& from, const Vec3& to, const Vec3& color, f32 headSize, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->arrow(layer, from, to, DebugDrawBuffer::packColor(color), headSize);
+    }
+}
+
+void DebugDraw::circle(const Vec3& center, f32 radius, const Vec3& color, const Vec3& normal, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->circle(layer, center, radius, normal, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::sphere(const Vec3& center, f32 radius, const Vec3& color, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->sphere(layer, center, radius, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::box(const Vec3& boundsMin, const Vec3& boundsMax, const Vec3& color, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->box(layer, boundsMin, boundsMax, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::cross(const Vec3& position, f32 size, const Vec3& color, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->cross(layer, position, size, DebugDrawBuffer::packColor(color));
+    }
+}
+
+void DebugDraw::text(const Vec3& anchor, std::string_view text, const Vec3& color, f32 height, DebugLayer layer) {
+    if (DebugDrawBuffer* buffer = recording()) {
+        buffer->label(layer, anchor, text, DebugDrawBuffer::packColor(color), height);
+    }
+}
+
+void DebugDraw::upload(const Mat4& view, const Mat4& projection) {
+    if (!s_state) {
+        return;
+    }
+    DebugDrawState& state = *s_state;
+    state.count[0] = state.count[1] = 0;
+    if (!state.enabled) {
+        return;
+    }
+
+    // The view matrix's rows are the camera axes in world space
+    state.buffer.layoutLabels(Vec3(view[0][0], view[1][0], view[2][0]), Vec3(view[0][1], view[1][1], view[2][1]));
+
+    size_t total = state.buffer.getVertexCount();
+    if (total == 0) {
+        return;
+    }
+
+    // Orphan to a fresh allocation each frame so last frame's draws never stall the copy
+    if (total > state.capacity) {
+        state.capacity = total + total / 2;
+    }
+    glNamedBufferData(state.vbo, static_cast<GLsizeiptr>(state.capacity * sizeof(DebugVertex)), nullptr,
+                      GL_STREAM_DRAW);
+
+    size_t offset = 0;
+    for (u32 layer = 0; layer < DebugDrawBuffer::LAYER_COUNT; layer++) {
+        const std::vector<DebugVertex>& vertices = state.buffer.getVertices(static_cast<DebugLayer>(layer));
+        state.first[layer] = static_cast<u32>(offset);
+        state.count[layer] = static_cast<u32>(vertices.size());
+        if (!vertices.empty()) {
+            glNamedBufferSubData(state.vbo, static_cast<GLintptr>(offset * sizeof(DebugVertex)),
+                                 static_cast<GLsizeiptr>(vertices.size() * sizeof(DebugVertex)), vertices.data());
+        }
+        offset += vertices.size();
+    }
+    state.buffer.clear();
+
+    state.shader.bind();
+    state.shader.setMat4("uViewProjection", projection * view);
+}
+
+void DebugDraw::draw(DebugLayer layer) {
+    u32 index = static_cast<u32>(layer);
+    if (!s_state || s_state->count[index] == 0) {
+        return;
+    }
+    s_state->shader.bind();
+    glBindVertexArray(s_state->vao);
+    glDrawArrays(GL_LINES, static_cast<GLint>(s_state->first[index]), static_cast<GLsizei>(s_state->count[index]));
+    glBindVertexArray(0);
+}
+
+u32 DebugDraw::getVertexCount(DebugLayer layer) {
+    return s_state ? s_state->count[static_cast<u32>(layer)] : 0;
+}
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+// DebugDraw.hpp
+// Immediate-mode debug lines, shapes, and labels, batched into one buffer and two draws per frame.
+#pragma once
+
+#include "DebugDrawBuffer.hpp"
+
+// Without SPORTS_DEBUG_DRAW (Release builds, or -DSPORTS_ENGINE_DEBUG_DRAW=OFF) every
+// entry point below is an empty inline function, so call sites compile to nothing
+#ifdef SPORTS_DEBUG_DRAW
+#define SPORTS_DEBUG_DRAW_BODY ;
+#define SPORTS_DEBUG_DRAW_RETURN(value) ;
+#else
+#define SPORTS_DEBUG_DRAW_BODY {}
+#define SPORTS_DEBUG_DRAW_RETURN(value) { return value; }
+#endif
+
+namespace Sports {
+
+// Record from anywhere on the frame thread during the frame. upload() sends it
+// all to the GPU in one buffer update and starts the next frame's lists; the
+// render graph then runs draw() once per layer, each a single GL_LINES draw.
+class DebugDraw {
+public:
+#ifdef SPORTS_DEBUG_DRAW
+    static constexpr bool COMPILED = true;
+#else
+    static constexpr bool COMPILED = false;  // For skipping argument set-up: if constexpr (DebugDraw::COMPILED)
+#endif
+
+    static bool init() SPORTS_DEBUG_DRAW_RETURN(true)
+    static void shutdown() SPORTS_DEBUG_DRAW_BODY
+
+    static void setEnabled(bool enabled) SPORTS_DEBUG_DRAW_BODY
+    static bool isEnabled() SPORTS_DEBUG_DRAW_RETURN(false)
+
+    static void line(const Vec3& from, const Vec3& to, const Vec3& color,
+                     DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void polyline(const Vec3* points, u32 count, const Vec3& color,
+                         DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void arrow(const Vec3& from, const Vec3& to, const Vec3& color, f32 headSize = 0.4f,
+                      DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void circle(const Vec3& center, f32 radius, const Vec3& color, const Vec3& normal = Vec3(0.0f, 1.0f, 0.0f),
+                       DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void sphere(const Vec3& center, f32 radius, const Vec3& color,
+                       DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void box(const Vec3& boundsMin, const Vec3& boundsMax, const Vec3& color,
+                    DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    static void cross(const Vec3& position, f32 size, const Vec3& color,
+                      DebugLayer layer = DebugLayer::DepthTested) SPORTS_DEBUG_DRAW_BODY
+    // Camera-facing, centred on the anchor; height in meters
+    static void text(const Vec3& anchor, std::string_view text, const Vec3& color, f32 height = 0.4f,
+                     DebugLayer layer = DebugLayer::Overlay) SPORTS_DEBUG_DRAW_BODY
+
+    static void upload(const Mat4& view, const Mat4& projection) SPORTS_DEBUG_DRAW_BODY
+    static void draw(DebugLayer layer) SPORTS_DEBUG_DRAW_BODY  // Render state comes from the caller's pass
+    static u32 getVertexCount(DebugLayer layer) SPORTS_DEBUG_DRAW_RETURN(0u)  // As of the last upload()
+};
+
+}
+
+#undef SPORTS_DEBUG_DRAW_BODY
+#undef SPORTS_DEBUG_DRAW_RETURN
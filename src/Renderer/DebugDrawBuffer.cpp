@@ -0,0 +1,229 @@
+// DebugDrawBuffer.cpp
+// Primitive tessellation into line lists and the stroke font used for labels.
+#include "DebugDrawBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sports {
+
+namespace {
+
+// Any unit vector perpendicular to the given one
+Vec3 perpendicular(const Vec3& direction) {
+    Vec3 helper = std::abs(direction.y) < 0.9f ? Vec3(0.0f, 1.0f, 0.0f) : Vec3(1.0f, 0.0f, 0.0f);
+    return glm::normalize(glm::cross(direction, helper));
+}
+
+}
+
+DebugDrawBuffer::DebugDrawBuffer() {
+    for (u32 i = 0; i < CIRCLE_SEGMENTS; i++) {
+        f32 angle = 6.28318530718f * static_cast<f32>(i) / CIRCLE_SEGMENTS;
+        m_unitCircle[i] = Vec2(std::cos(angle), std::sin(angle));
+    }
+}
+
+u32 DebugDrawBuffer::packColor(const Vec3& color, f32 alpha) {
+    auto channel = [](f32 value) {
+        return static_cast<u32>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(alpha) << 24);
+}
+
+bool DebugDrawBuffer::reserve(DebugLayer layer, size_t vertices) {
+    if (m_vertices[index(layer)].size() + vertices > MAX_VERTICES) {
+        m_dropped++;
+        return false;
+    }
+    return true;
+}
+
+void DebugDrawBuffer::line(DebugLayer layer, const Vec3& from, const Vec3& to, u32 color) {
+    if (!reserve(layer, 2)) return;
+    std::vector<DebugVertex>& vertices = m_vertices[index(layer)];
+    vertices.push_back({from, color});
+    vertices.push_back({to, color});
+}
+
+void DebugDrawBuffer::polyline(DebugLayer layer, const Vec3* points, u32 count, u32 color) {
+    if (count < 2 || !reserve(layer, 2 * static_cast<size_t>(count - 1))) return;
+    std::vector<DebugVertex>& vertices = m_vertices[index(layer)];
+    for (u32 i = 1; i < count; i++) {
+        vertices.push_back({points[i - 1], color});
+        vertices.push_back({points[i], color});
+    }
+}
+
+void DebugDrawBuffer::arrow(DebugLayer layer, const Vec3& from, const Vec3& to, u32 color, f32 headSize) {
+    Vec3 shaft = to - from;
+    f32 length = glm::length(shaft);
+    if (length <= 0.0f) return;
+    if (!reserve(layer, 10)) return;
+
+    // Head in two crossed planes so it reads from any side
+    Vec3 direction = shaft / length;
+    f32 head = std::min(headSize, length * 0.5f);
+    Vec3 side = perpendicular(direction) * (head * 0.5f);
+    Vec3 lift = glm::cross(direction, side);
+    Vec3 base = to - direction * head;
+
+    line(layer, from, to, color);
+    line(layer, to, base + side, color);
+    line(layer, to, base - side, color);
+    line(layer, to, base + lift, color);
+    line(layer, to, base - lift, color);
+}
+
+void DebugDrawBuffer::circle(DebugLayer layer, const Vec3& center, f32 radius, const Vec3& normal, u32 color) {
+    if (!reserve(layer, 2 * CIRCLE_SEGMENTS)) return;
+    Vec3 axisW = glm::normalize(normal);
+    Vec3 axisU = perpendicular(axisW) * radius;
+    Vec3 axisV = glm::cross(axisW, axisU);
+
+    // Sized once and written in place: circles are most of a busy frame's vertices
+    std::vector<DebugVertex>& vertices = m_vertices[index(layer)];
+    size_t first = vertices.size();
+    vertices.resize(first + 2 * CIRCLE_SEGMENTS);
+    DebugVertex* out = vertices.data() + first;
+    Vec3 previous = center + axisU;
+    for (u32 i = 1; i <= CIRCLE_SEGMENTS; i++) {
+        const Vec2& unit = m_unitCircle[i % CIRCLE_SEGMENTS];
+        Vec3 point = center + axisU * unit.x + axisV * unit.y;
+        *out++ = {previous, color};
+        *out++ = {point, color};
+        previous = point;
+    }
+}
+
+void DebugDrawBuffer::sphere(DebugLayer layer, const Vec3& center, f32 radius, u32 color) {
+    circle(layer, center, radius, Vec3(1.0f, 0.0f, 0.0f), color);
+    circle(layer, center, radius, Vec3(0.0f, 1.0f, 0.0f), color);
+    circle(layer, center, radius, Vec3(0.0f, 0.0f, 1.0f), color);
+}
+
+void DebugDrawBuffer::box(DebugLayer layer, const Vec3& boundsMin, const Vec3& boundsMax, u32 color) {
+    if (!reserve(layer, 24)) return;
+    auto corner = [&](u32 bits) {
+        return Vec3((bits & 1) ? boundsMax.x : boundsMin.x, (bits & 2) ? boundsMax.y : boundsMin.y,
+                    (bits & 4) ? boundsMax.z : boundsMin.z);
+    };
+    // Each edge joins two corners that differ in one axis bit
+    for (u32 bits = 0; bits < 8; bits++) {
+        for (u32 axis = 1; axis < 8; axis <<= 1) {
+            if (!(bits & axis)) {
+                line(layer, corner(bits), corner(bits | axis), color);
+            }
+        }
+    }
+}
+
+void DebugDrawBuffer::cross(DebugLayer layer, const Vec3& position, f32 size, u32 color) {
+    if (!reserve(layer, 6)) return;
+    f32 half = size * 0.5f;
+    line(layer, position - Vec3(half, 0.0f, 0.0f), position + Vec3(half, 0.0f, 0.0f), color);
+    line(layer, position - Vec3(0.0f, half, 0.0f), position + Vec3(0.0f, half, 0.0f), color);
+    line(layer, position - Vec3(0.0f, 0.0f, half), position + Vec3(0.0f, 0.0f, half), color);
+}
+
+void DebugDrawBuffer::label(DebugLayer layer, const Vec3& anchor, std::string_view text, u32 color, f32 height) {
+    if (text.empty()) return;
+    m_labels.push_back({anchor, color, height, layer, static_cast<u32>(m_labelText.size()),
+                        static_cast<u32>(text.size())});
+    m_labelText.append(text);
+}
+
+void DebugDrawBuffer::layoutLabels(const Vec3& right, const Vec3& up) {
+    for (const Label& text : m_labels) {
+        f32 scale = text.height / GLYPH_HEIGHT;
+        f32 width = text.textLength * GLYPH_ADVANCE - (GLYPH_ADVANCE - 4.0f);
+        Vec3 stepX = right * scale;
+        Vec3 stepY = up * scale;
+        Vec3 origin = text.anchor - stepX * (width * 0.5f);
+
+        for (u32 i = 0; i < text.textLength; i++) {
+            Vec3 cell = origin + stepX * (i * GLYPH_ADVANCE);
+            const char* strokes = glyphStrokes(m_labelText[text.textOffset + i]);
+            for (const char* s = strokes; *s; s += s[4] == ' ' ? 5 : 4) {
+                auto point = [&](char x, char y) {
+                    return cell + stepX * static_cast<f32>(x - '0') + stepY * static_cast<f32>(y - '0');
+                };
+                line(text.layer, point(s[0], s[1]), point(s[2], s[3]), text.color);
+            }
+        }
+    }
+    m_labels.clear();
+    m_labelText.clear();
+}
+
+void DebugDrawBuffer::clear() {
+    for (std::vector<DebugVertex>& vertices : m_vertices) {
+        vertices.clear();
+    }
+    m_labels.clear();
+    m_labelText.clear();
+}
+
+size_t DebugDrawBuffer::getVertexCount() const {
+    size_t count = 0;
+    for (const std::vector<DebugVertex>& vertices : m_vertices) {
+        count += vertices.size();
+    }
+    return count;
+}
+
+const char* DebugDrawBuffer::glyphStrokes(char c) {
+    switch (c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c) {
+        case ' ': return "";
+        case '0': return "0040 4046 4606 0600 0046";
+        case '1': return "2026 2615 1030";
+        case '2': return "0646 4643 4303 0300 0040";
+        case '3': return "0646 4640 4000 1343";
+        case '4': return "0603 0343 4640";
+        case '5': return "4606 0603 0343 4340 4000";
+        case '6': return "4606 0600 0040 4043 4303";
+        case '7': return "0646 4620";
+        case '8': return "0040 4046 4606 0600 0343";
+        case '9': return "4303 0306 0646 4640 4000";
+        case 'A': return "0026 2640 1333";
+        case 'B': return "0006 0636 3645 4544 4433 0333 3342 4241 4130 3000";
+        case 'C': return "4606 0600 0040";
+        case 'D': return "0006 0636 3645 4541 4130 3000";
+        case 'E': return "4606 0600 0040 0333";
+        case 'F': return "4606 0600 0333";
+        case 'G': return "4606 0600 0040 4043 4323";
+        case 'H': return "0006 4046 0343";
+        case 'I': return "0646 2026 0040";
+        case 'J': return "2646 4641 4130 3010 1001";
+        case 'K': return "0006 0346 0340";
+        case 'L': return "0600 0040";
+        case 'M': return "0006 0623 2346 4640";
+        case 'N': return "0006 0640 4046";
+        case 'O': return "0040 4046 4606 0600";
+        case 'P': return "0006 0646 4643 4303";
+        case 'Q': return "0040 4046 4606 0600 2240";
+        case 'R': return "0006 0646 4643 4303 0340";
+        case 'S': return "4606 0603 0343 4340 4000";
+        case 'T': return "0646 2620";
+        case 'U': return "0600 0040 4046";
+        case 'V': return "0620 2046";
+        case 'W': return "0610 1023 2330 3046";
+        case 'X': return "0046 0640";
+        case 'Y': return "0623 2346 2320";
+        case 'Z': return "0646 4600 0040";
+        case '.': return "2021";
+        case ',': return "2110";
+        case ':': return "2122 2425";
+        case '-': return "1333";
+        case '+': return "1333 2224";
+        case '=': return "1232 1434";
+        case '/': return "0046";
+        case '%': return "0046 0516 3041";
+        case '(': return "3625 2521 2130";
+        case ')': return "1625 2521 2110";
+        case '_': return "0040";
+        default: return "0646 4643 4323 2322 2021";  // '?'
+    }
+}
+
+}
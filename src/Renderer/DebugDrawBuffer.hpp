@@ -0,0 +1,77 @@
+// DebugDrawBuffer.hpp
+// Per-frame line-list accumulation for debug primitives and stroke-font labels.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Sports {
+
+enum class DebugLayer : u8 {
+    DepthTested,  // Hidden behind scene geometry
+    Overlay,      // Always on top
+};
+
+struct DebugVertex {
+    Vec3 position;
+    u32 color;  // RGBA8, red in the low byte
+};
+
+// Every primitive becomes GL_LINES vertices in its layer's list, so a frame of
+// them is two draws however many there are. Labels are queued and only laid out
+// by layoutLabels(), once the camera that they face is known.
+class DebugDrawBuffer {
+public:
+    static constexpr u32 LAYER_COUNT = 2;
+    static constexpr u32 CIRCLE_SEGMENTS = 24;
+    static constexpr size_t MAX_VERTICES = 1u << 20;  // Per layer; beyond it primitives are dropped
+    static constexpr f32 GLYPH_HEIGHT = 6.0f;         // Stroke-font grid units per label height
+    static constexpr f32 GLYPH_ADVANCE = 6.0f;        // Four units of glyph, two of spacing
+
+    DebugDrawBuffer();
+
+    void line(DebugLayer layer, const Vec3& from, const Vec3& to, u32 color);
+    void polyline(DebugLayer layer, const Vec3* points, u32 count, u32 color);
+    void arrow(DebugLayer layer, const Vec3& from, const Vec3& to, u32 color, f32 headSize);
+    void circle(DebugLayer layer, const Vec3& center, f32 radius, const Vec3& normal, u32 color);
+    void sphere(DebugLayer layer, const Vec3& center, f32 radius, u32 color);
+    void box(DebugLayer layer, const Vec3& boundsMin, const Vec3& boundsMax, u32 color);
+    void cross(DebugLayer layer, const Vec3& position, f32 size, u32 color);
+    void label(DebugLayer layer, const Vec3& anchor, std::string_view text, u32 color, f32 height);
+
+    // Centres each queued label on its anchor, in the plane spanned by right and up
+    void layoutLabels(const Vec3& right, const Vec3& up);
+    void clear();  // Keeps the allocations for the next frame
+
+    const std::vector<DebugVertex>& getVertices(DebugLayer layer) const { return m_vertices[index(layer)]; }
+    size_t getVertexCount() const;
+    u64 getDroppedCount() const { return m_dropped; }  // Primitives over MAX_VERTICES, since construction
+
+    static u32 packColor(const Vec3& color, f32 alpha = 1.0f);
+    // Strokes as "x0y0x1y1" digit quads on a 4x6 grid; lower case draws as upper case
+    static const char* glyphStrokes(char c);
+
+private:
+    struct Label {
+        Vec3 anchor;
+        u32 color;
+        f32 height;
+        DebugLayer layer;
+        u32 textOffset;
+        u32 textLength;
+    };
+
+    static u32 index(DebugLayer layer) { return static_cast<u32>(layer); }
+    bool reserve(DebugLayer layer, size_t vertices);  // False (and counted) when the layer is full
+
+    std::array<Vec2, CIRCLE_SEGMENTS> m_unitCircle;
+    std::vector<DebugVertex> m_vertices[LAYER_COUNT];
+    std::vector<Label> m_labels;
+    std::string m_labelText;  // Every label's characters back to back
+    u64 m_dropped = 0;
+};
+
+}
@@ -0,0 +1,129 @@
+// FrameCapture.cpp
+// PBO colour readback with fences; completed copies are copied out in capture order.
+#include "FrameCapture.hpp"
+#include "Core/Logger.hpp"
+
+#include <glad/gl.h>
+#include <cstring>
+
+namespace Sports {
+
+FrameCapture::~FrameCapture() {
+    release();
+}
+
+void FrameCapture::release() {
+    for (Slot& slot : m_ring) {
+        if (slot.fence) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+            slot.fence = nullptr;
+        }
+        if (slot.buffer) {
+            glDeleteBuffers(1, &slot.buffer);
+            slot.buffer = 0;
+        }
+    }
+    m_next = 0;
+    m_oldest = 0;
+}
+
+bool FrameCapture::start(const std::string& path, u32 width, u32 height, u32 fps) {
+    stop();
+    VideoFormat format = FrameEncoder::formatForPath(path);
+    if (!m_encoder.open(path, width, height, fps, format)) {
+        LOG_ERROR("Failed to start recording to {}", path);
+        return false;
+    }
+
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(width) * height * 4;
+    for (Slot& slot : m_ring) {
+        glCreateBuffers(1, &slot.buffer);
+        glNamedBufferData(slot.buffer, bytes, nullptr, GL_STREAM_READ);
+    }
+
+    LOG_INFO("Recording {}x{} at {} fps to {} ({})", width, height, fps, path,
+             format == VideoFormat::Y4M ? "y4m" : "raw rgba");
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!isRecording()) {
+        return;
+    }
+
+    // Stopping may stall; losing the last few frames would be worse
+    while (harvest(true)) {
+    }
+    release();
+    m_encoder.close();
+    LOG_INFO("Recording stopped: {} frames written, {} dropped",
+             getWrittenCounter()->load(std::memory_order_relaxed),
+             getDroppedCounter()->load(std::memory_order_relaxed));
+}
+
+void FrameCapture::capture(u32 width, u32 height) {
+    if (!isRecording()) {
+        return;
+    }
+    if (width != m_encoder.getWidth() || height != m_encoder.getHeight()) {
+        m_encoder.dropFrame();  // Resized mid-recording: the video keeps its size
+        return;
+    }
+
+    // Unlike depth for culling, no frame may be overwritten before it is handed over
+    Slot& slot = m_ring[m_next];
+    if (slot.fence && !(m_lossless && harvest(true))) {
+        m_encoder.dropFrame();
+        return;
+    }
+    m_next = (m_next + 1) % RING_SIZE;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE,
+                 nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void FrameCapture::update() {
+    if (!isRecording()) {
+        return;
+    }
+    while (harvest(false)) {
+    }
+}
+
+bool FrameCapture::harvest(bool wait) {
+    Slot& slot = m_ring[m_oldest];
+    if (!slot.fence) {
+        return false;
+    }
+
+    GLsync fence = static_cast<GLsync>(slot.fence);
+    GLenum status = wait ? glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ~GLuint64(0))
+                         : glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;  // Later slots were queued later, so none of them is ready either
+    }
+
+    std::vector<u8>* frame = m_encoder.acquireFrame(wait || m_lossless);
+    if (frame) {
+        const void* pixels = glMapNamedBufferRange(slot.buffer, 0, static_cast<GLsizeiptr>(frame->size()),
+                                                   GL_MAP_READ_BIT);
+        if (pixels) {
+            std::memcpy(frame->data(), pixels, frame->size());
+            glUnmapNamedBuffer(slot.buffer);
+            m_encoder.submitFrame(frame);
+        } else {
+            m_encoder.cancelFrame(frame);
+        }
+    }
+
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+    m_oldest = (m_oldest + 1) % RING_SIZE;
+    return true;
+}
+
+}
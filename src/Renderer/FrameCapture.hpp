@@ -0,0 +1,58 @@
+// FrameCapture.hpp
+// Asynchronous colour readback into a fenced PBO ring feeding a background video encoder.
+#pragma once
+
+#include "Core/FrameEncoder.hpp"
+#include <array>
+
+namespace Sports {
+
+// capture() at the end of a frame queues a glReadPixels into a pixel pack buffer,
+// which returns as soon as the copy is recorded. update() at the start of a later
+// frame hands every copy the GPU has finished, oldest first, to the encoder thread.
+// Nothing on the render thread waits: a ring slot still in flight or a full
+// encoder queue drops that frame from the video instead.
+class FrameCapture {
+public:
+    static constexpr u32 RING_SIZE = 3;
+
+    FrameCapture() = default;
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Creates the encoder thread now, idle, so it doesn't inherit what the caller's thread becomes
+    void prepare() { m_encoder.startWorker(); }
+
+    // The path's extension picks the format; see FrameEncoder::formatForPath
+    bool start(const std::string& path, u32 width, u32 height, u32 fps);
+    void stop();  // Waits for the copies in flight so the file ends on the last captured frame
+    bool isRecording() const { return m_encoder.isOpen(); }
+
+    // Offscreen: no frame rate to protect, so wait for slots and queue space rather than drop
+    void setLossless(bool lossless) { m_lossless = lossless; }
+
+    void capture(u32 width, u32 height);  // Reads the bound READ framebuffer; other sizes are dropped
+    void update();
+
+    const std::atomic<u64>* getWrittenCounter() const { return m_encoder.getWrittenCounter(); }
+    const std::atomic<u64>* getDroppedCounter() const { return m_encoder.getDroppedCounter(); }
+
+private:
+    void release();
+    bool harvest(bool wait);  // The oldest pending slot; false when it isn't ready
+
+    struct Slot {
+        u32 buffer = 0;         // GL_PIXEL_PACK_BUFFER, one RGBA8 frame
+        void* fence = nullptr;  // GLsync, null when the slot is free
+    };
+
+    FrameEncoder m_encoder;
+    std::array<Slot, RING_SIZE> m_ring;
+    u32 m_next = 0;     // Slot the next capture writes
+    u32 m_oldest = 0;   // Slot update() hands over next
+    bool m_lossless = false;
+};
+
+}
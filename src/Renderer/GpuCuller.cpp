@@ -0,0 +1,203 @@
+// GpuCuller.cpp
+// Instance/visible/command buffers, the cull dispatch, and fenced statistics readback.
+#include "GpuCuller.hpp"
+#include "Mesh.hpp"
+#include "OcclusionCuller.hpp"
+#include "Core/Logger.hpp"
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Sports {
+
+GpuCuller::~GpuCuller() {
+    for (StatsSlot& slot : m_stats) {
+        if (slot.fence) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+        }
+        if (slot.buffer) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+    u32 buffers[] = {m_instanceBuffer, m_visibleBuffer, m_commandBuffer, m_hizBuffer};
+    for (u32 buffer : buffers) {
+        if (buffer) {
+            glDeleteBuffers(1, &buffer);
+        }
+    }
+}
+
+bool GpuCuller::init() {
+    if (!m_cullShader.loadComputeFromFiles("shaders/cull_instances.comp")) {
+        LOG_WARN("GPU culling unavailable: compute shader failed to build");
+        return false;
+    }
+    return true;
+}
+
+u32 GpuCuller::addDraw(Mesh& mesh) {
+    if (!mesh.isIndexed()) {
+        LOG_WARN("GPU culling needs indexed meshes; draw {} will stay empty", m_meshes.size());
+    }
+    m_meshes.push_back(&mesh);
+    m_commands.push_back({mesh.getIndexCount(), 0, 0, 0, 0});
+    return static_cast<u32>(m_meshes.size() - 1);
+}
+
+void GpuCuller::addInstance(u32 draw, const Mat4& model, const Vec3& boundsMin, const Vec3& boundsMax) {
+    m_pending.push_back({model, boundsMin, draw, boundsMax});
+    m_commands[draw].baseInstance++;  // Counts per draw until upload() turns them into offsets
+}
+
+void GpuCuller::upload() {
+    static_assert(sizeof(GpuInstance) == 96, "GpuInstance must match the std430 Instance");
+    static_assert(sizeof(DrawCommand) == 20, "DrawCommand must match glDrawElementsIndirect");
+    static_assert(sizeof(CommandHeader) == 16, "Commands array starts 16 bytes in");
+
+    // Each draw owns enough of the visible buffer for all of its instances
+    u32 offset = 0;
+    for (DrawCommand& command : m_commands) {
+        u32 count = command.baseInstance;
+        command.baseInstance = offset;
+        offset += count;
+    }
+    m_instanceCount = static_cast<u32>(m_pending.size());
+
+    glCreateBuffers(1, &m_instanceBuffer);
+    glNamedBufferStorage(m_instanceBuffer, std::max<size_t>(m_pending.size() * sizeof(GpuInstance), 1),
+                         m_pending.data(), 0);
+    glCreateBuffers(1, &m_visibleBuffer);
+    glNamedBufferStorage(m_visibleBuffer, std::max<size_t>(m_instanceCount * sizeof(Mat4), 1), nullptr, 0);
+    glCreateBuffers(1, &m_commandBuffer);
+    glNamedBufferStorage(m_commandBuffer, getCommandBytes(), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    // Header only until depth arrives, so the binding is always backed
+    glCreateBuffers(1, &m_hizBuffer);
+    std::vector<u32> emptyLevels(MAX_HIZ_LEVELS * 4, 0);
+    glNamedBufferData(m_hizBuffer, emptyLevels.size() * sizeof(u32), emptyLevels.data(), GL_STREAM_DRAW);
+
+    for (StatsSlot& slot : m_stats) {
+        glCreateBuffers(1, &slot.buffer);
+        glNamedBufferData(slot.buffer, getCommandBytes(), nullptr, GL_STREAM_READ);
+    }
+
+    for (Mesh* mesh : m_meshes) {
+        mesh->setInstanceBuffer(m_visibleBuffer);
+    }
+
+    m_pending.clear();
+    m_pending.shrink_to_fit();
+    LOG_INFO("GPU culling: {} instances in {} indirect draws", m_instanceCount, m_meshes.size());
+}
+
+void GpuCuller::cull(const Mat4& viewProjection, const OcclusionCuller& occlusion) {
+    if (!isReady()) {
+        return;
+    }
+
+    // The slot about to be reused was copied STATS_RING frames ago
+    StatsSlot& slot = m_stats[m_statsNext];
+    m_statsNext = (m_statsNext + 1) % STATS_RING;
+    readStats(slot);
+
+    const HiZPyramid& pyramid = occlusion.getPyramid();
+    bool useDepth = occlusion.isEnabled() && pyramid.isValid();
+    if (useDepth && occlusion.getPyramidVersion() != m_pyramidVersion) {
+        uploadPyramid(pyramid);
+        m_pyramidVersion = occlusion.getPyramidVersion();
+    }
+
+    // Counts start from zero every frame; the index ranges never change
+    CommandHeader header;
+    glNamedBufferSubData(m_commandBuffer, 0, sizeof(header), &header);
+    glNamedBufferSubData(m_commandBuffer, sizeof(header), m_commands.size() * sizeof(DrawCommand),
+                         m_commands.data());
+
+    m_cullShader.bind();
+    m_cullShader.setInt("uInstanceCount", static_cast<i32>(m_instanceCount));
+    m_cullShader.setMat4("uViewProjection", viewProjection);
+    m_cullShader.setInt("uOcclusion", useDepth ? 1 : 0);
+    if (useDepth) {
+        m_cullShader.setMat4("uHiZViewProjection", pyramid.getViewProjection());
+        m_cullShader.setVec2("uHiZSize", Vec2(pyramid.getSourceWidth(), pyramid.getSourceHeight()));
+        m_cullShader.setInt("uHiZLevels", static_cast<i32>(std::min(pyramid.getLevelCount(), MAX_HIZ_LEVELS)));
+        m_cullShader.setFloat("uBaseBlock", static_cast<f32>(HiZPyramid::BASE_BLOCK));
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_instanceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_visibleBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_hizBuffer);
+    glDispatchCompute((m_instanceCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    // Indirect draws, instance attributes, and the statistics copy all read what the dispatch wrote
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    glCopyNamedBufferSubData(m_commandBuffer, slot.buffer, 0, 0, getCommandBytes());
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void GpuCuller::draw() const {
+    if (!isReady()) {
+        return;
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+    for (u32 i = 0; i < m_meshes.size(); i++) {
+        m_meshes[i]->drawIndirect(sizeof(CommandHeader) + i * sizeof(DrawCommand));
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void GpuCuller::uploadPyramid(const HiZPyramid& pyramid) {
+    // Level table, then every level's texels back to back
+    u32 levels = std::min(pyramid.getLevelCount(), MAX_HIZ_LEVELS);
+    size_t texels = 0;
+    for (u32 level = 0; level < levels; level++) {
+        texels += static_cast<size_t>(pyramid.getLevelWidth(level)) * pyramid.getLevelHeight(level);
+    }
+
+    m_hizScratch.assign(MAX_HIZ_LEVELS * 4 + texels, 0);
+    u32 offset = 0;
+    for (u32 level = 0; level < levels; level++) {
+        u32 width = pyramid.getLevelWidth(level);
+        u32 height = pyramid.getLevelHeight(level);
+        m_hizScratch[level * 4 + 0] = offset;
+        m_hizScratch[level * 4 + 1] = width;
+        m_hizScratch[level * 4 + 2] = height;
+        std::memcpy(&m_hizScratch[MAX_HIZ_LEVELS * 4 + offset], pyramid.getLevelData(level),
+                    static_cast<size_t>(width) * height * sizeof(f32));
+        offset += width * height;
+    }
+
+    // Fresh storage each time, so frames still reading the old pyramid never stall this upload
+    glNamedBufferData(m_hizBuffer, m_hizScratch.size() * sizeof(u32), m_hizScratch.data(), GL_STREAM_DRAW);
+}
+
+void GpuCuller::readStats(StatsSlot& slot) {
+    if (!slot.fence) {
+        return;
+    }
+
+    // Never waits: a copy that hasn't landed is skipped, keeping the previous numbers
+    GLenum status = glClientWaitSync(static_cast<GLsync>(slot.fence), 0, 0);
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+        CommandHeader header;
+        m_readback.resize(m_commands.size());
+        glGetNamedBufferSubData(slot.buffer, 0, sizeof(header), &header);
+        glGetNamedBufferSubData(slot.buffer, sizeof(header), m_readback.size() * sizeof(DrawCommand),
+                                m_readback.data());
+
+        m_frustumCulled = header.frustumCulled;
+        m_occluded = header.occluded;
+        m_drawn = 0;
+        for (const DrawCommand& command : m_readback) {
+            m_drawn += command.instanceCount;
+        }
+    }
+    glDeleteSync(static_cast<GLsync>(slot.fence));
+    slot.fence = nullptr;
+}
+
+}
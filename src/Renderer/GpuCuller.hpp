@@ -0,0 +1,107 @@
+// GpuCuller.hpp
+// Compute-shader frustum and Hi-Z culling that writes indirect draw commands.
+#pragma once
+
+#include "Shader.hpp"
+#include <array>
+#include <vector>
+
+namespace Sports {
+
+class Mesh;
+class HiZPyramid;
+class OcclusionCuller;
+
+// Instances live in a GPU buffer for good. Every frame one dispatch tests all of
+// them, compacts the survivors' model matrices into each draw's range of a
+// second buffer, and writes the instance counts straight into the indirect
+// commands, so the CPU issues one draw per mesh however many instances there are.
+//
+// Only core GL 4.3 features (compute, SSBOs, glDrawElementsIndirect), so it also
+// runs on software rasterizers such as llvmpipe.
+class GpuCuller {
+public:
+    static constexpr u32 WORKGROUP_SIZE = 64;   // local_size_x in cull_instances.comp
+    static constexpr u32 MAX_HIZ_LEVELS = 16;   // MAX_HIZ_LEVELS in cull_instances.comp
+    static constexpr u32 STATS_RING = 3;        // Frames a statistics copy has to land
+
+    GpuCuller() = default;
+    ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    bool init();  // Compiles the compute shader; false leaves the caller on CPU culling
+
+    // Meshes are owned by the caller, must be indexed, and outlive the culler
+    u32 addDraw(Mesh& mesh);
+    void addInstance(u32 draw, const Mat4& model, const Vec3& boundsMin, const Vec3& boundsMax);
+    void upload();  // After the last addInstance: fixes each draw's range and creates the buffers
+
+    void cull(const Mat4& viewProjection, const OcclusionCuller& occlusion);
+    void draw() const;  // With a SHADER_INSTANCING shader bound
+
+    bool isReady() const { return m_instanceBuffer != 0; }
+    u32 getInstanceCount() const { return m_instanceCount; }
+    u32 getDrawCount() const { return static_cast<u32>(m_meshes.size()); }
+
+    // From a few frames ago: the statistics are read back without waiting on the GPU
+    u32 getDrawnCount() const { return m_drawn; }
+    u32 getFrustumCulledCount() const { return m_frustumCulled; }
+    u32 getOccludedCount() const { return m_occluded; }
+
+private:
+    // std430 layouts shared with cull_instances.comp
+    struct GpuInstance {
+        Mat4 model;
+        Vec3 boundsMin;
+        u32 draw;
+        Vec3 boundsMax;
+        u32 padding = 0;
+    };
+
+    struct DrawCommand {
+        u32 count;
+        u32 instanceCount;
+        u32 firstIndex;
+        i32 baseVertex;
+        u32 baseInstance;
+    };
+
+    struct CommandHeader {
+        u32 frustumCulled = 0;
+        u32 occluded = 0;
+        u32 reserved[2] = {0, 0};
+    };
+
+    struct StatsSlot {
+        u32 buffer = 0;
+        void* fence = nullptr;  // GLsync
+    };
+
+    void uploadPyramid(const HiZPyramid& pyramid);
+    void readStats(StatsSlot& slot);
+    size_t getCommandBytes() const { return sizeof(CommandHeader) + m_commands.size() * sizeof(DrawCommand); }
+
+    Shader m_cullShader;
+    std::vector<Mesh*> m_meshes;            // Per draw
+    std::vector<DrawCommand> m_commands;    // Per draw, instanceCount always 0: the per-frame reset
+    std::vector<GpuInstance> m_pending;     // Until upload()
+    std::vector<DrawCommand> m_readback;
+    std::vector<u32> m_hizScratch;
+
+    u32 m_instanceBuffer = 0;
+    u32 m_visibleBuffer = 0;
+    u32 m_commandBuffer = 0;   // Header then one DrawCommand per draw
+    u32 m_hizBuffer = 0;
+    u32 m_instanceCount = 0;
+    u64 m_pyramidVersion = ~0ull;
+
+    std::array<StatsSlot, STATS_RING> m_stats;
+    u32 m_statsNext = 0;
+    u32 m_drawn = 0;
+    u32 m_frustumCulled = 0;
+    u32 m_occluded = 0;
+};
+
+}
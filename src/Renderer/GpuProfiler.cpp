@@ -0,0 +1,103 @@
+// GpuProfiler.cpp
+// Timestamp query pooling and non-blocking result collection.
+#include "GpuProfiler.hpp"
+#include "Core/Timer.hpp"
+
+#include <glad/gl.h>
+
+namespace Sports {
+
+GpuProfiler::~GpuProfiler() {
+    for (Frame& frame : m_frames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+    }
+}
+
+void GpuProfiler::beginFrame() {
+    m_current = (m_current + 1) % LATENCY;
+    Frame& frame = m_frames[m_current];
+    if (frame.pending && !collect(frame)) {
+        m_dropped++;
+    }
+    frame.passes.clear();
+    frame.pending = false;
+}
+
+void GpuProfiler::beginPass(const char* name) {
+    if (m_inPass) {
+        endPass();
+    }
+
+    Frame& frame = m_frames[m_current];
+    u32 needed = static_cast<u32>(frame.passes.size() + 1) * 2;
+    if (frame.queries.size() < needed) {
+        size_t first = frame.queries.size();
+        frame.queries.resize(needed);
+        glGenQueries(static_cast<GLsizei>(needed - first), frame.queries.data() + first);
+    }
+
+    Pass pass;
+    pass.name = name;
+    pass.beginQuery = frame.queries[needed - 2];
+    pass.endQuery = frame.queries[needed - 1];
+    glQueryCounter(pass.beginQuery, GL_TIMESTAMP);
+    frame.passes.push_back(pass);
+
+    m_passStartTicks = CycleClock::now();
+    m_inPass = true;
+}
+
+void GpuProfiler::endPass() {
+    if (!m_inPass) {
+        return;
+    }
+    Frame& frame = m_frames[m_current];
+    Pass& pass = frame.passes.back();
+    glQueryCounter(pass.endQuery, GL_TIMESTAMP);
+    pass.cpuTicks = CycleClock::now() - m_passStartTicks;
+    frame.pending = true;
+    m_inPass = false;
+}
+
+bool GpuProfiler::collect(Frame& frame) {
+    // Queries complete in order, so the last one being ready means all are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.passes.back().endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+
+    m_results.resize(frame.passes.size());
+    for (size_t i = 0; i < frame.passes.size(); i++) {
+        const Pass& pass = frame.passes[i];
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(pass.beginQuery, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(pass.endQuery, GL_QUERY_RESULT, &end);
+
+        m_results[i].name = pass.name;
+        m_results[i].gpuMillis = static_cast<f64>(end - begin) * 1e-6;
+        m_results[i].cpuMillis = CycleClock::toSeconds(pass.cpuTicks) * 1000.0;
+    }
+    return true;
+}
+
+f64 GpuProfiler::getGpuMillis(const std::string& name) const {
+    f64 total = 0.0;
+    for (const PassTiming& timing : m_results) {
+        if (timing.name == name) total += timing.gpuMillis;
+    }
+    return total;
+}
+
+f64 GpuProfiler::getCpuMillis(const std::string& name) const {
+    f64 total = 0.0;
+    for (const PassTiming& timing : m_results) {
+        if (timing.name == name) total += timing.cpuMillis;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,65 @@
+// GpuProfiler.hpp
+// Per-pass GPU timestamps and CPU times, read back a few frames late so nothing stalls.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+struct PassTiming {
+    std::string name;
+    f64 gpuMillis = 0.0;
+    f64 cpuMillis = 0.0;   // Recording time on the render thread
+};
+
+// beginPass/endPass bracket each pass with GL_TIMESTAMP queries. Results for a
+// frame are collected LATENCY frames later, when its slot comes round again; a
+// frame whose queries still aren't ready is dropped rather than waited for.
+class GpuProfiler {
+public:
+    static constexpr u32 LATENCY = 3;
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void beginFrame();
+    void beginPass(const char* name);  // Passes don't nest
+    void endPass();
+
+    // Most recent completed frame, in submission order
+    const std::vector<PassTiming>& getResults() const { return m_results; }
+    f64 getGpuMillis(const std::string& name) const;  // Summed over passes sharing the name; 0 if none ran
+    f64 getCpuMillis(const std::string& name) const;
+    u64 getDroppedFrames() const { return m_dropped; }
+
+private:
+    struct Pass {
+        std::string name;   // Copied: callers' names needn't outlive the frame
+        u32 beginQuery = 0;
+        u32 endQuery = 0;
+        u64 cpuTicks = 0;
+    };
+
+    struct Frame {
+        std::vector<Pass> passes;
+        std::vector<u32> queries;   // Reused between frames, two per pass
+        bool pending = false;
+    };
+
+    bool collect(Frame& frame);
+
+    std::array<Frame, LATENCY> m_frames;
+    std::vector<PassTiming> m_results;
+    u32 m_current = 0;
+    u64 m_passStartTicks = 0;
+    u64 m_dropped = 0;
+    bool m_inPass = false;
+};
+
+}
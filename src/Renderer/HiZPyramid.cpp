@@ -0,0 +1,175 @@
+// HiZPyramid.cpp
+// Pyramid reduction (four rows at a time on SSE) and screen-rect occlusion queries.
+#include "HiZPyramid.hpp"
+#include "Math/Simd.hpp"
+
+#include <algorithm>
+
+namespace Sports {
+
+namespace {
+
+void corners(const Vec3& boundsMin, const Vec3& boundsMax, Vec3 out[8]) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = Vec3((i & 1) ? boundsMax.x : boundsMin.x,
+                      (i & 2) ? boundsMax.y : boundsMin.y,
+                      (i & 4) ? boundsMax.z : boundsMin.z);
+    }
+}
+
+}
+
+void HiZPyramid::build(const f32* depth, u32 width, u32 height, const Mat4& viewProjection) {
+    if (width == 0 || height == 0) {
+        m_valid = false;
+        return;
+    }
+
+    if (width != m_width || height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_levels.clear();
+        u32 levelWidth = (width + BASE_BLOCK - 1) / BASE_BLOCK;
+        u32 levelHeight = (height + BASE_BLOCK - 1) / BASE_BLOCK;
+        while (true) {
+            Level level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.depth.resize(static_cast<size_t>(levelWidth) * levelHeight);
+            m_levels.push_back(std::move(level));
+            if (levelWidth == 1 && levelHeight == 1) break;
+            levelWidth = (levelWidth + 1) / 2;
+            levelHeight = (levelHeight + 1) / 2;
+        }
+    }
+
+    buildBase(depth);
+    for (u32 level = 1; level < m_levels.size(); level++) {
+        buildLevel(level);
+    }
+    m_viewProjection = viewProjection;
+    m_valid = true;
+}
+
+void HiZPyramid::buildBase(const f32* depth) {
+    Level& base = m_levels[0];
+    for (u32 ty = 0; ty < base.height; ty++) {
+        u32 y0 = ty * BASE_BLOCK;
+        u32 rows = std::min(BASE_BLOCK, m_height - y0);
+        for (u32 tx = 0; tx < base.width; tx++) {
+            u32 x0 = tx * BASE_BLOCK;
+            u32 cols = std::min(BASE_BLOCK, m_width - x0);
+            const f32* block = depth + static_cast<size_t>(y0) * m_width + x0;
+
+            f32 farthest;
+            if (rows == BASE_BLOCK && cols == BASE_BLOCK) {
+                // Interior block: one 4-wide load per row
+                Float4 m = Float4::loadUnaligned(block);
+                m = max(m, Float4::loadUnaligned(block + m_width));
+                m = max(m, Float4::loadUnaligned(block + 2 * m_width));
+                m = max(m, Float4::loadUnaligned(block + 3 * m_width));
+                farthest = horizontalMax(m);
+            } else {
+                farthest = 0.0f;
+                for (u32 y = 0; y < rows; y++) {
+                    for (u32 x = 0; x < cols; x++) {
+                        farthest = std::max(farthest, block[static_cast<size_t>(y) * m_width + x]);
+                    }
+                }
+            }
+            base.depth[static_cast<size_t>(ty) * base.width + tx] = farthest;
+        }
+    }
+}
+
+void HiZPyramid::buildLevel(u32 level) {
+    const Level& source = m_levels[level - 1];
+    Level& target = m_levels[level];
+    for (u32 y = 0; y < target.height; y++) {
+        u32 sy0 = 2 * y;
+        u32 sy1 = std::min(sy0 + 1, source.height - 1);
+        for (u32 x = 0; x < target.width; x++) {
+            u32 sx0 = 2 * x;
+            u32 sx1 = std::min(sx0 + 1, source.width - 1);
+            target.depth[static_cast<size_t>(y) * target.width + x] = std::max(
+                std::max(source.depth[sy0 * source.width + sx0], source.depth[sy0 * source.width + sx1]),
+                std::max(source.depth[sy1 * source.width + sx0], source.depth[sy1 * source.width + sx1]));
+        }
+    }
+}
+
+bool HiZPyramid::isVisible(const Vec3& boundsMin, const Vec3& boundsMax) const {
+    if (!m_valid) {
+        return true;
+    }
+
+    Vec3 points[8];
+    corners(boundsMin, boundsMax, points);
+
+    Vec3 ndcMin(1e30f);
+    Vec3 ndcMax(-1e30f);
+    for (const Vec3& point : points) {
+        Vec4 clip = m_viewProjection * Vec4(point, 1.0f);
+        if (clip.w <= 1e-5f) {
+            return true;  // Crossing the near plane: no usable screen rectangle
+        }
+        Vec3 ndc = Vec3(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    // Any part outside the captured view has no depth to be hidden behind
+    if (ndcMin.x < -1.0f || ndcMax.x > 1.0f || ndcMin.y < -1.0f || ndcMax.y > 1.0f) {
+        return true;
+    }
+
+    f32 nearest = ndcMin.z * 0.5f + 0.5f;
+    f32 px0 = (ndcMin.x * 0.5f + 0.5f) * m_width;
+    f32 px1 = (ndcMax.x * 0.5f + 0.5f) * m_width;
+    f32 py0 = (ndcMin.y * 0.5f + 0.5f) * m_height;
+    f32 py1 = (ndcMax.y * 0.5f + 0.5f) * m_height;
+
+    // Coarsest level where the rectangle spans at most about 2x2 texels
+    u32 level = 0;
+    f32 texelSize = static_cast<f32>(BASE_BLOCK);
+    while (level + 1 < m_levels.size() && std::max(px1 - px0, py1 - py0) > 2.0f * texelSize) {
+        level++;
+        texelSize *= 2.0f;
+    }
+
+    const Level& hiz = m_levels[level];
+    u32 x0 = std::min(static_cast<u32>(px0 / texelSize), hiz.width - 1);
+    u32 x1 = std::min(static_cast<u32>(px1 / texelSize), hiz.width - 1);
+    u32 y0 = std::min(static_cast<u32>(py0 / texelSize), hiz.height - 1);
+    u32 y1 = std::min(static_cast<u32>(py1 / texelSize), hiz.height - 1);
+
+    f32 farthest = 0.0f;
+    for (u32 y = y0; y <= y1; y++) {
+        for (u32 x = x0; x <= x1; x++) {
+            farthest = std::max(farthest, hiz.depth[static_cast<size_t>(y) * hiz.width + x]);
+        }
+    }
+    return nearest <= farthest;
+}
+
+bool HiZPyramid::inFrustum(const Mat4& viewProjection, const Vec3& boundsMin, const Vec3& boundsMax) {
+    Vec3 points[8];
+    corners(boundsMin, boundsMax, points);
+
+    // Outcodes: a plane every corner lies outside of rejects the box
+    u32 allOutside = 0x3F;
+    for (const Vec3& point : points) {
+        Vec4 clip = viewProjection * Vec4(point, 1.0f);
+        u32 outside = 0;
+        if (clip.x < -clip.w) outside |= 1;
+        if (clip.x > clip.w) outside |= 2;
+        if (clip.y < -clip.w) outside |= 4;
+        if (clip.y > clip.w) outside |= 8;
+        if (clip.z < -clip.w) outside |= 16;
+        if (clip.z > clip.w) outside |= 32;
+        allOutside &= outside;
+    }
+    return allOutside == 0;
+}
+
+}
@@ -0,0 +1,54 @@
+// HiZPyramid.hpp
+// CPU max-depth pyramid over a captured depth buffer, for conservative bounds-vs-depth occlusion tests.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <vector>
+
+namespace Sports {
+
+// Level 0 holds the farthest depth of each 4x4 pixel block, every later level the farthest of 2x2 texels.
+// A box is hidden when its nearest point lies behind the farthest depth over the area it covers.
+// Depth is GL window depth in [0, 1], rows bottom-up as glReadPixels returns them.
+class HiZPyramid {
+public:
+    static constexpr u32 BASE_BLOCK = 4;  // Pixels per level 0 texel, each direction
+
+    void build(const f32* depth, u32 width, u32 height, const Mat4& viewProjection);
+    void invalidate() { m_valid = false; }
+
+    // Tested with the view-projection the depth was captured with; true when not provably hidden
+    // (including anything that was off screen or crossing the near plane in that frame)
+    bool isVisible(const Vec3& boundsMin, const Vec3& boundsMax) const;
+
+    // Box against the six clip planes of the current view; false only when wholly outside one
+    static bool inFrustum(const Mat4& viewProjection, const Vec3& boundsMin, const Vec3& boundsMax);
+
+    bool isValid() const { return m_valid; }
+    u32 getLevelCount() const { return static_cast<u32>(m_levels.size()); }
+    u32 getLevelWidth(u32 level) const { return m_levels[level].width; }
+    u32 getLevelHeight(u32 level) const { return m_levels[level].height; }
+    f32 getTexel(u32 level, u32 x, u32 y) const { return m_levels[level].depth[y * m_levels[level].width + x]; }
+    const f32* getLevelData(u32 level) const { return m_levels[level].depth.data(); }
+    const Mat4& getViewProjection() const { return m_viewProjection; }  // Of the captured frame
+    u32 getSourceWidth() const { return m_width; }
+    u32 getSourceHeight() const { return m_height; }
+
+private:
+    struct Level {
+        u32 width = 0;
+        u32 height = 0;
+        std::vector<f32> depth;
+    };
+
+    void buildBase(const f32* depth);
+    void buildLevel(u32 level);
+
+    std::vector<Level> m_levels;
+    Mat4 m_viewProjection{1.0f};
+    u32 m_width = 0;     // Source size in pixels
+    u32 m_height = 0;
+    bool m_valid = false;
+};
+
+}
@@ -117,6 +117,29 @@ void Mesh::draw() const {
     glBindVertexArray(0);
 }
 
+void Mesh::setInstanceBuffer(u32 buffer) {
+    if (m_vao == 0) return;
+
+    // Binding 3 is free: locations 0-2 use bindings 0-2 through glVertexAttribPointer
+    constexpr u32 INSTANCE_BINDING = 3;
+    glVertexArrayVertexBuffer(m_vao, INSTANCE_BINDING, buffer, 0, sizeof(Mat4));
+    glVertexArrayBindingDivisor(m_vao, INSTANCE_BINDING, 1);
+    for (u32 column = 0; column < 4; column++) {
+        u32 location = 3 + column;  // A mat4 attribute takes one location per column
+        glVertexArrayAttribFormat(m_vao, location, 4, GL_FLOAT, GL_FALSE, column * sizeof(Vec4));
+        glVertexArrayAttribBinding(m_vao, location, INSTANCE_BINDING);
+        glEnableVertexArrayAttrib(m_vao, location);
+    }
+}
+
+void Mesh::drawIndirect(size_t commandOffset) const {
+    if (m_vao == 0 || !m_useIndices) return;
+
+    glBindVertexArray(m_vao);
+    glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(commandOffset));
+    glBindVertexArray(0);
+}
+
 void Mesh::cleanup() {
     // Delete in reverse order of creation
     if (m_ebo != 0) {
@@ -42,7 +42,15 @@ public:
 
     void draw() const;
 
+    // Per-instance model matrices (attribute locations 3-6, the INSTANCING shader variant)
+    void setInstanceBuffer(u32 buffer);
+
+    // Indexed, instanced draw whose parameters the GPU wrote into the bound
+    // GL_DRAW_INDIRECT_BUFFER at this byte offset
+    void drawIndirect(size_t commandOffset) const;
+
     bool isValid() const { return m_vao != 0; }
+    bool isIndexed() const { return m_useIndices; }
 
     u32 getVertexCount() const { return m_vertexCount; }
     u32 getIndexCount() const { return m_indexCount; }
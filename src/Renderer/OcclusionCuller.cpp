@@ -0,0 +1,132 @@
+// OcclusionCuller.cpp
+// PBO depth readback with fences; the pyramid is rebuilt only from completed copies.
+#include "OcclusionCuller.hpp"
+
+#include <glad/gl.h>
+
+namespace Sports {
+
+OcclusionCuller::~OcclusionCuller() {
+    release();
+}
+
+void OcclusionCuller::release() {
+    for (Capture& capture : m_ring) {
+        if (capture.fence) {
+            glDeleteSync(static_cast<GLsync>(capture.fence));
+            capture.fence = nullptr;
+        }
+        if (capture.buffer) {
+            glDeleteBuffers(1, &capture.buffer);
+            capture.buffer = 0;
+        }
+    }
+}
+
+void OcclusionCuller::resize(u32 width, u32 height) {
+    release();
+    m_width = width;
+    m_height = height;
+    m_pyramid.invalidate();
+    m_pyramidVersion++;
+
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(width) * height * sizeof(f32);
+    for (Capture& capture : m_ring) {
+        glGenBuffers(1, &capture.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void OcclusionCuller::capture(const Mat4& viewProjection) {
+    if (!m_enabled || m_width == 0) {
+        return;
+    }
+
+    // Overwrites the oldest slot, even if it was never consumed
+    Capture& slot = m_ring[m_next];
+    m_next = (m_next + 1) % RING_SIZE;
+    if (slot.fence) {
+        glDeleteSync(static_cast<GLsync>(slot.fence));
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(0, 0, static_cast<GLsizei>(m_width), static_cast<GLsizei>(m_height),
+                 GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.sequence = ++m_sequence;
+    slot.viewProjection = viewProjection;
+}
+
+void OcclusionCuller::update() {
+    m_frustumCulled = 0;
+    m_occluded = 0;
+    if (!m_enabled) {
+        return;
+    }
+
+    // Newest capture the GPU has finished; never wait for one
+    Capture* ready = nullptr;
+    for (Capture& capture : m_ring) {
+        if (!capture.fence || (ready && capture.sequence < ready->sequence)) continue;
+        GLenum status = glClientWaitSync(static_cast<GLsync>(capture.fence), 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            ready = &capture;
+        }
+    }
+    if (!ready) {
+        return;  // Keep the previous pyramid
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, ready->buffer);
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(m_width) * m_height * sizeof(f32);
+    const void* depth = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+    if (depth) {
+        m_pyramid.build(static_cast<const f32*>(depth), m_width, m_height, ready->viewProjection);
+        m_pyramidVersion++;
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // This capture and anything older are spent
+    for (Capture& capture : m_ring) {
+        if (capture.fence && capture.sequence <= ready->sequence && &capture != ready) {
+            glDeleteSync(static_cast<GLsync>(capture.fence));
+            capture.fence = nullptr;
+        }
+    }
+    glDeleteSync(static_cast<GLsync>(ready->fence));
+    ready->fence = nullptr;
+}
+
+bool OcclusionCuller::isVisible(const Mat4& viewProjection, const Vec3& boundsMin, const Vec3& boundsMax) {
+    if (!HiZPyramid::inFrustum(viewProjection, boundsMin, boundsMax)) {
+        m_frustumCulled++;
+        return false;
+    }
+    if (m_enabled && !m_pyramid.isVisible(boundsMin, boundsMax)) {
+        m_occluded++;
+        return false;
+    }
+    return true;
+}
+
+void OcclusionCuller::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        // Stale depth must not cull anything once re-enabled
+        for (Capture& capture : m_ring) {
+            if (capture.fence) {
+                glDeleteSync(static_cast<GLsync>(capture.fence));
+                capture.fence = nullptr;
+            }
+        }
+        m_pyramid.invalidate();
+        m_pyramidVersion++;
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+// OcclusionCuller.hpp
+// Asynchronous depth readback into a PBO ring feeding a CPU Hi-Z pyramid for instance culling.
+#pragma once
+
+#include "HiZPyramid.hpp"
+#include <array>
+
+namespace Sports {
+
+// capture() after the opaque pass queues a depth copy; update() at the start of a later frame
+// builds the pyramid from the newest copy the GPU has finished. Tests therefore see depth one or
+// two frames old: static geometry is judged exactly as it was then, and anything that becomes
+// visible is drawn a frame or two late rather than dropped.
+class OcclusionCuller {
+public:
+    static constexpr u32 RING_SIZE = 2;
+
+    OcclusionCuller() = default;
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    void resize(u32 width, u32 height);  // Drops pending captures; everything is visible until the next lands
+    void capture(const Mat4& viewProjection);
+    void update();
+
+    // Current-view frustum test plus the Hi-Z test against the captured depth
+    bool isVisible(const Mat4& viewProjection, const Vec3& boundsMin, const Vec3& boundsMax);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // For culling on the GPU: the version changes whenever the pyramid is rebuilt or dropped
+    const HiZPyramid& getPyramid() const { return m_pyramid; }
+    u64 getPyramidVersion() const { return m_pyramidVersion; }
+
+    u32 getWidth() const { return m_width; }
+    u32 getHeight() const { return m_height; }
+    u32 getFrustumCulledCount() const { return m_frustumCulled; }  // Since the last update()
+    u32 getOccludedCount() const { return m_occluded; }
+
+private:
+    void release();
+
+    struct Capture {
+        u32 buffer = 0;         // GL_PIXEL_PACK_BUFFER
+        void* fence = nullptr;  // GLsync, null when nothing is pending
+        u64 sequence = 0;
+        Mat4 viewProjection{1.0f};
+    };
+
+    std::array<Capture, RING_SIZE> m_ring;
+    HiZPyramid m_pyramid;
+    u32 m_width = 0;
+    u32 m_height = 0;
+    u32 m_next = 0;
+    u64 m_sequence = 0;
+    u64 m_pyramidVersion = 0;
+    u32 m_frustumCulled = 0;
+    u32 m_occluded = 0;
+    bool m_enabled = true;
+};
+
+}
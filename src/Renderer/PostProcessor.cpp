@@ -0,0 +1,152 @@
+// PostProcessor.cpp
+// Post pass declarations and their draw calls.
+#include "PostProcessor.hpp"
+#include "Core/Logger.hpp"
+
+#include <glad/gl.h>
+#include <algorithm>
+
+namespace Sports {
+
+PostProcessor::PostProcessor() {
+    m_enabled.fill(true);
+}
+
+PostProcessor::~PostProcessor() {
+    if (m_emptyVao) {
+        glDeleteVertexArrays(1, &m_emptyVao);
+    }
+}
+
+const char* PostProcessor::getPassName(PostPass pass) {
+    switch (pass) {
+        case PostPass::Bloom: return "bloom";
+        case PostPass::Tonemap: return "tonemap";
+        case PostPass::ColorGrade: return "color_grade";
+        case PostPass::Fxaa: return "fxaa";
+        default: return "unknown";
+    }
+}
+
+bool PostProcessor::init() {
+    const char* vertex = "shaders/fullscreen.vert";
+    bool loaded = m_bloomPrefilter.loadFromFiles(vertex, "shaders/bloom_prefilter.frag")
+               && m_bloomDownsample.loadFromFiles(vertex, "shaders/bloom_downsample.frag")
+               && m_bloomUpsample.loadFromFiles(vertex, "shaders/bloom_upsample.frag")
+               && m_tonemap.loadFromFiles(vertex, "shaders/tonemap.frag")
+               && m_colorGrade.loadFromFiles(vertex, "shaders/color_grade.frag")
+               && m_fxaa.loadFromFiles(vertex, "shaders/fxaa.frag");
+    if (!loaded) {
+        LOG_ERROR("Failed to load post-processing shaders");
+        return false;
+    }
+
+    glCreateVertexArrays(1, &m_emptyVao);
+    return true;
+}
+
+void PostProcessor::addPasses(RenderGraph& graph, ResourceHandle scene, ResourceHandle output) {
+    RenderTargetDesc sceneDesc = graph.getResource(scene).desc;
+    RenderTargetDesc ldrDesc{sceneDesc.width, sceneDesc.height, TargetFormat::RGBA8, false};
+    bool grade = isEnabled(PostPass::ColorGrade);
+    bool fxaa = isEnabled(PostPass::Fxaa);
+
+    ResourceHandle bloom = addBloom(graph, scene);
+    bool useBloom = isEnabled(PostPass::Bloom) && m_settings.bloomIntensity > 0.0f;
+
+    // Resolve to display range; straight to the output when nothing follows
+    ResourceHandle resolved = (grade || fxaa) ? graph.createTarget("ldr", ldrDesc) : output;
+    auto tonemap = graph.addPass("tonemap", [this, scene, bloom, useBloom](const PassContext& context) {
+        m_tonemap.bind();
+        glBindTextureUnit(0, context.getTexture(scene));
+        glBindTextureUnit(1, context.getTexture(useBloom ? bloom : scene));
+        m_tonemap.setInt("uScene", 0);
+        m_tonemap.setInt("uBloom", 1);
+        m_tonemap.setFloat("uBloomIntensity", useBloom ? m_settings.bloomIntensity : 0.0f);
+        m_tonemap.setFloat("uExposure", m_settings.exposure);
+        m_tonemap.setInt("uTonemap", isEnabled(PostPass::Tonemap) ? 1 : 0);
+        glBindVertexArray(m_emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    });
+    tonemap.read(scene);
+    if (useBloom) {
+        tonemap.read(bloom);
+    }
+    tonemap.write(resolved);
+
+    if (grade) {
+        ResourceHandle graded = fxaa ? graph.createTarget("graded", ldrDesc) : output;
+        auto pass = graph.addPass("color_grade", [this, resolved, ldrDesc](const PassContext& context) {
+            m_colorGrade.bind();
+            m_colorGrade.setVec3("uLift", m_settings.lift);
+            m_colorGrade.setVec3("uGamma", m_settings.gamma);
+            m_colorGrade.setVec3("uGain", m_settings.gain);
+            m_colorGrade.setFloat("uSaturation", m_settings.saturation);
+            m_colorGrade.setFloat("uContrast", m_settings.contrast);
+            drawFullscreen(m_colorGrade, context.getTexture(resolved), ldrDesc);
+        });
+        pass.read(resolved);
+        pass.write(graded);
+        resolved = graded;
+    }
+
+    if (fxaa) {
+        auto pass = graph.addPass("fxaa", [this, resolved, ldrDesc](const PassContext& context) {
+            m_fxaa.bind();
+            drawFullscreen(m_fxaa, context.getTexture(resolved), ldrDesc);
+        });
+        pass.read(resolved);
+        pass.write(output);
+    }
+}
+
+ResourceHandle PostProcessor::addBloom(RenderGraph& graph, ResourceHandle scene) {
+    std::array<ResourceHandle, BLOOM_LEVELS> levels{};
+    RenderTargetDesc source = graph.getResource(scene).desc;
+
+    // Bright pass straight into half resolution, then halve again per level
+    for (u32 i = 0; i < BLOOM_LEVELS; i++) {
+        RenderTargetDesc desc{std::max(1u, source.width / 2), std::max(1u, source.height / 2),
+                              TargetFormat::RGBA16F, false};
+        levels[i] = graph.createTarget("bloom", desc);
+        ResourceHandle input = (i == 0) ? scene : levels[i - 1];
+
+        auto pass = graph.addPass("bloom", [this, input, source, i](const PassContext& context) {
+            Shader& shader = (i == 0) ? m_bloomPrefilter : m_bloomDownsample;
+            shader.bind();
+            if (i == 0) {
+                shader.setFloat("uThreshold", m_settings.bloomThreshold);
+                shader.setFloat("uKnee", m_settings.bloomKnee);
+            }
+            drawFullscreen(shader, context.getTexture(input), source);
+        });
+        pass.read(input);
+        pass.write(levels[i]);
+        source = desc;
+    }
+
+    // Tent upsample, accumulating each level into the next larger one
+    for (u32 i = BLOOM_LEVELS - 1; i > 0; i--) {
+        ResourceHandle input = levels[i];
+        RenderTargetDesc inputDesc = graph.getResource(input).desc;
+        auto pass = graph.addPass("bloom", [this, input, inputDesc](const PassContext& context) {
+            m_bloomUpsample.bind();
+            drawFullscreen(m_bloomUpsample, context.getTexture(input), inputDesc);
+        });
+        pass.read(input);
+        pass.write(levels[i - 1], LoadOp::Load);
+        pass.setState({false, false, BlendMode::Additive});
+    }
+
+    return levels[0];
+}
+
+void PostProcessor::drawFullscreen(Shader& shader, u32 texture, const RenderTargetDesc& source) {
+    glBindTextureUnit(0, texture);
+    shader.setInt("uSource", 0);
+    shader.setVec2("uTexelSize", Vec2(1.0f / source.width, 1.0f / source.height));
+    glBindVertexArray(m_emptyVao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+}
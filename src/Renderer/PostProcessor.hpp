@@ -0,0 +1,71 @@
+// PostProcessor.hpp
+// Post stack render-graph passes: bloom, tonemapping, colour grading, FXAA.
+#pragma once
+
+#include "RenderGraph.hpp"
+#include "Shader.hpp"
+#include <array>
+
+namespace Sports {
+
+enum class PostPass : u8 {
+    Bloom,
+    Tonemap,      // Off resolves HDR with a plain clamp
+    ColorGrade,
+    Fxaa,
+    Count
+};
+
+struct PostSettings {
+    f32 exposure = 1.0f;
+    f32 bloomThreshold = 1.0f;   // Scene luminance where bloom starts
+    f32 bloomKnee = 0.5f;        // Soft ramp below the threshold
+    f32 bloomIntensity = 0.5f;
+    Vec3 lift{0.0f};             // Lift/gamma/gain, per channel
+    Vec3 gamma{1.0f};
+    Vec3 gain{1.0f};
+    f32 saturation = 1.1f;
+    f32 contrast = 1.05f;
+};
+
+// Declares the post passes between an HDR scene target and an output target.
+// Intermediates are graph transients, so bloom levels and the LDR ping-pong
+// targets alias one another wherever their lifetimes allow. Bloom is always
+// declared; when it is off the resolve doesn't read it and the graph culls it.
+class PostProcessor {
+public:
+    static constexpr u32 BLOOM_LEVELS = 5;  // 1/2 down to 1/32 resolution
+
+    PostProcessor();
+    ~PostProcessor();
+
+    PostProcessor(const PostProcessor&) = delete;
+    PostProcessor& operator=(const PostProcessor&) = delete;
+
+    bool init();
+    void addPasses(RenderGraph& graph, ResourceHandle scene, ResourceHandle output);
+
+    void setEnabled(PostPass pass, bool enabled) { m_enabled[static_cast<u32>(pass)] = enabled; }
+    bool isEnabled(PostPass pass) const { return m_enabled[static_cast<u32>(pass)]; }
+    static const char* getPassName(PostPass pass);
+
+    PostSettings& getSettings() { return m_settings; }
+
+private:
+    ResourceHandle addBloom(RenderGraph& graph, ResourceHandle scene);  // Returns the half-res result
+    void drawFullscreen(Shader& shader, u32 texture, const RenderTargetDesc& source);
+
+    PostSettings m_settings;
+    std::array<bool, static_cast<u32>(PostPass::Count)> m_enabled;
+
+    Shader m_bloomPrefilter;
+    Shader m_bloomDownsample;
+    Shader m_bloomUpsample;
+    Shader m_tonemap;
+    Shader m_colorGrade;
+    Shader m_fxaa;
+
+    u32 m_emptyVao = 0;  // Fullscreen triangle is generated from gl_VertexID
+};
+
+}
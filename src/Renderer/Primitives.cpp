@@ -211,15 +211,21 @@ MeshData createCapsule(f32 radius, f32 height, const Vec3& color, u32 rings, u32
 }
 
 MeshData createCube(f32 size, const Vec3& color) {
+    return createBox(Vec3(size), color);
+}
+
+MeshData createBox(const Vec3& size, const Vec3& color, const Vec3& center) {
     std::vector<Vertex> vertices;
     std::vector<u32> indices;
 
-    f32 h = size / 2.0f;
+    Vec3 h = size / 2.0f;
 
     // 8 corner positions
     Vec3 corners[8] = {
-        {-h, -h, -h}, { h, -h, -h}, { h,  h, -h}, {-h,  h, -h},
-        {-h, -h,  h}, { h, -h,  h}, { h,  h,  h}, {-h,  h,  h}
+        center + Vec3(-h.x, -h.y, -h.z), center + Vec3( h.x, -h.y, -h.z),
+        center + Vec3( h.x,  h.y, -h.z), center + Vec3(-h.x,  h.y, -h.z),
+        center + Vec3(-h.x, -h.y,  h.z), center + Vec3( h.x, -h.y,  h.z),
+        center + Vec3( h.x,  h.y,  h.z), center + Vec3(-h.x,  h.y,  h.z)
     };
 
     // 6 faces with their vertex indices and outward normals
@@ -24,6 +24,9 @@ MeshData createCapsule(f32 radius, f32 height, const Vec3& color, u32 rings = 8,
 // Axis-aligned box
 MeshData createCube(f32 size, const Vec3& color);
 
+// Axis-aligned box with independent extents, optionally offset from the origin
+MeshData createBox(const Vec3& size, const Vec3& color, const Vec3& center = Vec3(0.0f));
+
 // Thin quad between two points (for field markings)
 MeshData createLine(const Vec3& start, const Vec3& end, f32 width, const Vec3& color);
 
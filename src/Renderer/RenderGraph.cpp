@@ -0,0 +1,203 @@
+// RenderGraph.cpp
+// Reverse-reachability culling, lifetime-based slot aliasing, and state diffing.
+#include "RenderGraph.hpp"
+
+namespace Sports {
+
+void RenderGraph::PassBuilder::read(ResourceHandle resource) {
+    Pass& pass = m_graph.m_passes[m_pass];
+    if (resource >= m_graph.m_resources.size()) {
+        m_graph.m_error = "pass '" + pass.name + "' reads an unknown resource";
+        return;
+    }
+    pass.reads.push_back(resource);
+}
+
+void RenderGraph::PassBuilder::write(ResourceHandle resource, LoadOp load) {
+    Pass& pass = m_graph.m_passes[m_pass];
+    if (resource >= m_graph.m_resources.size()) {
+        m_graph.m_error = "pass '" + pass.name + "' writes an unknown resource";
+        return;
+    }
+    if (pass.write != INVALID_RESOURCE) {
+        m_graph.m_error = "pass '" + pass.name + "' writes more than one target";
+        return;
+    }
+    pass.write = resource;
+    pass.load = load;
+}
+
+void RenderGraph::PassBuilder::setState(const PassState& state) {
+    m_graph.m_passes[m_pass].state = state;
+}
+
+void RenderGraph::PassBuilder::setSideEffect() {
+    m_graph.m_passes[m_pass].sideEffect = true;
+}
+
+void RenderGraph::reset() {
+    m_resources.clear();
+    m_passes.clear();
+    m_plan.clear();
+    m_physical.clear();
+    m_error.clear();
+}
+
+ResourceHandle RenderGraph::createTarget(const std::string& name, const RenderTargetDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    m_resources.push_back(std::move(resource));
+    return static_cast<ResourceHandle>(m_resources.size() - 1);
+}
+
+ResourceHandle RenderGraph::importTarget(const std::string& name, const RenderTargetDesc& desc,
+                                         const RenderTarget* external) {
+    ResourceHandle handle = createTarget(name, desc);
+    m_resources[handle].imported = true;
+    m_resources[handle].external = external;
+    return handle;
+}
+
+RenderGraph::PassBuilder RenderGraph::addPass(const std::string& name, PassExecute execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    m_passes.push_back(std::move(pass));
+    return PassBuilder(*this, static_cast<u32>(m_passes.size() - 1));
+}
+
+bool RenderGraph::compile() {
+    m_plan.clear();
+    m_physical.clear();
+    if (!m_error.empty()) {
+        return false;
+    }
+
+    cull();
+    for (u32 i = 0; i < m_passes.size(); i++) {
+        if (!m_passes[i].culled) {
+            m_plan.push_back({i, 0, {}, {}});
+        }
+    }
+
+    if (!allocate()) {
+        m_plan.clear();
+        return false;
+    }
+    diffStates();
+    return true;
+}
+
+void RenderGraph::cull() {
+    // Walk backwards from the outputs: a pass lives if a later live pass reads what it writes
+    std::vector<bool> needed(m_resources.size(), false);
+    for (u32 i = static_cast<u32>(m_passes.size()); i-- > 0;) {
+        Pass& pass = m_passes[i];
+        bool keep = pass.sideEffect;
+        if (pass.write != INVALID_RESOURCE) {
+            keep = keep || m_resources[pass.write].imported || needed[pass.write];
+        }
+        pass.culled = !keep;
+        if (!keep) continue;
+
+        if (pass.write != INVALID_RESOURCE) {
+            needed[pass.write] = pass.load == LoadOp::Load;  // Drawing over old contents still needs them
+        }
+        for (ResourceHandle read : pass.reads) {
+            needed[read] = true;
+        }
+    }
+}
+
+bool RenderGraph::allocate() {
+    constexpr u32 UNSEEN = ~0u;
+    for (Resource& resource : m_resources) {
+        resource.physical = INVALID_RESOURCE;
+        resource.firstStep = UNSEEN;
+        resource.lastStep = 0;
+    }
+
+    // Lifetimes in plan steps, checking every transient is written before it is used
+    std::vector<bool> written(m_resources.size(), false);
+    auto touch = [&](ResourceHandle handle, u32 step) {
+        Resource& resource = m_resources[handle];
+        if (resource.firstStep == UNSEEN) resource.firstStep = step;
+        resource.lastStep = step;
+    };
+    for (u32 step = 0; step < m_plan.size(); step++) {
+        const Pass& pass = m_passes[m_plan[step].pass];
+        for (ResourceHandle read : pass.reads) {
+            if (!m_resources[read].imported && !written[read]) {
+                m_error = "pass '" + pass.name + "' reads '" + m_resources[read].name + "' before it is written";
+                return false;
+            }
+            touch(read, step);
+        }
+        if (pass.write != INVALID_RESOURCE) {
+            if (!m_resources[pass.write].imported && pass.load == LoadOp::Load && !written[pass.write]) {
+                m_error = "pass '" + pass.name + "' draws over '" + m_resources[pass.write].name +
+                          "' before it is written";
+                return false;
+            }
+            written[pass.write] = true;
+            touch(pass.write, step);
+        }
+    }
+
+    // Slots are freed after a resource's last step and reused by the next matching description
+    std::vector<bool> slotFree;
+    for (u32 step = 0; step < m_plan.size(); step++) {
+        for (Resource& resource : m_resources) {
+            if (resource.imported || resource.firstStep != step) continue;
+            u32 slot = 0;
+            while (slot < m_physical.size() && !(slotFree[slot] && m_physical[slot] == resource.desc)) {
+                slot++;
+            }
+            if (slot == m_physical.size()) {
+                m_physical.push_back(resource.desc);
+                slotFree.push_back(false);
+            }
+            slotFree[slot] = false;
+            resource.physical = slot;
+            m_plan[step].acquire.push_back(slot);
+        }
+        for (Resource& resource : m_resources) {
+            if (resource.imported || resource.firstStep == UNSEEN || resource.lastStep != step) continue;
+            slotFree[resource.physical] = true;
+            m_plan[step].release.push_back(resource.physical);
+        }
+    }
+    return true;
+}
+
+void RenderGraph::diffStates() {
+    // Imported targets get identities above any slot index
+    constexpr u32 IMPORTED_BIT = 0x80000000u;
+    u32 boundTarget = INVALID_RESOURCE;
+    PassState current;
+    bool stateKnown = false;
+
+    for (PlanStep& step : m_plan) {
+        const Pass& pass = m_passes[step.pass];
+        if (pass.write == INVALID_RESOURCE) {
+            step.stateChanges = 0;  // Doesn't draw: leave everything as it is
+            continue;
+        }
+
+        const Resource& target = m_resources[pass.write];
+        u32 identity = target.imported ? (IMPORTED_BIT | pass.write) : target.physical;
+        u32 changes = 0;
+        if (identity != boundTarget) changes |= CHANGE_TARGET;
+        if (!stateKnown || pass.state.depthTest != current.depthTest) changes |= CHANGE_DEPTH_TEST;
+        if (!stateKnown || pass.state.depthWrite != current.depthWrite) changes |= CHANGE_DEPTH_WRITE;
+        if (!stateKnown || pass.state.blend != current.blend) changes |= CHANGE_BLEND;
+
+        step.stateChanges = changes;
+        boundTarget = identity;
+        current = pass.state;
+        stateKnown = true;
+    }
+}
+
+}
@@ -0,0 +1,144 @@
+// RenderGraph.hpp
+// Per-frame pass declarations compiled into an ordered, culled plan with aliased transient targets.
+#pragma once
+
+#include "RenderTargetPool.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Sports {
+
+using ResourceHandle = u32;
+constexpr ResourceHandle INVALID_RESOURCE = ~0u;
+
+enum class BlendMode : u8 {
+    Opaque,
+    Additive,   // ONE, ONE
+    Alpha,      // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+};
+
+// What a pass's target holds when the pass starts drawing
+enum class LoadOp : u8 {
+    Discard,   // Undefined: the pass covers every pixel (fullscreen passes)
+    Clear,     // Cleared to the clear colour and far depth
+    Load,      // Previous contents kept; the earlier writer stays live
+};
+
+// Fixed-function state a pass runs with; the executor only touches what differs from the previous pass
+struct PassState {
+    bool depthTest = false;
+    bool depthWrite = false;
+    BlendMode blend = BlendMode::Opaque;
+
+    bool operator==(const PassState&) const = default;
+};
+
+// Bits of PlanStep::stateChanges
+enum StateChange : u32 {
+    CHANGE_TARGET = 1 << 0,       // Framebuffer and viewport
+    CHANGE_DEPTH_TEST = 1 << 1,
+    CHANGE_DEPTH_WRITE = 1 << 2,
+    CHANGE_BLEND = 1 << 3,
+    CHANGE_ALL = 0xF,
+};
+
+// What a pass sees of its resources while it executes
+class PassContext {
+public:
+    explicit PassContext(const std::vector<const RenderTarget*>& targets) : m_targets(targets) {}
+
+    u32 getTexture(ResourceHandle resource) const { return m_targets[resource] ? m_targets[resource]->texture : 0; }
+    u32 getFramebuffer(ResourceHandle resource) const { return m_targets[resource] ? m_targets[resource]->framebuffer : 0; }
+
+private:
+    const std::vector<const RenderTarget*>& m_targets;  // By handle; null for the default framebuffer
+};
+
+using PassExecute = std::function<void(const PassContext&)>;
+
+// Passes are declared in execution order and say what they read and write.
+// compile() keeps only passes that contribute to an imported target or have side
+// effects, gives each transient target a physical slot (targets whose lifetimes
+// don't overlap and whose descriptions match share one), and records which state
+// each pass needs changed relative to the one before it.
+//
+// Rebuilt every frame: reset() keeps the allocations from the last one.
+class RenderGraph {
+public:
+    class PassBuilder {
+    public:
+        void read(ResourceHandle resource);
+        void write(ResourceHandle resource, LoadOp load = LoadOp::Discard);  // The pass's render target; one per pass
+        void setState(const PassState& state);
+        void setSideEffect();  // Kept even when nothing reads what it writes
+
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph& graph, u32 pass) : m_graph(graph), m_pass(pass) {}
+
+        RenderGraph& m_graph;
+        u32 m_pass;
+    };
+
+    struct Resource {
+        std::string name;
+        RenderTargetDesc desc;
+        const RenderTarget* external = nullptr;  // Imported: null is the default framebuffer
+        bool imported = false;
+        u32 physical = INVALID_RESOURCE;         // Transient slot after compile()
+        u32 firstStep = 0;
+        u32 lastStep = 0;
+    };
+
+    struct Pass {
+        std::string name;
+        PassExecute execute;
+        std::vector<ResourceHandle> reads;
+        ResourceHandle write = INVALID_RESOURCE;
+        PassState state;
+        LoadOp load = LoadOp::Discard;
+        bool sideEffect = false;
+        bool culled = false;
+    };
+
+    struct PlanStep {
+        u32 pass;
+        u32 stateChanges;
+        std::vector<u32> acquire;   // Physical slots first used by this step
+        std::vector<u32> release;   // Physical slots last used by this step
+    };
+
+    void reset();
+
+    ResourceHandle createTarget(const std::string& name, const RenderTargetDesc& desc);
+    ResourceHandle importTarget(const std::string& name, const RenderTargetDesc& desc,
+                                const RenderTarget* external = nullptr);
+    PassBuilder addPass(const std::string& name, PassExecute execute);
+
+    bool compile();  // False for an invalid graph; see getError()
+
+    const std::vector<PlanStep>& getPlan() const { return m_plan; }
+    const Pass& getPass(u32 pass) const { return m_passes[pass]; }
+    const Resource& getResource(ResourceHandle resource) const { return m_resources[resource]; }
+    const RenderTargetDesc& getPhysicalDesc(u32 physical) const { return m_physical[physical]; }
+
+    u32 getPassCount() const { return static_cast<u32>(m_passes.size()); }
+    u32 getResourceCount() const { return static_cast<u32>(m_resources.size()); }
+    u32 getCulledCount() const { return getPassCount() - static_cast<u32>(m_plan.size()); }
+    u32 getPhysicalCount() const { return static_cast<u32>(m_physical.size()); }
+    const std::string& getError() const { return m_error; }
+
+private:
+    void cull();
+    bool allocate();
+    void diffStates();
+
+    std::vector<Resource> m_resources;
+    std::vector<Pass> m_passes;
+    std::vector<PlanStep> m_plan;
+    std::vector<RenderTargetDesc> m_physical;
+    std::string m_error;
+};
+
+}
@@ -0,0 +1,99 @@
+// RenderGraphExecutor.cpp
+// Plan playback against GL.
+#include "RenderGraphExecutor.hpp"
+#include "GpuProfiler.hpp"
+
+#include <glad/gl.h>
+
+namespace Sports {
+
+void RenderGraphExecutor::execute(const RenderGraph& graph, RenderTargetPool& pool, GpuProfiler* profiler) {
+    m_slots.assign(graph.getPhysicalCount(), nullptr);
+    m_targets.assign(graph.getResourceCount(), nullptr);
+    for (ResourceHandle handle = 0; handle < graph.getResourceCount(); handle++) {
+        const RenderGraph::Resource& resource = graph.getResource(handle);
+        if (resource.imported) {
+            m_targets[handle] = resource.external;
+        }
+    }
+
+    PassContext context(m_targets);
+    for (const RenderGraph::PlanStep& step : graph.getPlan()) {
+        for (u32 slot : step.acquire) {
+            m_slots[slot] = pool.acquire(graph.getPhysicalDesc(slot));
+        }
+        for (ResourceHandle handle = 0; handle < graph.getResourceCount(); handle++) {
+            const RenderGraph::Resource& resource = graph.getResource(handle);
+            if (!resource.imported && resource.physical != INVALID_RESOURCE) {
+                m_targets[handle] = m_slots[resource.physical];
+            }
+        }
+
+        const RenderGraph::Pass& pass = graph.getPass(step.pass);
+        if (profiler) {
+            profiler->beginPass(pass.name.c_str());
+        }
+
+        if (pass.write != INVALID_RESOURCE) {
+            const RenderGraph::Resource& target = graph.getResource(pass.write);
+            const RenderTargetDesc& desc = target.desc;
+            if (step.stateChanges & CHANGE_TARGET) {
+                glBindFramebuffer(GL_FRAMEBUFFER, context.getFramebuffer(pass.write));
+                glViewport(0, 0, static_cast<GLsizei>(desc.width), static_cast<GLsizei>(desc.height));
+            }
+            applyState(pass.state, step.stateChanges);
+
+            if (pass.load == LoadOp::Clear) {
+                // Depth clears honour the write mask
+                GLbitfield mask = GL_COLOR_BUFFER_BIT;
+                bool hasDepth = desc.depth || (target.imported && target.external == nullptr);
+                if (hasDepth) {
+                    mask |= GL_DEPTH_BUFFER_BIT;
+                    if (!pass.state.depthWrite) glDepthMask(GL_TRUE);
+                }
+                glClear(mask);
+                if (hasDepth && !pass.state.depthWrite) glDepthMask(GL_FALSE);
+            }
+        }
+
+        if (pass.execute) {
+            pass.execute(context);
+        }
+
+        for (u32 slot : step.release) {
+            pool.release(m_slots[slot]);
+            m_slots[slot] = nullptr;
+        }
+    }
+
+    if (profiler) {
+        profiler->endPass();
+    }
+}
+
+void RenderGraphExecutor::applyState(const PassState& state, u32 changes) {
+    if (changes & CHANGE_DEPTH_TEST) {
+        if (state.depthTest) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+    }
+    if (changes & CHANGE_DEPTH_WRITE) {
+        glDepthMask(state.depthWrite ? GL_TRUE : GL_FALSE);
+    }
+    if (changes & CHANGE_BLEND) {
+        switch (state.blend) {
+            case BlendMode::Opaque:
+                glDisable(GL_BLEND);
+                break;
+            case BlendMode::Additive:
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_ONE, GL_ONE);
+                break;
+            case BlendMode::Alpha:
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+        }
+    }
+}
+
+}
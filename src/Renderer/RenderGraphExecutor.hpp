@@ -0,0 +1,25 @@
+// RenderGraphExecutor.hpp
+// Runs a compiled RenderGraph: pooled targets per slot, minimal GL state changes, per-pass profiling.
+#pragma once
+
+#include "RenderGraph.hpp"
+#include <vector>
+
+namespace Sports {
+
+class GpuProfiler;
+
+class RenderGraphExecutor {
+public:
+    // Slots are acquired from the pool at their first step and released after
+    // their last, so memory is shared across graphs and frames as well.
+    void execute(const RenderGraph& graph, RenderTargetPool& pool, GpuProfiler* profiler = nullptr);
+
+private:
+    static void applyState(const PassState& state, u32 changes);
+
+    std::vector<const RenderTarget*> m_slots;    // By physical slot
+    std::vector<const RenderTarget*> m_targets;  // By resource handle, for PassContext
+};
+
+}
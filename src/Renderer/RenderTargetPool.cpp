@@ -0,0 +1,113 @@
+// RenderTargetPool.cpp
+// Framebuffer creation, first-fit reuse, and idle eviction.
+#include "RenderTargetPool.hpp"
+#include "Core/Logger.hpp"
+
+#include <glad/gl.h>
+
+namespace Sports {
+
+RenderTargetPool::~RenderTargetPool() {
+    clear();
+}
+
+u64 RenderTargetPool::bytesFor(const RenderTargetDesc& desc) {
+    u64 texels = static_cast<u64>(desc.width) * desc.height;
+    u64 colorBytes = desc.format == TargetFormat::RGBA16F ? 8 : 4;
+    return texels * (colorBytes + (desc.depth ? 4 : 0));
+}
+
+const RenderTarget* RenderTargetPool::acquire(const RenderTargetDesc& desc) {
+    for (auto& entry : m_entries) {
+        if (!entry->inUse && entry->target.desc == desc) {
+            entry->inUse = true;
+            entry->lastUsedFrame = m_frame;
+            return &entry->target;
+        }
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->target.desc = desc;
+    create(entry->target);
+    entry->inUse = true;
+    entry->lastUsedFrame = m_frame;
+    m_allocatedBytes += bytesFor(desc);
+    m_createdThisFrame++;
+    m_entries.push_back(std::move(entry));
+    return &m_entries.back()->target;
+}
+
+void RenderTargetPool::release(const RenderTarget* target) {
+    for (auto& entry : m_entries) {
+        if (&entry->target == target) {
+            entry->inUse = false;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::endFrame() {
+    for (size_t i = 0; i < m_entries.size();) {
+        Entry& entry = *m_entries[i];
+        if (entry.inUse) {
+            LOG_WARN("Render target {}x{} still acquired at end of frame", entry.target.desc.width,
+                     entry.target.desc.height);
+            entry.inUse = false;
+        }
+        if (m_frame - entry.lastUsedFrame >= IDLE_FRAMES) {
+            m_allocatedBytes -= bytesFor(entry.target.desc);
+            destroy(entry.target);
+            m_entries[i] = std::move(m_entries.back());
+            m_entries.pop_back();
+        } else {
+            i++;
+        }
+    }
+    m_frame++;
+    m_createdThisFrame = 0;
+}
+
+void RenderTargetPool::clear() {
+    for (auto& entry : m_entries) {
+        destroy(entry->target);
+    }
+    m_entries.clear();
+    m_allocatedBytes = 0;
+}
+
+void RenderTargetPool::create(RenderTarget& target) {
+    const RenderTargetDesc& desc = target.desc;
+    GLenum internalFormat = desc.format == TargetFormat::RGBA16F ? GL_RGBA16F : GL_RGBA8;
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &target.texture);
+    glTextureStorage2D(target.texture, 1, internalFormat, static_cast<GLsizei>(desc.width),
+                       static_cast<GLsizei>(desc.height));
+    glTextureParameteri(target.texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(target.texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(target.texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(target.texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glCreateFramebuffers(1, &target.framebuffer);
+    glNamedFramebufferTexture(target.framebuffer, GL_COLOR_ATTACHMENT0, target.texture, 0);
+
+    if (desc.depth) {
+        glCreateRenderbuffers(1, &target.depthBuffer);
+        glNamedRenderbufferStorage(target.depthBuffer, GL_DEPTH_COMPONENT24, static_cast<GLsizei>(desc.width),
+                                   static_cast<GLsizei>(desc.height));
+        glNamedFramebufferRenderbuffer(target.framebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target.depthBuffer);
+    }
+
+    GLenum status = glCheckNamedFramebufferStatus(target.framebuffer, GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Render target {}x{} incomplete (status 0x{:x})", desc.width, desc.height, status);
+    }
+}
+
+void RenderTargetPool::destroy(RenderTarget& target) {
+    if (target.framebuffer) glDeleteFramebuffers(1, &target.framebuffer);
+    if (target.texture) glDeleteTextures(1, &target.texture);
+    if (target.depthBuffer) glDeleteRenderbuffers(1, &target.depthBuffer);
+    target.framebuffer = target.texture = target.depthBuffer = 0;
+}
+
+}
@@ -0,0 +1,72 @@
+// RenderTargetPool.hpp
+// Transient framebuffers handed out per pass and recycled across passes and frames.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <memory>
+#include <vector>
+
+namespace Sports {
+
+enum class TargetFormat : u8 {
+    RGBA8,     // Display-referred colour
+    RGBA16F,   // Scene-referred (HDR) colour
+};
+
+struct RenderTargetDesc {
+    u32 width = 0;
+    u32 height = 0;
+    TargetFormat format = TargetFormat::RGBA8;
+    bool depth = false;  // Adds a 24-bit depth attachment
+
+    bool operator==(const RenderTargetDesc&) const = default;
+};
+
+struct RenderTarget {
+    u32 framebuffer = 0;
+    u32 texture = 0;       // Colour attachment, linear filtered, clamped
+    u32 depthBuffer = 0;   // Renderbuffer, 0 without depth
+    RenderTargetDesc desc;
+};
+
+// A pass acquires what it writes and releases what it has finished reading, so
+// a later pass with the same description aliases the same memory. Targets idle
+// for IDLE_FRAMES are freed, which also drops the old sizes after a resize.
+class RenderTargetPool {
+public:
+    static constexpr u32 IDLE_FRAMES = 3;
+
+    RenderTargetPool() = default;
+    ~RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    const RenderTarget* acquire(const RenderTargetDesc& desc);
+    void release(const RenderTarget* target);
+    void endFrame();
+    void clear();
+
+    u32 getTargetCount() const { return static_cast<u32>(m_entries.size()); }
+    u64 getAllocatedBytes() const { return m_allocatedBytes; }
+    u32 getCreatedThisFrame() const { return m_createdThisFrame; }
+
+    static u64 bytesFor(const RenderTargetDesc& desc);
+
+private:
+    struct Entry {
+        RenderTarget target;
+        u64 lastUsedFrame = 0;
+        bool inUse = false;
+    };
+
+    static void create(RenderTarget& target);
+    static void destroy(RenderTarget& target);
+
+    std::vector<std::unique_ptr<Entry>> m_entries;  // Stable addresses for handed-out targets
+    u64 m_frame = 0;
+    u64 m_allocatedBytes = 0;
+    u32 m_createdThisFrame = 0;
+};
+
+}
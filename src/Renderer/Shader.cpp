@@ -5,8 +5,6 @@
 
 #include <glad/gl.h>
 #include <glm/gtc/type_ptr.hpp>
-#include <fstream>
-#include <sstream>
 
 namespace Sports {
 
@@ -36,7 +34,7 @@ Shader& Shader::operator=(Shader&& other) noexcept {
     return *this;
 }
 
-bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
+bool Shader::loadFromSource(std::string_view vertexSource, std::string_view fragmentSource) {
     // Compile individual shader stages
     u32 vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
     if (vertexShader == 0) {
@@ -50,11 +48,30 @@ bool Shader::loadFromSource(const std::string& vertexSource, const std::string&
     }
 
     // Link shaders into a program
+    u32 stages[] = {vertexShader, fragmentShader};
+    return linkProgram(stages, 2);
+}
+
+bool Shader::loadComputeFromSource(std::string_view computeSource) {
+    u32 computeShader = compileShader(GL_COMPUTE_SHADER, computeSource);
+    if (computeShader == 0) {
+        return false;
+    }
+    return linkProgram(&computeShader, 1);
+}
+
+bool Shader::linkProgram(const u32* shaders, u32 count) {
     m_programID = glCreateProgram();
-    glAttachShader(m_programID, vertexShader);
-    glAttachShader(m_programID, fragmentShader);
+    for (u32 i = 0; i < count; i++) {
+        glAttachShader(m_programID, shaders[i]);
+    }
     glLinkProgram(m_programID);
 
+    // Shaders are baked into the program (or it failed); either way the originals can go
+    for (u32 i = 0; i < count; i++) {
+        glDeleteShader(shaders[i]);
+    }
+
     i32 success;
     glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
     if (!success) {
@@ -63,33 +80,45 @@ bool Shader::loadFromSource(const std::string& vertexSource, const std::string&
         LOG_ERROR("Shader program linking failed: {}", infoLog);
         glDeleteProgram(m_programID);
         m_programID = 0;
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
         return false;
     }
 
-    // Shaders are now baked into program, originals can be deleted
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
     LOG_DEBUG("Shader program created successfully (ID: {})", m_programID);
     return true;
 }
 
 bool Shader::loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string vertexSource = readFile(vertexPath);
-    if (vertexSource.empty()) {
+    // Sources are views into the asset pack when one is mounted (no copies)
+    AssetData vertexSource = readFile(vertexPath);
+    if (!vertexSource.isValid()) {
         LOG_ERROR("Failed to read vertex shader: {}", vertexPath);
         return false;
     }
 
-    std::string fragmentSource = readFile(fragmentPath);
-    if (fragmentSource.empty()) {
+    AssetData fragmentSource = readFile(fragmentPath);
+    if (!fragmentSource.isValid()) {
         LOG_ERROR("Failed to read fragment shader: {}", fragmentPath);
         return false;
     }
 
-    return loadFromSource(vertexSource, fragmentSource);
+    return loadFromSource(vertexSource.text(), fragmentSource.text());
+}
+
+bool Shader::loadComputeFromFiles(const std::string& computePath) {
+    AssetData computeSource = readFile(computePath);
+    if (!computeSource.isValid()) {
+        LOG_ERROR("Failed to read compute shader: {}", computePath);
+        return false;
+    }
+    return loadComputeFromSource(computeSource.text());
+}
+
+void Shader::adoptProgram(u32 programID) {
+    if (m_programID != 0) {
+        glDeleteProgram(m_programID);
+    }
+    m_programID = programID;
+    m_uniformCache.clear();  // Locations belong to the old program
 }
 
 void Shader::bind() const {
@@ -128,11 +157,13 @@ void Shader::setMat4(const std::string& name, const Mat4& value) {
     glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
 
-u32 Shader::compileShader(u32 type, const std::string& source) {
+u32 Shader::compileShader(u32 type, std::string_view source) {
     u32 shader = glCreateShader(type);
 
-    const char* src = source.c_str();
-    glShaderSource(shader, 1, &src, nullptr);
+    // Explicit length: sources need not be null-terminated
+    const char* src = source.data();
+    GLint length = static_cast<GLint>(source.size());
+    glShaderSource(shader, 1, &src, &length);
     glCompileShader(shader);
 
     i32 success;
@@ -140,7 +171,8 @@ u32 Shader::compileShader(u32 type, const std::string& source) {
     if (!success) {
         char infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        const char* typeName = (type == GL_VERTEX_SHADER) ? "vertex" : "fragment";
+        const char* typeName = (type == GL_VERTEX_SHADER) ? "vertex"
+                             : (type == GL_COMPUTE_SHADER) ? "compute" : "fragment";
         LOG_ERROR("{} shader compilation failed: {}", typeName, infoLog);
         glDeleteShader(shader);
         return 0;
@@ -165,15 +197,8 @@ i32 Shader::getUniformLocation(const std::string& name) const {
     return location;
 }
 
-std::string Shader::readFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        return "";
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+AssetData Shader::readFile(const std::string& path) {
+    return VirtualFileSystem::read(path);
 }
 
 }
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Core/Types.hpp"
+#include "Core/VirtualFileSystem.hpp"
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Sports {
@@ -21,10 +23,17 @@ public:
     Shader(Shader&& other) noexcept;
     Shader& operator=(Shader&& other) noexcept;
 
-    // Load from GLSL source strings or file paths
-    bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
+    // Load from GLSL source strings or asset paths (resolved through the VirtualFileSystem)
+    bool loadFromSource(std::string_view vertexSource, std::string_view fragmentSource);
     bool loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
 
+    // Compute-only programs, run with glDispatchCompute after bind()
+    bool loadComputeFromSource(std::string_view computeSource);
+    bool loadComputeFromFiles(const std::string& computePath);
+
+    // Takes ownership of a program linked elsewhere (e.g. compiled in the background)
+    void adoptProgram(u32 programID);
+
     void bind() const;    // Activate this shader for rendering
     void unbind() const;  // Deactivate (use default pipeline)
 
@@ -43,9 +52,10 @@ private:
     u32 m_programID = 0;
     mutable std::unordered_map<std::string, i32> m_uniformCache;  // Avoids repeated lookups
 
-    u32 compileShader(u32 type, const std::string& source);
+    u32 compileShader(u32 type, std::string_view source);
+    bool linkProgram(const u32* shaders, u32 count);
     i32 getUniformLocation(const std::string& name) const;
-    std::string readFile(const std::string& path);
+    AssetData readFile(const std::string& path);
 };
 
 }
@@ -0,0 +1,83 @@
+// ShaderFeatures.cpp
+// Define-block generation and fallback variant selection.
+#include "ShaderFeatures.hpp"
+
+#include <bit>
+
+namespace Sports::ShaderFeatures {
+
+const char* getDefine(ShaderFeature feature) {
+    switch (feature) {
+        case SHADER_INSTANCING: return "INSTANCING";
+        case SHADER_SKINNING: return "SKINNING";
+        case SHADER_SHADOWS: return "SHADOWS";
+        case SHADER_FOG: return "FOG";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string describe(u32 features) {
+    features &= SHADER_FEATURE_MASK;
+    if (features == 0) {
+        return "base";
+    }
+
+    std::string name;
+    for (u32 bit = 0; bit < SHADER_FEATURE_COUNT; bit++) {
+        if (!(features & (1u << bit))) continue;
+        if (!name.empty()) name += '+';
+        name += getDefine(static_cast<ShaderFeature>(1u << bit));
+    }
+    return name;
+}
+
+std::string inject(std::string_view source, u32 features) {
+    features &= SHADER_FEATURE_MASK;
+    if (features == 0) {
+        return std::string(source);
+    }
+
+    // Split after the #version line; without one the block simply goes first
+    size_t split = 0;
+    u32 nextLine = 1;
+    size_t version = source.find("#version");
+    if (version != std::string_view::npos) {
+        size_t end = source.find('\n', version);
+        split = (end == std::string_view::npos) ? source.size() : end + 1;
+        for (size_t i = 0; i < split; i++) {
+            if (source[i] == '\n') nextLine++;
+        }
+    }
+
+    std::string result;
+    result.reserve(source.size() + 32 * SHADER_FEATURE_COUNT);
+    result.append(source.substr(0, split));
+    if (split > 0 && result.back() != '\n') {
+        result += '\n';  // #version was the last line, with no newline
+        nextLine++;
+    }
+    for (u32 bit = 0; bit < SHADER_FEATURE_COUNT; bit++) {
+        if (features & (1u << bit)) {
+            result += "#define ";
+            result += getDefine(static_cast<ShaderFeature>(1u << bit));
+            result += '\n';
+        }
+    }
+    result += "#line " + std::to_string(nextLine) + '\n';
+    result.append(source.substr(split));
+    return result;
+}
+
+u32 bestReadySubset(u32 wanted, u32 readyVariants) {
+    wanted &= SHADER_FEATURE_MASK;
+    u32 best = 0;
+    // Walk every subset of `wanted`, largest masks first
+    for (u32 subset = wanted; subset != 0; subset = (subset - 1) & wanted) {
+        if ((readyVariants & (1u << subset)) && std::popcount(subset) > std::popcount(best)) {
+            best = subset;
+        }
+    }
+    return best;
+}
+
+}
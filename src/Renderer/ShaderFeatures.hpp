@@ -0,0 +1,38 @@
+// ShaderFeatures.hpp
+// Feature bits for shader permutations and the #define blocks they expand to.
+#pragma once
+
+#include "Core/Types.hpp"
+#include <string>
+#include <string_view>
+
+namespace Sports {
+
+// One bit per #define; a variant is any combination, so the mask doubles as its index
+enum ShaderFeature : u32 {
+    SHADER_INSTANCING = 1 << 0,   // Model matrix from a per-instance attribute
+    SHADER_SKINNING = 1 << 1,     // Four-bone linear blend skinning
+    SHADER_SHADOWS = 1 << 2,      // Shadow map lookup with 2x2 PCF
+    SHADER_FOG = 1 << 3,          // Exponential-squared distance fog
+};
+
+constexpr u32 SHADER_FEATURE_COUNT = 4;
+constexpr u32 SHADER_VARIANT_COUNT = 1u << SHADER_FEATURE_COUNT;
+constexpr u32 SHADER_FEATURE_MASK = SHADER_VARIANT_COUNT - 1;
+
+namespace ShaderFeatures {
+
+const char* getDefine(ShaderFeature feature);  // "INSTANCING", "FOG", ...
+std::string describe(u32 features);            // "SHADOWS+FOG", or "base" for none
+
+// Adds one #define per feature straight after the #version line (which GLSL requires
+// first), then a #line so compiler errors still point at the file's own line numbers.
+std::string inject(std::string_view source, u32 features);
+
+// The variant to draw with while `wanted` compiles: the ready subset of it with the most
+// features. `readyVariants` has bit N set when variant N is ready; 0 (base) is assumed.
+u32 bestReadySubset(u32 wanted, u32 readyVariants);
+
+}
+
+}
@@ -0,0 +1,328 @@
+// ShaderPermutations.cpp
+// Variant source generation, background compile backends, and completion polling.
+#include "ShaderPermutations.hpp"
+#include "Window.hpp"
+#include "Core/Logger.hpp"
+#include "Core/VirtualFileSystem.hpp"
+
+#include <glad/gl.h>
+
+namespace Sports {
+
+ShaderPermutations::~ShaderPermutations() {
+    shutdown();
+}
+
+const char* ShaderPermutations::getBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::ParallelCompile: return "parallel compile";
+        case Backend::WorkerContext: return "worker context";
+        case Backend::Synchronous: return "synchronous";
+        default: return "unknown";
+    }
+}
+
+bool ShaderPermutations::init(const std::string& vertexPath, const std::string& fragmentPath, Window& window) {
+    AssetData vertex = VirtualFileSystem::read(vertexPath);
+    AssetData fragment = VirtualFileSystem::read(fragmentPath);
+    if (!vertex.isValid() || !fragment.isValid()) {
+        LOG_ERROR("Failed to read shader sources: {} / {}", vertexPath, fragmentPath);
+        return false;
+    }
+    // Copies: the worker thread reads them for the life of the permutation set
+    m_vertexSource = std::string(vertex.text());
+    m_fragmentSource = std::string(fragment.text());
+
+    // The fallback for every other variant, so it alone is built up front
+    if (!m_variants[0].shader.loadFromSource(m_vertexSource, m_fragmentSource)) {
+        return false;
+    }
+    m_variants[0].state = State::Ready;
+    m_ready = 1;
+
+    if (GLAD_GL_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);  // Let the driver pick its thread count
+        m_backend = Backend::ParallelCompile;
+    } else if (GLAD_GL_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        m_backend = Backend::ParallelCompile;
+    } else {
+        m_window = window.getSDLWindow();
+        m_workerContext = window.createSharedContext();
+        if (m_workerContext) {
+            m_backend = Backend::WorkerContext;
+            m_worker = std::thread(&ShaderPermutations::workerLoop, this);
+        } else {
+            m_backend = Backend::Synchronous;
+            LOG_WARN("No background shader compilation: variants will compile on the render thread");
+        }
+    }
+
+    LOG_INFO("Shader permutations for {}: {} variants, {}", fragmentPath, SHADER_VARIANT_COUNT,
+             getBackendName(m_backend));
+    return true;
+}
+
+void ShaderPermutations::shutdown() {
+    if (m_worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        m_worker.join();
+    }
+    if (m_workerContext) {
+        SDL_GL_DeleteContext(m_workerContext);
+        m_workerContext = nullptr;
+    }
+
+    // Programs the worker finished but nobody adopted, then anything still compiling
+    for (const Finished& done : m_finished) {
+        if (done.program != 0) {
+            glDeleteProgram(done.program);
+        }
+    }
+    m_finished.clear();
+    m_queue.clear();
+    for (Variant& variant : m_variants) {
+        if (variant.program != 0) {
+            glDeleteShader(variant.vertex);
+            glDeleteShader(variant.fragment);
+            glDeleteProgram(variant.program);
+            variant.vertex = variant.fragment = variant.program = 0;
+        }
+        variant.shader = Shader();
+        variant.state = State::Idle;
+    }
+    m_ready = 0;
+    m_pending = 0;
+}
+
+void ShaderPermutations::request(u32 features) {
+    features &= SHADER_FEATURE_MASK;
+    Variant& variant = m_variants[features];
+    if (variant.state != State::Idle) {
+        return;  // Built, building, or known broken
+    }
+
+    variant.state = State::Compiling;
+    variant.timer.reset();
+    m_pending++;
+
+    if (m_backend == Backend::ParallelCompile) {
+        startParallel(features);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(features);
+    }
+    m_wake.notify_one();
+}
+
+Shader& ShaderPermutations::get(u32 features) {
+    request(features);
+    return m_variants[resolve(features)].shader;
+}
+
+u32 ShaderPermutations::resolve(u32 features) const {
+    return ShaderFeatures::bestReadySubset(features, m_ready);
+}
+
+bool ShaderPermutations::isReady(u32 features) const {
+    return m_variants[features & SHADER_FEATURE_MASK].state == State::Ready;
+}
+
+void ShaderPermutations::poll() {
+    switch (m_backend) {
+        case Backend::ParallelCompile:
+            pollParallel();
+            break;
+
+        case Backend::WorkerContext: {
+            std::vector<Finished> finished;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                finished.swap(m_finished);
+            }
+            for (const Finished& done : finished) {
+                finish(done.features, done.program, done.log);
+            }
+            break;
+        }
+
+        case Backend::Synchronous:
+            // Hitches, but only once per variant and never more than one per frame
+            if (!m_queue.empty()) {
+                u32 features = m_queue.front();
+                m_queue.pop_front();
+                std::string log;
+                u32 program = buildProgram(sourceFor(GL_VERTEX_SHADER, features),
+                                           sourceFor(GL_FRAGMENT_SHADER, features), log);
+                finish(features, program, log);
+            }
+            break;
+    }
+}
+
+void ShaderPermutations::startParallel(u32 features) {
+    // With the extension none of these block; status queries would, so none are made here
+    Variant& variant = m_variants[features];
+    auto startStage = [&](u32 type) {
+        std::string source = sourceFor(type, features);
+        const char* text = source.c_str();
+        u32 shader = glCreateShader(type);
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+        return shader;
+    };
+    variant.vertex = startStage(GL_VERTEX_SHADER);
+    variant.fragment = startStage(GL_FRAGMENT_SHADER);
+    variant.program = glCreateProgram();
+    glAttachShader(variant.program, variant.vertex);
+    glAttachShader(variant.program, variant.fragment);
+    glLinkProgram(variant.program);
+}
+
+void ShaderPermutations::pollParallel() {
+    for (u32 features = 0; features < SHADER_VARIANT_COUNT; features++) {
+        Variant& variant = m_variants[features];
+        if (variant.state != State::Compiling || variant.program == 0) continue;
+
+        // Non-blocking: true once compile and link have both finished
+        i32 complete = 0;
+        glGetProgramiv(variant.program, GL_COMPLETION_STATUS_KHR, &complete);
+        if (!complete) continue;
+
+        std::string log;
+        i32 linked = 0;
+        glGetProgramiv(variant.program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            char infoLog[512];
+            for (u32 stage : {variant.vertex, variant.fragment}) {
+                i32 compiled = 0;
+                glGetShaderiv(stage, GL_COMPILE_STATUS, &compiled);
+                if (!compiled) {
+                    glGetShaderInfoLog(stage, sizeof(infoLog), nullptr, infoLog);
+                    log += infoLog;
+                }
+            }
+            glGetProgramInfoLog(variant.program, sizeof(infoLog), nullptr, infoLog);
+            log += infoLog;
+        }
+
+        u32 program = variant.program;
+        glDetachShader(program, variant.vertex);
+        glDetachShader(program, variant.fragment);
+        glDeleteShader(variant.vertex);
+        glDeleteShader(variant.fragment);
+        variant.vertex = variant.fragment = variant.program = 0;
+        if (!linked) {
+            glDeleteProgram(program);
+            program = 0;
+        }
+        finish(features, program, log);
+    }
+}
+
+void ShaderPermutations::finish(u32 features, u32 program, const std::string& log) {
+    Variant& variant = m_variants[features];
+    m_pending--;
+    if (program == 0) {
+        variant.state = State::Failed;  // Not retried: the source won't change
+        LOG_ERROR("Shader variant {} failed: {}", ShaderFeatures::describe(features), log);
+        return;
+    }
+
+    variant.shader.adoptProgram(program);
+    variant.state = State::Ready;
+    m_ready |= 1u << features;
+    LOG_INFO("Shader variant {} ready after {:.1f} ms", ShaderFeatures::describe(features),
+             variant.timer.elapsedMillis());
+}
+
+void ShaderPermutations::workerLoop() {
+    bool current = SDL_GL_MakeCurrent(m_window, m_workerContext) == 0;
+    std::string contextError = current ? "" : SDL_GetError();
+
+    for (;;) {
+        u32 features;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) break;
+            features = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        std::string log;
+        u32 program = 0;
+        if (current) {
+            program = buildProgram(sourceFor(GL_VERTEX_SHADER, features),
+                                   sourceFor(GL_FRAGMENT_SHADER, features), log);
+            glFinish();  // The main context may only use the program once its commands have completed
+        } else {
+            log = "worker context unavailable: " + contextError;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished.push_back({features, program, std::move(log)});
+    }
+
+    if (current) {
+        SDL_GL_MakeCurrent(m_window, nullptr);
+    }
+}
+
+std::string ShaderPermutations::sourceFor(u32 shaderType, u32 features) const {
+    return ShaderFeatures::inject(shaderType == GL_VERTEX_SHADER ? m_vertexSource : m_fragmentSource, features);
+}
+
+u32 ShaderPermutations::compileStage(u32 type, const std::string& source, std::string& log) {
+    u32 shader = glCreateShader(type);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+
+    i32 success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+        log += infoLog;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+u32 ShaderPermutations::buildProgram(const std::string& vertex, const std::string& fragment, std::string& log) {
+    u32 vertexShader = compileStage(GL_VERTEX_SHADER, vertex, log);
+    u32 fragmentShader = compileStage(GL_FRAGMENT_SHADER, fragment, log);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);  // Deleting 0 is a no-op
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    u32 program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    i32 success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+        log += infoLog;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+}
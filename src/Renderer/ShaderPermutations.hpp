@@ -0,0 +1,100 @@
+// ShaderPermutations.hpp
+// Feature variants of one shader source pair, compiled in the background.
+#pragma once
+
+#include "Core/Timer.hpp"
+#include "Shader.hpp"
+#include "ShaderFeatures.hpp"
+#include <SDL.h>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sports {
+
+class Window;
+
+// Every ShaderFeature combination of one vertex/fragment pair, built from the same
+// source by injecting #defines. Only the base variant is compiled up front; the rest
+// compile in the background when first requested, and get() hands back the closest
+// ready variant until then, so a frame never waits on the driver's compiler.
+//
+// Background compiles use GL_KHR/ARB_parallel_shader_compile when the driver has it,
+// otherwise a worker thread with its own shared GL context.
+class ShaderPermutations {
+public:
+    enum class Backend : u8 {
+        ParallelCompile,   // Driver compiles on its own threads; polled for completion
+        WorkerContext,     // Our thread compiles in a shared context
+        Synchronous,       // Neither available: one variant per poll() on the render thread
+    };
+
+    ShaderPermutations() = default;
+    ~ShaderPermutations();
+
+    ShaderPermutations(const ShaderPermutations&) = delete;
+    ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+    bool init(const std::string& vertexPath, const std::string& fragmentPath, Window& window);
+    void shutdown();  // Before the window's context goes away
+
+    void request(u32 features);   // Queues a compile if the variant isn't built or building
+    Shader& get(u32 features);    // Requests it; meanwhile the best ready subset (base at worst)
+    u32 resolve(u32 features) const;  // Which variant get() would return right now
+    bool isReady(u32 features) const;
+
+    void poll();  // Once per frame on the render thread: adopts finished variants
+
+    Backend getBackend() const { return m_backend; }
+    static const char* getBackendName(Backend backend);
+    u32 getPendingCount() const { return m_pending; }
+
+private:
+    enum class State : u8 { Idle, Compiling, Ready, Failed };
+
+    struct Variant {
+        Shader shader;
+        State state = State::Idle;
+        u32 vertex = 0;     // ParallelCompile: stages still attached while the link runs
+        u32 fragment = 0;
+        u32 program = 0;
+        Timer timer;        // Since the request
+    };
+
+    struct Finished {
+        u32 features;
+        u32 program;        // 0 on failure
+        std::string log;
+    };
+
+    void startParallel(u32 features);
+    void pollParallel();
+    void finish(u32 features, u32 program, const std::string& log);
+    void workerLoop();
+
+    std::string sourceFor(u32 shaderType, u32 features) const;
+    static u32 compileStage(u32 type, const std::string& source, std::string& log);  // Blocking
+    static u32 buildProgram(const std::string& vertex, const std::string& fragment, std::string& log);
+
+    std::string m_vertexSource;
+    std::string m_fragmentSource;
+    std::array<Variant, SHADER_VARIANT_COUNT> m_variants;
+    u32 m_ready = 1;      // Bit per ready variant; base is built by init()
+    u32 m_pending = 0;
+    Backend m_backend = Backend::Synchronous;
+
+    // WorkerContext backend
+    SDL_Window* m_window = nullptr;
+    SDL_GLContext m_workerContext = nullptr;
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<u32> m_queue;            // Features to compile, guarded by m_mutex
+    std::vector<Finished> m_finished;   // Guarded by m_mutex
+    bool m_stopping = false;
+};
+
+}
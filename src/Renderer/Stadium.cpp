@@ -0,0 +1,243 @@
+// Stadium.cpp
+// Procedural stands, crowd and props, with per-instance occlusion culling.
+#include "Stadium.hpp"
+#include "OcclusionCuller.hpp"
+#include "Primitives.hpp"
+#include "Shader.hpp"
+#include "Math/Transform.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Sports {
+
+namespace {
+
+constexpr f32 PI = 3.14159265358979f;
+constexpr f32 PLINTH_HEIGHT = 1.0f;       // Front row sits above the advertising boards
+constexpr f32 CONCOURSE_DEPTH = 1.5f;
+constexpr f32 BACK_WALL_HEIGHT = 3.0f;    // Above the top row
+constexpr f32 BACK_WALL_DEPTH = 0.5f;
+constexpr f32 SEAT_SPACING = 0.6f;
+constexpr f32 FAN_HEIGHT = 0.8f;
+constexpr f32 FLOODLIGHT_HEIGHT = 40.0f;
+constexpr f32 FLOODLIGHT_SETBACK = 14.0f;  // Behind the corner of the stands
+constexpr u32 BUILDING_COUNT = 24;
+constexpr f32 BUILDING_RADIUS = 110.0f;
+
+constexpr f32 TIER_DEPTH = Stadium::ROWS_PER_TIER * Stadium::ROW_DEPTH;
+constexpr f32 TIER_RISE = Stadium::ROWS_PER_TIER * Stadium::ROW_RISE;
+
+const Vec3 STAND_COLOR(0.55f, 0.55f, 0.58f);
+const Vec3 WALL_COLOR(0.35f, 0.36f, 0.40f);
+const Vec3 FLOODLIGHT_COLOR(0.75f, 0.75f, 0.70f);
+
+// Shirt colours fans are drawn from
+const Vec3 FAN_COLORS[] = {
+    Vec3(0.80f, 0.15f, 0.15f), Vec3(0.15f, 0.25f, 0.75f), Vec3(0.90f, 0.90f, 0.90f),
+    Vec3(0.15f, 0.15f, 0.15f), Vec3(0.85f, 0.75f, 0.20f), Vec3(0.30f, 0.55f, 0.30f),
+};
+
+// Deterministic [0, 1] noise so the stadium looks the same every run
+f32 hash01(u32 n) {
+    n = (n ^ 61u) ^ (n >> 16);
+    n *= 9u;
+    n ^= n >> 4;
+    n *= 0x27d4eb2du;
+    n ^= n >> 15;
+    return static_cast<f32>(n & 0xFFFFu) / 65535.0f;
+}
+
+void appendBox(MeshData& data, const Vec3& size, const Vec3& color, const Vec3& center) {
+    auto [vertices, indices] = Primitives::createBox(size, color, center);
+    u32 base = static_cast<u32>(data.first.size());
+    data.first.insert(data.first.end(), vertices.begin(), vertices.end());
+    for (u32 index : indices) {
+        data.second.push_back(base + index);
+    }
+}
+
+// Tier origins in stand space: x along the stand, y up, z away from the pitch
+f32 tierFront(u32 tier) { return tier == 0 ? 0.0f : TIER_DEPTH + CONCOURSE_DEPTH; }
+f32 tierBase(u32 tier) { return tier == 0 ? PLINTH_HEIGHT : PLINTH_HEIGHT + TIER_RISE + Stadium::UPPER_TIER_LIFT; }
+
+}
+
+u32 Stadium::addMesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices) {
+    m_meshes.emplace_back();
+    m_meshes.back().upload(vertices, indices);
+    return static_cast<u32>(m_meshes.size() - 1);
+}
+
+Stadium::Instance Stadium::makeInstance(u32 mesh, const Mat4& model, const Vec3& localMin, const Vec3& localMax) {
+    Instance instance{mesh, model, Vec3(1e30f), Vec3(-1e30f)};
+    for (u32 corner = 0; corner < 8; corner++) {
+        Vec3 local((corner & 1) ? localMax.x : localMin.x,
+                   (corner & 2) ? localMax.y : localMin.y,
+                   (corner & 4) ? localMax.z : localMin.z);
+        Vec3 world = Vec3(model * Vec4(local, 1.0f));
+        instance.boundsMin = glm::min(instance.boundsMin, world);
+        instance.boundsMax = glm::max(instance.boundsMax, world);
+    }
+    return instance;
+}
+
+void Stadium::create(f32 fieldLength, f32 fieldWidth) {
+    m_meshes.clear();
+    m_stands.clear();
+    m_instances.clear();
+
+    // Stand section: each row is a solid step down to the ground, so the stand is a closed occluder
+    MeshData stand;
+    for (u32 tier = 0; tier < 2; tier++) {
+        for (u32 row = 0; row < ROWS_PER_TIER; row++) {
+            f32 top = tierBase(tier) + (row + 1) * ROW_RISE;
+            f32 z = tierFront(tier) + (row + 0.5f) * ROW_DEPTH;
+            appendBox(stand, Vec3(BLOCK_WIDTH, top, ROW_DEPTH), STAND_COLOR, Vec3(0.0f, top * 0.5f, z));
+        }
+    }
+    f32 concourseTop = tierBase(1);
+    appendBox(stand, Vec3(BLOCK_WIDTH, concourseTop, CONCOURSE_DEPTH), WALL_COLOR,
+              Vec3(0.0f, concourseTop * 0.5f, TIER_DEPTH + CONCOURSE_DEPTH * 0.5f));
+    f32 standBack = tierFront(1) + TIER_DEPTH;
+    f32 wallTop = tierBase(1) + TIER_RISE + BACK_WALL_HEIGHT;
+    appendBox(stand, Vec3(BLOCK_WIDTH, wallTop, BACK_WALL_DEPTH), WALL_COLOR,
+              Vec3(0.0f, wallTop * 0.5f, standBack + BACK_WALL_DEPTH * 0.5f));
+    m_standMesh = addMesh(stand.first, stand.second);
+
+    // Crowd block: one fan per seat, relative to the tier origin
+    MeshData crowd;
+    u32 seats = static_cast<u32>(BLOCK_WIDTH / SEAT_SPACING);
+    f32 firstSeat = -(seats - 1) * SEAT_SPACING * 0.5f;
+    for (u32 row = 0; row < ROWS_PER_TIER; row++) {
+        for (u32 seat = 0; seat < seats; seat++) {
+            u32 id = row * seats + seat;
+            const Vec3& shirt = FAN_COLORS[static_cast<u32>(hash01(id) * 5.999f)];
+            f32 height = FAN_HEIGHT * (0.85f + 0.3f * hash01(id + 977u));
+            Vec3 center(firstSeat + seat * SEAT_SPACING,
+                        (row + 1) * ROW_RISE + height * 0.5f,
+                        (row + 0.5f) * ROW_DEPTH);
+            appendBox(crowd, Vec3(0.45f, height, 0.35f), shirt, center);
+        }
+    }
+    m_crowdMesh = addMesh(crowd.first, crowd.second);
+
+    // Long stands behind each touchline, shorter ones behind each goal line
+    f32 sideDistance = fieldWidth * 0.5f + RUNOFF;
+    f32 endDistance = fieldLength * 0.5f + RUNOFF;
+    addStand(Vec3(0.0f, 0.0f, sideDistance), 0.0f, fieldLength + 2.0f * RUNOFF);
+    addStand(Vec3(0.0f, 0.0f, -sideDistance), PI, fieldLength + 2.0f * RUNOFF);
+    addStand(Vec3(endDistance, 0.0f, 0.0f), PI * 0.5f, fieldWidth + 2.0f * RUNOFF);
+    addStand(Vec3(-endDistance, 0.0f, 0.0f), -PI * 0.5f, fieldWidth + 2.0f * RUNOFF);
+
+    addProps(fieldLength, fieldWidth);
+}
+
+void Stadium::addStand(const Vec3& origin, f32 yaw, f32 length) {
+    u32 sections = std::max(1u, static_cast<u32>(length / BLOCK_WIDTH));
+    f32 sinYaw = std::sin(yaw);
+    f32 cosYaw = std::cos(yaw);
+    Vec3 along(cosYaw, 0.0f, -sinYaw);  // Stand-space +x
+    Vec3 back(sinYaw, 0.0f, cosYaw);    // Stand-space +z
+
+    f32 halfBlock = BLOCK_WIDTH * 0.5f;
+    f32 standBack = tierFront(1) + TIER_DEPTH + BACK_WALL_DEPTH;
+    f32 wallTop = tierBase(1) + TIER_RISE + BACK_WALL_HEIGHT;
+    f32 crowdTop = TIER_RISE + FAN_HEIGHT * 1.15f;
+
+    for (u32 i = 0; i < sections; i++) {
+        f32 offset = (static_cast<f32>(i) - (sections - 1) * 0.5f) * BLOCK_WIDTH;
+        Vec3 position = origin + along * offset;
+
+        m_stands.push_back(makeInstance(m_standMesh, Transforms::translateYawPitch(position, yaw, 0.0f),
+                                        Vec3(-halfBlock, 0.0f, 0.0f), Vec3(halfBlock, wallTop, standBack)));
+
+        for (u32 tier = 0; tier < 2; tier++) {
+            Vec3 tierOrigin = position + back * tierFront(tier) + Vec3(0.0f, tierBase(tier), 0.0f);
+            m_instances.push_back(makeInstance(m_crowdMesh, Transforms::translateYawPitch(tierOrigin, yaw, 0.0f),
+                                               Vec3(-halfBlock, ROW_RISE, 0.0f),
+                                               Vec3(halfBlock, crowdTop, TIER_DEPTH)));
+        }
+    }
+}
+
+void Stadium::addProps(f32 fieldLength, f32 fieldWidth) {
+    // Floodlight towers on the corners, heads angled at the centre spot
+    MeshData tower;
+    appendBox(tower, Vec3(1.0f, FLOODLIGHT_HEIGHT, 1.0f), FLOODLIGHT_COLOR, Vec3(0.0f, FLOODLIGHT_HEIGHT * 0.5f, 0.0f));
+    appendBox(tower, Vec3(6.0f, 3.0f, 0.6f), FLOODLIGHT_COLOR, Vec3(0.0f, FLOODLIGHT_HEIGHT + 1.5f, -0.5f));
+    u32 towerMesh = addMesh(tower.first, tower.second);
+
+    f32 cornerX = fieldLength * 0.5f + RUNOFF + FLOODLIGHT_SETBACK;
+    f32 cornerZ = fieldWidth * 0.5f + RUNOFF + FLOODLIGHT_SETBACK;
+    for (u32 i = 0; i < 4; i++) {
+        Vec3 position((i & 1) ? cornerX : -cornerX, 0.0f, (i & 2) ? cornerZ : -cornerZ);
+        f32 yaw = std::atan2(position.x, position.z);  // Local -z faces the pitch
+        m_instances.push_back(makeInstance(towerMesh, Transforms::translateYawPitch(position, yaw, 0.0f),
+                                           Vec3(-3.0f, 0.0f, -0.8f), Vec3(3.0f, FLOODLIGHT_HEIGHT + 3.0f, 0.5f)));
+    }
+
+    // Skyline ring: one unit box scaled per building
+    MeshData box;
+    appendBox(box, Vec3(1.0f), WALL_COLOR, Vec3(0.0f, 0.5f, 0.0f));
+    u32 boxMesh = addMesh(box.first, box.second);
+
+    for (u32 i = 0; i < BUILDING_COUNT; i++) {
+        f32 angle = (i + 0.5f * hash01(i)) * 2.0f * PI / BUILDING_COUNT;
+        f32 radius = BUILDING_RADIUS + 30.0f * hash01(i + 101u);
+        Vec3 size(12.0f + 12.0f * hash01(i + 211u), 15.0f + 25.0f * hash01(i + 307u), 12.0f + 8.0f * hash01(i + 401u));
+        Vec3 position(std::cos(angle) * radius, 0.0f, std::sin(angle) * radius);
+        Mat4 model = glm::scale(Transforms::translateYawPitch(position, -angle, 0.0f), size);
+        m_instances.push_back(makeInstance(boxMesh, model, Vec3(-0.5f, 0.0f, -0.5f), Vec3(0.5f, 1.0f, 0.5f)));
+    }
+}
+
+bool Stadium::initGpuCulling() {
+    if (!m_gpuCuller.init()) {
+        return false;
+    }
+
+    // One indirect draw per mesh any instance uses
+    std::vector<u32> drawForMesh(m_meshes.size(), ~0u);
+    for (const Instance& instance : m_instances) {
+        if (drawForMesh[instance.mesh] == ~0u) {
+            drawForMesh[instance.mesh] = m_gpuCuller.addDraw(m_meshes[instance.mesh]);
+        }
+        m_gpuCuller.addInstance(drawForMesh[instance.mesh], instance.model, instance.boundsMin, instance.boundsMax);
+    }
+    m_gpuCuller.upload();
+    return true;
+}
+
+void Stadium::drawStands(Shader& shader, const Mat4& viewProjection) const {
+    for (const Instance& stand : m_stands) {
+        if (!HiZPyramid::inFrustum(viewProjection, stand.boundsMin, stand.boundsMax)) continue;
+        shader.setMat4("uModel", stand.model);
+        m_meshes[stand.mesh].draw();
+    }
+}
+
+void Stadium::drawInstances(Shader& shader, const Mat4& viewProjection, OcclusionCuller& culler) const {
+    m_drawn = 0;
+    for (const Instance& instance : m_instances) {
+        if (!culler.isVisible(viewProjection, instance.boundsMin, instance.boundsMax)) continue;
+        shader.setMat4("uModel", instance.model);
+        m_meshes[instance.mesh].draw();
+        m_drawn++;
+    }
+    m_frustumCulled = culler.getFrustumCulledCount();
+    m_occluded = culler.getOccludedCount();
+}
+
+void Stadium::drawInstancesIndirect(Shader& instancedShader, const Mat4& viewProjection,
+                                    const OcclusionCuller& culler) {
+    m_gpuCuller.cull(viewProjection, culler);
+    instancedShader.bind();  // The dispatch left the compute program bound
+    m_gpuCuller.draw();
+
+    m_drawn = m_gpuCuller.getDrawnCount();
+    m_frustumCulled = m_gpuCuller.getFrustumCulledCount();
+    m_occluded = m_gpuCuller.getOccludedCount();
+}
+
+}
@@ -0,0 +1,66 @@
+// Stadium.hpp
+// Stands around the pitch, crowd blocks seated on them, and surrounding props.
+#pragma once
+
+#include "GpuCuller.hpp"
+#include "Mesh.hpp"
+#include <vector>
+
+namespace Sports {
+
+class Shader;
+class OcclusionCuller;
+
+// The stands are drawn first and act as occluders; crowd blocks and props are
+// drawn only when the culler can't prove them hidden, either one draw each after
+// CPU tests or in one indirect draw per mesh after a compute pass.
+class Stadium {
+public:
+    static constexpr f32 RUNOFF = 6.0f;          // Touchline to first row
+    static constexpr u32 ROWS_PER_TIER = 6;
+    static constexpr f32 ROW_DEPTH = 0.8f;
+    static constexpr f32 ROW_RISE = 0.45f;
+    static constexpr f32 UPPER_TIER_LIFT = 2.5f; // Concourse between tiers
+    static constexpr f32 BLOCK_WIDTH = 8.0f;     // Crowd block span along a stand
+
+    void create(f32 fieldLength, f32 fieldWidth);
+    bool initGpuCulling();  // After create(); false keeps only the CPU path
+
+    void drawStands(Shader& shader, const Mat4& viewProjection) const;
+    void drawInstances(Shader& shader, const Mat4& viewProjection, OcclusionCuller& culler) const;
+    // Culled on the GPU; `instancedShader` is a SHADER_INSTANCING variant with its uniforms set
+    void drawInstancesIndirect(Shader& instancedShader, const Mat4& viewProjection, const OcclusionCuller& culler);
+
+    bool hasGpuCulling() const { return m_gpuCuller.isReady(); }
+    u32 getInstanceCount() const { return static_cast<u32>(m_instances.size()); }
+
+    // Outcome of the last draw of the instances (GPU counts lag a few frames)
+    u32 getDrawnCount() const { return m_drawn; }
+    u32 getFrustumCulledCount() const { return m_frustumCulled; }
+    u32 getOccludedCount() const { return m_occluded; }
+
+private:
+    struct Instance {
+        u32 mesh;
+        Mat4 model;
+        Vec3 boundsMin;   // World-space AABB
+        Vec3 boundsMax;
+    };
+
+    u32 addMesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices);
+    void addStand(const Vec3& origin, f32 yaw, f32 length);
+    void addProps(f32 fieldLength, f32 fieldWidth);
+    static Instance makeInstance(u32 mesh, const Mat4& model, const Vec3& localMin, const Vec3& localMax);
+
+    std::vector<Mesh> m_meshes;
+    std::vector<Instance> m_stands;     // Occluders, always drawn when in view
+    std::vector<Instance> m_instances;  // Crowd blocks and props
+    u32 m_standMesh = 0;    // One BLOCK_WIDTH section of both tiers
+    u32 m_crowdMesh = 0;    // One tier's rows of seated fans over a section
+    GpuCuller m_gpuCuller;  // GPU copy of m_instances after initGpuCulling()
+    mutable u32 m_drawn = 0;
+    mutable u32 m_frustumCulled = 0;
+    mutable u32 m_occluded = 0;
+};
+
+}
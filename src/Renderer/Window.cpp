@@ -31,7 +31,7 @@ bool Window::init(const WindowConfig& config) {
     SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);   // Double buffering for smooth rendering
 
     // Build window flags from config
-    Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN;
+    Uint32 windowFlags = SDL_WINDOW_OPENGL | (config.hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
     if (config.resizable) {
         windowFlags |= SDL_WINDOW_RESIZABLE;
     }
@@ -88,6 +88,21 @@ bool Window::init(const WindowConfig& config) {
     return true;
 }
 
+SDL_GLContext Window::createSharedContext() {
+    // Sharing is with whichever context is current at creation, so the main one must be
+    SDL_GL_MakeCurrent(m_window, m_glContext);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    SDL_GLContext context = SDL_GL_CreateContext(m_window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+    // Creating a context makes it current; hand this thread back to the main one
+    SDL_GL_MakeCurrent(m_window, m_glContext);
+    if (!context) {
+        LOG_WARN("Failed to create shared OpenGL context: {}", SDL_GetError());
+    }
+    return context;
+}
+
 void Window::shutdown() {
     if (m_glContext) {
         SDL_GL_DeleteContext(m_glContext);
@@ -15,6 +15,7 @@ struct WindowConfig {
     bool vsync = true;
     bool fullscreen = false;
     bool resizable = true;
+    bool hidden = false;  // Offscreen rendering: the context still needs a window, just not a visible one
 };
 
 class Window {
@@ -40,6 +41,10 @@ public:
 
     SDL_Window* getSDLWindow() const { return m_window; }
 
+    // Second context sharing objects with the main one, for a worker thread to make current.
+    // Null if the driver refuses; the caller deletes it with SDL_GL_DeleteContext.
+    SDL_GLContext createSharedContext();
+
 private:
     SDL_Window* m_window = nullptr;
     SDL_GLContext m_glContext = nullptr;
@@ -1,30 +1,64 @@
 // main.cpp
 // Application entry point and game loop for Sports Engine.
+#include "Core/CpuTopology.hpp"
+#include "Core/FlightRecorder.hpp"
+#include "Core/JobSystem.hpp"
 #include "Core/Logger.hpp"
+#include "Core/Metrics.hpp"
+#include "Core/MetricsServer.hpp"
 #include "Core/Timer.hpp"
 #include "Core/Types.hpp"
+#include "Core/VirtualFileSystem.hpp"
 #include "Renderer/Window.hpp"
-#include "Renderer/Shader.hpp"
+#include "Renderer/FrameCapture.hpp"
+#include "Renderer/ShaderPermutations.hpp"
 #include "Renderer/Camera.hpp"
+#include "Renderer/DebugDraw.hpp"
 #include "Renderer/Mesh.hpp"
+#include "Renderer/GpuProfiler.hpp"
+#include "Renderer/OcclusionCuller.hpp"
+#include "Renderer/PostProcessor.hpp"
+#include "Renderer/RenderGraphExecutor.hpp"
 #include "Renderer/Primitives.hpp"
+#include "Renderer/Stadium.hpp"
 #include "Game/Ball.hpp"
 #include "Game/Player.hpp"
 #include "Game/AIPlayer.hpp"
+#include "Game/DecisionTrace.hpp"
+#include "Game/HeadlessWorld.hpp"
 #include "Game/Match.hpp"
+#include "Game/MatchEvents.hpp"
+#include "Game/Replay.hpp"
+#include "Game/ReplayCapture.hpp"
+#include "Game/SetPiecePlanner.hpp"
 #include "Input/InputHandler.hpp"
+#include "Math/Transform.hpp"
 
 #include <glad/gl.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 #include <vector>
 
 using namespace Sports;
 
+// Command-line switches
+struct AppOptions {
+    std::string recordPath;   // --record <file>: capture from the first frame (.y4m, otherwise raw RGBA)
+    bool offscreen = false;   // --offscreen: hidden window, fixed time step, frames rendered to a texture
+    u64 frameLimit = 0;       // --frames <n>: quit after n frames; 0 runs until closed
+    std::string replayPath;   // --replay <file>: draw a recorded match instead of simulating
+    TickRange replayTicks;    // --ticks <begin>:<end>: part of the replay; end 0 plays to the last tick
+    std::string saveReplayPath;  // --save-replay <file>: record this match's poses every tick
+};
+
 class Application {
 public:
-    bool init();
+    bool init(const AppOptions& options);
     void run();
     void shutdown();
 
@@ -32,12 +66,26 @@ private:
     void processInput(f32 deltaTime);
     void update(f32 deltaTime);
     void render();
+    void drawScene();
+    void setSceneUniforms(Shader& shader, u32 features);
     void createScene();
     void drawGoalCelebration();
-
+    void drawDebugView();
+    void planSetPiece(i32 team);
+    void recordFrame(f32 deltaTime, f32 updateMs, f32 renderMs);
+    void captureDrawnFrame(f32 deltaTime);
+    void stepFixed(f32 frameTime);
+    bool openReplay();
+    bool advanceReplay();
+    void registerMetrics();
+    void publishMetrics(f32 updateMs, f32 renderMs);
+    void placeThreads();
+    void toggleRecording();
+
+    AppOptions m_options;
     Window m_window;
     Camera m_camera;
-    Shader m_shader;
+    ShaderPermutations m_shaders;  // basic.vert/frag feature variants
     Timer m_frameTimer;
 
     // Scene meshes
@@ -46,12 +94,26 @@ private:
     Mesh m_playerMesh;
     Mesh m_playerFaceMesh;
     std::vector<Mesh> m_fieldLines;
+    TransformBatch m_transforms;  // Per-frame model matrices, reused
     Mesh m_goalPostMesh;
     Mesh m_crossbarMesh;
     Mesh m_aiPlayerMeshRed;
     Mesh m_aiPlayerFaceMeshRed;
     Mesh m_aiPlayerMeshBlue;
     Mesh m_aiPlayerFaceMeshBlue;
+    Stadium m_stadium;
+    OcclusionCuller m_occlusion;  // Culls crowd and props against last frame's depth
+    PostProcessor m_post;
+    GpuProfiler m_gpuProfiler;
+    RenderGraph m_renderGraph;          // Rebuilt every frame
+    RenderGraphExecutor m_graphExecutor;
+    RenderTargetPool m_renderTargets;   // Backs the graph's transient targets
+    Mat4 m_viewProjection{1.0f};        // Camera for the frame being rendered
+    FrameCapture m_capture;             // F9 or --record
+    DecisionTraceWriter m_traceWriter;  // T and goal dumps, written off the frame thread
+
+    static constexpr u32 CAPTURE_FPS = 60;  // Also the offscreen time step
+    static constexpr const char* DEFAULT_RECORDING = "capture.y4m";
 
     // Field dimensions (FIFA standard in meters)
     static constexpr f32 FIELD_LENGTH = 105.0f;
@@ -74,22 +136,86 @@ private:
 
     FieldBounds m_fieldBounds;
 
+    // Background workers and set-piece search
+    JobSystem m_jobs;
+    SetPiecePlanner m_planner{m_jobs};
+
     bool m_aiEnabled = true;
 
+    // What drawScene shows: the live world captured after update(), or a decoded replay tick
+    ReplayFrame m_drawn;
+    std::vector<ReplayRole> m_drawnRoles;  // Parallel to m_drawn.players
+    ReplayWriter m_replayWriter;           // --save-replay
+    MatchEventDetector m_eventDetector;    // Indexes the saved replay for highlights
+    std::vector<MatchEvent> m_newEvents;
+    ReplayReader m_replayReader;           // --replay
+    u64 m_replayEnd = 0;
+    u64 m_simTick = 0;                     // Steps simulated; a saved replay's tick numbers
+    f32 m_stepBacklog = 0.0f;              // Frame time not yet stepped while saving a replay
+    bool m_touchesStepped = true;          // The ball's contacts have been through a step
+
+    // Crash forensics: recent frames and the last keyframe, written out by a signal handler
+    static constexpr u64 KEYFRAME_INTERVAL = 300;  // Frames (~5 s at 60 Hz)
+    FlightRecorder m_flight;
+    u64 m_frameIndex = 0;
+    u32 m_frameFlags = 0;
+    std::vector<u8> m_keyframeScratch;
+    bool m_nonFiniteDumped = false;
+
+    // Operations telemetry: Prometheus endpoint plus periodic JSON log lines
+    static constexpr f64 METRICS_LOG_INTERVAL = 10.0;  // Seconds
+    static constexpr std::array<const char*, 10> PROFILED_PASSES = {"scene", "occlusion_capture", "debug_draw", "bloom",
+                                                                   "tonemap", "color_grade", "fxaa", "debug_overlay",
+                                                                   "hud", "frame_capture"};
+    MetricsServer m_metricsServer;
+    MetricId m_ticksMetric = 0;
+    MetricId m_tickRateMetric = 0;
+    MetricId m_tickTimeMetric = 0;
+    MetricId m_physicsTimeMetric = 0;
+    MetricId m_aiTimeMetric = 0;
+    MetricId m_renderTimeMetric = 0;
+    MetricId m_queueDepthMetric = 0;
+    MetricId m_drawnInstancesMetric = 0;
+    MetricId m_frustumCulledMetric = 0;
+    MetricId m_occludedMetric = 0;
+    std::vector<MetricId> m_passGpuMetrics;   // Parallel to PROFILED_PASSES
+    std::vector<MetricId> m_passCpuMetrics;
+    MetricId m_renderTargetBytesMetric = 0;
+    MetricId m_executedPassesMetric = 0;
+    MetricId m_culledPassesMetric = 0;
+    Timer m_tickRateTimer;
+    Timer m_metricsLogTimer;
+    u64 m_tickRateStart = 0;
+
     // Simple directional lighting
     Vec3 m_lightDir = glm::normalize(Vec3(0.5f, 1.0f, 0.3f));
     Vec3 m_lightColor{1.0f, 1.0f, 0.95f};
     Vec3 m_ambientColor{0.3f, 0.3f, 0.35f};
+
+    // Distance fog: the far stands and skyline fade into the clear colour
+    static constexpr f32 FOG_DENSITY = 0.005f;  // Per meter; ~57% visibility at 150 m
+    Vec3 m_fogColor{0.1f, 0.4f, 0.1f};
+    u32 m_sceneFeatures = SHADER_FOG;           // ShaderFeature bits for the scene pass
+    bool m_gpuCulling = false;                  // Crowd and props culled by compute, drawn indirectly
 };
 
-bool Application::init() {
+bool Application::init(const AppOptions& options) {
+    m_options = options;
     Logger::init();
     LOG_INFO("Starting Sports Engine...");
 
+    if (CycleClock::isTsc()) {
+        LOG_INFO("Clock: invariant TSC at {:.0f} MHz", CycleClock::calibration().ticksPerSecond * 1e-6);
+    } else {
+        LOG_INFO("Clock: steady_clock (no invariant TSC)");
+    }
+
     WindowConfig windowConfig;
     windowConfig.title = "Sports Engine - Third Person Camera";
     windowConfig.width = 1600;
     windowConfig.height = 900;
+    windowConfig.hidden = m_options.offscreen;
+    windowConfig.vsync = !m_options.offscreen;  // Offscreen runs as fast as the GPU allows
 
     if (!m_window.init(windowConfig)) {
         LOG_ERROR("Failed to initialize window");
@@ -97,7 +223,7 @@ bool Application::init() {
     }
 
     // Lock mouse to window for camera control
-    m_input.setMouseCaptured(true);
+    m_input.setMouseCaptured(!m_options.offscreen);
 
     // Configure third-person camera
     m_camera.setPerspective(60.0f, m_window.getAspectRatio(), 0.1f, 500.0f);
@@ -105,10 +231,29 @@ bool Application::init() {
     m_camera.setFollowHeight(3.0f);
     m_camera.setSensitivity(0.003f);
 
-    if (!m_shader.loadFromFiles("assets/shaders/basic.vert", "assets/shaders/basic.frag")) {
+    // One mapping for every asset; loose files fill in during development
+    VirtualFileSystem::mount("assets.pak", "assets");
+
+    if (!m_shaders.init("shaders/basic.vert", "shaders/basic.frag", m_window)) {
         LOG_ERROR("Failed to load shaders");
         return false;
     }
+    m_shaders.request(m_sceneFeatures);  // Compiles in the background; the base variant draws until then
+    m_shaders.request(m_sceneFeatures | SHADER_INSTANCING);
+    if (!m_options.replayPath.empty()) {
+        // Export segments render in separate processes; none may start on a fallback variant
+        while (m_shaders.getPendingCount() > 0) {
+            m_shaders.poll();
+            SDL_Delay(1);
+        }
+    }
+
+    if (!m_post.init()) {
+        return false;
+    }
+    // Optional: without it the debug view just stays empty
+    DebugDraw::init();
+    DebugDraw::setEnabled(false);
 
     // Initialize field bounds for physics
     m_fieldBounds.length = FIELD_LENGTH;
@@ -118,8 +263,34 @@ bool Application::init() {
 
     m_match.setFieldDimensions(FIELD_LENGTH, FIELD_WIDTH, GOAL_WIDTH, GOAL_HEIGHT);
     m_aiManager.createTeams(FIELD_LENGTH);
+    if (!openReplay()) {
+        return false;
+    }
 
     createScene();
+    m_gpuCulling = m_stadium.initGpuCulling();
+
+    m_flight.installCrashHandler("crash_flight.bin");
+
+    registerMetrics();
+    // Export tools start offscreen engines many at a time; they'd all contend for one port
+    u16 metricsPort = m_options.offscreen ? 0 : MetricsServer::configuredPort();
+    if (metricsPort != 0 && !m_metricsServer.start(metricsPort)) {
+        LOG_WARN("Metrics endpoint off: port {} unavailable (pick another with SPORTS_METRICS_PORT)", metricsPort);
+    }
+
+    // Last: threads created from here on would inherit the frame thread's pinning and priority.
+    // The encoder and trace writer threads start now so F9, T, or a goal later doesn't put
+    // them on the frame core.
+    m_capture.prepare();
+    m_traceWriter.startWorker();
+    placeThreads();
+
+    m_capture.setLossless(m_options.offscreen);
+    if (!m_options.recordPath.empty() &&
+        !m_capture.start(m_options.recordPath, m_window.getWidth(), m_window.getHeight(), CAPTURE_FPS)) {
+        return false;
+    }
 
     LOG_INFO("Application initialized successfully");
     LOG_INFO("Controls:");
@@ -133,11 +304,53 @@ bool Application::init() {
     LOG_INFO("  Tab - Toggle mouse capture");
     LOG_INFO("  R - Reset ball");
     LOG_INFO("  0 - Toggle AI (for testing)");
+    LOG_INFO("  T - Dump AI decision trace");
+    LOG_INFO("  O - Toggle occlusion culling");
+    LOG_INFO("  F - Toggle distance fog");
+    LOG_INFO("  G - Toggle GPU (compute) culling of the crowd and props");
+    if (DebugDraw::COMPILED) {
+        LOG_INFO("  V - Toggle AI / physics debug view");
+    }
+    LOG_INFO("  F1-F4 - Toggle bloom / tonemapping / color grading / FXAA");
+    LOG_INFO("  F9 - Start/stop recording to {}", DEFAULT_RECORDING);
     LOG_INFO("  Escape - Quit");
 
     return true;
 }
 
+void Application::placeThreads() {
+    CpuTopology topology = CpuTopology::detect();
+    ThreadPlacementConfig config = ThreadPlacementConfig::fromEnvironment();
+    LOG_INFO("CPU topology: {} logical, {} cores, {} L3 domains{}", topology.getLogicalCount(),
+             topology.getCoreCount(), topology.getDomainCount(), topology.isDetected() ? "" : " (guessed)");
+
+    // Offscreen renders run many to a machine (replay export, highlights). Every process
+    // would plan the same frame core and worker sets, so leave them to the scheduler.
+    if (m_options.offscreen) {
+        LOG_INFO("Offscreen: threads left unpinned at normal priority");
+        return;
+    }
+
+    if (config.pinThreads) {
+        ThreadPlacement placement = ThreadPlacement::plan(topology, m_jobs.getWorkerCount());
+        if (!placement.frameCpus.empty() && ThreadAffinity::pinCurrentThread(placement.frameCpus)) {
+            LOG_INFO("Frame thread pinned to cpu {}", placement.frameCpus.front());
+        }
+        u32 pinned = m_jobs.pinWorkers(placement.workerCpus);
+        if (pinned > 0) {
+            LOG_INFO("Pinned {} of {} workers across L3 domains", pinned, m_jobs.getWorkerCount());
+        }
+    }
+
+    if (config.framePriority > 0) {
+        if (ThreadAffinity::setRealtimePriority(config.framePriority)) {
+            LOG_INFO("Frame thread running SCHED_FIFO priority {}", config.framePriority);
+        } else {
+            LOG_WARN("SCHED_FIFO refused (needs CAP_SYS_NICE or rtprio limit); staying at normal priority");
+        }
+    }
+}
+
 void Application::createScene() {
     // Generate all meshes using procedural primitives
 
@@ -151,7 +364,7 @@ void Application::createScene() {
 
     // Human player (blue team)
     Vec3 playerColor(0.2f, 0.4f, 0.8f);
-    auto [playerVerts, playerIndices] = Primitives::createCapsule(Player::RADIUS, 1.8f, playerColor, 8, 16);
+    auto [playerVerts, playerIndices] = Primitives::createCapsule(Player::RADIUS, BodyCollision::BODY_HEIGHT, playerColor, 8, 16);
     m_playerMesh.upload(playerVerts, playerIndices);
 
     // Direction indicator cone
@@ -220,7 +433,7 @@ void Application::createScene() {
 
     // AI players - Red team
     Vec3 redColor(0.8f, 0.2f, 0.2f);
-    auto [aiRedVerts, aiRedIndices] = Primitives::createCapsule(AIPlayer::RADIUS, 1.8f, redColor, 8, 16);
+    auto [aiRedVerts, aiRedIndices] = Primitives::createCapsule(AIPlayer::RADIUS, BodyCollision::BODY_HEIGHT, redColor, 8, 16);
     m_aiPlayerMeshRed.upload(aiRedVerts, aiRedIndices);
 
     Vec3 redFaceColor(1.0f, 0.5f, 0.2f);
@@ -229,32 +442,114 @@ void Application::createScene() {
 
     // AI players - Blue team
     Vec3 blueColor(0.2f, 0.4f, 0.8f);
-    auto [aiBlueVerts, aiBlueIndices] = Primitives::createCapsule(AIPlayer::RADIUS, 1.8f, blueColor, 8, 16);
+    auto [aiBlueVerts, aiBlueIndices] = Primitives::createCapsule(AIPlayer::RADIUS, BodyCollision::BODY_HEIGHT, blueColor, 8, 16);
     m_aiPlayerMeshBlue.upload(aiBlueVerts, aiBlueIndices);
 
     Vec3 blueFaceColor(0.3f, 0.7f, 1.0f);
     auto [blueFaceVerts, blueFaceIndices] = Primitives::createCone(0.15f, 0.4f, blueFaceColor, 12);
     m_aiPlayerFaceMeshBlue.upload(blueFaceVerts, blueFaceIndices);
 
-    LOG_INFO("Scene created with field markings, goals, and {} AI players", m_aiManager.getPlayers().size());
+    m_stadium.create(FIELD_LENGTH, FIELD_WIDTH);
+
+    LOG_INFO("Scene created with field markings, goals, {} AI players and {} stadium instances",
+             m_aiManager.getPlayers().size(), m_stadium.getInstanceCount());
 }
 
 void Application::run() {
     LOG_INFO("Entering main loop");
 
     while (!m_window.shouldClose()) {
+        if (m_options.frameLimit > 0 && m_frameIndex >= m_options.frameLimit) {
+            break;
+        }
+
         // Calculate frame delta time (capped to prevent physics explosions)
         f32 deltaTime = static_cast<f32>(m_frameTimer.lap());
         if (deltaTime > 0.1f) deltaTime = 0.1f;
+        if (m_options.offscreen) {
+            deltaTime = 1.0f / CAPTURE_FPS;  // Every video frame is one step, however long it took
+        }
 
-        processInput(deltaTime);
-        update(deltaTime);
+        Timer zone;
+        if (m_replayReader.isOpen()) {
+            if (!advanceReplay()) {
+                break;  // Past the last requested tick
+            }
+        } else if (m_replayWriter.isOpen() && !m_options.offscreen) {
+            // A replay says every tick is 1/CAPTURE_FPS, so that is what gets stepped
+            processInput(deltaTime);
+            stepFixed(deltaTime);
+        } else {
+            processInput(deltaTime);
+            update(deltaTime);
+            captureDrawnFrame(deltaTime);
+            m_touchesStepped = true;
+        }
+        f32 updateMs = static_cast<f32>(zone.elapsedMillis());
+
+        zone.reset();
         render();
+        f32 renderMs = static_cast<f32>(zone.elapsedMillis());
+
+        recordFrame(deltaTime, updateMs, renderMs);
+        publishMetrics(updateMs, renderMs);
 
-        m_window.swapBuffers();
+        if (!m_options.offscreen) {
+            m_window.swapBuffers();
+        }
     }
 }
 
+bool Application::openReplay() {
+    if (m_options.replayPath.empty()) {
+        ReplayCapture::roles(m_aiManager.getPlayers(), m_drawnRoles);
+        if (!m_options.saveReplayPath.empty() &&
+            !m_replayWriter.open(m_options.saveReplayPath, m_drawnRoles, CAPTURE_FPS)) {
+            LOG_ERROR("Cannot write replay {}", m_options.saveReplayPath);
+            return false;
+        }
+        m_stepBacklog = 1.0f / CAPTURE_FPS;  // The first frame steps at once: there is always a tick to draw
+        m_eventDetector.setField(m_fieldBounds);
+        m_eventDetector.reset();
+        return true;
+    }
+
+    if (!m_replayReader.open(m_options.replayPath)) {
+        LOG_ERROR("Cannot read replay {}", m_options.replayPath);
+        return false;
+    }
+    auto roles = m_replayReader.getRoles();
+    m_drawnRoles.assign(roles.begin(), roles.end());
+
+    u64 begin = std::max(m_options.replayTicks.begin, m_replayReader.getFirstTick());
+    m_replayEnd = m_options.replayTicks.end == 0 ? m_replayReader.getEndTick()
+                                                  : std::min(m_options.replayTicks.end, m_replayReader.getEndTick());
+    if (begin >= m_replayEnd || !m_replayReader.seek(begin)) {
+        LOG_ERROR("Replay {} has no ticks in {}:{}", m_options.replayPath, m_options.replayTicks.begin,
+                  m_options.replayTicks.end);
+        return false;
+    }
+    LOG_INFO("Replaying ticks {} to {} of {} ({} keyframes)", begin, m_replayEnd, m_options.replayPath,
+             m_replayReader.getKeyframes().size());
+    return true;
+}
+
+bool Application::advanceReplay() {
+    m_input.processEvents(m_window, m_camera);
+    if (!m_replayReader.read(m_drawn) || m_drawn.tick >= m_replayEnd) {
+        return false;
+    }
+
+    // Broadcast shot from a gantry over the near touchline, panning with the ball. It depends
+    // only on this tick, so segments rendered by separate processes join without a seam.
+    const Vec3& ball = m_drawn.ball.position;
+    Vec3 target(ball.x * 0.85f, 0.0f, ball.z * 0.5f);
+    Vec3 gantry(ball.x * 0.6f, 16.0f, FIELD_WIDTH / 2.0f + 10.0f);
+    m_camera.setAspectRatio(m_window.getAspectRatio());
+    m_camera.lookAt(gantry, target);
+    return true;
+}
+
 void Application::processInput(f32 deltaTime) {
     m_input.processEvents(m_window, m_camera);
     m_input.updateKeyboardState(m_camera);
@@ -271,17 +566,71 @@ void Application::processInput(f32 deltaTime) {
         m_input.clearToggleAI();
     }
 
+    if (m_input.shouldDumpAITrace()) {
+        m_traceWriter.submit(m_aiManager.getTrace(), "ai_trace.bin");
+        m_input.clearDumpAITrace();
+    }
+
+    if (m_input.shouldToggleOcclusion()) {
+        m_occlusion.setEnabled(!m_occlusion.isEnabled());
+        LOG_INFO("Occlusion culling: {}", m_occlusion.isEnabled() ? "ENABLED" : "DISABLED");
+        m_input.clearToggleOcclusion();
+    }
+
+    if (m_input.shouldToggleFog()) {
+        m_sceneFeatures ^= SHADER_FOG;
+        LOG_INFO("Fog: {}", (m_sceneFeatures & SHADER_FOG) ? "ENABLED" : "DISABLED");
+        m_input.clearToggleFog();
+    }
+
+    if (m_input.shouldToggleGpuCulling()) {
+        m_gpuCulling = !m_gpuCulling && m_stadium.hasGpuCulling();
+        LOG_INFO("GPU culling: {}", m_gpuCulling ? "ENABLED" : "DISABLED");
+        m_input.clearToggleGpuCulling();
+    }
+
+    if (m_input.shouldTogglePostPass()) {
+        PostPass pass = static_cast<PostPass>(m_input.getPostPassToggle());
+        m_post.setEnabled(pass, !m_post.isEnabled(pass));
+        LOG_INFO("Post pass {}: {}", PostProcessor::getPassName(pass), m_post.isEnabled(pass) ? "ENABLED" : "DISABLED");
+        m_input.clearTogglePostPass();
+    }
+
+    if (m_input.shouldToggleDebugView()) {
+        DebugDraw::setEnabled(!DebugDraw::isEnabled());
+        LOG_INFO("Debug view: {}", DebugDraw::isEnabled() ? "ENABLED" : "DISABLED");
+        m_input.clearToggleDebugView();
+    }
+
+    if (m_input.shouldToggleRecording()) {
+        toggleRecording();
+        m_input.clearToggleRecording();
+    }
+
     // Pass input to player controller
     const auto& inputState = m_input.getState();
     m_player.setMovementInput(inputState.movementDirection, inputState.sprinting);
     m_player.setTargetRotation(-m_camera.getYaw());  // Face camera direction
 
-    // Kick attempt
+    // Kick attempt (the first contact event of the tick). Touches no step has seen
+    // yet are kept, as when a fast display draws a frame between fixed steps.
+    if (m_touchesStepped) {
+        m_ball.clearContacts();
+        m_touchesStepped = false;
+    }
     if (inputState.kickJustPressed && !m_match.isGoalScored()) {
         m_player.tryKick(m_ball, inputState.sprinting, inputState.spinY);
     }
 }
 
+void Application::toggleRecording() {
+    if (m_capture.isRecording()) {
+        m_capture.stop();
+        return;
+    }
+    m_capture.start(DEFAULT_RECORDING, m_window.getWidth(), m_window.getHeight(), CAPTURE_FPS);
+}
+
 void Application::update(f32 deltaTime) {
     // Player movement bounds
     Vec3 boundsMin(-FIELD_LENGTH / 2.0f + 1.0f, 0.0f, -FIELD_WIDTH / 2.0f + 1.0f);
@@ -294,7 +643,8 @@ void Application::update(f32 deltaTime) {
     m_camera.setAspectRatio(m_window.getAspectRatio());
     m_camera.update(deltaTime);
 
-    // Ball physics
+    // Ball physics; leaving the pitch awards a restart
+    Timer zone;
     m_ball.update(deltaTime, m_fieldBounds);
     m_match.handleBoundaryCollision(m_ball);
 
@@ -302,167 +652,431 @@ void Application::update(f32 deltaTime) {
     if (!m_match.isGoalScored()) {
         m_player.handleBallCollision(m_ball, deltaTime);
     }
+    Metrics::observe(m_physicsTimeMetric, zone.elapsedMillis());
 
     // Goal detection and celebration
+    bool goalBefore = m_match.isGoalScored();
     m_match.update(deltaTime, m_ball);
 
+    // Keep the AI's view of the lead-up to every goal
+    if (!goalBefore && m_match.isGoalScored()) {
+        m_frameFlags |= FrameSummary::Goal;
+        i32 goalNumber = m_match.getScoreLeft() + m_match.getScoreRight();
+        m_traceWriter.submit(m_aiManager.getTrace(), "ai_trace_goal_" + std::to_string(goalNumber) + ".bin");
+    }
+
+    // Ball back on the centre spot after a goal: the team that conceded kicks off
+    if (goalBefore && !m_match.isGoalScored() && m_aiEnabled) {
+        planSetPiece(1 - m_match.getLastScoringTeam());
+    }
+
     // AI team updates
     if (m_aiEnabled) {
+        zone.reset();
         m_aiManager.update(deltaTime, m_ball, m_player.getPosition(),
                           FIELD_LENGTH, FIELD_WIDTH, GOAL_WIDTH);
+        Metrics::observe(m_aiTimeMetric, zone.elapsedMillis());
+    }
+
+    // Referee sees every touch of the tick (human, AI bodies, kicks) once all have happened
+    m_match.processTouches(m_ball, m_aiManager.getPlayers(), m_player.getPosition());
+
+    Restart restart;
+    if (m_match.consumeRestart(restart)) {
+        m_frameFlags |= FrameSummary::Restart;
+        if (m_aiEnabled) {
+            planSetPiece(restart.team);
+        }
+    }
+}
+
+void Application::stepFixed(f32 frameTime) {
+    // Catches up with real time: none on some frames of a fast display, several after a slow
+    // one (frame time is already capped, so never more than a handful)
+    const f32 step = 1.0f / CAPTURE_FPS;
+    m_stepBacklog += frameTime;
+    while (m_stepBacklog >= step) {
+        if (m_touchesStepped) {
+            m_ball.clearContacts();  // The previous step's, already refereed and recorded
+        }
+        update(step);
+        captureDrawnFrame(step);
+        m_touchesStepped = true;
+        m_stepBacklog -= step;
+    }
+}
+
+void Application::captureDrawnFrame(f32 deltaTime) {
+    m_drawn.tick = m_simTick++;
+    m_drawn.ball = ReplayCapture::ball(m_ball);
+    m_drawn.players.clear();
+    for (const AIPlayer& ai : m_aiManager.getPlayers()) {
+        m_drawn.players.push_back(ReplayCapture::aiPlayer(ai));
+    }
+    m_drawn.players.push_back(ReplayCapture::human(m_player));
+    ReplayCapture::match(m_match, m_drawn);
+
+    if (!m_replayWriter.isOpen()) {
+        return;
+    }
+    if (!m_replayWriter.write(m_drawn)) {
+        LOG_ERROR("Replay write failed; recording stopped at tick {}", m_drawn.tick);
+        m_replayWriter.close();
+        return;
+    }
+
+    // This tick's touches are still on the ball (processInput clears them)
+    m_newEvents.clear();
+    m_eventDetector.observe(m_drawn.tick, deltaTime, m_ball.state(), m_ball.getContacts(),
+                            m_match.isGoalScored(), m_match.getLastScoringTeam(), m_newEvents);
+    for (const MatchEvent& event : m_newEvents) {
+        m_replayWriter.addEvent(event);
+    }
+}
+
+void Application::recordFrame(f32 deltaTime, f32 updateMs, f32 renderMs) {
+    const auto& players = m_aiManager.getPlayers();
+    const Vec3& ballPos = m_ball.getPosition();
+
+    FrameSummary summary;
+    summary.frame = m_frameIndex;
+    summary.checksum = WorldSnapshot::checksum(m_ball.state(), players, m_player.getPosition());
+    summary.deltaTime = deltaTime;
+    summary.updateMs = updateMs;
+    summary.renderMs = renderMs;
+    summary.contacts = static_cast<u16>(m_ball.getContacts().size());
+    summary.ballX = ballPos.x;
+    summary.ballY = ballPos.y;
+    summary.ballZ = ballPos.z;
+
+    // Keyframes let a replay start near the end instead of from frame zero
+    if (m_frameIndex % KEYFRAME_INTERVAL == 0) {
+        WorldSnapshot::capture(m_ball, m_aiManager, m_player.getPosition(), m_fieldBounds)
+            .serialize(m_keyframeScratch);
+        if (m_flight.setKeyframe(m_frameIndex, m_keyframeScratch)) {
+            m_frameFlags |= FrameSummary::Keyframe;
+        }
+    }
+
+    bool finite = std::isfinite(ballPos.x) && std::isfinite(ballPos.y) && std::isfinite(ballPos.z);
+    for (const auto& ai : players) {
+        const Vec3& p = ai.getPosition();
+        finite = finite && std::isfinite(p.x) && std::isfinite(p.z);
+    }
+    if (!finite) {
+        m_frameFlags |= FrameSummary::NonFinite;
+    }
+
+    summary.flags = m_frameFlags;
+    m_flight.record(summary);
+    m_frameFlags = 0;
+    m_frameIndex++;
+
+    // First NaN: keep the lead-up (the crash handler only fires on signals)
+    if (!finite && !m_nonFiniteDumped) {
+        m_nonFiniteDumped = true;
+        m_flight.dump("nan_flight.bin", 0);
+        LOG_ERROR("Non-finite world state at frame {}, flight record written to nan_flight.bin", summary.frame);
+    }
+}
+
+void Application::planSetPiece(i32 team) {
+    i32 taker = m_aiManager.findClosestOutfielder(team, m_ball.getPosition());
+    if (taker < 0) return;
+
+    WorldSnapshot snapshot = WorldSnapshot::capture(m_ball, m_aiManager, m_player.getPosition(), m_fieldBounds);
+    SetPiecePlan plan = m_planner.plan(snapshot, team, taker);
+    if (!plan.valid) return;
+
+    auto& players = m_aiManager.getPlayers();
+    players[taker].setPlannedKick(plan.kickDirection, plan.kickPower, plan.kickSpin);
+    if (plan.runnerIndex >= 0) {
+        players[plan.runnerIndex].commandRun(plan.runTarget, PlannerConfig{}.runDuration);
+    }
+
+    LOG_INFO("Set-piece plan: {} rollouts, runner {}, expected value {:.2f}",
+             plan.rollouts, plan.runnerIndex, plan.expectedValue);
+}
+
+void Application::registerMetrics() {
+    MetricLabels mainWorld = {{"world", "main"}};
+    m_ticksMetric = Metrics::counter("sports_ticks_total", "Simulation ticks", mainWorld);
+    m_tickRateMetric = Metrics::gauge("sports_ticks_per_second", "Ticks per second over the last second", mainWorld);
+    m_tickTimeMetric = Metrics::histogram("sports_tick_duration_ms", "Update plus render time per tick",
+                                          {1, 2, 4, 8, 16.7, 33.3, 50, 100}, mainWorld);
+
+    // Zone times share one name so dashboards can stack them
+    auto zoneHistogram = [](const char* zone) {
+        return Metrics::histogram("sports_zone_duration_ms", "Time spent per tick in an engine zone",
+                                  {0.05, 0.1, 0.25, 0.5, 1, 2, 4, 8, 16}, {{"zone", zone}});
+    };
+    m_physicsTimeMetric = zoneHistogram("physics");
+    m_aiTimeMetric = zoneHistogram("ai");
+    m_renderTimeMetric = zoneHistogram("render");
+
+    m_queueDepthMetric = Metrics::gauge("sports_job_queue_depth", "Jobs waiting for a worker");
+    // Stadium crowd blocks and props, by what became of them this frame
+    auto instanceGauge = [](const char* state) {
+        return Metrics::gauge("sports_render_instances", "Culled stadium instances by outcome", {{"state", state}});
+    };
+    m_drawnInstancesMetric = instanceGauge("drawn");
+    m_frustumCulledMetric = instanceGauge("frustum_culled");
+    m_occludedMetric = instanceGauge("occluded");
+
+    // Per-pass cost from the GPU profiler, a few frames behind
+    for (const char* pass : PROFILED_PASSES) {
+        m_passGpuMetrics.push_back(Metrics::gauge("sports_render_pass_ms", "Render pass time by clock",
+                                                  {{"pass", pass}, {"clock", "gpu"}}));
+        m_passCpuMetrics.push_back(Metrics::gauge("sports_render_pass_ms", "Render pass time by clock",
+                                                  {{"pass", pass}, {"clock", "cpu"}}));
+    }
+    m_renderTargetBytesMetric = Metrics::gauge("sports_render_target_bytes", "Memory held by pooled render targets");
+    m_executedPassesMetric = Metrics::gauge("sports_render_graph_passes", "Declared render passes by outcome",
+                                            {{"state", "executed"}});
+    m_culledPassesMetric = Metrics::gauge("sports_render_graph_passes", "Declared render passes by outcome",
+                                          {{"state", "culled"}});
+
+    Metrics::counterFrom("sports_allocations_total", "Global operator new calls", &AllocationStats::count);
+    Metrics::counterFrom("sports_allocated_bytes_total", "Bytes requested from operator new", &AllocationStats::bytes);
+    Metrics::counterFrom("sports_capture_frames_total", "Recorded video frames by outcome",
+                         m_capture.getWrittenCounter(), {{"state", "written"}});
+    Metrics::counterFrom("sports_capture_frames_total", "Recorded video frames by outcome",
+                         m_capture.getDroppedCounter(), {{"state", "dropped"}});
+}
+
+void Application::publishMetrics(f32 updateMs, f32 renderMs) {
+    Metrics::add(m_ticksMetric);
+    Metrics::observe(m_tickTimeMetric, updateMs + renderMs);
+    Metrics::observe(m_renderTimeMetric, renderMs);
+    Metrics::set(m_queueDepthMetric, m_jobs.getQueueDepth());
+    Metrics::set(m_drawnInstancesMetric, m_stadium.getDrawnCount());
+    Metrics::set(m_frustumCulledMetric, m_stadium.getFrustumCulledCount());
+    Metrics::set(m_occludedMetric, m_stadium.getOccludedCount());
+    for (size_t i = 0; i < PROFILED_PASSES.size(); i++) {
+        Metrics::set(m_passGpuMetrics[i], m_gpuProfiler.getGpuMillis(PROFILED_PASSES[i]));
+        Metrics::set(m_passCpuMetrics[i], m_gpuProfiler.getCpuMillis(PROFILED_PASSES[i]));
+    }
+    Metrics::set(m_renderTargetBytesMetric, static_cast<f64>(m_renderTargets.getAllocatedBytes()));
+    Metrics::set(m_executedPassesMetric, static_cast<f64>(m_renderGraph.getPlan().size()));
+    Metrics::set(m_culledPassesMetric, m_renderGraph.getCulledCount());
+
+    if (m_tickRateTimer.elapsed() >= 1.0) {
+        Metrics::set(m_tickRateMetric, (m_frameIndex - m_tickRateStart) / m_tickRateTimer.elapsed());
+        m_tickRateStart = m_frameIndex;
+        m_tickRateTimer.reset();
+    }
+
+    if (m_metricsLogTimer.elapsed() >= METRICS_LOG_INTERVAL) {
+        LOG_INFO("metrics {}", Metrics::renderJson());
+        m_metricsLogTimer.reset();
     }
 }
 
 void Application::render() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    u32 width = static_cast<u32>(m_window.getWidth());
+    u32 height = static_cast<u32>(m_window.getHeight());
 
-    m_shader.bind();
+    // Swap in any shader variants that finished compiling since last frame
+    m_shaders.poll();
+    // Hand recorded frames whose readback has landed to the encoder
+    m_capture.update();
 
-    // Upload lighting uniforms
-    m_shader.setVec3("uLightDir", m_lightDir);
-    m_shader.setVec3("uLightColor", m_lightColor);
-    m_shader.setVec3("uAmbientColor", m_ambientColor);
-    m_shader.setVec3("uCameraPos", m_camera.getPosition());
+    // Depth captured at the scene target's size; a resize starts the ring over
+    if (width != m_occlusion.getWidth() || height != m_occlusion.getHeight()) {
+        m_occlusion.resize(width, height);
+    }
+    m_occlusion.update();
+    m_viewProjection = m_camera.getViewProjectionMatrix();
+
+    // Everything recorded this frame goes to the GPU in one upload
+    drawDebugView();
+    DebugDraw::upload(m_camera.getViewMatrix(), m_camera.getProjectionMatrix());
+
+    // Declare this frame's passes; compile() orders, culls, and aliases them
+    m_renderGraph.reset();
+    // Offscreen, a pooled texture stands in for the hidden window's framebuffer
+    RenderTargetDesc outputDesc{width, height, TargetFormat::RGBA8, false};
+    const RenderTarget* output = m_options.offscreen ? m_renderTargets.acquire(outputDesc) : nullptr;
+    ResourceHandle backbuffer = m_renderGraph.importTarget("backbuffer", outputDesc, output);
+    ResourceHandle scene = m_renderGraph.createTarget("scene", {width, height, TargetFormat::RGBA16F, true});
+
+    auto scenePass = m_renderGraph.addPass("scene", [this](const PassContext&) { drawScene(); });
+    scenePass.write(scene, LoadOp::Clear);
+    scenePass.setState({true, true, BlendMode::Opaque});
+
+    // Opaque depth is queued for a later frame's occlusion tests
+    auto capturePass = m_renderGraph.addPass("occlusion_capture", [this, scene](const PassContext& context) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, context.getFramebuffer(scene));
+        m_occlusion.capture(m_viewProjection);
+    });
+    capturePass.read(scene);
+    capturePass.setSideEffect();
+
+    // Debug lines hidden by the scene go in before post; overlay lines go on top after it
+    if (DebugDraw::getVertexCount(DebugLayer::DepthTested) > 0) {
+        auto debugPass = m_renderGraph.addPass("debug_draw",
+                                               [](const PassContext&) { DebugDraw::draw(DebugLayer::DepthTested); });
+        debugPass.write(scene, LoadOp::Load);
+        debugPass.setState({true, false, BlendMode::Alpha});
+    }
 
-    // Upload camera matrices
-    m_shader.setMat4("uView", m_camera.getViewMatrix());
-    m_shader.setMat4("uProjection", m_camera.getProjectionMatrix());
+    m_post.addPasses(m_renderGraph, scene, backbuffer);
+
+    if (DebugDraw::getVertexCount(DebugLayer::Overlay) > 0) {
+        auto overlayPass = m_renderGraph.addPass("debug_overlay",
+                                                 [](const PassContext&) { DebugDraw::draw(DebugLayer::Overlay); });
+        overlayPass.write(backbuffer, LoadOp::Load);
+        overlayPass.setState({false, false, BlendMode::Alpha});
+    }
+
+    // Goal celebration overlay goes on top of the post-processed frame
+    if (m_drawn.celebration > 0.0f) {
+        auto hudPass = m_renderGraph.addPass("hud", [this](const PassContext&) { drawGoalCelebration(); });
+        hudPass.write(backbuffer, LoadOp::Load);
+        hudPass.setState({false, false, BlendMode::Opaque});
+    }
+
+    // Last: the finished frame is queued for readback, never waited on
+    if (m_capture.isRecording()) {
+        auto recordPass = m_renderGraph.addPass("frame_capture", [=, this](const PassContext& context) {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, context.getFramebuffer(backbuffer));
+            m_capture.capture(width, height);
+        });
+        recordPass.read(backbuffer);
+        recordPass.setSideEffect();
+    }
+
+    if (!m_renderGraph.compile()) {
+        LOG_ERROR("Render graph: {}", m_renderGraph.getError());
+        if (output) {
+            m_renderTargets.release(output);
+        }
+        return;
+    }
+    m_gpuProfiler.beginFrame();
+    m_graphExecutor.execute(m_renderGraph, m_renderTargets, &m_gpuProfiler);
+    if (output) {
+        m_renderTargets.release(output);
+    }
+    m_renderTargets.endFrame();
+    glUseProgram(0);
+}
+
+void Application::drawScene() {
+    // Until the requested variant has compiled this is the closest one that has
+    Shader& shader = m_shaders.get(m_sceneFeatures);
+    shader.bind();
+    setSceneUniforms(shader, m_shaders.resolve(m_sceneFeatures));
 
     // Draw field
     Mat4 fieldModel = Mat4(1.0f);
-    m_shader.setMat4("uModel", fieldModel);
+    shader.setMat4("uModel", fieldModel);
     m_fieldMesh.draw();
 
     // Draw field markings
     for (auto& line : m_fieldLines) {
-        m_shader.setMat4("uModel", Mat4(1.0f));
+        shader.setMat4("uModel", Mat4(1.0f));
         line.draw();
     }
 
-    // Draw goals (4 posts + 2 crossbars)
+    // Stands first so they occlude; crowd and props are tested against earlier frames' depth
+    m_stadium.drawStands(shader, m_viewProjection);
+
+    // Indirect draws need the model matrix from an instance attribute
+    u32 instancedFeatures = m_sceneFeatures | SHADER_INSTANCING;
+    Shader& instanced = m_shaders.get(instancedFeatures);
+    u32 instancedResolved = m_shaders.resolve(instancedFeatures);
+    if (m_gpuCulling && (instancedResolved & SHADER_INSTANCING)) {
+        instanced.bind();
+        setSceneUniforms(instanced, instancedResolved);
+        m_stadium.drawInstancesIndirect(instanced, m_viewProjection, m_occlusion);
+        shader.bind();
+    } else {
+        m_stadium.drawInstances(shader, m_viewProjection, m_occlusion);
+    }
+
+    // Every model matrix this frame is translate * yaw * pitch; compose them in one batch
+    m_transforms.clear();
+
+    // Goals (4 posts + 2 crossbars rotated 90 degrees)
     f32 halfLength = FIELD_LENGTH / 2.0f;
     f32 goalHalfWidth = GOAL_WIDTH / 2.0f;
+    f32 quarterTurn = glm::radians(90.0f);
+
+    u32 firstGoalPart = m_transforms.add(Vec3(-halfLength, GOAL_HEIGHT / 2.0f, -goalHalfWidth));
+    m_transforms.add(Vec3(-halfLength, GOAL_HEIGHT / 2.0f, goalHalfWidth));
+    m_transforms.add(Vec3(-halfLength, GOAL_HEIGHT, 0.0f), 0.0f, quarterTurn);
+    m_transforms.add(Vec3(halfLength, GOAL_HEIGHT / 2.0f, -goalHalfWidth));
+    m_transforms.add(Vec3(halfLength, GOAL_HEIGHT / 2.0f, goalHalfWidth));
+    m_transforms.add(Vec3(halfLength, GOAL_HEIGHT, 0.0f), 0.0f, quarterTurn);
+
+    // Ball with rotation
+    u32 ballTransform = m_transforms.add(m_drawn.ball.position, 0.0f, m_drawn.ball.pitch);
+
+    // Players: body then face indicator (shows direction) for each
+    u32 firstPlayerTransform = m_transforms.size();
+    for (const BodyPose& pose : m_drawn.players) {
+        Vec3 bodyPos = pose.position + Vec3(0.0f, 0.9f + pose.bob, 0.0f);
+        m_transforms.add(bodyPos, pose.yaw, pose.pitch);
+
+        f32 faceOffsetDist = 0.35f;
+        Vec3 faceForward(-std::sin(pose.yaw), 0.0f, -std::cos(pose.yaw));
+        Vec3 facePos = pose.position + Vec3(0.0f, 1.4f + pose.bob, 0.0f) + faceForward * faceOffsetDist;
+        m_transforms.add(facePos, pose.yaw, quarterTurn);
+    }
 
-    // Left goal posts
-    Mat4 postModel = glm::translate(Mat4(1.0f), Vec3(-halfLength, GOAL_HEIGHT / 2.0f, -goalHalfWidth));
-    m_shader.setMat4("uModel", postModel);
-    m_goalPostMesh.draw();
-
-    postModel = glm::translate(Mat4(1.0f), Vec3(-halfLength, GOAL_HEIGHT / 2.0f, goalHalfWidth));
-    m_shader.setMat4("uModel", postModel);
-    m_goalPostMesh.draw();
-
-    // Left crossbar (rotated 90 degrees)
-    Mat4 barModel = glm::translate(Mat4(1.0f), Vec3(-halfLength, GOAL_HEIGHT, 0.0f));
-    barModel = glm::rotate(barModel, glm::radians(90.0f), Vec3(1.0f, 0.0f, 0.0f));
-    m_shader.setMat4("uModel", barModel);
-    m_crossbarMesh.draw();
-
-    // Right goal posts
-    postModel = glm::translate(Mat4(1.0f), Vec3(halfLength, GOAL_HEIGHT / 2.0f, -goalHalfWidth));
-    m_shader.setMat4("uModel", postModel);
-    m_goalPostMesh.draw();
-
-    postModel = glm::translate(Mat4(1.0f), Vec3(halfLength, GOAL_HEIGHT / 2.0f, goalHalfWidth));
-    m_shader.setMat4("uModel", postModel);
-    m_goalPostMesh.draw();
-
-    // Right crossbar
-    barModel = glm::translate(Mat4(1.0f), Vec3(halfLength, GOAL_HEIGHT, 0.0f));
-    barModel = glm::rotate(barModel, glm::radians(90.0f), Vec3(1.0f, 0.0f, 0.0f));
-    m_shader.setMat4("uModel", barModel);
-    m_crossbarMesh.draw();
-
-    // Draw ball with rotation
-    Mat4 ballModel = glm::translate(Mat4(1.0f), m_ball.getPosition());
-    ballModel = glm::rotate(ballModel, m_ball.getRotationAngle(), Vec3(1.0f, 0.0f, 0.0f));
-    m_shader.setMat4("uModel", ballModel);
-    m_ballMesh.draw();
-
-    // Draw human player with animation
-    f32 playerSpeed = m_player.getSpeed();
-    f32 bobAmount = 0.0f;
-    f32 leanAngle = 0.0f;
-
-    if (playerSpeed > 0.5f) {
-        // Running bob animation
-        bobAmount = std::sin(m_player.getAnimationTime() * 2.0f) * 0.05f * std::min(playerSpeed / 8.0f, 1.0f);
-        leanAngle = std::min(playerSpeed / 15.0f, 0.15f);
-    }
-
-    if (m_player.isKicking()) {
-        // Kick lean animation
-        f32 kickProgress = m_player.getKickTimer() / 0.3f;
-        f32 kickLean = std::sin(kickProgress * 3.14159f) * 0.3f;
-        leanAngle += kickLean;
-    }
-
-    Vec3 playerRenderPos = m_player.getPosition() + Vec3(0.0f, 0.9f + bobAmount, 0.0f);
-    Mat4 playerModel = glm::translate(Mat4(1.0f), playerRenderPos);
-    playerModel = glm::rotate(playerModel, m_player.getRotation(), Vec3(0.0f, 1.0f, 0.0f));
-    playerModel = glm::rotate(playerModel, leanAngle, Vec3(1.0f, 0.0f, 0.0f));
-    m_shader.setMat4("uModel", playerModel);
-    m_playerMesh.draw();
-
-    // Draw player face indicator (shows direction)
-    f32 faceOffsetDist = 0.35f;
-    Vec3 faceForward(-std::sin(m_player.getRotation()), 0.0f, -std::cos(m_player.getRotation()));
-    Vec3 faceRenderPos = m_player.getPosition() + Vec3(0.0f, 1.4f + bobAmount, 0.0f) + faceForward * faceOffsetDist;
-
-    Mat4 faceModel = glm::translate(Mat4(1.0f), faceRenderPos);
-    faceModel = glm::rotate(faceModel, m_player.getRotation(), Vec3(0.0f, 1.0f, 0.0f));
-    faceModel = glm::rotate(faceModel, glm::radians(90.0f), Vec3(1.0f, 0.0f, 0.0f));
-    m_shader.setMat4("uModel", faceModel);
-    m_playerFaceMesh.draw();
-
-    // Draw AI players
-    for (const auto& ai : m_aiManager.getPlayers()) {
-        f32 aiSpeed = glm::length(ai.getVelocity());
-
-        f32 aiBob = 0.0f;
-        f32 aiLean = 0.0f;
-        if (aiSpeed > 0.5f) {
-            aiBob = std::sin(ai.getAnimTime() * 2.0f) * 0.05f * std::min(aiSpeed / 7.0f, 1.0f);
-            aiLean = std::min(aiSpeed / 12.0f, 0.15f);
-        }
+    m_transforms.compose();
 
-        // Select mesh based on team
-        Mesh& bodyMesh = (ai.getTeam() == 0) ? m_aiPlayerMeshRed : m_aiPlayerMeshBlue;
-        Mesh& faceMesh = (ai.getTeam() == 0) ? m_aiPlayerFaceMeshRed : m_aiPlayerFaceMeshBlue;
+    // Draw goals
+    Mesh* goalMeshes[] = {&m_goalPostMesh, &m_goalPostMesh, &m_crossbarMesh,
+                          &m_goalPostMesh, &m_goalPostMesh, &m_crossbarMesh};
+    for (u32 i = 0; i < 6; i++) {
+        shader.setMat4("uModel", m_transforms.getMatrix(firstGoalPart + i));
+        goalMeshes[i]->draw();
+    }
 
-        Vec3 aiRenderPos = ai.getPosition() + Vec3(0.0f, 0.9f + aiBob, 0.0f);
-        Mat4 aiModel = glm::translate(Mat4(1.0f), aiRenderPos);
-        aiModel = glm::rotate(aiModel, ai.getRotation(), Vec3(0.0f, 1.0f, 0.0f));
-        aiModel = glm::rotate(aiModel, aiLean, Vec3(1.0f, 0.0f, 0.0f));
-        m_shader.setMat4("uModel", aiModel);
-        bodyMesh.draw();
+    // Draw ball
+    shader.setMat4("uModel", m_transforms.getMatrix(ballTransform));
+    m_ballMesh.draw();
 
-        // AI face indicator
-        f32 aiFaceOffset = 0.35f;
-        Vec3 aiForward(-std::sin(ai.getRotation()), 0.0f, -std::cos(ai.getRotation()));
-        Vec3 aiFacePos = ai.getPosition() + Vec3(0.0f, 1.4f + aiBob, 0.0f) + aiForward * aiFaceOffset;
+    // Draw players, meshes by team
+    u32 playerTransform = firstPlayerTransform;
+    for (ReplayRole role : m_drawnRoles) {
+        Mesh& bodyMesh = role == ReplayRole::Human ? m_playerMesh
+                       : role == ReplayRole::TeamRed ? m_aiPlayerMeshRed : m_aiPlayerMeshBlue;
+        Mesh& faceMesh = role == ReplayRole::Human ? m_playerFaceMesh
+                       : role == ReplayRole::TeamRed ? m_aiPlayerFaceMeshRed : m_aiPlayerFaceMeshBlue;
 
-        Mat4 aiFaceModel = glm::translate(Mat4(1.0f), aiFacePos);
-        aiFaceModel = glm::rotate(aiFaceModel, ai.getRotation(), Vec3(0.0f, 1.0f, 0.0f));
-        aiFaceModel = glm::rotate(aiFaceModel, glm::radians(90.0f), Vec3(1.0f, 0.0f, 0.0f));
-        m_shader.setMat4("uModel", aiFaceModel);
+        shader.setMat4("uModel", m_transforms.getMatrix(playerTransform++));
+        bodyMesh.draw();
+        shader.setMat4("uModel", m_transforms.getMatrix(playerTransform++));
         faceMesh.draw();
     }
+}
 
-    // Draw goal celebration overlay
-    if (m_match.isGoalScored()) {
-        drawGoalCelebration();
+void Application::setSceneUniforms(Shader& shader, u32 features) {
+    // Upload lighting uniforms
+    shader.setVec3("uLightDir", m_lightDir);
+    shader.setVec3("uLightColor", m_lightColor);
+    shader.setVec3("uAmbientColor", m_ambientColor);
+    shader.setVec3("uCameraPos", m_camera.getPosition());
+    if (features & SHADER_FOG) {
+        shader.setVec3("uFogColor", m_fogColor);
+        shader.setFloat("uFogDensity", FOG_DENSITY);
     }
 
-    m_shader.unbind();
+    // Upload camera matrices
+    shader.setMat4("uView", m_camera.getViewMatrix());
+    shader.setMat4("uProjection", m_camera.getProjectionMatrix());
 }
 
 void Application::drawGoalCelebration() {
-    f32 alpha = m_match.getCelebrationAlpha();
-    if (alpha <= 0.0f) return;
+    f32 alpha = m_drawn.celebration;
+    Shader& shader = m_shaders.get(0);  // Flat colour; no features needed
+    shader.bind();
 
     // Team-colored text
-    Vec3 textColor = (m_match.getLastScoringTeam() == 0)
+    Vec3 textColor = (m_drawn.scoringTeam == 0)
         ? Vec3(1.0f, 0.3f, 0.3f)   // Red team scored
         : Vec3(0.3f, 0.5f, 1.0f);  // Blue team scored
 
@@ -477,10 +1091,8 @@ void Application::drawGoalCelebration() {
                                  -1.0f, 1.0f);
     Mat4 identityView = Mat4(1.0f);
 
-    m_shader.setMat4("uProjection", orthoProj);
-    m_shader.setMat4("uView", identityView);
-
-    glDisable(GL_DEPTH_TEST);
+    shader.setMat4("uProjection", orthoProj);
+    shader.setMat4("uView", identityView);
 
     // Pixel art style "GOAL!" text using balls as blocks
     f32 blockSize = 20.0f;
@@ -495,9 +1107,9 @@ void Application::drawGoalCelebration() {
         Mat4 model = glm::translate(Mat4(1.0f), Vec3(screenX, screenY, 0.0f));
         model = glm::scale(model, Vec3(blockSize, blockSize, 1.0f));
 
-        m_shader.setVec3("uAmbientColor", textColor);
-        m_shader.setVec3("uLightColor", Vec3(0.0f));  // No lighting for 2D
-        m_shader.setMat4("uModel", model);
+        shader.setVec3("uAmbientColor", textColor);
+        shader.setVec3("uLightColor", Vec3(0.0f));  // No lighting for 2D
+        shader.setMat4("uModel", model);
         m_ballMesh.draw();
     };
 
@@ -532,26 +1144,127 @@ void Application::drawGoalCelebration() {
     // !
     drawBlock(8.0f, 2.0f); drawBlock(8.0f, 1.0f); drawBlock(8.0f, 0.0f);
     drawBlock(8.0f, -2.0f);
+}
+
+void Application::drawDebugView() {
+    if (!DebugDraw::isEnabled()) {
+        return;
+    }
 
-    // Restore 3D rendering state
-    glEnable(GL_DEPTH_TEST);
-    m_shader.setMat4("uProjection", m_camera.getProjectionMatrix());
-    m_shader.setMat4("uView", m_camera.getViewMatrix());
-    m_shader.setVec3("uAmbientColor", m_ambientColor);
-    m_shader.setVec3("uLightColor", m_lightColor);
+    static constexpr f32 CELL = 5.0f;                  // Pitch-control grid spacing in meters
+    static constexpr f32 PREDICTION_STEP = 1.0f / 30.0f;
+    static constexpr u32 PREDICTION_STEPS = 60;        // Two seconds of ball flight
+    const Vec3 teamColors[2] = {Vec3(1.0f, 0.3f, 0.3f), Vec3(0.3f, 0.5f, 1.0f)};
+    const std::vector<AIPlayer>& players = m_aiManager.getPlayers();
+
+    // Pitch control: which team's nearest player reaches each cell first at top speed
+    for (f32 x = -FIELD_LENGTH / 2.0f + CELL / 2.0f; x < FIELD_LENGTH / 2.0f; x += CELL) {
+        for (f32 z = -FIELD_WIDTH / 2.0f + CELL / 2.0f; z < FIELD_WIDTH / 2.0f; z += CELL) {
+            Vec3 cell(x, 0.05f, z);
+            f32 nearest[2] = {1e9f, 1e9f};
+            for (const AIPlayer& ai : players) {
+                f32& best = nearest[ai.getTeam() & 1];
+                best = std::min(best, glm::length(ai.getPosition() - cell));
+            }
+            f32 margin = std::clamp((nearest[1] - nearest[0]) / (AIPlayer::MAX_SPEED * 0.5f), -1.0f, 1.0f);
+            Vec3 color = glm::mix(teamColors[1], teamColors[0], margin * 0.5f + 0.5f);
+            f32 half = CELL * 0.2f * std::abs(margin) + 0.2f;  // Bigger squares where control is clearer
+            Vec3 square[5] = {cell + Vec3(-half, 0.0f, -half), cell + Vec3(half, 0.0f, -half),
+                              cell + Vec3(half, 0.0f, half), cell + Vec3(-half, 0.0f, half),
+                              cell + Vec3(-half, 0.0f, -half)};
+            DebugDraw::polyline(square, 5, color);
+        }
+    }
+
+    // AI intent: collision radius, where each player is heading, and its state
+    static constexpr const char* STATE_NAMES[] = {"IDLE", "CHASE", "RETURN", "DEFEND", "RUN"};
+    for (const AIPlayer& ai : players) {
+        const Vec3& color = teamColors[ai.getTeam() & 1];
+        Vec3 feet = ai.getPosition() + Vec3(0.0f, 0.05f, 0.0f);
+        DebugDraw::circle(feet, AIPlayer::RADIUS, color);
+        DebugDraw::arrow(feet, ai.getTargetPosition() + Vec3(0.0f, 0.05f, 0.0f), color);
+        DebugDraw::text(ai.getPosition() + Vec3(0.0f, BodyCollision::BODY_HEIGHT + 0.5f, 0.0f),
+                        STATE_NAMES[static_cast<u32>(ai.getState())], color);
+    }
+    DebugDraw::circle(m_player.getPosition() + Vec3(0.0f, 0.05f, 0.0f), Player::RADIUS, Vec3(1.0f));
+
+    // Ball: collision sphere and where the current physics will carry it
+    std::array<Vec3, PREDICTION_STEPS + 1> path;
+    BallState predicted = m_ball.state();
+    path[0] = predicted.position;
+    for (u32 i = 1; i <= PREDICTION_STEPS; i++) {
+        BallPhysics::update(predicted, PREDICTION_STEP, m_fieldBounds);
+        path[i] = predicted.position;
+    }
+    DebugDraw::sphere(m_ball.getPosition(), Ball::RADIUS, Vec3(1.0f, 1.0f, 0.0f));
+    DebugDraw::polyline(path.data(), static_cast<u32>(path.size()), Vec3(1.0f, 1.0f, 0.0f));
+    DebugDraw::cross(path.back(), 0.6f, Vec3(1.0f, 1.0f, 0.0f), DebugLayer::Overlay);
 }
 
 void Application::shutdown() {
     LOG_INFO("Shutting down...");
+    m_flight.uninstallCrashHandler();
+    m_metricsServer.stop();
     m_input.setMouseCaptured(false);
+    m_capture.stop();
+    m_traceWriter.flush();
+    if (m_replayWriter.isOpen()) {
+        m_newEvents.clear();
+        m_eventDetector.flush(m_newEvents);
+        for (const MatchEvent& event : m_newEvents) {
+            m_replayWriter.addEvent(event);
+        }
+        u64 ticks = m_replayWriter.getTickCount();
+        size_t events = m_replayWriter.getEventCount();
+        if (m_replayWriter.close()) {
+            LOG_INFO("Replay saved to {} ({} ticks, {} events)", m_options.saveReplayPath, ticks, events);
+        }
+    }
+    DebugDraw::shutdown();
+    m_shaders.shutdown();
     m_window.shutdown();
+    VirtualFileSystem::unmount();
     Logger::shutdown();
 }
 
+static bool parseOptions(int argc, char* argv[], AppOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--frames" && hasValue) {
+            options.frameLimit = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--offscreen") {
+            options.offscreen = true;
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--save-replay" && hasValue) {
+            options.saveReplayPath = argv[++i];
+        } else if (arg == "--ticks" && hasValue) {
+            char* end = nullptr;
+            options.replayTicks.begin = std::strtoull(argv[++i], &end, 10);
+            options.replayTicks.end = *end == ':' ? std::strtoull(end + 1, nullptr, 10) : 0;
+        } else {
+            std::fprintf(stderr,
+                         "Usage: %s [--record <file.y4m|file.rgba>] [--offscreen] [--frames <n>]\n"
+                         "          [--save-replay <file.rpl>] [--replay <file.rpl> [--ticks <begin>:<end>]]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
 int main(int argc, char* argv[]) {
+    AppOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
     Application app;
 
-    if (!app.init()) {
+    if (!app.init(options)) {
         return 1;
     }
 
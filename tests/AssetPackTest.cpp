@@ -0,0 +1,116 @@
+// =============================================================================
+// AssetPackTest.cpp - Asset Pack Tests
+// =============================================================================
+// Pack round trip: written blobs come back aligned, intact, and by path; the file
+// system resolves packed and loose copies in build order, empty files included.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/AssetPack.hpp"
+#include "Core/Logger.hpp"
+#include "Core/VirtualFileSystem.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace Sports;
+
+namespace {
+
+std::vector<u8> bytesOf(const std::string& text) {
+    return std::vector<u8>(text.begin(), text.end());
+}
+
+std::string tempPackPath() {
+    return (std::filesystem::temp_directory_path() / "sports_engine_test.pak").string();
+}
+
+}
+
+TEST(AssetPackTest, RoundTripFindsEveryAsset) {
+    AssetPackWriter writer;
+    writer.add("shaders/basic.vert", bytesOf("#version 450 core\nvoid main() {}\n"));
+    writer.add("shaders\\basic.frag", bytesOf("#version 450 core\n"));  // Normalized to '/'
+    writer.add("tables/falloff.lut", std::vector<u8>(1000, 7));
+    std::string path = tempPackPath();
+    ASSERT_TRUE(writer.write(path));
+
+    AssetPack pack;
+    ASSERT_TRUE(pack.open(path));
+    EXPECT_EQ(pack.getEntryCount(), 3u);
+
+    auto vert = pack.find("shaders/basic.vert");
+    ASSERT_EQ(vert.size(), 33u);
+    EXPECT_EQ(std::memcmp(vert.data(), "#version 450 core", 17), 0);
+
+    auto table = pack.find("tables/falloff.lut");
+    ASSERT_EQ(table.size(), 1000u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(table.data()) % AssetPack::BLOB_ALIGNMENT, 0u);
+    EXPECT_EQ(table[999], 7);
+
+    const PackEntry* frag = pack.findEntry("shaders/basic.frag");
+    ASSERT_NE(frag, nullptr);
+    EXPECT_EQ(frag->type, static_cast<u16>(AssetType::Shader));
+    EXPECT_EQ(pack.getName(*frag), "shaders/basic.frag");
+
+    EXPECT_TRUE(pack.find("shaders/missing.vert").empty());
+
+    pack.close();
+    std::filesystem::remove(path);
+}
+
+TEST(AssetPackTest, RejectsNonPackFiles) {
+    std::string path = tempPackPath();
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fputs("not a pack file, just some text that is long enough", file);
+        std::fclose(file);
+    }
+
+    AssetPack pack;
+    EXPECT_FALSE(pack.open(path));
+    EXPECT_FALSE(pack.isOpen());
+    std::filesystem::remove(path);
+}
+
+TEST(AssetPackTest, LooseFilesShadowThePackOnlyWhenPreferred) {
+    if (!Logger::getCoreLogger()) {
+        Logger::init();
+    }
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "sports_engine_loose";
+    std::filesystem::create_directories(root / "shaders");
+    std::ofstream(root / "shaders/basic.vert") << "edited";
+    std::ofstream(root / "shaders/empty.frag").flush();
+
+    AssetPackWriter writer;
+    writer.add("shaders/basic.vert", bytesOf("packed"));
+    std::string path = tempPackPath();
+    ASSERT_TRUE(writer.write(path));
+    ASSERT_TRUE(VirtualFileSystem::mount(path, root.string()));
+    bool looseFirst = VirtualFileSystem::isLooseFirst();
+
+    VirtualFileSystem::setLooseFirst(false);
+    AssetData packed = VirtualFileSystem::read("shaders/basic.vert");
+    EXPECT_TRUE(packed.isMapped());
+    EXPECT_EQ(packed.text(), "packed");
+
+    VirtualFileSystem::setLooseFirst(true);
+    AssetData loose = VirtualFileSystem::read("shaders/basic.vert");
+    EXPECT_FALSE(loose.isMapped());
+    EXPECT_EQ(loose.text(), "edited");
+
+    // Present but empty is not missing, whichever side is preferred
+    for (bool preferLoose : {false, true}) {
+        VirtualFileSystem::setLooseFirst(preferLoose);
+        AssetData empty = VirtualFileSystem::read("shaders/empty.frag");
+        EXPECT_TRUE(empty.isValid());
+        EXPECT_TRUE(empty.bytes().empty());
+        EXPECT_FALSE(VirtualFileSystem::read("shaders/missing.frag").isValid());
+    }
+
+    VirtualFileSystem::setLooseFirst(looseFirst);
+    VirtualFileSystem::unmount();
+    std::filesystem::remove(path);
+    std::filesystem::remove_all(root);
+}
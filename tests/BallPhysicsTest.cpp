@@ -0,0 +1,92 @@
+// =============================================================================
+// BallPhysicsTest.cpp - Ball Physics Tests
+// =============================================================================
+// Checks the closed-form rolling model against the per-tick integrator.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Physics/BallPhysics.hpp"
+#include <cmath>
+
+using namespace Sports;
+
+namespace {
+
+BallState makeRollingBall(const Vec3& velocity) {
+    BallState ball;
+    ball.position = Vec3(0.0f, BallPhysics::BALL_RADIUS, 0.0f);
+    ball.velocity = velocity;
+    return ball;
+}
+
+}
+
+TEST(BallPhysicsTest, GroundedBallIsRolling) {
+    BallState ball = makeRollingBall(Vec3(5.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(BallPhysics::isRolling(ball));
+
+    ball.velocity.y = 2.0f;
+    EXPECT_FALSE(BallPhysics::isRolling(ball));
+}
+
+TEST(BallPhysicsTest, RollStopsAtAnalyticDistance) {
+    FieldBounds bounds;
+    BallState ball = makeRollingBall(Vec3(6.0f, 0.0f, 0.0f));
+    RollSegment segment = BallPhysics::planRoll(ball, bounds);
+
+    f32 decel = BallPhysics::ROLLING_FRICTION * BallPhysics::GRAVITY;
+    EXPECT_NEAR(segment.stopTime, 6.0f / decel, 1e-4f);
+    EXPECT_TRUE(std::isinf(segment.eventTime));
+
+    // Long after stopping, the ball rests at v0^2 / 2a
+    BallState out;
+    BallPhysics::evaluateRoll(segment, segment.stopTime + 10.0f, out);
+    EXPECT_NEAR(out.position.x, 36.0f / (2.0f * decel), 1e-3f);
+    EXPECT_FLOAT_EQ(glm::length(out.velocity), 0.0f);
+}
+
+TEST(BallPhysicsTest, RollMatchesIntegrator) {
+    FieldBounds bounds;
+    BallState integrated = makeRollingBall(Vec3(4.0f, 0.0f, 3.0f));
+    RollSegment segment = BallPhysics::planRoll(integrated, bounds);
+
+    const f32 dt = 1.0f / 240.0f;
+    f32 time = 0.0f;
+    for (int i = 0; i < 240; i++) {
+        BallPhysics::update(integrated, dt, bounds);
+        time += dt;
+    }
+
+    BallState analytic;
+    BallPhysics::evaluateRoll(segment, time, analytic);
+    EXPECT_NEAR(analytic.position.x, integrated.position.x, 0.05f);
+    EXPECT_NEAR(analytic.position.z, integrated.position.z, 0.05f);
+    EXPECT_NEAR(glm::length(analytic.velocity), glm::length(integrated.velocity), 0.05f);
+}
+
+TEST(BallPhysicsTest, RollPredictsSidelineContact) {
+    FieldBounds bounds;
+    BallState ball = makeRollingBall(Vec3(0.0f, 0.0f, 12.0f));
+    ball.position.z = 30.0f;
+    RollSegment segment = BallPhysics::planRoll(ball, bounds);
+
+    ASSERT_FALSE(std::isinf(segment.eventTime));
+    BallState atEvent;
+    BallPhysics::evaluateRoll(segment, segment.eventTime, atEvent);
+    EXPECT_NEAR(atEvent.position.z, bounds.width / 2.0f - BallPhysics::BALL_RADIUS, 1e-3f);
+}
+
+TEST(BallPhysicsTest, EventDrivenReplansAfterOutsideChange) {
+    FieldBounds bounds;
+    BallState ball = makeRollingBall(Vec3(3.0f, 0.0f, 0.0f));
+    RollSegment segment;
+
+    BallPhysics::updateEventDriven(ball, segment, 1.0f / 60.0f, bounds);
+    ASSERT_TRUE(segment.active);
+
+    // A kick between ticks must invalidate the closed-form segment
+    ball.velocity = Vec3(0.0f, 0.0f, -8.0f);
+    BallPhysics::updateEventDriven(ball, segment, 1.0f / 60.0f, bounds);
+    EXPECT_LT(ball.velocity.z, -7.0f);
+    EXPECT_NEAR(ball.velocity.x, 0.0f, 1e-4f);
+}
@@ -0,0 +1,65 @@
+// =============================================================================
+// BodyCollisionTest.cpp - Player Body Collision Tests
+// =============================================================================
+// Sphere-vs-capsule contacts at different heights and grid broadphase queries.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Physics/BodyCollision.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Sports;
+
+TEST(BodyCollisionTest, HeaderHeightBallHitsCapsule) {
+    Capsule body{Vec3(0.0f), 0.3f, BodyCollision::BODY_HEIGHT};
+    BallContact contact;
+
+    // Ball at head height, just touching from the front
+    ASSERT_TRUE(BodyCollision::sphereVsCapsule(Vec3(0.0f, 1.6f, -0.45f), 0.22f, body, contact));
+    EXPECT_GT(contact.heightRatio, 0.85f);
+    EXPECT_LT(contact.normal.z, 0.0f);
+    EXPECT_GT(contact.normal.y, 0.0f);  // Above the segment end: glancing off the top cap
+    EXPECT_NEAR(contact.depth, 0.52f - std::sqrt(0.1f * 0.1f + 0.45f * 0.45f), 1e-4f);
+}
+
+TEST(BodyCollisionTest, BallAboveHeadMisses) {
+    Capsule body{Vec3(0.0f), 0.3f, BodyCollision::BODY_HEIGHT};
+    BallContact contact;
+    EXPECT_FALSE(BodyCollision::sphereVsCapsule(Vec3(0.0f, 2.4f, 0.0f), 0.22f, body, contact));
+}
+
+TEST(BodyCollisionTest, LoftedBallReboundsOffChest) {
+    Capsule body{Vec3(0.0f), 0.3f, BodyCollision::BODY_HEIGHT};
+    BallState ball;
+    ball.position = Vec3(0.0f, 1.2f, -0.5f);
+    ball.velocity = Vec3(0.0f, 0.0f, 10.0f);
+
+    BallContact contact;
+    ASSERT_TRUE(BodyCollision::sphereVsCapsule(ball.position, 0.22f, body, contact));
+    f32 impact = BodyCollision::resolveBallContact(ball, contact, Vec3(0.0f));
+
+    EXPECT_NEAR(impact, 10.0f, 1e-3f);
+    EXPECT_NEAR(ball.velocity.z, -10.0f * BodyCollision::CHEST_RESTITUTION, 1e-3f);
+    EXPECT_NEAR(ball.position.z, -0.52f, 1e-4f);
+}
+
+TEST(BodyCollisionTest, BroadphaseReturnsOnlyNearbyBodies) {
+    std::vector<Capsule> bodies = {
+        {Vec3(0.0f, 0.0f, 0.0f)},
+        {Vec3(20.0f, 0.0f, 10.0f)},
+        {Vec3(-40.0f, 0.0f, -25.0f)},
+    };
+    BodyBroadphase grid;
+    grid.build(bodies, 105.0f, 68.0f);
+
+    std::vector<u32> found;
+    grid.query(Vec3(0.5f, 0.2f, 0.0f), 0.22f, found);
+    EXPECT_NE(std::find(found.begin(), found.end(), 0u), found.end());
+    EXPECT_EQ(std::find(found.begin(), found.end(), 1u), found.end());
+    EXPECT_EQ(std::find(found.begin(), found.end(), 2u), found.end());
+
+    grid.query(Vec3(-40.0f, 0.2f, -25.2f), 0.22f, found);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], 2u);
+}
@@ -0,0 +1,92 @@
+// =============================================================================
+// CpuTopologyTest.cpp - CPU Topology and Placement Tests
+// =============================================================================
+// A fake sysfs tree: 2 L3 domains x 2 cores x 2 SMT threads.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/CpuTopology.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace Sports;
+
+namespace {
+
+void writeFile(const std::filesystem::path& path, const std::string& text) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path) << text << "\n";
+}
+
+// cpuN: core N%4, SMT sibling N+4 (Linux numbering); L3 shared by cores {0,1} and {2,3}
+std::string fakeSysfs() {
+    auto root = std::filesystem::temp_directory_path() / "sports_engine_fake_cpu";
+    std::filesystem::remove_all(root);
+    writeFile(root / "online", "0-7");
+    for (int cpu = 0; cpu < 8; cpu++) {
+        auto dir = root / ("cpu" + std::to_string(cpu));
+        int core = cpu % 4;
+        writeFile(dir / "topology" / "core_id", std::to_string(core));
+        writeFile(dir / "topology" / "physical_package_id", "0");
+        writeFile(dir / "cache" / "index0" / "level", "1");
+        writeFile(dir / "cache" / "index0" / "shared_cpu_list", std::to_string(cpu));
+        writeFile(dir / "cache" / "index3" / "level", "3");
+        writeFile(dir / "cache" / "index3" / "shared_cpu_list", core < 2 ? "0-1,4-5" : "2-3,6-7");
+        writeFile(dir / "cache" / "index1" / "level", "2");
+        writeFile(dir / "cache" / "index2" / "level", "2");
+    }
+    return root.string();
+}
+
+}
+
+TEST(CpuTopologyTest, ParsesCpuLists) {
+    EXPECT_EQ(CpuTopology::parseCpuList("0-3,8,10-11"), (std::vector<u32>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(CpuTopology::parseCpuList("").empty());
+
+    // A corrupt list is rejected whole rather than looping to UINT_MAX
+    EXPECT_TRUE(CpuTopology::parseCpuList("0-4294967295").empty());
+    EXPECT_TRUE(CpuTopology::parseCpuList("0-3,4096").empty());
+    EXPECT_TRUE(CpuTopology::parseCpuList("0-99999999999999999999").empty());
+    EXPECT_EQ(CpuTopology::parseCpuList("4094-4095"), (std::vector<u32>{4094, 4095}));
+}
+
+TEST(CpuTopologyTest, DetectsCoresSiblingsAndDomains) {
+    CpuTopology topology = CpuTopology::detect(fakeSysfs());
+    ASSERT_TRUE(topology.isDetected());
+    EXPECT_EQ(topology.getLogicalCount(), 8u);
+    EXPECT_EQ(topology.getCoreCount(), 4u);
+    EXPECT_EQ(topology.getDomainCount(), 2u);
+    EXPECT_EQ(topology.cpusOfCore(topology.getCpus()[1].core), (std::vector<u32>{1, 5}));
+    EXPECT_EQ(topology.cpusOfDomain(1), (std::vector<u32>{2, 3, 6, 7}));
+}
+
+TEST(CpuTopologyTest, PlacementKeepsWorkersOffTheFrameCore) {
+    CpuTopology topology = CpuTopology::detect(fakeSysfs());
+    ThreadPlacement placement = ThreadPlacement::plan(topology, 5);
+
+    // Not cpu 0's core, and its sibling (cpu 5) is left idle
+    ASSERT_EQ(placement.frameCpus, (std::vector<u32>{1}));
+    ASSERT_EQ(placement.workerCpus.size(), 5u);
+
+    u32 perDomain[2] = {0, 0};
+    for (const auto& cpus : placement.workerCpus) {
+        for (u32 cpu : cpus) {
+            EXPECT_NE(cpu, 1u);
+            EXPECT_NE(cpu, 5u);
+        }
+        perDomain[cpus.front() == 0 ? 0 : 1]++;
+    }
+    // Domain 1 has twice the free cpus, so it takes the larger share
+    EXPECT_EQ(perDomain[0], 2u);
+    EXPECT_EQ(perDomain[1], 3u);
+}
+
+TEST(CpuTopologyTest, MissingSysfsFallsBackUnpinned) {
+    CpuTopology topology = CpuTopology::detect("/nonexistent/cpu");
+    EXPECT_FALSE(topology.isDetected());
+    EXPECT_GE(topology.getLogicalCount(), 1u);
+    ThreadPlacement placement = ThreadPlacement::plan(topology, 4);
+    EXPECT_TRUE(placement.frameCpus.empty());
+    EXPECT_TRUE(placement.workerCpus.empty());
+}
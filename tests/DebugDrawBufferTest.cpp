@@ -0,0 +1,156 @@
+// =============================================================================
+// DebugDrawBufferTest.cpp - Debug Draw Batching Tests
+// =============================================================================
+// Primitive tessellation, layer separation, the per-layer vertex cap, colour
+// packing, and stroke-font label layout.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Renderer/DebugDrawBuffer.hpp"
+#include <set>
+#include <tuple>
+#include <utility>
+
+using namespace Sports;
+
+namespace {
+
+constexpr u32 WHITE = 0xFFFFFFFFu;
+
+bool nearVec(const Vec3& a, const Vec3& b, f32 tolerance = 1e-4f) {
+    return glm::length(a - b) <= tolerance;
+}
+
+}
+
+TEST(DebugDrawBufferTest, PacksColorRedInTheLowByte) {
+    EXPECT_EQ(DebugDrawBuffer::packColor(Vec3(1.0f, 0.0f, 0.0f)), 0xFF0000FFu);
+    EXPECT_EQ(DebugDrawBuffer::packColor(Vec3(0.0f, 0.0f, 1.0f), 0.0f), 0x00FF0000u);
+    EXPECT_EQ(DebugDrawBuffer::packColor(Vec3(2.0f, -1.0f, 0.5f)), 0xFF8000FFu);  // Clamped
+}
+
+TEST(DebugDrawBufferTest, LayersAreBatchedSeparately) {
+    DebugDrawBuffer buffer;
+    buffer.line(DebugLayer::DepthTested, Vec3(0.0f), Vec3(1.0f), WHITE);
+    buffer.line(DebugLayer::Overlay, Vec3(0.0f), Vec3(2.0f), WHITE);
+    buffer.line(DebugLayer::Overlay, Vec3(0.0f), Vec3(3.0f), WHITE);
+
+    EXPECT_EQ(buffer.getVertices(DebugLayer::DepthTested).size(), 2u);
+    EXPECT_EQ(buffer.getVertices(DebugLayer::Overlay).size(), 4u);
+    EXPECT_EQ(buffer.getVertexCount(), 6u);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.getVertexCount(), 0u);
+}
+
+TEST(DebugDrawBufferTest, PrimitivesTessellateToLineLists) {
+    DebugDrawBuffer buffer;
+    Vec3 points[4] = {Vec3(0.0f), Vec3(1.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)};
+    buffer.polyline(DebugLayer::DepthTested, points, 4, WHITE);
+    EXPECT_EQ(buffer.getVertexCount(), 6u);
+
+    buffer.clear();
+    buffer.arrow(DebugLayer::DepthTested, Vec3(0.0f), Vec3(0.0f, 0.0f, 5.0f), WHITE, 0.5f);
+    EXPECT_EQ(buffer.getVertexCount(), 10u);  // Shaft and four head strokes
+
+    buffer.clear();
+    buffer.arrow(DebugLayer::DepthTested, Vec3(1.0f), Vec3(1.0f), WHITE, 0.5f);
+    EXPECT_EQ(buffer.getVertexCount(), 0u);  // No direction, nothing drawn
+
+    buffer.clear();
+    buffer.cross(DebugLayer::DepthTested, Vec3(0.0f), 1.0f, WHITE);
+    EXPECT_EQ(buffer.getVertexCount(), 6u);
+
+    buffer.clear();
+    buffer.sphere(DebugLayer::DepthTested, Vec3(0.0f), 1.0f, WHITE);
+    EXPECT_EQ(buffer.getVertexCount(), 3u * 2u * DebugDrawBuffer::CIRCLE_SEGMENTS);
+}
+
+TEST(DebugDrawBufferTest, BoxHasTwelveDistinctAxisAlignedEdges) {
+    DebugDrawBuffer buffer;
+    buffer.box(DebugLayer::DepthTested, Vec3(-1.0f, 0.0f, -2.0f), Vec3(1.0f, 3.0f, 2.0f), WHITE);
+    const std::vector<DebugVertex>& vertices = buffer.getVertices(DebugLayer::DepthTested);
+    ASSERT_EQ(vertices.size(), 24u);
+
+    std::set<std::pair<std::tuple<f32, f32, f32>, std::tuple<f32, f32, f32>>> edges;
+    for (size_t i = 0; i < vertices.size(); i += 2) {
+        Vec3 delta = vertices[i + 1].position - vertices[i].position;
+        u32 axesChanged = (delta.x != 0.0f) + (delta.y != 0.0f) + (delta.z != 0.0f);
+        EXPECT_EQ(axesChanged, 1u);
+        const Vec3& a = vertices[i].position;
+        const Vec3& b = vertices[i + 1].position;
+        edges.insert({{a.x, a.y, a.z}, {b.x, b.y, b.z}});
+    }
+    EXPECT_EQ(edges.size(), 12u);
+}
+
+TEST(DebugDrawBufferTest, CircleIsClosedAndOnItsRadius) {
+    DebugDrawBuffer buffer;
+    Vec3 center(3.0f, 1.0f, -2.0f);
+    Vec3 normal(0.0f, 0.0f, 1.0f);
+    buffer.circle(DebugLayer::DepthTested, center, 2.0f, normal, WHITE);
+    const std::vector<DebugVertex>& vertices = buffer.getVertices(DebugLayer::DepthTested);
+    ASSERT_EQ(vertices.size(), 2u * DebugDrawBuffer::CIRCLE_SEGMENTS);
+
+    for (const DebugVertex& vertex : vertices) {
+        Vec3 offset = vertex.position - center;
+        EXPECT_NEAR(glm::length(offset), 2.0f, 1e-4f);
+        EXPECT_NEAR(glm::dot(offset, normal), 0.0f, 1e-4f);
+    }
+    // Each segment starts where the last one ended, and the last ends at the first
+    for (size_t i = 2; i < vertices.size(); i += 2) {
+        EXPECT_TRUE(nearVec(vertices[i].position, vertices[i - 1].position));
+    }
+    EXPECT_TRUE(nearVec(vertices.back().position, vertices.front().position));
+}
+
+TEST(DebugDrawBufferTest, FullLayerDropsWholePrimitives) {
+    DebugDrawBuffer buffer;
+    for (size_t i = 0; i < DebugDrawBuffer::MAX_VERTICES / 2 - 1; i++) {
+        buffer.line(DebugLayer::Overlay, Vec3(0.0f), Vec3(1.0f), WHITE);
+    }
+    buffer.cross(DebugLayer::Overlay, Vec3(0.0f), 1.0f, WHITE);  // Needs six, two are left
+    EXPECT_EQ(buffer.getVertices(DebugLayer::Overlay).size(), DebugDrawBuffer::MAX_VERTICES - 2);
+    EXPECT_EQ(buffer.getDroppedCount(), 1u);
+
+    // The other layer has its own budget
+    buffer.cross(DebugLayer::DepthTested, Vec3(0.0f), 1.0f, WHITE);
+    EXPECT_EQ(buffer.getVertices(DebugLayer::DepthTested).size(), 6u);
+}
+
+TEST(DebugDrawBufferTest, GlyphStrokesStayOnTheGrid) {
+    for (int c = 32; c < 127; c++) {
+        const char* strokes = DebugDrawBuffer::glyphStrokes(static_cast<char>(c));
+        for (const char* s = strokes; *s; s += s[4] == ' ' ? 5 : 4) {
+            for (int i = 0; i < 4; i++) {
+                int limit = (i % 2 == 0) ? 4 : 6;
+                ASSERT_GE(s[i], '0') << "glyph " << char(c);
+                ASSERT_LE(s[i], '0' + limit) << "glyph " << char(c);
+            }
+        }
+    }
+    EXPECT_STREQ(DebugDrawBuffer::glyphStrokes('a'), DebugDrawBuffer::glyphStrokes('A'));
+    EXPECT_STREQ(DebugDrawBuffer::glyphStrokes(' '), "");
+}
+
+TEST(DebugDrawBufferTest, LabelsAreCentredInTheCameraPlane) {
+    DebugDrawBuffer buffer;
+    Vec3 anchor(10.0f, 2.0f, 5.0f);
+    buffer.label(DebugLayer::Overlay, anchor, "-", WHITE, 0.6f);
+    EXPECT_EQ(buffer.getVertexCount(), 0u);  // Nothing until the camera is known
+
+    // '-' is one stroke from (1,3) to (3,3) on a glyph four units wide
+    Vec3 right(0.0f, 0.0f, -1.0f);
+    Vec3 up(0.0f, 1.0f, 0.0f);
+    buffer.layoutLabels(right, up);
+    const std::vector<DebugVertex>& vertices = buffer.getVertices(DebugLayer::Overlay);
+    ASSERT_EQ(vertices.size(), 2u);
+    f32 unit = 0.6f / DebugDrawBuffer::GLYPH_HEIGHT;
+    EXPECT_TRUE(nearVec(vertices[0].position, anchor + right * (-1.0f * unit) + up * (3.0f * unit)));
+    EXPECT_TRUE(nearVec(vertices[1].position, anchor + right * (1.0f * unit) + up * (3.0f * unit)));
+
+    // Laid-out labels are consumed; the next frame starts empty
+    buffer.clear();
+    buffer.layoutLabels(right, up);
+    EXPECT_EQ(buffer.getVertexCount(), 0u);
+}
@@ -0,0 +1,61 @@
+// =============================================================================
+// FastMathTest.cpp - Fast Approximation Tests
+// =============================================================================
+// Sweeps each approximation against libm and holds it to its documented bound.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Math/FastMath.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Sports;
+
+TEST(FastMathTest, SinCosWithinBound) {
+    f64 worst = 0.0;
+    for (f32 x = -8192.0f; x <= 8192.0f; x += 0.37f) {
+        f32 s, c;
+        FastMath::sinCos(x, s, c);
+        worst = std::max(worst, std::abs(s - std::sin(static_cast<f64>(x))));
+        worst = std::max(worst, std::abs(c - std::cos(static_cast<f64>(x))));
+    }
+    EXPECT_LE(worst, 2.4e-7);
+}
+
+TEST(FastMathTest, ExpWithinBound) {
+    f64 worst = 0.0;
+    for (f32 x = -87.0f; x <= 88.0f; x += 0.0013f) {
+        f64 exact = std::exp(static_cast<f64>(x));
+        worst = std::max(worst, std::abs(FastMath::exp(x) - exact) / exact);
+    }
+    EXPECT_LE(worst, 1.5e-7);
+    EXPECT_NEAR(1.0f - FastMath::exp(-12.0f * (1.0f / 60.0f)), 1.0f - std::exp(-0.2f), 1e-7f);
+}
+
+TEST(FastMathTest, Atan2WithinBoundInEveryQuadrant) {
+    f64 worst = 0.0;
+    for (f32 angle = -3.14f; angle <= 3.14f; angle += 0.001f) {
+        for (f32 radius : {1e-3f, 1.0f, 250.0f}) {
+            f32 y = radius * std::sin(angle);
+            f32 x = radius * std::cos(angle);
+            worst = std::max(worst, std::abs(FastMath::atan2(y, x) - std::atan2(static_cast<f64>(y), static_cast<f64>(x))));
+        }
+    }
+    EXPECT_LE(worst, 1.2e-5);
+    EXPECT_EQ(FastMath::atan2(0.0f, 0.0f), 0.0f);
+    EXPECT_NEAR(FastMath::atan2(0.0f, -1.0f), FastMath::PI, 1e-6f);
+    EXPECT_NEAR(FastMath::atan2(-1.0f, 0.0f), -FastMath::PI / 2.0f, 1e-6f);
+}
+
+TEST(FastMathTest, BatchMatchesScalar) {
+    f32 angles[11];
+    for (int i = 0; i < 11; i++) angles[i] = -5.0f + i * 0.93f;
+    f32 sines[11], cosines[11];
+    FastMath::sinCos(angles, 11, sines, cosines);
+    for (int i = 0; i < 11; i++) {
+        f32 s, c;
+        FastMath::sinCos(angles[i], s, c);
+        EXPECT_EQ(sines[i], s);
+        EXPECT_EQ(cosines[i], c);
+    }
+}
@@ -0,0 +1,132 @@
+// =============================================================================
+// FlightRecorderTest.cpp - Crash Flight Recorder Tests
+// =============================================================================
+// Ring wraparound, keyframe publishing, and the signal-handler dump path,
+// including a stack overflow on the thread that installed the handler.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/FlightRecorder.hpp"
+#include <csignal>
+#include <filesystem>
+
+using namespace Sports;
+
+namespace {
+
+std::string tempDumpPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+FrameSummary frameAt(u64 index) {
+    FrameSummary summary;
+    summary.frame = index;
+    summary.checksum = index * 31;
+    return summary;
+}
+
+}
+
+TEST(FlightRecorderTest, DumpKeepsLastFramesInOrder) {
+    FlightRecorder recorder;
+    u64 total = FlightRecorder::CAPACITY + 100;
+    for (u64 i = 0; i < total; i++) {
+        recorder.record(frameAt(i));
+    }
+
+    std::vector<u8> keyframe = {1, 2, 3, 4, 5};
+    ASSERT_TRUE(recorder.setKeyframe(900, keyframe));
+
+    std::string path = tempDumpPath("sports_engine_flight.bin");
+    ASSERT_TRUE(recorder.dump(path.c_str(), 0));
+
+    FlightDump dump;
+    ASSERT_TRUE(FlightRecorder::load(path, dump));
+    EXPECT_EQ(dump.totalFrames, total);
+    ASSERT_EQ(dump.frames.size(), FlightRecorder::CAPACITY);
+    EXPECT_EQ(dump.frames.front().frame, 100u);
+    EXPECT_EQ(dump.frames.back().frame, total - 1);
+    for (size_t i = 1; i < dump.frames.size(); i++) {
+        ASSERT_EQ(dump.frames[i].frame, dump.frames[i - 1].frame + 1);
+    }
+    EXPECT_EQ(dump.keyframeFrame, 900u);
+    EXPECT_EQ(dump.keyframe, keyframe);
+
+    std::filesystem::remove(path);
+}
+
+TEST(FlightRecorderTest, LatestKeyframeWins) {
+    FlightRecorder recorder;
+    recorder.record(frameAt(0));
+    std::vector<u8> first(100, 1);
+    std::vector<u8> second(50, 2);
+    recorder.setKeyframe(0, first);
+    recorder.setKeyframe(300, second);
+    EXPECT_FALSE(recorder.setKeyframe(600, std::vector<u8>(FlightRecorder::MAX_KEYFRAME_BYTES + 1)));
+
+    std::string path = tempDumpPath("sports_engine_flight_kf.bin");
+    ASSERT_TRUE(recorder.dump(path.c_str(), 0));
+
+    FlightDump dump;
+    ASSERT_TRUE(FlightRecorder::load(path, dump));
+    EXPECT_EQ(dump.frames.size(), 1u);
+    EXPECT_EQ(dump.keyframeFrame, 300u);
+    EXPECT_EQ(dump.keyframe, second);
+
+    std::filesystem::remove(path);
+}
+
+TEST(FlightRecorderDeathTest, SignalFlushesToDisk) {
+    std::string path = tempDumpPath("sports_engine_flight_crash.bin");
+    std::filesystem::remove(path);
+
+    EXPECT_DEATH({
+        FlightRecorder recorder;
+        recorder.record(frameAt(42));
+        recorder.installCrashHandler(path);
+        std::raise(SIGABRT);
+    }, "");
+
+    FlightDump dump;
+    ASSERT_TRUE(FlightRecorder::load(path, dump));
+    EXPECT_EQ(dump.reason, SIGABRT);
+    ASSERT_EQ(dump.frames.size(), 1u);
+    EXPECT_EQ(dump.frames[0].frame, 42u);
+
+    std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+namespace {
+
+volatile u32 g_overflowDepth = ~0u;  // Never reached; keeps the recursion finite on paper
+
+u32 overflowStack(u32 depth) {
+    volatile u8 frame[4096];
+    frame[0] = static_cast<u8>(depth);
+    if (depth == g_overflowDepth) return frame[0];
+    return overflowStack(depth + 1) + frame[0];  // Not a tail call: every frame stays live
+}
+
+}
+
+TEST(FlightRecorderDeathTest, StackOverflowStillDumps) {
+    std::string path = tempDumpPath("sports_engine_flight_overflow.bin");
+    std::filesystem::remove(path);
+
+    EXPECT_DEATH({
+        FlightRecorder recorder;
+        recorder.record(frameAt(7));
+        recorder.installCrashHandler(path);
+        overflowStack(0);
+    }, "");
+
+    FlightDump dump;
+    ASSERT_TRUE(FlightRecorder::load(path, dump));
+    EXPECT_EQ(dump.reason, SIGSEGV);
+    ASSERT_EQ(dump.frames.size(), 1u);
+    EXPECT_EQ(dump.frames[0].frame, 7u);
+
+    std::filesystem::remove(path);
+}
+#endif
@@ -0,0 +1,219 @@
+// =============================================================================
+// FrameEncoderTest.cpp - Capture Encoder Tests
+// =============================================================================
+// Format selection, the Y4M stream layout, colour conversion, row order, and
+// the drop-instead-of-wait buffer pool.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/FrameEncoder.hpp"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace Sports;
+
+namespace {
+
+std::string tempVideoPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Bottom-up RGBA frame, as glReadPixels returns it, with every row one flat colour
+std::vector<u8> rowColouredFrame(u32 width, u32 height, const std::vector<std::array<u8, 3>>& bottomUpRows) {
+    std::vector<u8> frame(static_cast<size_t>(width) * height * 4);
+    for (u32 y = 0; y < height; y++) {
+        for (u32 x = 0; x < width; x++) {
+            u8* p = &frame[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = bottomUpRows[y][0];
+            p[1] = bottomUpRows[y][1];
+            p[2] = bottomUpRows[y][2];
+            p[3] = 255;
+        }
+    }
+    return frame;
+}
+
+}
+
+TEST(FrameEncoderTest, FormatFollowsExtension) {
+    EXPECT_EQ(FrameEncoder::formatForPath("match.y4m"), VideoFormat::Y4M);
+    EXPECT_EQ(FrameEncoder::formatForPath("MATCH.Y4M"), VideoFormat::Y4M);
+    EXPECT_EQ(FrameEncoder::formatForPath("match.rgba"), VideoFormat::Raw);
+    EXPECT_EQ(FrameEncoder::formatForPath("y4m"), VideoFormat::Raw);
+}
+
+TEST(FrameEncoderTest, PartPathKeepsExtension) {
+    EXPECT_EQ(FrameEncoder::partPath("out/match.y4m", 7), "out/match.part007.y4m");
+    EXPECT_EQ(FrameEncoder::partPath("v1.0/match", 12), "v1.0/match.part012");
+    EXPECT_EQ(FrameEncoder::formatForPath(FrameEncoder::partPath("match.y4m", 0)), VideoFormat::Y4M);
+}
+
+TEST(FrameEncoderTest, Y4MHeaderAndPlaneSizes) {
+    EXPECT_EQ(FrameEncoder::y4mHeader(1600, 900, 60), "YUV4MPEG2 W1600 H900 F60:1 Ip A1:1 C420jpeg\n");
+    EXPECT_EQ(FrameEncoder::i420Size(4, 2), 8u + 2u * 2u);
+    EXPECT_EQ(FrameEncoder::i420Size(3, 3), 9u + 2u * 4u);  // Odd sizes round chroma up
+}
+
+TEST(FrameEncoderTest, ConvertsPrimariesToLimitedRange) {
+    struct Case { u8 r, g, b; u8 y, u, v; };
+    const Case cases[] = {
+        {0, 0, 0, 16, 128, 128},
+        {255, 255, 255, 235, 128, 128},
+        {255, 0, 0, 82, 90, 240},
+        {0, 255, 0, 145, 54, 34},
+        {0, 0, 255, 41, 240, 110},
+    };
+    for (const Case& c : cases) {
+        std::vector<u8> frame = rowColouredFrame(2, 2, {{c.r, c.g, c.b}, {c.r, c.g, c.b}});
+        std::vector<u8> out(FrameEncoder::i420Size(2, 2));
+        FrameEncoder::rgbaToI420(frame.data(), 2, 2, out.data());
+        for (u32 i = 0; i < 4; i++) {
+            EXPECT_NEAR(out[i], c.y, 1) << "rgb " << int(c.r) << "," << int(c.g) << "," << int(c.b);
+        }
+        EXPECT_NEAR(out[4], c.u, 1);
+        EXPECT_NEAR(out[5], c.v, 1);
+    }
+}
+
+TEST(FrameEncoderTest, ConversionFlipsRowsAndAveragesChroma) {
+    // Bottom row black, top row white: the luma plane starts at the top
+    std::vector<u8> frame = rowColouredFrame(2, 2, {{0, 0, 0}, {255, 255, 255}});
+    std::vector<u8> out(FrameEncoder::i420Size(2, 2));
+    FrameEncoder::rgbaToI420(frame.data(), 2, 2, out.data());
+    EXPECT_EQ(out[0], 235);
+    EXPECT_EQ(out[1], 235);
+    EXPECT_EQ(out[2], 16);
+    EXPECT_EQ(out[3], 16);
+    EXPECT_NEAR(out[4], 128, 1);  // Grey average of black and white
+    EXPECT_NEAR(out[5], 128, 1);
+}
+
+TEST(FrameEncoderTest, WritesY4MFramesInSubmitOrder) {
+    std::string path = tempVideoPath("sports_engine_capture.y4m");
+    FrameEncoder encoder;
+    ASSERT_TRUE(encoder.open(path, 2, 2, 30, VideoFormat::Y4M));
+
+    for (u8 shade : {0, 255}) {
+        std::vector<u8>* frame = encoder.acquireFrame(true);
+        ASSERT_NE(frame, nullptr);
+        *frame = rowColouredFrame(2, 2, {{shade, shade, shade}, {shade, shade, shade}});
+        encoder.submitFrame(frame);
+    }
+    encoder.close();
+    EXPECT_EQ(encoder.getWrittenCounter()->load(), 2u);
+    EXPECT_EQ(encoder.getDroppedCounter()->load(), 0u);
+
+    std::string header = FrameEncoder::y4mHeader(2, 2, 30);
+    size_t frameBytes = 6 + FrameEncoder::i420Size(2, 2);
+    std::string video = readFile(path);
+    ASSERT_EQ(video.size(), header.size() + 2 * frameBytes);
+    EXPECT_EQ(video.compare(0, header.size(), header), 0);
+    EXPECT_EQ(video.compare(header.size(), 6, "FRAME\n"), 0);
+    EXPECT_EQ(static_cast<u8>(video[header.size() + 6]), 16);                // Black first
+    EXPECT_EQ(static_cast<u8>(video[header.size() + frameBytes + 6]), 235);  // Then white
+    std::filesystem::remove(path);
+}
+
+TEST(FrameEncoderTest, WorkerStartedEarlyServesLaterRecordings) {
+    std::string path = tempVideoPath("sports_engine_capture_reuse.rgba");
+    FrameEncoder encoder;
+    encoder.startWorker();  // As the engine does before pinning its frame thread
+    encoder.close();        // Nothing open yet: nothing to do
+
+    for (u8 value : {7, 9}) {
+        ASSERT_TRUE(encoder.open(path, 1, 1, 60, VideoFormat::Raw));
+        std::vector<u8>* frame = encoder.acquireFrame(true);
+        ASSERT_NE(frame, nullptr);
+        *frame = {value, value, value, value};
+        encoder.submitFrame(frame);
+        encoder.close();
+        EXPECT_EQ(encoder.getWrittenCounter()->load(), 1u);
+        EXPECT_EQ(readFile(path), std::string(4, static_cast<char>(value)));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(FrameEncoderTest, RawFramesAreWrittenTopRowFirst) {
+    std::string path = tempVideoPath("sports_engine_capture.rgba");
+    FrameEncoder encoder;
+    ASSERT_TRUE(encoder.open(path, 1, 2, 60, VideoFormat::Raw));
+
+    std::vector<u8>* frame = encoder.acquireFrame();
+    ASSERT_NE(frame, nullptr);
+    *frame = {1, 2, 3, 4, 5, 6, 7, 8};  // Bottom row, then top row
+    encoder.submitFrame(frame);
+    encoder.close();
+
+    std::string video = readFile(path);
+    ASSERT_EQ(video.size(), 8u);
+    EXPECT_EQ(video, std::string("\x05\x06\x07\x08\x01\x02\x03\x04", 8));
+    std::filesystem::remove(path);
+}
+
+TEST(FrameEncoderTest, DropsWhenEveryBufferIsTaken) {
+    std::string path = tempVideoPath("sports_engine_drop.rgba");
+    FrameEncoder encoder;
+    ASSERT_TRUE(encoder.open(path, 4, 4, 60, VideoFormat::Raw));
+
+    std::vector<std::vector<u8>*> held;
+    for (u32 i = 0; i < FrameEncoder::QUEUE_DEPTH; i++) {
+        held.push_back(encoder.acquireFrame());
+        ASSERT_NE(held.back(), nullptr);
+    }
+    EXPECT_EQ(encoder.acquireFrame(), nullptr);
+    EXPECT_EQ(encoder.getDroppedCounter()->load(), 1u);
+
+    // Returned buffers can be acquired again; cancelled ones are never written
+    encoder.cancelFrame(held.back());
+    held.pop_back();
+    EXPECT_NE(encoder.acquireFrame(), nullptr);
+    EXPECT_EQ(encoder.getDroppedCounter()->load(), 2u);
+
+    for (std::vector<u8>* frame : held) {
+        encoder.submitFrame(frame);
+    }
+    encoder.close();
+    EXPECT_EQ(encoder.getWrittenCounter()->load(), FrameEncoder::QUEUE_DEPTH - 1);
+    std::filesystem::remove(path);
+}
+
+TEST(FrameEncoderTest, ConcatenatesY4MPartsUnderOneHeader) {
+    std::vector<std::string> parts = {tempVideoPath("sports_engine_part0.y4m"), tempVideoPath("sports_engine_part1.y4m")};
+    for (size_t i = 0; i < parts.size(); i++) {
+        FrameEncoder encoder;
+        ASSERT_TRUE(encoder.open(parts[i], 2, 2, 60, VideoFormat::Y4M));
+        u8 shade = i == 0 ? 0 : 255;
+        std::vector<u8>* frame = encoder.acquireFrame(true);
+        *frame = rowColouredFrame(2, 2, {{shade, shade, shade}, {shade, shade, shade}});
+        encoder.submitFrame(frame);
+    }
+
+    std::string path = tempVideoPath("sports_engine_joined.y4m");
+    ASSERT_TRUE(FrameEncoder::concatenate(parts, path));
+    std::string header = FrameEncoder::y4mHeader(2, 2, 60);
+    size_t frameBytes = 6 + FrameEncoder::i420Size(2, 2);
+    std::string video = readFile(path);
+    ASSERT_EQ(video.size(), header.size() + 2 * frameBytes);
+    EXPECT_EQ(video.compare(header.size() + frameBytes, 6, "FRAME\n"), 0);
+    EXPECT_EQ(static_cast<u8>(video[header.size() + 6]), 16);
+    EXPECT_EQ(static_cast<u8>(video[header.size() + frameBytes + 6]), 235);
+
+    // Parts recorded at another size can't share the first header
+    {
+        FrameEncoder encoder;
+        ASSERT_TRUE(encoder.open(parts[1], 4, 2, 60, VideoFormat::Y4M));
+    }
+    EXPECT_FALSE(FrameEncoder::concatenate(parts, path));
+
+    for (const std::string& part : parts) {
+        std::filesystem::remove(part);
+    }
+    std::filesystem::remove(path);
+}
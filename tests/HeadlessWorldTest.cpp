@@ -0,0 +1,190 @@
+// =============================================================================
+// HeadlessWorldTest.cpp - Forked Simulation Tests
+// =============================================================================
+// Worlds forked from one snapshot replay identically for a given seed, however
+// other worlds step around them; recorded steps come back through the replay
+// index with their events; a lag-compensated challenge applied between steps
+// reaches the referee as a touch, credited to the team the server has on record.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/HeadlessWorld.hpp"
+#include "Game/Player.hpp"
+#include "Game/Replay.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+constexpr f32 DT = 1.0f / 60.0f;
+
+// Teams in their kickoff shape, the human standing out wide
+WorldSnapshot openPlaySnapshot(const Vec3& ballPosition, const Vec3& ballVelocity) {
+    FieldBounds bounds;
+    AIManager ai;
+    ai.createTeams(bounds.length);
+    Ball ball;
+    ball.state().position = ballPosition;
+    ball.state().velocity = ballVelocity;
+    return WorldSnapshot::capture(ball, ai, Vec3(0.0f, 0.0f, 25.0f), bounds);
+}
+
+// Ball at the feet of a red forward, so shots are taken within the first ticks
+WorldSnapshot shootingSnapshot() {
+    FieldBounds bounds;
+    AIManager ai;
+    ai.createTeams(bounds.length);
+    Ball ball;
+    ball.state().position = Vec3(20.0f, Ball::RADIUS, 0.0f);
+    ball.state().velocity = Vec3(0.0f);
+
+    i32 shooter = ai.findClosestOutfielder(0, ball.getPosition());
+    ai.getPlayers()[shooter].setHomePosition(ball.getPosition() - Vec3(0.5f, 0.0f, 0.0f));
+    return WorldSnapshot::capture(ball, ai, Vec3(0.0f, 0.0f, 30.0f), bounds);
+}
+
+// Ball and every AI body, enough to tell two runs apart
+std::vector<Vec3> stateOf(HeadlessWorld& world) {
+    WorldSnapshot state = world.capture();
+    std::vector<Vec3> out = {state.ball.position, state.ball.velocity};
+    for (const AIPlayer& ai : state.aiPlayers) {
+        out.push_back(ai.getPosition());
+    }
+    return out;
+}
+
+}
+
+TEST(HeadlessWorldTest, ForksReplayIdenticallyFromOneSeed) {
+    WorldSnapshot snapshot = shootingSnapshot();
+
+    HeadlessWorld alone;
+    alone.restore(snapshot, 7);
+    for (int i = 0; i < 120; i++) {
+        alone.step(DT);
+    }
+
+    // Same seed again, with another world shooting in between every tick
+    HeadlessWorld interleaved;
+    HeadlessWorld other;
+    interleaved.restore(snapshot, 7);
+    other.restore(snapshot, 8);
+    for (int i = 0; i < 120; i++) {
+        other.step(DT);
+        interleaved.step(DT);
+    }
+
+    EXPECT_EQ(stateOf(alone), stateOf(interleaved));
+    EXPECT_NE(stateOf(alone), stateOf(other));  // The seed reaches the shot
+}
+
+TEST(HeadlessWorldTest, RecordedStepsComeBackThroughTheIndex) {
+    std::string path = (std::filesystem::temp_directory_path() / "sports_headless_record.rpl").string();
+    HeadlessWorld world;
+    // Red's ball flying into the +X goal, nobody near enough to stop it
+    world.restore(openPlaySnapshot(Vec3(49.0f, 1.0f, 0.5f), Vec3(24.0f, 0.0f, 0.0f)));
+    ASSERT_TRUE(world.startRecording(path, 60));
+    EXPECT_TRUE(world.isRecording());
+    constexpr u64 STEPS = 90;
+    for (u64 i = 0; i < STEPS; i++) {
+        world.step(DT);
+    }
+    ASSERT_TRUE(world.stopRecording());
+    EXPECT_FALSE(world.isRecording());
+
+    ReplayIndex index;
+    ASSERT_TRUE(index.open(path));
+    EXPECT_EQ(index.getHeader().tickCount, STEPS);
+    EXPECT_EQ(index.getHeader().tickRate, 60u);
+    EXPECT_EQ(index.getHeader().playerCount, world.getAI().getPlayers().size() + 1);  // AI, then the human
+    ASSERT_FALSE(index.getKeyframes().empty());
+    EXPECT_EQ(index.getKeyframes()[0].tick, 0u);
+
+    auto events = index.getEvents();
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(),
+                               [](const MatchEvent& a, const MatchEvent& b) { return a.tick < b.tick; }));
+    auto goals = std::count_if(events.begin(), events.end(),
+                               [](const MatchEvent& event) { return event.type == MatchEventType::Goal; });
+    ASSERT_EQ(goals, 1);
+    const MatchEvent& goal = *std::find_if(events.begin(), events.end(),
+                                           [](const MatchEvent& event) { return event.type == MatchEventType::Goal; });
+    EXPECT_EQ(goal.team, 0);
+    EXPECT_LT(goal.tick, 15u);  // About 4 m to the line at 24 m/s
+    EXPECT_GT(goal.value, 20.0f);
+    index.close();
+
+    // The recorded ticks play back
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ReplayFrame frame;
+    ASSERT_TRUE(reader.seek(STEPS - 1));
+    ASSERT_TRUE(reader.read(frame));
+    EXPECT_EQ(frame.tick, STEPS - 1);
+    EXPECT_EQ(frame.scoreRight, 1);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST(HeadlessWorldTest, ChallengeBetweenStepsReachesTheReferee) {
+    HeadlessWorld world;
+    // Loose ball at the human's feet, every AI player at least 20 m away
+    world.restore(openPlaySnapshot(Vec3(0.6f, Ball::RADIUS, 25.0f), Vec3(0.0f)));
+    world.enableLagCompensation();
+    for (int i = 0; i < 6; i++) {
+        world.step(DT);
+    }
+    ASSERT_EQ(world.getMatch().getRules().getLastTouchTeam(), -1);
+
+    ChallengeCommand kick;
+    kick.slot = static_cast<u32>(world.getAI().getPlayers().size());  // The human, after the AI
+    kick.team = Player::TEAM;
+    kick.viewTick = world.getTick() - 3;  // As a client ~50 ms behind saw it
+    kick.viewAlpha = 0.5f;
+    kick.direction = Vec3(-1.0f, 0.0f, 0.0f);
+    kick.power = 12.0f;
+
+    ChallengeCommand stale = kick;
+    stale.viewTick = 0;
+    world.step(DT);
+    for (int i = 0; i < static_cast<int>(LagCompensator::MAX_REWIND_TICKS); i++) {
+        world.step(DT);
+    }
+    EXPECT_EQ(world.applyChallenge(stale), ChallengeResult::TooOld);
+    EXPECT_EQ(world.getMatch().getRules().getLastTouchTeam(), -1);
+
+    kick.viewTick = world.getTick() - 3;
+    ASSERT_EQ(world.applyChallenge(kick), ChallengeResult::Accepted);
+    EXPECT_LT(world.getBall().getVelocity().x, 0.0f);  // The ball moves at once
+
+    world.step(DT);  // The accepted kick is this tick's first contact
+    EXPECT_EQ(world.getMatch().getRules().getLastTouchTeam(), Player::TEAM);
+}
+
+TEST(HeadlessWorldTest, ChallengeTeamComesFromTheServerRoster) {
+    HeadlessWorld world;
+    world.restore(openPlaySnapshot(Vec3(0.6f, Ball::RADIUS, 25.0f), Vec3(0.0f)));
+    world.enableLagCompensation();
+    for (int i = 0; i < 6; i++) {
+        world.step(DT);
+    }
+
+    u32 humanSlot = static_cast<u32>(world.getAI().getPlayers().size());
+    ChallengeCommand kick;
+    kick.slot = humanSlot;
+    kick.team = 1 - Player::TEAM;  // Spoofed: would hand the next restart to the other side
+    kick.viewTick = world.getTick() - 3;
+    kick.viewAlpha = 0.5f;
+    kick.direction = Vec3(-1.0f, 0.0f, 0.0f);
+    kick.power = 12.0f;
+
+    ChallengeCommand unknown = kick;
+    unknown.slot = humanSlot + 1;
+    EXPECT_EQ(world.applyChallenge(unknown), ChallengeResult::UnknownSlot);
+
+    ASSERT_EQ(world.applyChallenge(kick), ChallengeResult::Accepted);
+    world.step(DT);
+    EXPECT_EQ(world.getMatch().getRules().getLastTouchTeam(), Player::TEAM);
+}
@@ -0,0 +1,120 @@
+// =============================================================================
+// HiZPyramidTest.cpp - Hi-Z Occlusion Tests
+// =============================================================================
+// Synthetic depth buffers: a wall in front of the camera must hide boxes behind
+// it and nothing else, and the pyramid must stay conservative at its edges.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Renderer/HiZPyramid.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+constexpr u32 WIDTH = 160;
+constexpr u32 HEIGHT = 90;
+
+// Camera at the origin looking down -Z
+Mat4 viewProjection() {
+    Mat4 projection = glm::perspective(glm::radians(60.0f), static_cast<f32>(WIDTH) / HEIGHT, 0.1f, 500.0f);
+    Mat4 view = glm::lookAt(Vec3(0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// Window depth of a point straight ahead at the given distance
+f32 depthAt(f32 distance) {
+    Vec4 clip = viewProjection() * Vec4(0.0f, 0.0f, -distance, 1.0f);
+    return clip.z / clip.w * 0.5f + 0.5f;
+}
+
+// Full-screen wall at wallDistance, except the left quarter which sees the far plane
+std::vector<f32> wallDepth(f32 wallDistance) {
+    std::vector<f32> depth(WIDTH * HEIGHT, depthAt(wallDistance));
+    for (u32 y = 0; y < HEIGHT; y++) {
+        for (u32 x = 0; x < WIDTH / 4; x++) {
+            depth[y * WIDTH + x] = 1.0f;
+        }
+    }
+    return depth;
+}
+
+}
+
+TEST(HiZPyramidTest, LevelsReduceToSingleTexelHoldingFarthestDepth) {
+    std::vector<f32> depth(WIDTH * HEIGHT, 0.25f);
+    depth[37 * WIDTH + 101] = 0.75f;
+
+    HiZPyramid pyramid;
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+
+    ASSERT_TRUE(pyramid.isValid());
+    EXPECT_EQ(pyramid.getLevelWidth(0), WIDTH / HiZPyramid::BASE_BLOCK);
+    EXPECT_EQ(pyramid.getLevelHeight(0), (HEIGHT + 3) / HiZPyramid::BASE_BLOCK);
+    u32 top = pyramid.getLevelCount() - 1;
+    EXPECT_EQ(pyramid.getLevelWidth(top), 1u);
+    EXPECT_EQ(pyramid.getLevelHeight(top), 1u);
+    EXPECT_FLOAT_EQ(pyramid.getTexel(top, 0, 0), 0.75f);
+    EXPECT_FLOAT_EQ(pyramid.getTexel(0, 101 / 4, 37 / 4), 0.75f);
+    EXPECT_FLOAT_EQ(pyramid.getTexel(0, 0, 0), 0.25f);
+}
+
+TEST(HiZPyramidTest, BoxBehindWallIsHidden) {
+    std::vector<f32> depth = wallDepth(20.0f);
+    HiZPyramid pyramid;
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+
+    // Centred, 40m away: entirely behind the wall
+    EXPECT_FALSE(pyramid.isVisible(Vec3(-2.0f, -2.0f, -42.0f), Vec3(2.0f, 2.0f, -38.0f)));
+}
+
+TEST(HiZPyramidTest, BoxInFrontOfWallIsVisible) {
+    std::vector<f32> depth = wallDepth(20.0f);
+    HiZPyramid pyramid;
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-1.0f, -1.0f, -11.0f), Vec3(1.0f, 1.0f, -9.0f)));
+    // Straddling the wall counts as visible
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-1.0f, -1.0f, -25.0f), Vec3(1.0f, 1.0f, -15.0f)));
+}
+
+TEST(HiZPyramidTest, BoxOverGapInWallIsVisible) {
+    std::vector<f32> depth = wallDepth(20.0f);
+    HiZPyramid pyramid;
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+
+    // Far left of the view, where the wall is missing
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-30.0f, -1.0f, -42.0f), Vec3(-28.0f, 1.0f, -40.0f)));
+}
+
+TEST(HiZPyramidTest, OffscreenAndNearPlaneBoxesAreVisible) {
+    std::vector<f32> depth(WIDTH * HEIGHT, 0.0f);  // Everything behind the near plane would be hidden
+    HiZPyramid pyramid;
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+
+    // Partly outside the captured view
+    EXPECT_TRUE(pyramid.isVisible(Vec3(10.0f, -1.0f, -12.0f), Vec3(20.0f, 1.0f, -10.0f)));
+    // Behind the camera
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-1.0f, -1.0f, 5.0f), Vec3(1.0f, 1.0f, 7.0f)));
+}
+
+TEST(HiZPyramidTest, InvalidPyramidHidesNothing) {
+    std::vector<f32> depth = wallDepth(20.0f);
+    HiZPyramid pyramid;
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-2.0f, -2.0f, -42.0f), Vec3(2.0f, 2.0f, -38.0f)));
+
+    pyramid.build(depth.data(), WIDTH, HEIGHT, viewProjection());
+    pyramid.invalidate();
+    EXPECT_TRUE(pyramid.isVisible(Vec3(-2.0f, -2.0f, -42.0f), Vec3(2.0f, 2.0f, -38.0f)));
+}
+
+TEST(HiZPyramidTest, FrustumRejectsOnlyBoxesWhollyOutside) {
+    Mat4 vp = viewProjection();
+    EXPECT_TRUE(HiZPyramid::inFrustum(vp, Vec3(-1.0f, -1.0f, -11.0f), Vec3(1.0f, 1.0f, -9.0f)));
+    EXPECT_TRUE(HiZPyramid::inFrustum(vp, Vec3(-1.0f, -1.0f, -1.0f), Vec3(1.0f, 1.0f, 1.0f)));  // Around the eye
+    EXPECT_FALSE(HiZPyramid::inFrustum(vp, Vec3(-1.0f, -1.0f, 5.0f), Vec3(1.0f, 1.0f, 7.0f)));   // Behind
+    EXPECT_FALSE(HiZPyramid::inFrustum(vp, Vec3(50.0f, -1.0f, -12.0f), Vec3(60.0f, 1.0f, -10.0f)));  // Right
+    EXPECT_FALSE(HiZPyramid::inFrustum(vp, Vec3(-1.0f, -1.0f, -700.0f), Vec3(1.0f, 1.0f, -600.0f))); // Past far
+}
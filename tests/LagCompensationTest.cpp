@@ -0,0 +1,135 @@
+// =============================================================================
+// LagCompensationTest.cpp - Server Rewind Tests
+// =============================================================================
+// History lookup by tick, interpolated rewinds, reach checks against the past,
+// and refusing views that are too old, too new, or already superseded.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/LagCompensation.hpp"
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+// The ball rolls along +X at 0.5 m per tick past two stationary bodies
+// (slot 0 an AI player at x = 2, slot 1 the human at x = 20)
+struct Server {
+    LagCompensator history;
+    Ball ball;
+    std::vector<Vec3> bodies{Vec3(2.0f, 0.0f, 0.0f), Vec3(20.0f, 0.0f, 0.0f)};
+
+    void run(u64 ticks) {
+        for (u64 tick = 0; tick < ticks; tick++) {
+            tickAt(tick);
+        }
+    }
+
+    void tickAt(u64 tick) {
+        ball.setPosition(Vec3(0.5f * static_cast<f32>(tick), Ball::RADIUS, 0.0f));
+        history.record(tick, ball, bodies);
+        ball.clearContacts();
+    }
+};
+
+ChallengeCommand kickFrom(u32 slot, u64 viewTick, f32 viewAlpha = 0.0f) {
+    ChallengeCommand command;
+    command.slot = slot;
+    command.team = 1;
+    command.viewTick = viewTick;
+    command.viewAlpha = viewAlpha;
+    command.direction = Vec3(0.0f, 0.0f, 1.0f);
+    command.power = 15.0f;
+    return command;
+}
+
+}
+
+TEST(LagCompensationTest, RewindInterpolatesBetweenTicks) {
+    Server server;
+    server.run(10);
+
+    RewoundState state;
+    ASSERT_TRUE(server.history.rewind(4, 0.5f, 0, state));
+    EXPECT_FLOAT_EQ(state.ball.x, 2.25f);
+    EXPECT_FLOAT_EQ(state.body.x, 2.0f);
+
+    // Nothing after the newest tick to blend toward
+    ASSERT_TRUE(server.history.rewind(9, 0.5f, 0, state));
+    EXPECT_FLOAT_EQ(state.ball.x, 4.5f);
+
+    EXPECT_FALSE(server.history.rewind(10, 0.0f, 0, state));
+    EXPECT_FALSE(server.history.rewind(4, 0.0f, 2, state));
+}
+
+TEST(LagCompensationTest, HistoryIsBoundedToTheRing) {
+    Server server;
+    server.run(LagCompensator::HISTORY_TICKS * 3);
+
+    RewoundState state;
+    u64 latest = server.history.getLatestTick();
+    EXPECT_EQ(latest, LagCompensator::HISTORY_TICKS * 3 - 1);
+    EXPECT_TRUE(server.history.rewind(latest - (LagCompensator::HISTORY_TICKS - 1), 0.0f, 0, state));
+    EXPECT_FALSE(server.history.rewind(latest - LagCompensator::HISTORY_TICKS, 0.0f, 0, state));
+}
+
+TEST(LagCompensationTest, KickJudgedWhereTheClientSawTheBall) {
+    Server server;
+    server.run(12);  // The ball passed slot 0 around tick 4 and is now 3.5 m beyond it
+
+    // Now it's out of reach, but as seen at tick 4 it was at the feet
+    EXPECT_EQ(server.history.apply(kickFrom(0, 11), server.ball), ChallengeResult::OutOfRange);
+    EXPECT_EQ(server.history.apply(kickFrom(0, 4), server.ball), ChallengeResult::Accepted);
+
+    // Applied to the present ball
+    EXPECT_FLOAT_EQ(server.ball.getPosition().x, 5.5f);
+    EXPECT_NEAR(server.ball.getVelocity().z, 15.0f, 1e-4f);
+    ASSERT_EQ(server.ball.getContacts().size(), 1u);
+    EXPECT_EQ(server.ball.getContacts()[0].playerIndex, 0);
+    EXPECT_EQ(server.ball.getContacts()[0].team, 1);
+}
+
+TEST(LagCompensationTest, HumanSlotRecordsAsTheHumanPlayer) {
+    Server server;
+    server.bodies[1] = Vec3(3.0f, 0.0f, 1.0f);
+    server.run(8);
+
+    ChallengeCommand tackle = kickFrom(1, 6);
+    tackle.type = ChallengeType::Tackle;
+    EXPECT_EQ(server.history.apply(tackle, server.ball), ChallengeResult::Accepted);
+    ASSERT_EQ(server.ball.getContacts().size(), 1u);
+    EXPECT_EQ(server.ball.getContacts()[0].playerIndex, -1);
+}
+
+TEST(LagCompensationTest, RefusesViewsOutsideTheRewindWindow) {
+    Server server;
+    server.run(40);
+
+    u64 latest = server.history.getLatestTick();
+    EXPECT_EQ(server.history.apply(kickFrom(0, latest + 1), server.ball), ChallengeResult::InFuture);
+    EXPECT_EQ(server.history.apply(kickFrom(0, latest - LagCompensator::MAX_REWIND_TICKS - 1), server.ball),
+              ChallengeResult::TooOld);
+    EXPECT_EQ(server.history.apply(kickFrom(5, latest), server.ball), ChallengeResult::UnknownSlot);
+    EXPECT_TRUE(server.ball.getContacts().empty());
+
+    LagCompensator empty;
+    EXPECT_EQ(empty.apply(kickFrom(0, 0), server.ball), ChallengeResult::InFuture);
+}
+
+TEST(LagCompensationTest, FirstTouchSinceTheViewWins) {
+    Server server;
+    server.bodies[1] = Vec3(2.5f, 0.0f, 0.5f);  // Both bodies near the ball at tick 4
+    server.run(6);
+
+    // Two clients act on the same view; the second arrives before the next tick
+    EXPECT_EQ(server.history.apply(kickFrom(1, 4), server.ball), ChallengeResult::Accepted);
+    EXPECT_EQ(server.history.apply(kickFrom(0, 4), server.ball), ChallengeResult::Superseded);
+
+    // Still superseded once the touch is in the history
+    server.tickAt(6);
+    EXPECT_EQ(server.history.apply(kickFrom(0, 4), server.ball), ChallengeResult::Superseded);
+
+    // The player who touched it last may play it again
+    EXPECT_EQ(server.history.apply(kickFrom(1, 4), server.ball), ChallengeResult::Accepted);
+}
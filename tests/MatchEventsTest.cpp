@@ -0,0 +1,154 @@
+// =============================================================================
+// MatchEventsTest.cpp - Highlight Event Detection Tests
+// =============================================================================
+// Goals on the rising edge, shots projected onto the goal line, near misses
+// found after the referee has already moved the ball, long passes dated at the
+// pass, and fast balls reported once at their peak.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/MatchEvents.hpp"
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+constexpr f32 DT = 1.0f / 60.0f;
+
+// Steps a ball that moves on its own velocity unless a test places it
+struct Feed {
+    MatchEventDetector detector;
+    BallState ball;
+    u64 tick = 0;
+    std::vector<MatchEvent> events;
+
+    void step(std::vector<ContactEvent> contacts = {}, bool goalScored = false, i32 scoringTeam = -1) {
+        detector.observe(tick++, DT, ball, contacts, goalScored, scoringTeam, events);
+        ball.position += ball.velocity * DT;
+    }
+
+    size_t count(MatchEventType type) const {
+        size_t n = 0;
+        for (const MatchEvent& event : events) {
+            n += event.type == type;
+        }
+        return n;
+    }
+};
+
+ContactEvent touchBy(i32 team, i32 playerIndex, const Vec3& point) {
+    ContactEvent touch;
+    touch.team = team;
+    touch.playerIndex = playerIndex;
+    touch.point = point;
+    return touch;
+}
+
+}
+
+TEST(MatchEventsTest, GoalOnceWhenScored) {
+    Feed feed;
+    feed.ball.position = Vec3(52.0f, 1.0f, 0.0f);
+    feed.ball.velocity = Vec3(18.0f, 0.0f, 0.0f);
+    feed.step();
+    for (int i = 0; i < 10; i++) {
+        feed.step({}, true, 0);  // The celebration lasts many ticks
+    }
+
+    ASSERT_EQ(feed.count(MatchEventType::Goal), 1u);
+    EXPECT_EQ(feed.events[0].tick, 1u);
+    EXPECT_EQ(feed.events[0].team, 0);
+    EXPECT_NEAR(feed.events[0].value, 18.0f, 0.01f);
+}
+
+TEST(MatchEventsTest, ShotNeedsPaceAndTheFrame) {
+    Feed feed;
+    feed.ball.position = Vec3(30.0f, 0.3f, 0.0f);
+
+    feed.ball.velocity = Vec3(22.0f, 3.0f, 1.0f);  // Team 0 attacks +X: on target
+    feed.step({touchBy(0, 3, feed.ball.position)});
+    ASSERT_EQ(feed.count(MatchEventType::Shot), 1u);
+    EXPECT_EQ(feed.events[0].team, 0);
+
+    feed.ball.position = Vec3(30.0f, 0.3f, 0.0f);
+    feed.ball.velocity = Vec3(22.0f, 0.0f, 14.0f);  // Crosses the line ~14 m wide
+    feed.step({touchBy(0, 3, feed.ball.position)});
+    feed.ball.velocity = Vec3(22.0f, 12.0f, 0.0f);  // Sails over the bar
+    feed.step({touchBy(0, 3, feed.ball.position)});
+    feed.ball.velocity = Vec3(22.0f, 0.0f, 0.0f);   // Team 1 clearing toward the other goal
+    feed.step({touchBy(1, 5, feed.ball.position)});
+    feed.ball.velocity = Vec3(8.0f, 0.0f, 0.0f);    // Too soft
+    feed.step({touchBy(0, 3, feed.ball.position)});
+    EXPECT_EQ(feed.count(MatchEventType::Shot), 1u);
+}
+
+TEST(MatchEventsTest, NearMissFoundAfterTheBallIsPlacedForTheRestart) {
+    // Last tick in play, short of the wall one radius inside the goal line where the ball
+    // is ruled out; the referee then puts it on the goal-kick spot
+    auto missBy = [](f32 z, f32 y, f32 speed = 20.0f) {
+        Feed feed;
+        f32 wall = FieldBounds{}.length / 2.0f - BallPhysics::BALL_RADIUS;
+        feed.ball.position = Vec3(wall - 0.5f * speed * DT, y, z);
+        feed.ball.velocity = Vec3(speed, 0.0f, 0.0f);
+        feed.step();
+        feed.ball.position = Vec3(47.0f, BallPhysics::BALL_RADIUS, 9.16f);
+        feed.ball.velocity = Vec3(0.0f);
+        feed.step();
+        return feed.events;
+    };
+
+    std::vector<MatchEvent> wide = missBy(5.0f, 0.5f);
+    ASSERT_EQ(wide.size(), 1u);
+    EXPECT_EQ(wide[0].type, MatchEventType::NearMiss);
+    EXPECT_EQ(wide[0].tick, 1u);
+    EXPECT_EQ(wide[0].team, 0);
+    EXPECT_NEAR(wide[0].value, 5.0f - 3.66f, 0.01f);
+
+    std::vector<MatchEvent> over = missBy(0.0f, 3.0f);
+    ASSERT_EQ(over.size(), 1u);
+    EXPECT_NEAR(over[0].value, 3.0f - 2.44f, 0.01f);
+
+    // A slow ball never gets within one step of the line itself, only of the wall
+    std::vector<MatchEvent> slow = missBy(5.0f, 0.5f, 6.0f);
+    ASSERT_EQ(slow.size(), 1u);
+    EXPECT_NEAR(slow[0].value, 5.0f - 3.66f, 0.01f);
+
+    EXPECT_TRUE(missBy(12.0f, 0.5f).empty());  // Nowhere near
+    EXPECT_TRUE(missBy(1.0f, 0.5f).empty());   // In the mouth: a goal, not a miss
+}
+
+TEST(MatchEventsTest, LongPassDatedAtThePass) {
+    Feed feed;
+    feed.step({touchBy(1, 2, Vec3(-20.0f, 0.0f, 0.0f))});
+    for (int i = 0; i < 40; i++) feed.step();
+    feed.step({touchBy(1, 4, Vec3(15.0f, 0.0f, 5.0f))});
+
+    ASSERT_EQ(feed.count(MatchEventType::LongPass), 1u);
+    EXPECT_EQ(feed.events[0].tick, 0u);
+    EXPECT_EQ(feed.events[0].team, 1);
+    EXPECT_NEAR(feed.events[0].value, glm::length(Vec2(35.0f, 5.0f)), 0.01f);
+
+    // Dribbling, a short pass, and an interception don't count
+    feed.step({touchBy(1, 4, Vec3(50.0f, 0.0f, 5.0f))});
+    feed.step({touchBy(1, 6, Vec3(40.0f, 0.0f, 5.0f))});
+    feed.step({touchBy(0, 1, Vec3(0.0f, 0.0f, 5.0f))});
+    feed.step({touchBy(1, 2, Vec3(-40.0f, 0.0f, 5.0f))});
+    EXPECT_EQ(feed.count(MatchEventType::LongPass), 1u);
+}
+
+TEST(MatchEventsTest, FastBallReportedOnceAtItsPeak) {
+    Feed feed;
+    feed.ball.position = Vec3(0.0f, 1.0f, 0.0f);
+    for (f32 speed : {20.0f, 29.0f, 33.0f, 31.0f, 28.5f, 24.0f, 30.0f}) {
+        feed.ball.velocity = Vec3(speed, 0.0f, 0.0f);
+        feed.step();
+    }
+    ASSERT_EQ(feed.count(MatchEventType::FastBall), 1u);
+    EXPECT_EQ(feed.events[0].tick, 2u);
+    EXPECT_NEAR(feed.events[0].value, 33.0f, 0.01f);
+
+    feed.detector.flush(feed.events);  // The last spell was still going
+    ASSERT_EQ(feed.count(MatchEventType::FastBall), 2u);
+    EXPECT_EQ(feed.events[1].tick, 6u);
+}
@@ -0,0 +1,119 @@
+// =============================================================================
+// MetricsTest.cpp - Metrics Registry Tests
+// =============================================================================
+// Per-thread counters sum on scrape; histograms render cumulative buckets; the
+// endpoint serves scrapes and can't be held open by a silent client.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/Logger.hpp"
+#include "Core/Metrics.hpp"
+#include "Core/MetricsServer.hpp"
+#include "Core/Timer.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace Sports;
+
+TEST(MetricsTest, CountersSumAcrossThreads) {
+    MetricId id = Metrics::counter("test_events_total", "Events", {{"source", "threads"}});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([id] {
+            for (int i = 0; i < 1000; i++) Metrics::add(id);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    Metrics::add(id, 5);
+
+    std::string text = Metrics::renderPrometheus();
+    EXPECT_NE(text.find("# TYPE test_events_total counter"), std::string::npos);
+    EXPECT_NE(text.find("test_events_total{source=\"threads\"} 4005\n"), std::string::npos);
+}
+
+TEST(MetricsTest, HistogramBucketsAreCumulative) {
+    MetricId id = Metrics::histogram("test_latency_ms", "Latency", {1, 10});
+    Metrics::observe(id, 0.5);
+    Metrics::observe(id, 5.0);
+    Metrics::observe(id, 5.0);
+    Metrics::observe(id, 50.0);
+
+    std::string text = Metrics::renderPrometheus();
+    EXPECT_NE(text.find("test_latency_ms_bucket{le=\"1\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_bucket{le=\"10\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_bucket{le=\"+Inf\"} 4\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_sum 60.5\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_count 4\n"), std::string::npos);
+}
+
+TEST(MetricsTest, GaugesAndJsonLine) {
+    MetricId id = Metrics::gauge("test_queue_depth", "Depth");
+    Metrics::set(id, 3.0);
+    Metrics::set(id, 7.0);
+
+    EXPECT_NE(Metrics::renderPrometheus().find("test_queue_depth 7\n"), std::string::npos);
+
+    std::string json = Metrics::renderJson();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("{\"name\":\"test_queue_depth\",\"value\":7}"), std::string::npos);
+    EXPECT_EQ(json.find('\n'), std::string::npos);
+}
+
+#ifndef _WIN32
+namespace {
+
+int connectTo(u16 port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+}
+
+TEST(MetricsTest, ServerAnswersScrapesAndStopsPastSilentClients) {
+    if (!Logger::getCoreLogger()) {
+        Logger::init();  // The server reports its address through the engine log
+    }
+    MetricsServer server;
+    ASSERT_TRUE(server.start(0));
+
+    int scraper = connectTo(server.getPort());
+    ASSERT_GE(scraper, 0);
+    const char request[] = "GET /metrics HTTP/1.1\r\n\r\n";
+    ASSERT_EQ(::send(scraper, request, sizeof(request) - 1, 0), static_cast<ssize_t>(sizeof(request) - 1));
+    std::string response;
+    char buffer[4096];
+    for (ssize_t n; (n = ::recv(scraper, buffer, sizeof(buffer), 0)) > 0;) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(scraper);
+    EXPECT_EQ(response.rfind("HTTP/1.1 200 OK", 0), 0u);
+
+    // Connected but never sends: the serve thread is stuck in this client when stop() comes
+    int silent = connectTo(server.getPort());
+    ASSERT_GE(silent, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    Timer clock;
+    server.stop();
+    EXPECT_LT(clock.elapsedMillis(), 1000.0);
+    EXPECT_FALSE(server.isRunning());
+    ::close(silent);
+}
+#endif
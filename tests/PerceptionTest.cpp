@@ -0,0 +1,90 @@
+// =============================================================================
+// PerceptionTest.cpp - Vision and Occlusion Tests
+// =============================================================================
+// Bodies in the line of sight hide what is behind them below head height, a
+// body never hides its own slot, and the SSE and scalar paths agree on every
+// observer of random layouts.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/AIPlayer.hpp"
+#include "Game/Perception.hpp"
+#include <random>
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+// AI players stand where placed, facing -Z (rotation 0)
+AIPlayer standingAt(f32 x, f32 z) {
+    AIPlayer ai;
+    ai.setHomePosition(Vec3(x, 0.0f, z));
+    return ai;
+}
+
+}
+
+TEST(PerceptionTest, BodyInTheWayHidesWhatIsBehind) {
+    std::vector<AIPlayer> players = {standingAt(0.0f, 0.0f), standingAt(0.0f, -5.0f), standingAt(0.0f, -10.0f)};
+    Vec3 human(20.0f, 0.0f, 40.0f);  // Behind the observer and far: never seen
+    PerceptionSystem perception;
+
+    perception.update(0, players, human, Vec3(0.0f, Ball::RADIUS, -12.0f));
+    EXPECT_TRUE(perception.canSee(0, 1));
+    EXPECT_FALSE(perception.canSee(0, 2));
+    EXPECT_FALSE(perception.canSeeBall(0));
+    EXPECT_FALSE(perception.canSee(0, perception.getHumanSlot()));
+
+    // Step the blocker aside and roll the ball clear of both; a ball in the air clears heads
+    players[1] = standingAt(1.0f, -5.0f);
+    perception.update(1, players, human, Vec3(-2.0f, Ball::RADIUS, -12.0f));
+    EXPECT_TRUE(perception.canSee(0, 2));
+    EXPECT_TRUE(perception.canSeeBall(0));
+
+    players[1] = standingAt(0.0f, -5.0f);
+    perception.update(2, players, human, Vec3(0.0f, 6.0f, -12.0f));
+    EXPECT_TRUE(perception.canSeeBall(0));
+}
+
+TEST(PerceptionTest, BodiesSharingASpotDoNotHideEachOther) {
+    // Two bodies on one spot: each is still visible, whatever its index
+    std::vector<AIPlayer> players = {standingAt(0.0f, 0.0f), standingAt(0.0f, -8.0f), standingAt(0.0f, -8.0f)};
+    PerceptionSystem perception;
+    for (bool simd : {true, false}) {
+        perception.setSimdEnabled(simd);
+        perception.update(simd ? 0 : 1, players, Vec3(30.0f, 0.0f, 30.0f), Vec3(30.0f, 0.0f, 31.0f));
+        EXPECT_TRUE(perception.canSee(0, 1)) << "simd " << simd;
+        EXPECT_TRUE(perception.canSee(0, 2)) << "simd " << simd;
+    }
+}
+
+TEST(PerceptionTest, SimdAndScalarAgreeOnRandomLayouts) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<f32> alongX(-52.0f, 52.0f);
+    std::uniform_real_distribution<f32> alongZ(-34.0f, 34.0f);
+    std::uniform_real_distribution<f32> nearby(-3.0f, 3.0f);
+    std::uniform_real_distribution<f32> height(0.0f, 4.0f);
+
+    PerceptionSystem simd;
+    PerceptionSystem scalar;
+    scalar.setSimdEnabled(false);
+    for (u32 layout = 0; layout < 300; layout++) {
+        // Crowded on odd layouts (a goalmouth scramble), spread on even ones
+        std::vector<AIPlayer> players;
+        u32 count = 1 + layout % (PerceptionSystem::MAX_ENTITIES - 2);
+        for (u32 i = 0; i < count; i++) {
+            players.push_back(layout % 2 ? standingAt(nearby(rng) * 3.0f, nearby(rng) * 3.0f)
+                                         : standingAt(alongX(rng), alongZ(rng)));
+        }
+        Vec3 human(alongX(rng), 0.0f, alongZ(rng));
+        Vec3 ball(nearby(rng), height(rng), nearby(rng));
+
+        simd.update(layout, players, human, ball);
+        scalar.update(layout, players, human, ball);
+        for (u32 observer = 0; observer < count; observer++) {
+            ASSERT_EQ(simd.getVisibleMask(observer), scalar.getVisibleMask(observer))
+                << "layout " << layout << " observer " << observer;
+        }
+    }
+}
@@ -0,0 +1,182 @@
+// =============================================================================
+// RenderGraphTest.cpp - Render Graph Compilation Tests
+// =============================================================================
+// Culling, transient aliasing, state diffing, and validation, with no GL: the
+// passes are declared but never executed.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Renderer/RenderGraph.hpp"
+
+using namespace Sports;
+
+namespace {
+
+const RenderTargetDesc HDR{640, 360, TargetFormat::RGBA16F, true};
+const RenderTargetDesc HALF{320, 180, TargetFormat::RGBA16F, false};
+const RenderTargetDesc LDR{640, 360, TargetFormat::RGBA8, false};
+
+std::vector<std::string> planNames(const RenderGraph& graph) {
+    std::vector<std::string> names;
+    for (const auto& step : graph.getPlan()) {
+        names.push_back(graph.getPass(step.pass).name);
+    }
+    return names;
+}
+
+}
+
+TEST(RenderGraphTest, CullsPassesNothingConsumes) {
+    RenderGraph graph;
+    ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+    ResourceHandle scene = graph.createTarget("scene", HDR);
+    ResourceHandle unused = graph.createTarget("unused", HALF);
+
+    graph.addPass("scene", nullptr).write(scene, LoadOp::Clear);
+    auto orphan = graph.addPass("orphan", nullptr);
+    orphan.read(scene);
+    orphan.write(unused);
+    auto resolve = graph.addPass("resolve", nullptr);
+    resolve.read(scene);
+    resolve.write(backbuffer);
+
+    ASSERT_TRUE(graph.compile()) << graph.getError();
+    EXPECT_EQ(planNames(graph), (std::vector<std::string>{"scene", "resolve"}));
+    EXPECT_EQ(graph.getCulledCount(), 1u);
+}
+
+TEST(RenderGraphTest, SideEffectPassesSurviveWithoutOutputs) {
+    RenderGraph graph;
+    ResourceHandle scene = graph.createTarget("scene", HDR);
+    graph.addPass("scene", nullptr).write(scene, LoadOp::Clear);
+    auto capture = graph.addPass("capture", nullptr);
+    capture.read(scene);
+    capture.setSideEffect();
+
+    ASSERT_TRUE(graph.compile()) << graph.getError();
+    EXPECT_EQ(planNames(graph), (std::vector<std::string>{"scene", "capture"}));
+}
+
+TEST(RenderGraphTest, ClearingWriteKillsEarlierWriterButLoadKeepsIt) {
+    RenderGraph graph;
+    ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+    ResourceHandle target = graph.createTarget("target", HALF);
+
+    graph.addPass("overwritten", nullptr).write(target, LoadOp::Clear);
+    graph.addPass("base", nullptr).write(target, LoadOp::Clear);
+    graph.addPass("accumulate", nullptr).write(target, LoadOp::Load);
+    auto resolve = graph.addPass("resolve", nullptr);
+    resolve.read(target);
+    resolve.write(backbuffer);
+
+    ASSERT_TRUE(graph.compile()) << graph.getError();
+    EXPECT_EQ(planNames(graph), (std::vector<std::string>{"base", "accumulate", "resolve"}));
+}
+
+TEST(RenderGraphTest, DisjointLifetimesWithMatchingDescsShareASlot) {
+    RenderGraph graph;
+    ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+    ResourceHandle a = graph.createTarget("a", HALF);
+    ResourceHandle b = graph.createTarget("b", HALF);
+    ResourceHandle c = graph.createTarget("c", HALF);
+    ResourceHandle ldr = graph.createTarget("ldr", LDR);
+
+    graph.addPass("make_a", nullptr).write(a);
+    auto makeB = graph.addPass("make_b", nullptr);
+    makeB.read(a);
+    makeB.write(b);                 // a and b overlap here
+    auto makeC = graph.addPass("make_c", nullptr);
+    makeC.read(b);
+    makeC.write(c);                 // a is dead: c can take its slot
+    auto toLdr = graph.addPass("to_ldr", nullptr);
+    toLdr.read(c);
+    toLdr.write(ldr);
+    auto present = graph.addPass("present", nullptr);
+    present.read(ldr);
+    present.write(backbuffer);
+
+    ASSERT_TRUE(graph.compile()) << graph.getError();
+    EXPECT_NE(graph.getResource(a).physical, graph.getResource(b).physical);
+    EXPECT_NE(graph.getResource(b).physical, graph.getResource(c).physical);
+    EXPECT_EQ(graph.getResource(a).physical, graph.getResource(c).physical);
+    EXPECT_NE(graph.getResource(ldr).physical, graph.getResource(a).physical);  // Different format
+    EXPECT_EQ(graph.getPhysicalCount(), 3u);
+
+    // Each slot is acquired once and released once across the plan
+    std::vector<u32> acquired(graph.getPhysicalCount(), 0);
+    std::vector<u32> released(graph.getPhysicalCount(), 0);
+    for (const auto& step : graph.getPlan()) {
+        for (u32 slot : step.acquire) acquired[slot]++;
+        for (u32 slot : step.release) released[slot]++;
+    }
+    EXPECT_EQ(acquired, (std::vector<u32>{2, 1, 1}));
+    EXPECT_EQ(released, (std::vector<u32>{2, 1, 1}));
+}
+
+TEST(RenderGraphTest, OnlyChangedStateIsRecorded) {
+    RenderGraph graph;
+    ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+    ResourceHandle scene = graph.createTarget("scene", HDR);
+
+    auto opaque = graph.addPass("opaque", nullptr);
+    opaque.write(scene, LoadOp::Clear);
+    opaque.setState({true, true, BlendMode::Opaque});
+    auto decals = graph.addPass("decals", nullptr);
+    decals.write(scene, LoadOp::Load);
+    decals.setState({true, false, BlendMode::Alpha});
+    auto capture = graph.addPass("capture", nullptr);
+    capture.read(scene);
+    capture.setSideEffect();
+    auto resolve = graph.addPass("resolve", nullptr);
+    resolve.read(scene);
+    resolve.write(backbuffer);
+    resolve.setState({false, false, BlendMode::Opaque});
+    auto hud = graph.addPass("hud", nullptr);
+    hud.write(backbuffer, LoadOp::Load);
+    hud.setState({false, false, BlendMode::Opaque});
+
+    ASSERT_TRUE(graph.compile()) << graph.getError();
+    const auto& plan = graph.getPlan();
+    ASSERT_EQ(plan.size(), 5u);
+    EXPECT_EQ(plan[0].stateChanges, static_cast<u32>(CHANGE_ALL));
+    EXPECT_EQ(plan[1].stateChanges, static_cast<u32>(CHANGE_DEPTH_WRITE | CHANGE_BLEND));
+    EXPECT_EQ(plan[2].stateChanges, 0u);  // Doesn't draw
+    EXPECT_EQ(plan[3].stateChanges, static_cast<u32>(CHANGE_TARGET | CHANGE_DEPTH_TEST | CHANGE_BLEND));
+    EXPECT_EQ(plan[4].stateChanges, 0u);
+}
+
+TEST(RenderGraphTest, RejectsReadsOfUnwrittenTargets) {
+    RenderGraph graph;
+    ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+    ResourceHandle never = graph.createTarget("never", HALF);
+    auto pass = graph.addPass("resolve", nullptr);
+    pass.read(never);
+    pass.write(backbuffer);
+
+    EXPECT_FALSE(graph.compile());
+    EXPECT_NE(graph.getError().find("never"), std::string::npos);
+    EXPECT_TRUE(graph.getPlan().empty());
+}
+
+TEST(RenderGraphTest, RejectsSecondTargetOnOnePass) {
+    RenderGraph graph;
+    ResourceHandle a = graph.createTarget("a", HALF);
+    ResourceHandle b = graph.createTarget("b", HALF);
+    auto pass = graph.addPass("split", nullptr);
+    pass.write(a);
+    pass.write(b);
+
+    EXPECT_FALSE(graph.compile());
+}
+
+TEST(RenderGraphTest, ResetAllowsRebuildingEachFrame) {
+    RenderGraph graph;
+    for (int frame = 0; frame < 3; frame++) {
+        graph.reset();
+        ResourceHandle backbuffer = graph.importTarget("backbuffer", LDR);
+        graph.addPass("clear", nullptr).write(backbuffer, LoadOp::Clear);
+        ASSERT_TRUE(graph.compile());
+        EXPECT_EQ(graph.getPassCount(), 1u);
+        EXPECT_EQ(graph.getPhysicalCount(), 0u);  // Imported targets take no slot
+    }
+}
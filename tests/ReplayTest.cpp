@@ -0,0 +1,265 @@
+// =============================================================================
+// ReplayTest.cpp - Replay Format Tests
+// =============================================================================
+// Quantized round trips, forced keyframes, seeking, recovery of an unclosed
+// file, the mapped event index, and splitting a replay into export segments.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/Replay.hpp"
+#include <cmath>
+#include <filesystem>
+
+using namespace Sports;
+
+namespace {
+
+std::string tempReplayPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+const ReplayRole ROLES[] = {ReplayRole::TeamRed, ReplayRole::TeamBlue, ReplayRole::Human};
+
+// Smooth motion, except the ball jumps 45 m at tick 450 (a reset)
+ReplayFrame frameAt(u64 tick) {
+    f32 t = static_cast<f32>(tick) / 60.0f;
+    ReplayFrame frame;
+    frame.tick = tick;
+    frame.ball.position = Vec3(40.0f * std::sin(t * 0.3f) - (tick >= 450 ? 45.0f : 0.0f), 0.11f, 5.0f);
+    frame.ball.pitch = t * 9.0f;  // Keeps rolling past a full turn
+    for (u32 i = 0; i < 3; i++) {
+        BodyPose pose;
+        pose.position = Vec3(-30.0f + i * 20.0f + t, 0.0f, std::cos(t + i) * 10.0f);
+        pose.yaw = std::sin(t * 0.5f + i) * 3.0f;
+        pose.pitch = 0.1f;
+        pose.bob = 0.04f * std::sin(t * 8.0f);
+        frame.players.push_back(pose);
+    }
+    frame.scoreLeft = static_cast<u8>(tick / 500);
+    frame.celebration = tick % 500 < 60 ? 1.0f : 0.0f;
+    return frame;
+}
+
+// Angles come back wrapped to (-pi, pi]
+f32 angleError(f32 a, f32 b) {
+    f32 d = std::fmod(std::abs(a - b), 6.2831853f);
+    return std::min(d, 6.2831853f - d);
+}
+
+void expectNear(const ReplayFrame& actual, const ReplayFrame& expected) {
+    ASSERT_EQ(actual.tick, expected.tick);
+    ASSERT_EQ(actual.players.size(), expected.players.size());
+    EXPECT_NEAR(actual.ball.position.x, expected.ball.position.x, 0.001f);
+    EXPECT_LT(angleError(actual.ball.pitch, expected.ball.pitch), 0.001f);
+    for (size_t i = 0; i < expected.players.size(); i++) {
+        EXPECT_NEAR(actual.players[i].position.x, expected.players[i].position.x, 0.001f);
+        EXPECT_NEAR(actual.players[i].position.z, expected.players[i].position.z, 0.001f);
+        EXPECT_LT(angleError(actual.players[i].yaw, expected.players[i].yaw), 0.001f);
+        EXPECT_NEAR(actual.players[i].bob, expected.players[i].bob, 0.001f);
+    }
+    EXPECT_EQ(actual.scoreLeft, expected.scoreLeft);
+    EXPECT_NEAR(actual.celebration, expected.celebration, 0.01f);
+}
+
+void writeReplay(const std::string& path, u64 firstTick, u64 count) {
+    ReplayWriter writer;
+    ASSERT_TRUE(writer.open(path, ROLES, 60));
+    for (u64 tick = firstTick; tick < firstTick + count; tick++) {
+        ASSERT_TRUE(writer.write(frameAt(tick)));
+    }
+    ASSERT_TRUE(writer.close());
+}
+
+}
+
+TEST(ReplayTest, RoundTripsWithinQuantization) {
+    std::string path = tempReplayPath("sports_replay_roundtrip.rpl");
+    writeReplay(path, 100, 1000);
+
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getFirstTick(), 100u);
+    EXPECT_EQ(reader.getEndTick(), 1100u);
+    ASSERT_EQ(reader.getRoles().size(), 3u);
+    EXPECT_EQ(reader.getRoles()[2], ReplayRole::Human);
+
+    ReplayFrame frame;
+    for (u64 tick = 100; tick < 1100; tick++) {
+        ASSERT_TRUE(reader.read(frame));
+        expectNear(frame, frameAt(tick));
+    }
+    EXPECT_FALSE(reader.read(frame));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, KeyframesEveryIntervalAndOnJumps) {
+    std::string path = tempReplayPath("sports_replay_keyframes.rpl");
+    writeReplay(path, 0, 1000);
+
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    std::vector<u64> ticks;
+    for (const ReplayKeyframe& keyframe : reader.getKeyframes()) {
+        ticks.push_back(keyframe.tick);
+    }
+    // The reset at 450 doesn't fit a 16-bit delta, so it starts the next interval
+    EXPECT_EQ(ticks, (std::vector<u64>{0, 300, 450, 750}));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, SeekMatchesSequentialDecode) {
+    std::string path = tempReplayPath("sports_replay_seek.rpl");
+    writeReplay(path, 0, 1000);
+
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ReplayFrame frame;
+    for (u64 tick : {737u, 0u, 450u, 999u, 301u}) {
+        ASSERT_TRUE(reader.seek(tick));
+        ASSERT_TRUE(reader.read(frame));
+        expectNear(frame, frameAt(tick));
+    }
+    EXPECT_FALSE(reader.seek(1000));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, UnclosedReplayIsRecoveredByScanning) {
+    std::string path = tempReplayPath("sports_replay_unclosed.rpl");
+    writeReplay(path, 0, 700);
+
+    // What a crash leaves: no index, the header as first written, and a torn last record
+    ReplayHeader header;
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1u);
+    u64 recordsEnd = header.indexOffset;
+    header.indexOffset = 0;
+    header.keyframeCount = 0;
+    header.tickCount = 0;
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fclose(file);
+    std::filesystem::resize_file(path, recordsEnd - 10);
+
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getEndTick(), 699u);
+    EXPECT_EQ(reader.getKeyframes().size(), 3u);
+    ReplayFrame frame;
+    ASSERT_TRUE(reader.seek(698));
+    ASSERT_TRUE(reader.read(frame));
+    expectNear(frame, frameAt(698));
+    EXPECT_FALSE(reader.read(frame));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, IndexMapsKeyframesAndSortedEvents) {
+    std::string path = tempReplayPath("sports_replay_index.rpl");
+    {
+        ReplayWriter writer;
+        ASSERT_TRUE(writer.open(path, ROLES, 60));
+        for (u64 tick = 0; tick < 1000; tick++) {
+            ASSERT_TRUE(writer.write(frameAt(tick)));
+        }
+        // Added as detected: a long pass is only known at the reception, after a later shot
+        writer.addEvent({500, 31.0f, MatchEventType::Goal, 1});
+        writer.addEvent({420, 22.5f, MatchEventType::Shot, 0});
+        writer.addEvent({380, 41.0f, MatchEventType::LongPass, 0});
+        EXPECT_EQ(writer.getEventCount(), 3u);
+        ASSERT_TRUE(writer.close());
+    }
+
+    ReplayIndex index;
+    ASSERT_TRUE(index.open(path));
+    EXPECT_EQ(index.getHeader().tickCount, 1000u);
+    EXPECT_EQ(index.getHeader().indexOffset % 8, 0u);
+    ASSERT_EQ(index.getKeyframes().size(), 4u);
+    EXPECT_EQ(index.getKeyframes()[2].tick, 450u);
+
+    auto events = index.getEvents();
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].type, MatchEventType::LongPass);
+    EXPECT_EQ(events[1].type, MatchEventType::Shot);
+    EXPECT_EQ(events[2].tick, 500u);
+    EXPECT_EQ(events[2].team, 1);
+    EXPECT_FLOAT_EQ(events[2].value, 31.0f);
+    index.close();
+
+    // The tables at the end don't get in the way of playback
+    ReplayReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ReplayFrame frame;
+    ASSERT_TRUE(reader.seek(999));
+    ASSERT_TRUE(reader.read(frame));
+    expectNear(frame, frameAt(999));
+    EXPECT_FALSE(reader.read(frame));
+    reader.close();
+
+    // An unclosed replay has no tables to map
+    ReplayHeader header;
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1u);
+    header.indexOffset = 0;
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fclose(file);
+    EXPECT_FALSE(index.open(path));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, RejectsWrongPlayerCountAndForeignFiles) {
+    std::string path = tempReplayPath("sports_replay_reject.rpl");
+    ReplayWriter writer;
+    ASSERT_TRUE(writer.open(path, ROLES, 60));
+    ReplayFrame frame = frameAt(0);
+    frame.players.pop_back();
+    EXPECT_FALSE(writer.write(frame));
+    writer.close();
+
+    ReplayReader reader;
+    EXPECT_FALSE(reader.open(path));  // No ticks, so nothing to seek to
+
+    // Version 1 files had a 48-byte header: reading them as 64 would misplace every record
+    writeReplay(path, 0, 10);
+    ReplayHeader header;
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1, file), 1u);
+    EXPECT_EQ(header.version, ReplayHeader::VERSION);
+    header.version = 1;
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fclose(file);
+    EXPECT_FALSE(reader.open(path));
+    ReplayIndex index;
+    EXPECT_FALSE(index.open(path));
+
+    file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a replay at all, just some text long enough for a header", file);
+    std::fclose(file);
+    EXPECT_FALSE(reader.open(path));
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayTest, SplitsAtNearestKeyframes) {
+    std::vector<ReplayKeyframe> keyframes;
+    for (u64 tick = 0; tick < 3000; tick += 300) {
+        keyframes.push_back({tick, 0});
+    }
+
+    std::vector<TickRange> ranges = splitAtKeyframes(keyframes, 3000, 4);
+    ASSERT_EQ(ranges.size(), 4u);
+    EXPECT_EQ(ranges[0].begin, 0u);
+    EXPECT_EQ(ranges.back().end, 3000u);
+    for (size_t i = 1; i < ranges.size(); i++) {
+        EXPECT_EQ(ranges[i].begin, ranges[i - 1].end);
+        EXPECT_EQ(ranges[i].begin % 300, 0u);
+    }
+    EXPECT_EQ(ranges[1].begin, 600u);  // Ideal 750: 600 and 900 tie, the earlier wins
+    EXPECT_EQ(ranges[2].begin, 1500u);
+
+    // More segments asked for than keyframes: one per keyframe
+    EXPECT_EQ(splitAtKeyframes(keyframes, 3000, 50).size(), keyframes.size());
+    EXPECT_TRUE(splitAtKeyframes({}, 3000, 4).empty());
+}
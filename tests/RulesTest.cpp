@@ -0,0 +1,146 @@
+// =============================================================================
+// RulesTest.cpp - Restart and Offside Tests
+// =============================================================================
+// Boundary events award the right restart; touches judge offside at the pass.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/Rules.hpp"
+
+using namespace Sports;
+
+namespace {
+
+RulesEngine makeRules() {
+    RulesEngine rules;
+    rules.setFieldDimensions(105.0f, 68.0f, 7.32f, 2.44f);
+    return rules;
+}
+
+ContactEvent touch(i32 team, i32 playerIndex) {
+    ContactEvent event;
+    event.team = team;
+    event.playerIndex = playerIndex;
+    return event;
+}
+
+// Slots 0-1 red (attack +X), 2-4 blue (defend +X), slot 5 is the human (blue)
+struct Squad {
+    std::vector<Vec3> positions{
+        Vec3(10.0f, 0.0f, 0.0f),   // Red passer
+        Vec3(35.0f, 0.0f, 5.0f),   // Red forward
+        Vec3(50.0f, 0.0f, 0.0f),   // Blue keeper
+        Vec3(30.0f, 0.0f, -5.0f),  // Blue defender: second-last at x = 30
+        Vec3(20.0f, 0.0f, 5.0f),
+        Vec3(0.0f, 0.0f, 10.0f)
+    };
+    std::vector<i32> teams{0, 0, 1, 1, 1, 1};
+};
+
+}
+
+TEST(RulesTest, TouchlineGivesThrowInToOpponents) {
+    RulesEngine rules = makeRules();
+    Squad squad;
+    BallState ball;
+    ball.position = Vec3(10.0f, 0.11f, 0.0f);
+    rules.onTouches({touch(1, 3)}, squad.positions, squad.teams, ball);
+
+    ball.position = Vec3(12.0f, 0.11f, 33.95f);
+    ball.velocity = Vec3(0.0f, 0.0f, 5.0f);
+    ASSERT_TRUE(rules.onBoundary(ball));
+
+    const Restart& restart = rules.getLastRestart();
+    EXPECT_EQ(restart.type, RestartType::ThrowIn);
+    EXPECT_EQ(restart.team, 0);
+    EXPECT_FLOAT_EQ(ball.position.x, 12.0f);
+    EXPECT_FLOAT_EQ(glm::length(ball.velocity), 0.0f);
+    EXPECT_FALSE(rules.onBoundary(ball));  // Dead ball on its spot is in play
+}
+
+TEST(RulesTest, GoalLineGivesCornerOrGoalKick) {
+    RulesEngine rules = makeRules();
+    Squad squad;
+    BallState ball;
+
+    // Blue (defending +X) last touched it: corner to red
+    rules.onTouches({touch(1, 2)}, squad.positions, squad.teams, ball);
+    ball.position = Vec3(52.45f, 0.11f, 10.0f);
+    ASSERT_TRUE(rules.onBoundary(ball));
+    EXPECT_EQ(rules.getLastRestart().type, RestartType::CornerKick);
+    EXPECT_EQ(rules.getLastRestart().team, 0);
+
+    // Red last touched it: goal kick to blue
+    rules.onTouches({touch(0, 1)}, squad.positions, squad.teams, ball);
+    ball.position = Vec3(52.45f, 0.11f, -10.0f);
+    ASSERT_TRUE(rules.onBoundary(ball));
+    EXPECT_EQ(rules.getLastRestart().type, RestartType::GoalKick);
+    EXPECT_EQ(rules.getLastRestart().team, 1);
+
+    // Goal mouth is not out of play
+    ball.position = Vec3(52.45f, 0.11f, 0.0f);
+    EXPECT_FALSE(rules.onBoundary(ball));
+}
+
+TEST(RulesTest, ReceivingPassBeyondSecondLastDefenderIsOffside) {
+    RulesEngine rules = makeRules();
+    Squad squad;
+    BallState ball;
+    ball.position = squad.positions[0];
+
+    EXPECT_FALSE(rules.onTouches({touch(0, 0)}, squad.positions, squad.teams, ball));
+    EXPECT_FLOAT_EQ(rules.getOffsideLines().getLineX(1), 30.0f);
+    EXPECT_EQ(rules.getOffsideCandidates(), 1ull << 1);
+
+    // Forward runs back onside after the pass: still offside, judged at the pass
+    squad.positions[1].x = 25.0f;
+    ASSERT_TRUE(rules.onTouches({touch(0, 1)}, squad.positions, squad.teams, ball));
+    EXPECT_EQ(rules.getLastRestart().type, RestartType::IndirectFreeKick);
+    EXPECT_EQ(rules.getLastRestart().team, 1);
+    EXPECT_FLOAT_EQ(ball.position.x, 25.0f);
+}
+
+TEST(RulesTest, OpponentTouchClearsOffside) {
+    RulesEngine rules = makeRules();
+    Squad squad;
+    BallState ball;
+    ball.position = squad.positions[0];
+
+    rules.onTouches({touch(0, 0)}, squad.positions, squad.teams, ball);
+    EXPECT_FALSE(rules.onTouches({touch(1, -1), touch(0, 1)}, squad.positions, squad.teams, ball));
+}
+
+TEST(RulesTest, NoOffsideStraightFromThrowIn) {
+    RulesEngine rules = makeRules();
+    Squad squad;
+    BallState ball;
+
+    rules.onTouches({touch(1, 4)}, squad.positions, squad.teams, ball);
+    ball.position = Vec3(10.0f, 0.11f, 34.0f);
+    ASSERT_TRUE(rules.onBoundary(ball));
+
+    EXPECT_FALSE(rules.onTouches({touch(0, 0)}, squad.positions, squad.teams, ball));
+    EXPECT_FALSE(rules.onTouches({touch(0, 1)}, squad.positions, squad.teams, ball));
+}
+
+TEST(RulesTest, OffsideLinesReuseOrderBetweenTouches) {
+    OffsideLines lines;
+    lines.setFieldLength(105.0f);
+    Squad squad;
+
+    lines.refresh(squad.positions, squad.teams);
+    EXPECT_FLOAT_EQ(lines.getLineX(0), 35.0f);  // Only two red players: the higher x
+    EXPECT_FLOAT_EQ(lines.getLineX(1), 30.0f);
+
+    // Small movement that keeps the order costs no shifts
+    for (auto& p : squad.positions) p.x += 0.5f;
+    lines.refresh(squad.positions, squad.teams);
+    EXPECT_EQ(lines.getLastSortShifts(), 0u);
+    EXPECT_FLOAT_EQ(lines.getLineX(1), 30.5f);
+
+    // Defender overtakes the keeper: one swap, new line
+    squad.positions[3].x = 51.0f;
+    lines.refresh(squad.positions, squad.teams);
+    EXPECT_EQ(lines.getLastSortShifts(), 1u);
+    EXPECT_FLOAT_EQ(lines.getLineX(1), 50.5f);
+}
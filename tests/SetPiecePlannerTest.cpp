@@ -0,0 +1,91 @@
+// =============================================================================
+// SetPiecePlannerTest.cpp - Set-Piece Search Tests
+// =============================================================================
+// A free kick near the box must come back as a usable plan for the taker, and
+// the search must hand control back within its wall-clock budget.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Game/SetPiecePlanner.hpp"
+
+using namespace Sports;
+
+namespace {
+
+// Red free kick 25 m out, taken by the nearest red outfielder
+WorldSnapshot freeKickSnapshot(i32& takerIndex) {
+    FieldBounds bounds;
+    AIManager ai;
+    ai.createTeams(bounds.length);
+    Ball ball;
+    ball.state().position = Vec3(27.5f, Ball::RADIUS, 6.0f);
+    ball.state().velocity = Vec3(0.0f);
+
+    takerIndex = ai.findClosestOutfielder(0, ball.getPosition());
+    ai.getPlayers()[takerIndex].setHomePosition(ball.getPosition() - Vec3(0.8f, 0.0f, 0.0f));
+    return WorldSnapshot::capture(ball, ai, Vec3(0.0f, 0.0f, 30.0f), bounds);
+}
+
+}
+
+TEST(SetPiecePlannerTest, FreeKickPlanIsUsable) {
+    i32 taker = -1;
+    WorldSnapshot snapshot = freeKickSnapshot(taker);
+    ASSERT_GE(taker, 0);
+
+    JobSystem jobs(2);
+    SetPiecePlanner planner(jobs);
+    PlannerConfig config;
+    config.budgetMs = 10000.0f;  // Bounded by rollouts, not time
+    config.maxRollouts = 60;
+    SetPiecePlan plan = planner.plan(snapshot, 0, taker, config);
+
+    ASSERT_TRUE(plan.valid);
+    EXPECT_EQ(plan.takerIndex, taker);
+    EXPECT_GE(plan.rollouts, config.maxRollouts);
+    EXPECT_GE(plan.expectedValue, -1.0f);
+    EXPECT_LE(plan.expectedValue, 1.0f);
+    EXPECT_NEAR(glm::length(plan.kickDirection), 1.0f, 0.01f);
+    EXPECT_GT(plan.kickPower, 0.0f);
+    if (plan.runnerIndex >= 0) {
+        const AIPlayer& runner = snapshot.aiPlayers[plan.runnerIndex];
+        EXPECT_EQ(runner.getTeam(), 0);
+        EXPECT_NE(plan.runnerIndex, taker);
+        EXPECT_FALSE(runner.isGoalkeeper());
+    }
+}
+
+TEST(SetPiecePlannerTest, ReturnsWithinBudget) {
+    i32 taker = -1;
+    WorldSnapshot snapshot = freeKickSnapshot(taker);
+
+    JobSystem jobs(2);
+    SetPiecePlanner planner(jobs);
+    PlannerConfig config;
+    config.budgetMs = 15.0f;
+    config.horizon = 60.0f;  // Rollouts far longer than the budget: the deadline has to cut them off
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        Timer clock;
+        SetPiecePlan plan = planner.plan(snapshot, 0, taker, config);
+        f64 elapsed = clock.elapsedMillis();
+        EXPECT_LT(elapsed, config.budgetMs + 10.0) << "attempt " << attempt;
+        EXPECT_EQ(plan.valid, plan.rollouts > 0);  // Only finished rollouts back a recommendation
+    }
+
+    config.horizon = 1.0f;
+    Timer clock;
+    SetPiecePlan plan = planner.plan(snapshot, 0, taker, config);
+    EXPECT_LT(clock.elapsedMillis(), config.budgetMs + 10.0);
+    EXPECT_TRUE(plan.valid);
+    EXPECT_GT(plan.rollouts, 0u);
+}
+
+TEST(SetPiecePlannerTest, OutOfRangeTakerIsRejected) {
+    i32 taker = -1;
+    WorldSnapshot snapshot = freeKickSnapshot(taker);
+    JobSystem jobs(1);
+    SetPiecePlanner planner(jobs);
+    EXPECT_FALSE(planner.plan(snapshot, 0, -1).valid);
+    EXPECT_FALSE(planner.plan(snapshot, 0, static_cast<i32>(snapshot.aiPlayers.size())).valid);
+}
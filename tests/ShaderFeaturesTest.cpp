@@ -0,0 +1,70 @@
+// =============================================================================
+// ShaderFeaturesTest.cpp - Shader Permutation Source Tests
+// =============================================================================
+// Define injection and fallback selection; the compiling itself needs a GL
+// context and isn't covered here.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Renderer/ShaderFeatures.hpp"
+
+using namespace Sports;
+
+namespace {
+
+const char* SOURCE =
+    "#version 450 core\n"
+    "// comment\n"
+    "void main() {}\n";
+
+}
+
+TEST(ShaderFeaturesTest, BaseVariantIsTheSourceUnchanged) {
+    EXPECT_EQ(ShaderFeatures::inject(SOURCE, 0), SOURCE);
+    EXPECT_EQ(ShaderFeatures::describe(0), "base");
+}
+
+TEST(ShaderFeaturesTest, DefinesFollowTheVersionLine) {
+    std::string result = ShaderFeatures::inject(SOURCE, SHADER_FOG | SHADER_INSTANCING);
+    EXPECT_EQ(result,
+              "#version 450 core\n"
+              "#define INSTANCING\n"
+              "#define FOG\n"
+              "#line 2\n"
+              "// comment\n"
+              "void main() {}\n");
+}
+
+TEST(ShaderFeaturesTest, LineDirectiveAccountsForLinesBeforeVersion) {
+    std::string result = ShaderFeatures::inject("\n\n#version 450 core\nvoid main() {}", SHADER_SHADOWS);
+    EXPECT_EQ(result, "\n\n#version 450 core\n#define SHADOWS\n#line 4\nvoid main() {}");
+}
+
+TEST(ShaderFeaturesTest, SourcesWithoutVersionGetDefinesFirst) {
+    EXPECT_EQ(ShaderFeatures::inject("void main() {}\n", SHADER_SKINNING),
+              "#define SKINNING\n#line 1\nvoid main() {}\n");
+    EXPECT_EQ(ShaderFeatures::inject("#version 450 core", SHADER_FOG),
+              "#version 450 core\n#define FOG\n#line 2\n");
+}
+
+TEST(ShaderFeaturesTest, UnknownBitsAreIgnored) {
+    EXPECT_EQ(ShaderFeatures::inject(SOURCE, 1u << 20), SOURCE);
+    EXPECT_EQ(ShaderFeatures::describe(SHADER_FOG | (1u << 20)), "FOG");
+    EXPECT_EQ(ShaderFeatures::describe(SHADER_FEATURE_MASK), "INSTANCING+SKINNING+SHADOWS+FOG");
+}
+
+TEST(ShaderFeaturesTest, FallbackIsTheLargestReadySubset) {
+    u32 wanted = SHADER_FOG | SHADER_SHADOWS | SHADER_INSTANCING;
+    u32 ready = 1u;  // Base only
+    EXPECT_EQ(ShaderFeatures::bestReadySubset(wanted, ready), 0u);
+
+    ready |= 1u << SHADER_FOG;
+    ready |= 1u << SHADER_SKINNING;  // Not wanted: never picked
+    EXPECT_EQ(ShaderFeatures::bestReadySubset(wanted, ready), static_cast<u32>(SHADER_FOG));
+
+    ready |= 1u << (SHADER_FOG | SHADER_SHADOWS);
+    EXPECT_EQ(ShaderFeatures::bestReadySubset(wanted, ready), static_cast<u32>(SHADER_FOG | SHADER_SHADOWS));
+
+    ready |= 1u << wanted;
+    EXPECT_EQ(ShaderFeatures::bestReadySubset(wanted, ready), wanted);
+}
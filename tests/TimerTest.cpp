@@ -0,0 +1,45 @@
+// =============================================================================
+// TimerTest.cpp - Cycle Clock and Timer Tests
+// =============================================================================
+// Ticks convert to wall time whichever clock source calibration picked.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Core/Timer.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace Sports;
+
+TEST(TimerTest, TicksTrackSteadyClock) {
+    CycleClock::calibration();  // First use spins for calibration; keep it out of the window
+    auto steadyStart = std::chrono::steady_clock::now();
+    u64 start = CycleClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    u64 end = CycleClock::nowSerialized();
+    f64 steadyNanos = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - steadyStart).count();
+
+    f64 nanos = CycleClock::toNanos(end - start);
+    EXPECT_GE(nanos, 25e6);
+    EXPECT_NEAR(nanos, steadyNanos, steadyNanos * 0.05);
+    EXPECT_NEAR(CycleClock::toSeconds(CycleClock::fromSeconds(0.5)), 0.5, 1e-6);
+}
+
+TEST(TimerTest, StopwatchAccumulatesOnlyWhileRunning) {
+    Stopwatch watch;
+    watch.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    watch.stop();
+    f64 first = watch.elapsed();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(watch.elapsed(), first);
+
+    watch.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    watch.stop();
+    EXPECT_GE(watch.elapsed(), 0.018);
+    EXPECT_NEAR(watch.elapsedNanos(), watch.elapsed() * 1e9, 1.0);
+
+    watch.reset();
+    EXPECT_EQ(watch.elapsedTicks(), 0u);
+}
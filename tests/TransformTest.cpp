@@ -0,0 +1,61 @@
+// =============================================================================
+// TransformTest.cpp - Batched Transform Composition Tests
+// =============================================================================
+// Closed-form and four-wide matrices must match the glm translate/rotate chain.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Math/Transform.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+using namespace Sports;
+
+namespace {
+
+Mat4 reference(const Vec3& position, f32 yaw, f32 pitch) {
+    Mat4 model = glm::translate(Mat4(1.0f), position);
+    model = glm::rotate(model, yaw, Vec3(0.0f, 1.0f, 0.0f));
+    return glm::rotate(model, pitch, Vec3(1.0f, 0.0f, 0.0f));
+}
+
+void expectNear(const Mat4& actual, const Mat4& expected) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            EXPECT_NEAR(actual[c][r], expected[c][r], 2e-6f) << "column " << c << " row " << r;
+        }
+    }
+}
+
+}
+
+TEST(TransformTest, SingleMatchesGlmChain) {
+    Vec3 position(12.5f, 0.9f, -30.0f);
+    expectNear(Transforms::translateYawPitch(position, 2.3f, 0.15f), reference(position, 2.3f, 0.15f));
+    expectNear(Transforms::translateYawPitch(position, 0.0f, glm::radians(90.0f)),
+               reference(position, 0.0f, glm::radians(90.0f)));
+}
+
+TEST(TransformTest, BatchMatchesGlmChainIncludingTail) {
+    TransformBatch batch;
+    std::vector<Vec3> positions;
+    std::vector<f32> yaws;
+    std::vector<f32> pitches;
+
+    // 11 entities: two full groups of four plus a scalar tail; angles sweep every octant
+    for (int i = 0; i < 11; i++) {
+        positions.emplace_back(i * 3.0f - 15.0f, 0.9f + i * 0.01f, 20.0f - i * 4.0f);
+        yaws.push_back(-7.0f + i * 1.37f);
+        pitches.push_back(i % 3 == 0 ? glm::radians(90.0f) : 0.05f * i - 0.2f);
+        EXPECT_EQ(batch.add(positions.back(), yaws.back(), pitches.back()), static_cast<u32>(i));
+    }
+    batch.compose();
+
+    ASSERT_EQ(batch.size(), 11u);
+    for (u32 i = 0; i < batch.size(); i++) {
+        expectNear(batch.getMatrix(i), reference(positions[i], yaws[i], pitches[i]));
+    }
+
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+}
@@ -0,0 +1,268 @@
+// =============================================================================
+// TransportTest.cpp - Network Transport Tests
+// =============================================================================
+// SPSC ring ordering and back-pressure, the shared-memory transport between
+// two endpoints, and the UDP transport over loopback.
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include "Net/SharedMemoryTransport.hpp"
+#include "Net/SpscRing.hpp"
+#include "Net/UdpTransport.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+using namespace Sports;
+
+namespace {
+
+// Whether this machine lets a socket use io_uring at all (sandboxes and old kernels don't)
+bool uringUsable() {
+#ifdef __linux__
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+    bool usable = false;
+    {
+        UringSocket probe;
+        usable = probe.init(fd);
+    }
+    ::close(fd);
+    return usable;
+#else
+    return false;
+#endif
+}
+
+std::string uniqueName(const char* test) {
+    return std::string("sports_test_") + test + "_" +
+           std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// Polls a transport for up to a second (UDP delivery is asynchronous even on loopback)
+bool receiveWithin(Transport& transport, std::span<u8> buffer, size_t& size) {
+    for (int i = 0; i < 1000; i++) {
+        if (transport.receive(buffer, size)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+}
+
+TEST(TransportTest, RingPreservesOrderAcrossThreads) {
+    constexpr u32 SLOTS = 16;
+    constexpr u32 MESSAGES = 20000;
+    std::vector<u8> memory(SpscRing::bytesFor(SLOTS) + 64);
+    void* aligned = memory.data() + (64 - reinterpret_cast<std::uintptr_t>(memory.data()) % 64) % 64;
+
+    SpscRing producer;
+    producer.attach(aligned, SLOTS);
+    producer.initialize();
+    SpscRing consumer;
+    consumer.attach(aligned, SLOTS);
+
+    std::thread writer([&] {
+        for (u32 i = 0; i < MESSAGES; i++) {
+            u8 message[8];
+            std::memcpy(message, &i, sizeof(i));
+            u32 length = 4 + i % 5;  // Sizes vary, as snapshots do
+            while (!producer.push(std::span<const u8>(message, length))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool inOrder = true;
+    for (u32 expected = 0; expected < MESSAGES;) {
+        u8 buffer[SpscRing::MAX_MESSAGE];
+        size_t size = 0;
+        if (!consumer.pop(buffer, size)) {
+            std::this_thread::yield();
+            continue;
+        }
+        u32 value;
+        std::memcpy(&value, buffer, sizeof(value));
+        inOrder = inOrder && value == expected && size == 4 + expected % 5;
+        expected++;
+    }
+    writer.join();
+    EXPECT_TRUE(inOrder);
+}
+
+TEST(TransportTest, RingRefusesWhenFullOrOversized) {
+    constexpr u32 SLOTS = 4;
+    std::vector<u8> memory(SpscRing::bytesFor(SLOTS));
+    SpscRing ring;
+    ring.attach(memory.data(), SLOTS);
+    ring.initialize();
+
+    std::array<u8, 1> byte{7};
+    for (u32 i = 0; i < SLOTS; i++) {
+        EXPECT_TRUE(ring.push(byte));
+    }
+    EXPECT_FALSE(ring.push(byte));
+
+    std::vector<u8> big(SpscRing::MAX_MESSAGE + 1);
+    size_t size = 0;
+    u8 buffer[4];
+    ASSERT_TRUE(ring.pop(buffer, size));
+    EXPECT_FALSE(ring.push(big));  // Space now, but too long
+    EXPECT_TRUE(ring.push(byte));
+}
+
+TEST(TransportTest, SharedMemoryCarriesBothDirections) {
+    std::string name = uniqueName("duplex");
+    SharedMemoryTransport server;
+    ASSERT_TRUE(server.create(name));
+    SharedMemoryTransport duplicate;
+    EXPECT_FALSE(duplicate.create(name));
+
+    SharedMemoryTransport client;
+    ASSERT_TRUE(client.attach(name));
+
+    std::array<u8, 3> snapshot{1, 2, 3};
+    std::array<u8, 2> input{9, 8};
+    ASSERT_TRUE(server.send(snapshot));
+    ASSERT_TRUE(client.send(input));
+
+    std::array<u8, Transport::MAX_MESSAGE> buffer{};
+    size_t size = 0;
+    ASSERT_TRUE(client.receive(buffer, size));
+    EXPECT_EQ(size, 3u);
+    EXPECT_EQ(buffer[2], 3);
+    EXPECT_FALSE(client.receive(buffer, size));  // Doesn't read its own sends
+
+    ASSERT_TRUE(server.receive(buffer, size));
+    EXPECT_EQ(size, 2u);
+    EXPECT_EQ(buffer[0], 9);
+
+    std::vector<u8> tooBig(Transport::MAX_MESSAGE + 1);
+    EXPECT_FALSE(server.send(tooBig));
+
+    // The name goes with the creator; a connected client keeps working
+    server.close();
+    SharedMemoryTransport late;
+    EXPECT_FALSE(late.attach(name));
+    EXPECT_TRUE(client.send(input));
+}
+
+#ifndef _WIN32
+TEST(TransportTest, SharedMemoryNameLeftByACrashIsReclaimed) {
+    std::string name = uniqueName("stale");
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        SharedMemoryTransport crashed;
+        _exit(crashed.create(name) ? 0 : 1);  // Exits without close(): the name stays
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    SharedMemoryTransport server;
+    ASSERT_TRUE(server.create(name));
+    SharedMemoryTransport duplicate;
+    EXPECT_FALSE(duplicate.create(name));  // A live creator still holds it
+
+    SharedMemoryTransport client;
+    ASSERT_TRUE(client.attach(name));
+    std::array<u8, 1> ping{5};
+    ASSERT_TRUE(client.send(ping));
+    std::array<u8, Transport::MAX_MESSAGE> buffer{};
+    size_t size = 0;
+    ASSERT_TRUE(server.receive(buffer, size));
+    EXPECT_EQ(buffer[0], 5);
+}
+#endif
+
+TEST(TransportTest, TransportsAreInterchangeable) {
+    std::string name = uniqueName("swap");
+    auto serverShm = std::make_unique<SharedMemoryTransport>();
+    auto clientShm = std::make_unique<SharedMemoryTransport>();
+    ASSERT_TRUE(serverShm->create(name));
+    ASSERT_TRUE(clientShm->attach(name));
+
+    auto serverUdp = std::make_unique<UdpTransport>();
+    auto clientUdp = std::make_unique<UdpTransport>();
+    ASSERT_TRUE(serverUdp->open(0, "127.0.0.1", 9));  // Peer port fixed up below
+    ASSERT_TRUE(clientUdp->open(0, "127.0.0.1", serverUdp->getLocalPort()));
+    u16 serverPort = serverUdp->getLocalPort();
+    ASSERT_TRUE(serverUdp->open(serverPort, "127.0.0.1", clientUdp->getLocalPort()));
+
+    std::pair<Transport*, Transport*> links[] = {{serverShm.get(), clientShm.get()},
+                                                 {serverUdp.get(), clientUdp.get()}};
+    for (auto [server, client] : links) {
+        std::vector<u8> snapshot(Transport::MAX_MESSAGE, 0x5A);
+        ASSERT_TRUE(server->send(snapshot));
+
+        std::array<u8, Transport::MAX_MESSAGE> buffer{};
+        size_t size = 0;
+        ASSERT_TRUE(receiveWithin(*client, buffer, size));
+        EXPECT_EQ(size, Transport::MAX_MESSAGE);
+        EXPECT_EQ(buffer.back(), 0x5A);
+
+        std::array<u8, 1> input{42};
+        ASSERT_TRUE(client->send(input));
+        ASSERT_TRUE(receiveWithin(*server, buffer, size));
+        EXPECT_EQ(size, 1u);
+        EXPECT_EQ(buffer[0], 42);
+    }
+}
+
+TEST(TransportTest, UdpBatchesOnEveryBackend) {
+    for (UdpBackend backend : {UdpBackend::Syscall, UdpBackend::IoUring}) {
+        UdpTransport a;
+        UdpTransport b;
+        ASSERT_TRUE(a.open(0, "127.0.0.1", 9, backend));
+        ASSERT_TRUE(b.open(0, "127.0.0.1", a.getLocalPort(), backend));
+        u16 portA = a.getLocalPort();
+        ASSERT_TRUE(a.open(portA, "127.0.0.1", b.getLocalPort(), backend));
+        if (backend == UdpBackend::IoUring && uringUsable()) {
+            // Otherwise a broken ring would quietly be tested as a second syscall run
+            ASSERT_EQ(a.getBackend(), UdpBackend::IoUring);
+            ASSERT_EQ(b.getBackend(), UdpBackend::IoUring);
+        }
+
+        // More than one batch's worth, each message tagged with its index
+        constexpr u32 COUNT = MessageBatch::CAPACITY + 10;
+        std::vector<std::array<u8, 2>> payloads(COUNT);
+        std::vector<std::span<const u8>> messages;
+        for (u32 i = 0; i < COUNT; i++) {
+            payloads[i] = {static_cast<u8>(i), 0xEE};
+            messages.emplace_back(payloads[i]);
+        }
+        ASSERT_EQ(b.sendBatch(std::span<const std::span<const u8>>(messages).first(MessageBatch::CAPACITY)),
+                  MessageBatch::CAPACITY);
+        ASSERT_EQ(b.sendBatch(std::span<const std::span<const u8>>(messages).subspan(MessageBatch::CAPACITY)), 10u);
+
+        MessageBatch batch;
+        std::vector<bool> seen(COUNT, false);
+        u32 received = 0;
+        for (int i = 0; i < 1000 && received < COUNT; i++) {
+            if (a.receiveBatch(batch) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            for (u32 m = 0; m < batch.count; m++) {
+                ASSERT_EQ(batch.sizes[m], 2u);
+                seen[batch[m][0]] = true;
+                received++;
+            }
+        }
+        EXPECT_EQ(received, COUNT);
+        EXPECT_EQ(std::count(seen.begin(), seen.end(), true), static_cast<long>(COUNT));
+    }
+}
@@ -0,0 +1,62 @@
+// AssetPacker.cpp
+// Build-time tool: packs every file under an asset directory into one .pak.
+// Usage: SportsAssetPacker <asset-dir> <output.pak>
+#include "Core/AssetPack.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Sports;
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "Usage: %s <asset-dir> <output.pak>\n", argv[0]);
+        return 1;
+    }
+
+    fs::path root = argv[1];
+    if (!fs::is_directory(root)) {
+        std::fprintf(stderr, "Not a directory: %s\n", argv[1]);
+        return 1;
+    }
+
+    // Sorted so the same inputs always produce the same pack
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    AssetPackWriter writer;
+    u64 totalBytes = 0;
+    for (const auto& file : files) {
+        std::ifstream in(file, std::ios::binary | std::ios::ate);
+        if (!in) {
+            std::fprintf(stderr, "Failed to read %s\n", file.string().c_str());
+            return 1;
+        }
+
+        std::vector<u8> data(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        totalBytes += data.size();
+
+        writer.add(fs::relative(file, root).generic_string(), std::move(data));
+    }
+
+    if (!writer.write(argv[2])) {
+        std::fprintf(stderr, "Failed to write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("Packed %zu assets (%llu bytes) into %s\n", writer.getCount(),
+                static_cast<unsigned long long>(totalBytes), argv[2]);
+    return 0;
+}
@@ -0,0 +1,256 @@
+// Highlights.cpp
+// Cuts a highlight reel from any number of recorded matches: the event index at the end of
+// each replay is read through a memory mapping (no tick is decoded or re-simulated), the best
+// events are picked, and only the windows around them are rendered by offscreen engines.
+// Usage: SportsHighlights <output.y4m|output.rgba> <replay.rpl|directory>... [--events goal,shot,...]
+//        [--top <n>] [--before <s>] [--after <s>] [--jobs <n>] [--engine <path>] [--list]
+#include "Core/FrameEncoder.hpp"
+#include "Core/ProcessPool.hpp"
+#include "Game/MatchEvents.hpp"
+#include "Game/Replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Sports;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr u32 EVENT_TYPE_COUNT = 5;
+constexpr u32 ALL_EVENTS = (1u << EVENT_TYPE_COUNT) - 1;
+
+struct Candidate {
+    u32 file = 0;
+    MatchEvent event;
+};
+
+struct Clip {
+    u32 file = 0;
+    TickRange ticks;
+};
+
+// Earlier in the list is worth more, whatever the value
+constexpr MatchEventType RANKING[EVENT_TYPE_COUNT] = {MatchEventType::Goal, MatchEventType::NearMiss,
+                                                       MatchEventType::Shot, MatchEventType::LongPass,
+                                                       MatchEventType::FastBall};
+
+u32 rankOf(MatchEventType type) {
+    return static_cast<u32>(std::find(std::begin(RANKING), std::end(RANKING), type) - std::begin(RANKING));
+}
+
+// Within a type: faster goals and shots, longer passes, closer misses
+bool better(const Candidate& a, const Candidate& b) {
+    u32 rankA = rankOf(a.event.type);
+    u32 rankB = rankOf(b.event.type);
+    if (rankA != rankB) return rankA < rankB;
+    if (a.event.type == MatchEventType::NearMiss) return a.event.value < b.event.value;
+    return a.event.value > b.event.value;
+}
+
+// "goal,nearmiss" -> bit mask over MatchEventType; 0 on an unknown name
+u32 parseEventMask(const std::string& list) {
+    u32 mask = 0;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = std::min(list.find(',', start), list.size());
+        std::string name = list.substr(start, end - start);
+        u32 bit = 0;
+        for (u32 type = 0; type < EVENT_TYPE_COUNT; type++) {
+            if (name == MatchEventDetector::getName(static_cast<MatchEventType>(type))) {
+                bit = 1u << type;
+            }
+        }
+        if (bit == 0) {
+            return 0;
+        }
+        mask |= bit;
+        start = end + 1;
+    }
+    return mask;
+}
+
+// Files as given, directories searched for .rpl files; sorted so the reel order is stable
+std::vector<std::string> collectReplays(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (!fs::is_directory(input, error)) {
+            files.push_back(input);
+            continue;
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(input, error)) {
+            if (entry.is_regular_file(error) && entry.path().extension() == ".rpl") {
+                files.push_back(entry.path().string());
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s <output.y4m|output.rgba> <replay.rpl|directory>... [--events goal,shot,nearmiss,longpass,fast]\n"
+                 "       [--top <n>] [--before <s>] [--after <s>] [--jobs <n>] [--engine <path>] [--list]\n",
+                 program);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string outputPath = argv[1];
+    std::vector<std::string> inputs;
+    u32 eventMask = ALL_EVENTS;
+    u32 top = 20;
+    f32 before = 4.0f;
+    f32 after = 3.0f;
+    bool listOnly = false;
+    u32 jobs = std::max(1u, std::thread::hardware_concurrency());
+#ifdef _WIN32
+    fs::path engine = fs::path(argv[0]).replace_filename("SportsEngine.exe");
+#else
+    fs::path engine = fs::path(argv[0]).replace_filename("SportsEngine");
+#endif
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--events" && hasValue) {
+            eventMask = parseEventMask(argv[++i]);
+            if (eventMask == 0) {
+                std::fprintf(stderr, "Unknown event type in %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--top" && hasValue) {
+            top = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--before" && hasValue) {
+            before = std::max(0.0f, std::strtof(argv[++i], nullptr));
+        } else if (arg == "--after" && hasValue) {
+            after = std::max(0.0f, std::strtof(argv[++i], nullptr));
+        } else if (arg == "--jobs" && hasValue) {
+            jobs = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--engine" && hasValue) {
+            engine = argv[++i];
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    jobs = std::clamp(jobs, 1u, ProcessPool::MAX_RUNNING);
+
+    // Query: only each replay's header page and its index tables are touched
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> files = collectReplays(inputs);
+    std::vector<ReplayHeader> headers(files.size());
+    std::vector<Candidate> candidates;
+    size_t unreadable = 0;
+    ReplayIndex index;
+    for (u32 file = 0; file < files.size(); file++) {
+        if (!index.open(files[file])) {
+            unreadable++;  // Not a replay, or never closed (playable, but without events)
+            continue;
+        }
+        headers[file] = index.getHeader();
+        for (const MatchEvent& event : index.getEvents()) {
+            if (static_cast<u32>(event.type) < EVENT_TYPE_COUNT && ((eventMask >> static_cast<u32>(event.type)) & 1)) {
+                candidates.push_back({file, event});
+            }
+        }
+    }
+    index.close();
+
+    size_t found = candidates.size();
+    size_t keep = std::min<size_t>(top, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(keep), candidates.end(),
+                      better);
+    candidates.resize(keep);
+
+    // Windows around the picks, in match order, merged where they overlap
+    std::vector<Clip> clips;
+    for (const Candidate& pick : candidates) {
+        const ReplayHeader& header = headers[pick.file];
+        u64 lead = static_cast<u64>(before * header.tickRate);
+        u64 tail = static_cast<u64>(after * header.tickRate);
+        u64 end = header.firstTick + header.tickCount;
+        u64 begin = std::max(pick.event.tick, header.firstTick + lead) - lead;
+        clips.push_back({pick.file, {begin, std::min(pick.event.tick + tail + 1, end)}});
+    }
+    std::sort(clips.begin(), clips.end(), [](const Clip& a, const Clip& b) {
+        return a.file != b.file ? a.file < b.file : a.ticks.begin < b.ticks.begin;
+    });
+    std::vector<Clip> merged;
+    for (const Clip& clip : clips) {
+        if (clip.ticks.begin >= clip.ticks.end) continue;
+        if (!merged.empty() && merged.back().file == clip.file && clip.ticks.begin <= merged.back().ticks.end) {
+            merged.back().ticks.end = std::max(merged.back().ticks.end, clip.ticks.end);
+        } else {
+            merged.push_back(clip);
+        }
+    }
+    f64 queryMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%zu events in %zu replays (%zu unreadable) in %.1f ms; %zu picked, %zu clips\n", found,
+                files.size() - unreadable, unreadable, queryMs, candidates.size(), merged.size());
+    if (listOnly) {
+        for (const Candidate& pick : candidates) {
+            std::printf("%-9s %6.1f  tick %-8llu %s\n", MatchEventDetector::getName(pick.event.type), pick.event.value,
+                        static_cast<unsigned long long>(pick.event.tick), files[pick.file].c_str());
+        }
+        return 0;
+    }
+    if (merged.empty()) {
+        std::fprintf(stderr, "No events to render\n");
+        return 1;
+    }
+
+    // Render: one offscreen engine per clip, seeking straight to it
+    std::vector<std::string> parts;
+    std::vector<std::vector<std::string>> commands;
+    u64 frames = 0;
+    for (size_t i = 0; i < merged.size(); i++) {
+        const Clip& clip = merged[i];
+        parts.push_back(FrameEncoder::partPath(outputPath, i));
+        commands.push_back({engine.string(), "--offscreen", "--replay", files[clip.file], "--ticks",
+                            std::to_string(clip.ticks.begin) + ":" + std::to_string(clip.ticks.end), "--record",
+                            parts[i]});
+        frames += clip.ticks.end - clip.ticks.begin;
+    }
+
+    start = std::chrono::steady_clock::now();
+    size_t failedClip = 0;
+    bool failed = !ProcessPool::runAll(commands, jobs, &failedClip);
+    if (failed) {
+        std::fprintf(stderr, "Clip %zu (%s, ticks %llu-%llu) failed\n", failedClip, files[merged[failedClip].file].c_str(),
+                     static_cast<unsigned long long>(merged[failedClip].ticks.begin),
+                     static_cast<unsigned long long>(merged[failedClip].ticks.end));
+    }
+    bool joined = !failed && FrameEncoder::concatenate(parts, outputPath);
+    std::error_code ignored;
+    for (const std::string& part : parts) {
+        fs::remove(part, ignored);
+    }
+    if (!joined) {
+        std::fprintf(stderr, "Highlights to %s failed\n", outputPath.c_str());
+        return 1;
+    }
+
+    f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+    std::printf("Wrote %llu frames to %s in %.1f s\n", static_cast<unsigned long long>(frames), outputPath.c_str(),
+                seconds);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// NetBench.cpp
+// Loopback UDP throughput: packets per second per core for each way of driving the socket.
+// Usage: SportsNetBench [payload-bytes] [seconds-per-mode]
+#include "Net/UdpTransport.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+using namespace Sports;
+
+namespace {
+
+enum class Mode { PerPacket, Batched, IoUring };
+
+struct Result {
+    u64 received = 0;
+    f64 wallSeconds = 0.0;
+    f64 cpuSeconds = 0.0;  // Whole process, so io_uring's kernel workers are included
+};
+
+// One thread plays both ends, so everything it costs lands on one core
+Result run(Mode mode, size_t payload, f64 seconds) {
+    UdpBackend backend = mode == Mode::IoUring ? UdpBackend::IoUring : UdpBackend::Syscall;
+    UdpTransport server;
+    UdpTransport client;
+    Result result;
+    if (!server.open(0, "127.0.0.1", 9, backend) ||
+        !client.open(0, "127.0.0.1", server.getLocalPort(), backend) ||
+        !server.open(server.getLocalPort(), "127.0.0.1", client.getLocalPort(), backend)) {
+        std::fprintf(stderr, "Cannot open loopback sockets\n");
+        return result;
+    }
+    if (mode == Mode::IoUring && server.getBackend() != UdpBackend::IoUring) {
+        std::fprintf(stderr, "io_uring unavailable here; skipped\n");
+        return result;
+    }
+
+    std::vector<u8> data(payload, 0x5A);
+    std::vector<std::span<const u8>> messages(MessageBatch::CAPACITY, std::span<const u8>(data));
+    MessageBatch batch;
+    std::vector<u8> buffer(Transport::MAX_MESSAGE);
+    size_t size = 0;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    std::clock_t cpuStart = std::clock();
+    auto deadline = wallStart + std::chrono::duration<f64>(seconds);
+    while (std::chrono::steady_clock::now() < deadline) {
+        // A burst the size of one batch, then drain it; loopback delivers within the send
+        if (mode == Mode::PerPacket) {
+            for (u32 i = 0; i < MessageBatch::CAPACITY; i++) {
+                client.send(data);
+            }
+            while (server.receive(buffer, size)) {
+                result.received++;
+            }
+        } else {
+            // A short batch means the socket is drained, as a server polling once a tick would see
+            client.sendBatch(messages);
+            u32 count = 0;
+            do {
+                count = server.receiveBatch(batch);
+                result.received += count;
+            } while (count == MessageBatch::CAPACITY);
+        }
+    }
+    result.cpuSeconds = static_cast<f64>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result.wallSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - wallStart).count();
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t payload = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    f64 seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 2.0;
+    if (payload == 0 || payload > Transport::MAX_MESSAGE || seconds <= 0.0) {
+        std::fprintf(stderr, "Usage: %s [payload-bytes 1-%zu] [seconds-per-mode]\n", argv[0], Transport::MAX_MESSAGE);
+        return 1;
+    }
+
+    struct Named {
+        Mode mode;
+        const char* name;
+    };
+    const Named modes[] = {{Mode::PerPacket, "send/recv"},
+                           {Mode::Batched, "sendmmsg/recvmmsg"},
+                           {Mode::IoUring, "io_uring"}};
+
+    std::printf("%zu-byte datagrams over loopback, one thread sending and receiving\n", payload);
+    std::printf("%-20s %14s %16s\n", "mode", "packets/s", "packets/s/core");
+    for (const Named& entry : modes) {
+        Result result = run(entry.mode, payload, seconds);
+        if (result.received == 0 || result.wallSeconds <= 0.0) {
+            continue;
+        }
+        f64 perCore = result.cpuSeconds > 0.0 ? result.received / result.cpuSeconds : 0.0;
+        std::printf("%-20s %14.0f %16.0f\n", entry.name, result.received / result.wallSeconds, perCore);
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// ReplayExport.cpp
+// Renders a replay to video on every core: the replay is split at keyframes, each segment
+// is drawn by its own offscreen SportsEngine process, and the parts are joined in order.
+// Usage: SportsReplayExport <replay.rpl> <output.y4m|output.rgba> [--jobs <n>] [--engine <path>]
+#include "Core/FrameEncoder.hpp"
+#include "Core/ProcessPool.hpp"
+#include "Game/Replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Sports;
+namespace fs = std::filesystem;
+
+namespace {
+
+// More segments than processes, so one slow stretch (a goal celebration, a crowded box)
+// doesn't leave the other cores idle at the end
+constexpr u32 SEGMENTS_PER_JOB = 3;
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <replay.rpl> <output.y4m|output.rgba> [--jobs <n>] [--engine <path>]\n",
+                     argv[0]);
+        return 1;
+    }
+    std::string replayPath = argv[1];
+    fs::path outputPath = argv[2];
+    u32 jobs = std::max(1u, std::thread::hardware_concurrency());
+#ifdef _WIN32
+    fs::path engine = fs::path(argv[0]).replace_filename("SportsEngine.exe");
+#else
+    fs::path engine = fs::path(argv[0]).replace_filename("SportsEngine");
+#endif
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--jobs") {
+            jobs = static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (arg == "--engine") {
+            engine = argv[i + 1];
+        }
+    }
+    jobs = std::clamp(jobs, 1u, ProcessPool::MAX_RUNNING);
+
+    ReplayReader replay;
+    if (!replay.open(replayPath)) {
+        std::fprintf(stderr, "Cannot read replay %s\n", replayPath.c_str());
+        return 1;
+    }
+    std::vector<TickRange> segments = splitAtKeyframes(replay.getKeyframes(), replay.getEndTick(),
+                                                       jobs * SEGMENTS_PER_JOB);
+    replay.close();
+
+    std::vector<std::string> parts;
+    for (size_t i = 0; i < segments.size(); i++) {
+        parts.push_back(FrameEncoder::partPath(outputPath.string(), i));
+    }
+    std::printf("%zu segments on up to %u processes\n", segments.size(), jobs);
+
+    std::vector<std::vector<std::string>> commands;
+    for (size_t i = 0; i < segments.size(); i++) {
+        const TickRange& range = segments[i];
+        commands.push_back({engine.string(), "--offscreen", "--replay", replayPath, "--ticks",
+                            std::to_string(range.begin) + ":" + std::to_string(range.end), "--record", parts[i]});
+    }
+
+    // Segments may finish in any order; the join waits for all of them
+    auto start = std::chrono::steady_clock::now();
+    size_t failedSegment = 0;
+    bool failed = !ProcessPool::runAll(commands, jobs, &failedSegment);
+    if (failed) {
+        std::fprintf(stderr, "Segment %zu (ticks %llu-%llu) failed\n", failedSegment,
+                     static_cast<unsigned long long>(segments[failedSegment].begin),
+                     static_cast<unsigned long long>(segments[failedSegment].end));
+    }
+
+    bool joined = !failed && FrameEncoder::concatenate(parts, outputPath.string());
+    std::error_code ignored;
+    for (const std::string& part : parts) {
+        fs::remove(part, ignored);
+    }
+    if (!joined) {
+        std::fprintf(stderr, "Export of %s failed\n", replayPath.c_str());
+        return 1;
+    }
+
+    f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+    u64 ticks = segments.empty() ? 0 : segments.back().end - segments.front().begin;
+    std::printf("Wrote %llu frames to %s in %.1f s (%.0f frames/s)\n", static_cast<unsigned long long>(ticks),
+                outputPath.string().c_str(), seconds, seconds > 0.0 ? ticks / seconds : 0.0);
+    return 0;
+}